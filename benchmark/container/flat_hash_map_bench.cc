@@ -0,0 +1,104 @@
+//
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+#include <collie/container/flat_hash_map.h>
+#include <collie/container/htrie_map.h>
+#include <collie/testing/pico_bench.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+static constexpr size_t kKeys = 1 << 20;
+
+template<typename F>
+void report(const char *name, const char *op, F &&f) {
+    auto bencher = pico_bench::Benchmarker<std::chrono::microseconds>{5, std::chrono::seconds{10}};
+    size_t sink = 0;
+    auto stats = bencher([&] { sink += f(); });
+    auto median_us = static_cast<double>(stats.median().count());
+    std::cout << name << ' ' << op << " median " << median_us * 1e3 / kKeys << " ns/op"
+              << (sink == 0 ? " " : "") << '\n';
+}
+
+// insert all the keys in a new map, then look up the keys in another order
+// and keys that are absent
+template<typename Map, typename Key>
+void bench_map(const char *name, const std::vector<Key> &keys, const std::vector<Key> &shuffled,
+               const std::vector<Key> &absent) {
+    report(name, "insert", [&] {
+        Map m;
+        for (size_t i = 0; i < keys.size(); ++i) {
+            m.emplace(keys[i], i);
+        }
+        return m.size();
+    });
+    Map m;
+    for (size_t i = 0; i < keys.size(); ++i) {
+        m.emplace(keys[i], i);
+    }
+    report(name, "find hit", [&] {
+        size_t sum = 0;
+        for (auto &k: shuffled) {
+            sum += m.find(k) != m.end();
+        }
+        return sum;
+    });
+    report(name, "find miss", [&] {
+        size_t sum = 0;
+        for (auto &k: absent) {
+            sum += m.find(k) != m.end();
+        }
+        return sum + 1;
+    });
+}
+
+int main() {
+    std::mt19937_64 rng(42);
+
+    std::vector<uint64_t> ints(kKeys), absent_ints(kKeys);
+    for (size_t i = 0; i < kKeys; ++i) {
+        ints[i] = rng() | 1;
+        absent_ints[i] = rng() & ~uint64_t{1};
+    }
+    auto shuffled_ints = ints;
+    std::shuffle(shuffled_ints.begin(), shuffled_ints.end(), rng);
+
+    bench_map<std::unordered_map<uint64_t, uint64_t>>("std::unordered_map  ", ints, shuffled_ints, absent_ints);
+    bench_map<collie::flat_hash_map<uint64_t, uint64_t>>("collie::flat_hash_map", ints, shuffled_ints, absent_ints);
+    bench_map<collie::node_hash_map<uint64_t, uint64_t>>("collie::node_hash_map", ints, shuffled_ints, absent_ints);
+    std::cout << '\n';
+
+    // keys shaped like cache keys
+    std::vector<std::string> strs(kKeys), absent_strs(kKeys);
+    for (size_t i = 0; i < kKeys; ++i) {
+        strs[i] = "user:" + std::to_string(rng() % 100000000) + ":profile:" + std::to_string(i);
+        absent_strs[i] = "user:" + std::to_string(rng() % 100000000) + ":session:" + std::to_string(i);
+    }
+    auto shuffled_strs = strs;
+    std::shuffle(shuffled_strs.begin(), shuffled_strs.end(), rng);
+
+    bench_map<std::unordered_map<std::string, uint64_t>>("std::unordered_map  ", strs, shuffled_strs, absent_strs);
+    bench_map<collie::flat_hash_map<std::string, uint64_t>>("collie::flat_hash_map", strs, shuffled_strs, absent_strs);
+    bench_map<collie::node_hash_map<std::string, uint64_t>>("collie::node_hash_map", strs, shuffled_strs, absent_strs);
+    bench_map<collie::htrie_map<char, uint64_t>>("collie::htrie_map   ", strs, shuffled_strs, absent_strs);
+    return 0;
+}
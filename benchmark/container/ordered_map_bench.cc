@@ -0,0 +1,101 @@
+//
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+#include <collie/container/fifo_map.h>
+#include <collie/container/ordered_hash_map.h>
+#include <collie/nlohmann/json.hpp>
+#include <collie/testing/pico_bench.hpp>
+
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+static constexpr size_t kLookups = 1 << 16;
+
+template<typename F>
+void report(const char *name, size_t keys, F &&f) {
+    auto bencher = pico_bench::Benchmarker<std::chrono::microseconds>{5, std::chrono::seconds{10}};
+    size_t sink = 0;
+    auto stats = bencher([&] { sink += f(); });
+    auto median_us = static_cast<double>(stats.median().count());
+    std::cout << name << " keys " << keys << " find median " << median_us * 1e3 / kLookups << " ns/op"
+              << (sink == 0 ? " " : "") << '\n';
+}
+
+// looks up the keys of an object of n members, in random order
+void bench_keys(size_t n) {
+    std::vector<std::string> keys;
+    for (size_t i = 0; i < n; ++i) {
+        keys.push_back("member_" + std::to_string(i * 7919 % 100003));
+    }
+    std::mt19937 rng(42);
+    std::vector<std::string> lookups;
+    for (size_t i = 0; i < kLookups; ++i) {
+        lookups.push_back(keys[rng() % n]);
+    }
+
+    // what nlohmann::ordered_map did: a linear scan of a vector of pairs
+    std::vector<std::pair<const std::string, int>> vec;
+    collie::fifo_map<std::string, int> fifo;
+    collie::ordered_hash_map<std::string, int> ordered;
+    nlohmann::ordered_json oj = nlohmann::ordered_json::object();
+    for (size_t i = 0; i < n; ++i) {
+        vec.emplace_back(keys[i], static_cast<int>(i));
+        fifo[keys[i]] = static_cast<int>(i);
+        ordered[keys[i]] = static_cast<int>(i);
+        oj[keys[i]] = i;
+    }
+
+    report("vector scan     ", n, [&] {
+        size_t sum = 0;
+        for (auto &k: lookups) {
+            sum += std::find_if(vec.begin(), vec.end(), [&](auto &kv) { return kv.first == k; })->second;
+        }
+        return sum;
+    });
+    report("fifo_map        ", n, [&] {
+        size_t sum = 0;
+        for (auto &k: lookups) {
+            sum += fifo.find(k)->second;
+        }
+        return sum;
+    });
+    report("ordered_hash_map", n, [&] {
+        size_t sum = 0;
+        for (auto &k: lookups) {
+            sum += ordered.find(k)->second;
+        }
+        return sum;
+    });
+    report("ordered_json at ", n, [&] {
+        size_t sum = 0;
+        for (auto &k: lookups) {
+            sum += oj.at(k).get<size_t>();
+        }
+        return sum;
+    });
+}
+
+int main() {
+    for (size_t n: {8, 64, 512, 4096}) {
+        bench_keys(n);
+    }
+    return 0;
+}
@@ -0,0 +1,94 @@
+//
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+// pattern_formatter and compiled_pattern cost per message and cost of the log clocks.
+// The "uncached" patterns start with the zero width %$ flag, which stops the
+// per-second date prefix cache and formats every date/time flag field by field.
+
+#include <collie/log/compiled_pattern.h>
+#include <collie/log/details/os.h>
+#include <collie/log/details/tsc_clock.h>
+#include <collie/log/pattern_formatter.h>
+#include <collie/testing/pico_bench.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+using namespace collie::log;
+
+static constexpr size_t kMessages = 1 << 20;
+
+static constexpr char kPattern[] = "[%Y-%m-%d %H:%M:%S.%e] [%n] [%l] %v";
+static constexpr char kIsoPattern[] = "%Y-%m-%dT%H:%M:%S.%f%z %v";
+
+static void bench_formatter(const char *name, formatter &formatter) {
+    details::log_msg msg("bench", level::info, "some log message payload");
+    auto start = log_clock::now();
+    memory_buf_t dest;
+    auto bencher = pico_bench::Benchmarker<std::chrono::milliseconds>{10, std::chrono::seconds{5}};
+    auto stats = bencher([&] {
+        for (size_t i = 0; i < kMessages; i++) {
+            // 1024 messages per second of log time
+            msg.time = start + std::chrono::microseconds(i * 977);
+            dest.clear();
+            formatter.format(msg, dest);
+        }
+    });
+    auto median_ms = static_cast<double>(stats.median().count());
+    std::cout << name << " median " << median_ms * 1e6 / kMessages << " ns/msg\n";
+}
+
+static void bench_pattern(const char *name, const std::string &pattern) {
+    pattern_formatter formatter(pattern);
+    bench_formatter(name, formatter);
+}
+
+template <const char *Pattern>
+static void bench_compiled(const char *name) {
+    compiled_pattern<Pattern> formatter;
+    bench_formatter(name, formatter);
+}
+
+template <typename Clock>
+static void bench_clock(const char *name, Clock clock) {
+    auto bencher = pico_bench::Benchmarker<std::chrono::milliseconds>{10, std::chrono::seconds{5}};
+    volatile log_clock::rep last = 0;
+    auto stats = bencher([&] {
+        for (size_t i = 0; i < kMessages; i++) {
+            last = clock().time_since_epoch().count();
+        }
+    });
+    auto median_ms = static_cast<double>(stats.median().count());
+    std::cout << name << " median " << median_ms * 1e6 / kMessages << " ns/call\n";
+}
+
+int main() {
+    bench_pattern("full (%+)", "%+");
+    bench_pattern("date prefix cached", kPattern);
+    bench_pattern("date prefix uncached", std::string("%$") + kPattern);
+    bench_compiled<kPattern>("date compiled_pattern");
+    bench_pattern("iso prefix cached", kIsoPattern);
+    bench_pattern("iso prefix uncached", std::string("%$") + kIsoPattern);
+    bench_compiled<kIsoPattern>("iso compiled_pattern");
+
+    bench_clock("system_clock", [] { return log_clock::now(); });
+    bench_clock("os::now", [] { return details::os::now(); });
+    bench_clock("tsc_clock", [] { return details::tsc_clock::now(); });
+    return 0;
+}
@@ -0,0 +1,74 @@
+//
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+// contention benchmark of the async thread pool queues:
+// N producers push async_msg items, one consumer drains them in batches.
+
+#include <collie/log/async.h>
+#include <collie/testing/pico_bench.hpp>
+
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace collie::log;
+
+static constexpr size_t kQueueSize = 8192;
+static constexpr size_t kTotalMessages = 1 << 19;
+
+template <typename Queue>
+void run_contention(Queue &q, size_t producers) {
+    const size_t per_producer = kTotalMessages / producers;
+    std::vector<std::thread> threads;
+    threads.reserve(producers);
+    for (size_t p = 0; p < producers; p++) {
+        threads.emplace_back([&q, per_producer] {
+            details::log_msg msg("bench", level::info, "some log message payload");
+            for (size_t i = 0; i < per_producer; i++) {
+                q.enqueue(details::async_msg(nullptr, details::async_msg_type::log, msg));
+            }
+        });
+    }
+
+    std::vector<details::async_msg> batch(details::thread_pool::max_batch_size);
+    size_t received = 0;
+    while (received < per_producer * producers) {
+        received += q.dequeue_bulk(batch.data(), batch.size());
+    }
+    for (auto &t : threads) {
+        t.join();
+    }
+}
+
+template <typename Queue>
+void bench_queue(const char *name, size_t producers) {
+    auto bencher = pico_bench::Benchmarker<std::chrono::milliseconds>{10, std::chrono::seconds{5}};
+    Queue q(kQueueSize);
+    auto stats = bencher([&] { run_contention(q, producers); });
+    auto median_ms = static_cast<double>(stats.median().count());
+    std::cout << name << " producers=" << producers << " median " << median_ms << "ms, "
+              << (median_ms > 0 ? kTotalMessages / median_ms / 1000.0 : 0.0) << " Mmsg/s\n";
+}
+
+int main() {
+    for (size_t producers : {1, 8, 64}) {
+        bench_queue<details::mpmc_blocking_queue<details::async_msg>>("mpmc_blocking_queue", producers);
+        bench_queue<details::mpmc_lockfree_queue<details::async_msg>>("mpmc_lockfree_queue", producers);
+    }
+    return 0;
+}
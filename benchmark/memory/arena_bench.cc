@@ -0,0 +1,117 @@
+//
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+#include <collie/memory/arena.h>
+#include <collie/memory/memory_resource.h>
+#include <collie/memory/size_class_pool.h>
+#include <collie/testing/pico_bench.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <memory_resource>
+#include <random>
+#include <vector>
+
+static constexpr size_t kObjects = 1 << 20;
+
+template<typename F>
+void report(const char *name, F &&f) {
+    auto bencher = pico_bench::Benchmarker<std::chrono::microseconds>{5, std::chrono::seconds{10}};
+    size_t sink = 0;
+    auto stats = bencher([&] { sink += f(); });
+    auto median_us = static_cast<double>(stats.median().count());
+    std::cout << name << " median " << median_us * 1e3 / kObjects << " ns/object"
+              << (sink == 0 ? " " : "") << '\n';
+}
+
+int main() {
+    std::mt19937 rng(42);
+    std::vector<size_t> sizes(kObjects);
+    for (auto &s: sizes) {
+        s = 16 + rng() % 113;
+    }
+    // frees in random order, as a graph of objects would
+    std::vector<size_t> order(kObjects);
+    for (size_t i = 0; i < kObjects; ++i) {
+        order[i] = i;
+    }
+    std::shuffle(order.begin(), order.end(), rng);
+    std::vector<void *> ptrs(kObjects);
+
+    // allocate 1M objects of 16 to 128 bytes, then free them all
+    report("malloc/free        ", [&] {
+        for (size_t i = 0; i < kObjects; ++i) {
+            ptrs[i] = std::malloc(sizes[i]);
+            *static_cast<char *>(ptrs[i]) = 1;
+        }
+        for (auto i: order) {
+            std::free(ptrs[i]);
+        }
+        return ptrs.size();
+    });
+    report("size_class_pool    ", [&] {
+        for (size_t i = 0; i < kObjects; ++i) {
+            ptrs[i] = collie::size_class_pool::allocate(sizes[i]);
+            *static_cast<char *>(ptrs[i]) = 1;
+        }
+        for (auto i: order) {
+            collie::size_class_pool::deallocate(ptrs[i], sizes[i]);
+        }
+        return ptrs.size();
+    });
+    collie::monotonic_arena arena;
+    report("monotonic_arena    ", [&] {
+        for (size_t i = 0; i < kObjects; ++i) {
+            ptrs[i] = arena.allocate(sizes[i], 8);
+            *static_cast<char *>(ptrs[i]) = 1;
+        }
+        arena.reset();
+        return ptrs.size();
+    });
+
+    // fill a std::map then destroy it
+    report("map std::allocator ", [&] {
+        std::map<size_t, size_t> m;
+        for (size_t i = 0; i < kObjects; ++i) {
+            m.emplace(order[i], i);
+        }
+        return m.size();
+    });
+    report("map pool_allocator ", [&] {
+        std::map<size_t, size_t, std::less<>, collie::pool_allocator<std::pair<const size_t, size_t>>> m;
+        for (size_t i = 0; i < kObjects; ++i) {
+            m.emplace(order[i], i);
+        }
+        return m.size();
+    });
+    report("map arena_resource ", [&] {
+        size_t n;
+        {
+            collie::arena_resource resource(arena);
+            std::pmr::map<size_t, size_t> m(&resource);
+            for (size_t i = 0; i < kObjects; ++i) {
+                m.emplace(order[i], i);
+            }
+            n = m.size();
+        }
+        arena.reset();
+        return n;
+    });
+    return 0;
+}
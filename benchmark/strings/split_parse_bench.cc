@@ -0,0 +1,91 @@
+//
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+#include <collie/strings/splitter.h>
+#include <collie/testing/pico_bench.hpp>
+
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+
+// TSV rows of an id, a count and three measurements
+static std::string make_tsv(size_t rows) {
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<double> real(-1000, 1000);
+    std::string s;
+    for (size_t i = 0; i < rows; ++i) {
+        s += std::to_string(i) + '\t' + std::to_string(rng() % 100000);
+        for (int k = 0; k < 3; ++k) {
+            s += '\t' + std::to_string(real(rng));
+        }
+        s += '\t';
+    }
+    return s;
+}
+
+template<typename F>
+void report(const char *name, const std::string &input, F &&f) {
+    auto bencher = pico_bench::Benchmarker<std::chrono::microseconds>{10, std::chrono::seconds{5}};
+    double sink = 0;
+    auto stats = bencher([&] { sink += f(input); });
+    auto median_us = static_cast<double>(stats.median().count());
+    std::cout << name << " median " << input.size() / median_us << " MB/s"
+              << (sink == 0 ? " " : "") << '\n';
+}
+
+int main() {
+    auto tsv = make_tsv(200000);
+
+    // what StringSplitter::to_double used to do
+    report("StringSplitter + strtod", tsv, [](const std::string &s) {
+        double sum = 0;
+        for (collie::StringSplitter sp(s.data(), s.data() + s.size(), '\t'); sp; ++sp) {
+            char *end = nullptr;
+            sum += strtod(sp.field(), &end);
+        }
+        return sum;
+    });
+    report("StringSplitter::to_double", tsv, [](const std::string &s) {
+        double sum = 0;
+        for (collie::StringSplitter sp(s, '\t'); sp; ++sp) {
+            double v;
+            if (sp.to_double(&v) == 0) {
+                sum += v;
+            }
+        }
+        return sum;
+    });
+    report("split_view + parse_field", tsv, [](const std::string &s) {
+        double sum = 0;
+        for (auto f: collie::split_view(s, '\t')) {
+            double v;
+            if (collie::parse_field(f, &v) == 0) {
+                sum += v;
+            }
+        }
+        return sum;
+    });
+    report("split_view only", tsv, [](const std::string &s) {
+        double n = 0;
+        for (auto f: collie::split_view(s, '\t')) {
+            n += static_cast<double>(f.size());
+        }
+        return n;
+    });
+    return 0;
+}
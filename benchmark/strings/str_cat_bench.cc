@@ -0,0 +1,85 @@
+//
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <collie/strings/cat.h>
+#include <collie/strings/inlined_string.h>
+#include <collie/testing/pico_bench.hpp>
+
+#include <iostream>
+#include <string>
+
+static constexpr size_t kKeys = 1 << 18;
+
+// the recursive implementation str_cat used to have, for comparison
+template <typename T>
+std::string recursive_cat(const T &t) {
+    return fmt::format("{}", t);
+}
+
+template <typename T, typename... Args>
+std::string recursive_cat(const T &t, const Args &... args) {
+    return fmt::format("{}{}", t, recursive_cat(args...));
+}
+
+template <typename F>
+void report(const char *name, F &&f) {
+    auto bencher = pico_bench::Benchmarker<std::chrono::microseconds>{10, std::chrono::seconds{5}};
+    size_t sink = 0;
+    auto stats = bencher([&] {
+        for (size_t i = 0; i < kKeys; i++) {
+            sink += f(i);
+        }
+    });
+    auto median_us = static_cast<double>(stats.median().count());
+    std::cout << name << " median " << median_us * 1e3 / kKeys << " ns/key"
+              << (sink == 0 ? " " : "") << '\n';
+}
+
+int main() {
+    const std::string table = "user_profile";
+    const std::string_view field = "last_login";
+
+    // a typical cache key: table:id:field:shard:version
+    report("recursive fmt", [&](size_t i) {
+        return recursive_cat(table, ':', i, ':', field, ':', i % 64, ":v", 3).size();
+    });
+    report("str_cat", [&](size_t i) {
+        return collie::str_cat(table, ':', i, ':', field, ':', i % 64, ":v", 3).size();
+    });
+
+    std::string buffer;
+    report("str_cat_append std::string", [&](size_t i) {
+        buffer.clear();
+        return collie::str_cat_append(buffer, table, ':', i, ':', field, ':', i % 64, ":v", 3).size();
+    });
+
+    collie::InlinedString<64> inlined;
+    report("str_cat_append InlinedString<64>", [&](size_t i) {
+        inlined.clear();
+        return collie::str_cat_append(inlined, table, ':', i, ':', field, ':', i % 64, ":v", 3).size();
+    });
+
+    report("recursive fmt, doubles", [&](size_t i) {
+        return recursive_cat("lat=", i * 0.001, ",lon=", i * -0.002).size();
+    });
+    report("str_cat, doubles", [&](size_t i) {
+        return collie::str_cat("lat=", i * 0.001, ",lon=", i * -0.002).size();
+    });
+
+    return 0;
+}
@@ -0,0 +1,129 @@
+//
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+#include <collie/strings/internal/str_simd_internal.h>
+#include <collie/testing/pico_bench.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <iostream>
+#include <random>
+#include <string>
+
+using namespace collie::strings_internal;
+
+// a log line of about 200 bytes, and 4 MB of them
+static std::string make_input(size_t n) {
+    static const char kLine[] =
+            "2024-05-17 12:03:44.512 INFO  [worker-7] request_handler.cc:218 "
+            "served GET /api/v1/users/83412/profile?fields=name,email,last_login "
+            "status=200 bytes=4182 latency_us=734 peer=10.12.4.77:50312 trace=9f3e1c\n";
+    std::string s;
+    while (s.size() < n) {
+        s += kLine;
+    }
+    s.resize(n);
+    return s;
+}
+
+template<typename F>
+void report(const char *name, const std::string &input, F &&f) {
+    auto bencher = pico_bench::Benchmarker<std::chrono::nanoseconds>{20, std::chrono::seconds{5}};
+    // repeat short inputs so that each run takes a measurable time
+    size_t reps = std::max<size_t>(1, (1 << 22) / input.size());
+    size_t sink = 0;
+    auto stats = bencher([&] {
+        for (size_t i = 0; i < reps; i++) {
+            sink += f(input);
+        }
+    });
+    auto median_ns = static_cast<double>(stats.median().count());
+    std::cout << name << " (" << input.size() << " B) "
+              << input.size() * reps / median_ns << " GB/s"
+              << (sink == 0 ? " " : "") << '\n';
+}
+
+int main() {
+    for (size_t n: {size_t{200}, size_t{4} << 20}) {
+        auto input = make_input(n);
+        std::string out(n, '\0');
+
+        // count fields, the inner loop of splitting by one character
+        report("split ' ' scalar     ", input, [](const std::string &s) {
+            size_t k = 0;
+            for (size_t i = 0; i < s.size(); i = i + scalar_find_byte(s.data() + i, s.size() - i, ' ') + 1) {
+                ++k;
+            }
+            return k;
+        });
+        report("split ' ' memchr     ", input, [](const std::string &s) {
+            size_t k = 0;
+            for (auto p = s.data(), e = p + s.size(); p < e; ++k) {
+                auto q = static_cast<const char *>(std::memchr(p, ' ', static_cast<size_t>(e - p)));
+                p = q ? q + 1 : e;
+            }
+            return k;
+        });
+        report("split ' ' simd       ", input, [](const std::string &s) {
+            size_t k = 0;
+            for (size_t i = 0; i < s.size(); i = i + simd_find_byte(s.data() + i, s.size() - i, ' ') + 1) {
+                ++k;
+            }
+            return k;
+        });
+
+        report("split \" =,\" std     ", input, [](const std::string &s) {
+            size_t k = 0;
+            for (size_t i = 0; i < s.size(); ++k) {
+                auto r = std::string_view(s).find_first_of(" =,", i);
+                i = r == std::string_view::npos ? s.size() : r + 1;
+            }
+            return k;
+        });
+        report("split \" =,\" simd    ", input, [](const std::string &s) {
+            size_t k = 0;
+            for (size_t i = 0; i < s.size(); ++k) {
+                i = i + simd_find_any(s.data() + i, s.size() - i, " =,") + 1;
+            }
+            return k;
+        });
+
+        report("find absent std     ", input, [](const std::string &s) {
+            return s.find("status=503");
+        });
+        report("find absent simd    ", input, [](const std::string &s) {
+            return simd_find_substr(s.data(), s.size(), "status=503");
+        });
+
+        report("to_upper ctype      ", input, [&](const std::string &s) {
+            std::transform(s.begin(), s.end(), out.begin(), [](unsigned char c) {
+                return static_cast<char>(std::toupper(c));
+            });
+            return static_cast<size_t>(out[0]);
+        });
+        report("to_upper scalar     ", input, [&](const std::string &s) {
+            scalar_case_convert(s.data(), out.data(), s.size(), true);
+            return static_cast<size_t>(out[0]);
+        });
+        report("to_upper simd       ", input, [&](const std::string &s) {
+            simd_case_convert(s.data(), out.data(), s.size(), true);
+            return static_cast<size_t>(out[0]);
+        });
+        std::cout << '\n';
+    }
+    return 0;
+}
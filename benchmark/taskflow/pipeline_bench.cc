@@ -0,0 +1,113 @@
+//
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+
+// scheduling overhead of pipelines of tiny stages:
+// 8 pipes that only touch a per-token counter, run with different batch sizes.
+
+#include <collie/taskflow/taskflow.h>
+#include <collie/taskflow/algorithm/pipeline.h>
+#include <collie/taskflow/algorithm/data_pipeline.h>
+#include <collie/testing/pico_bench.hpp>
+
+#include <iostream>
+#include <thread>
+#include <vector>
+
+static constexpr size_t kNumLines = 8;
+static constexpr size_t kNumTokens = 1 << 16;
+
+template <typename Pipeline>
+void report(const char *name, size_t batch, collie::tf::Executor &executor, Pipeline &pl) {
+    collie::tf::Taskflow taskflow;
+    taskflow.composed_of(pl);
+    auto bencher = pico_bench::Benchmarker<std::chrono::microseconds>{10, std::chrono::seconds{5}};
+    auto stats = bencher([&] {
+        pl.reset();
+        executor.run(taskflow).wait();
+    });
+    auto median_us = static_cast<double>(stats.median().count());
+    std::cout << name << " batch=" << batch << " median " << median_us << "us, "
+              << (median_us > 0 ? kNumTokens / median_us : 0.0) << " Mtoken/s\n";
+}
+
+void bench_pipeline(collie::tf::Executor &executor, size_t batch) {
+
+    std::vector<std::vector<size_t>> buffer(kNumLines, std::vector<size_t>(batch));
+
+    auto stage = [&buffer]() {
+        return [&buffer](collie::tf::Pipeflow &pf) {
+            buffer[pf.line()][pf.batch_index()] += pf.pipe();
+        };
+    };
+
+    collie::tf::Pipeline pl(kNumLines,
+        collie::tf::Pipe{collie::tf::PipeType::SERIAL, [&](collie::tf::Pipeflow &pf) {
+            if (pf.token() == kNumTokens) {
+                pf.stop();
+                return;
+            }
+            buffer[pf.line()][pf.batch_index()] = pf.token();
+        }},
+        collie::tf::Pipe{collie::tf::PipeType::PARALLEL, stage()},
+        collie::tf::Pipe{collie::tf::PipeType::PARALLEL, stage()},
+        collie::tf::Pipe{collie::tf::PipeType::PARALLEL, stage()},
+        collie::tf::Pipe{collie::tf::PipeType::PARALLEL, stage()},
+        collie::tf::Pipe{collie::tf::PipeType::PARALLEL, stage()},
+        collie::tf::Pipe{collie::tf::PipeType::PARALLEL, stage()},
+        collie::tf::Pipe{collie::tf::PipeType::SERIAL, stage()}
+    );
+    pl.batch_size(batch);
+
+    report("Pipeline", batch, executor, pl);
+}
+
+void bench_data_pipeline(collie::tf::Executor &executor, size_t batch) {
+
+    auto stage = []() {
+        return [](size_t &input) { return input + 1; };
+    };
+
+    collie::tf::DataPipeline pl(kNumLines,
+        collie::tf::make_data_pipe<void, size_t>(collie::tf::PipeType::SERIAL, [](collie::tf::Pipeflow &pf) -> size_t {
+            if (pf.token() == kNumTokens) {
+                pf.stop();
+            }
+            return pf.token();
+        }),
+        collie::tf::make_data_pipe<size_t, size_t>(collie::tf::PipeType::PARALLEL, stage()),
+        collie::tf::make_data_pipe<size_t, size_t>(collie::tf::PipeType::PARALLEL, stage()),
+        collie::tf::make_data_pipe<size_t, size_t>(collie::tf::PipeType::PARALLEL, stage()),
+        collie::tf::make_data_pipe<size_t, size_t>(collie::tf::PipeType::PARALLEL, stage()),
+        collie::tf::make_data_pipe<size_t, size_t>(collie::tf::PipeType::PARALLEL, stage()),
+        collie::tf::make_data_pipe<size_t, size_t>(collie::tf::PipeType::PARALLEL, stage()),
+        collie::tf::make_data_pipe<size_t, void>(collie::tf::PipeType::SERIAL, [](size_t &) {})
+    );
+    pl.batch_size(batch);
+
+    report("DataPipeline", batch, executor, pl);
+}
+
+int main() {
+    collie::tf::Executor executor(std::min<size_t>(kNumLines, std::thread::hardware_concurrency()));
+    for (size_t batch : {1, 4, 16, 64}) {
+        bench_pipeline(executor, batch);
+        bench_data_pipeline(executor, batch);
+    }
+    return 0;
+}
@@ -0,0 +1,68 @@
+//
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+#include <collie/toml/toml.h>
+#include <collie/testing/pico_bench.hpp>
+
+#include <malloc.h>
+#include <iostream>
+#include <string>
+
+// a catalog of services with 12 values each, spread over three tables
+static std::string make_catalog(size_t services) {
+    std::string doc;
+    doc.reserve(services * 400);
+    for (size_t i = 0; i < services; ++i) {
+        const auto id = std::to_string(i);
+        doc += "[[service]]\n";
+        doc += "name = \"svc-" + id + "\"\n";
+        doc += "owner = \"team-" + std::to_string(i % 97) + "\"\n";
+        doc += "tier = " + std::to_string(i % 4) + "\n";
+        doc += "enabled = true\n";
+        doc += "replicas = " + std::to_string(1 + i % 16) + "\n";
+        doc += "tags = [\"prod\", \"region-" + std::to_string(i % 8) + "\"]\n";
+        doc += "[service.endpoint]\n";
+        doc += "host = \"svc-" + id + ".internal\"\n";
+        doc += "port = " + std::to_string(8000 + i % 1000) + "\n";
+        doc += "timeout_ms = 250\n";
+        doc += "[service.limits]\n";
+        doc += "cpu = 0.5\n";
+        doc += "memory_mib = 512\n";
+        doc += "max_connections_per_instance = 1024\n";
+    }
+    return doc;
+}
+
+// built twice, as toml_parse_bench and with TOML_COMPACT_DOM as toml_parse_compact_bench
+int main() {
+    const auto doc = make_catalog(50000);
+
+    const auto before = mallinfo2().uordblks;
+    {
+        auto tbl = toml::parse(doc);
+        const auto after = mallinfo2().uordblks;
+        std::cout << "compact dom " << TOML_COMPACT_DOM << ", document " << doc.size() / 1024 << " KiB, "
+                  << tbl["service"].as_array()->size() << " services, heap "
+                  << (after - before) / 1024 << " KiB\n";
+    }
+
+    auto bencher = pico_bench::Benchmarker<std::chrono::microseconds>{10, std::chrono::seconds{20}};
+    size_t sink = 0;
+    auto stats = bencher([&] { sink += toml::parse(doc).size(); });
+    std::cout << "parse median " << static_cast<double>(stats.median().count()) / 1e3 << " ms"
+              << (sink == 0 ? " " : "") << '\n';
+}
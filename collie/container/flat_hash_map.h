@@ -0,0 +1,85 @@
+//
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+#pragma once
+
+#include <memory>
+#include <utility>
+
+#include <collie/container/internal/flat_hash.h>
+
+namespace collie {
+
+    /**
+     * An open-addressing hash map storing its elements in one flat array
+     * of slots, probed 16 control bytes at a time with collie::simd.
+     *
+     * It is a drop-in replacement for std::unordered_map in lookup-heavy
+     * code: no allocation per element and no pointer chasing. The differences
+     * are those of the iterators and references below, and that
+     * max_load_factor (7/8) cannot be changed. Elements must be movable
+     * without throwing.
+     *
+     * With the default hash and equality, a map keyed by std::string can be
+     * looked up, erased and indexed with a std::string_view or a C string
+     * without building a std::string. The same holds for any Hash and Eq
+     * that both declare `is_transparent`.
+     *
+     * Iterators invalidation:
+     *  - clear, operator=, rehash, reserve: always invalidate the iterators.
+     *  - insert, emplace, try_emplace, operator[]: invalidate the iterators
+     *    and references if the table grows.
+     *  - erase: only invalidates the iterators to the erased element.
+     *
+     * Use node_hash_map when references to the elements must stay valid.
+     */
+    template<class K, class V,
+            class Hash = detail_flat_hash::hash_default_hash<K>,
+            class Eq = detail_flat_hash::hash_default_eq<K>,
+            class Alloc = std::allocator<std::pair<const K, V>>>
+    class flat_hash_map
+            : public detail_flat_hash::raw_hash_map<detail_flat_hash::flat_map_policy<K, V>, Hash, Eq, Alloc> {
+        using base = detail_flat_hash::raw_hash_map<detail_flat_hash::flat_map_policy<K, V>, Hash, Eq, Alloc>;
+
+    public:
+        flat_hash_map() = default;
+
+        using base::base;
+        using base::operator=;
+    };
+
+    /**
+     * A hash map with the same table as flat_hash_map, whose slots point to
+     * elements allocated one by one. Pointers and references to the elements
+     * stay valid until the elements are erased, as with std::unordered_map.
+     */
+    template<class K, class V,
+            class Hash = detail_flat_hash::hash_default_hash<K>,
+            class Eq = detail_flat_hash::hash_default_eq<K>,
+            class Alloc = std::allocator<std::pair<const K, V>>>
+    class node_hash_map
+            : public detail_flat_hash::raw_hash_map<detail_flat_hash::node_map_policy<K, V>, Hash, Eq, Alloc> {
+        using base = detail_flat_hash::raw_hash_map<detail_flat_hash::node_map_policy<K, V>, Hash, Eq, Alloc>;
+
+    public:
+        node_hash_map() = default;
+
+        using base::base;
+        using base::operator=;
+    };
+
+}  // namespace collie
@@ -0,0 +1,74 @@
+//
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+#pragma once
+
+#include <memory>
+
+#include <collie/container/internal/flat_hash.h>
+
+namespace collie {
+
+    /**
+     * An open-addressing hash set storing its elements in one flat array
+     * of slots, probed 16 control bytes at a time with collie::simd.
+     *
+     * See flat_hash_map for heterogeneous lookup and the differences with
+     * the standard unordered containers. Elements must be movable without
+     * throwing.
+     *
+     * Iterators invalidation:
+     *  - clear, operator=, rehash, reserve: always invalidate the iterators.
+     *  - insert, emplace: invalidate the iterators and references if the
+     *    table grows.
+     *  - erase: only invalidates the iterators to the erased element.
+     */
+    template<class K,
+            class Hash = detail_flat_hash::hash_default_hash<K>,
+            class Eq = detail_flat_hash::hash_default_eq<K>,
+            class Alloc = std::allocator<K>>
+    class flat_hash_set
+            : public detail_flat_hash::raw_hash_set<detail_flat_hash::flat_set_policy<K>, Hash, Eq, Alloc> {
+        using base = detail_flat_hash::raw_hash_set<detail_flat_hash::flat_set_policy<K>, Hash, Eq, Alloc>;
+
+    public:
+        flat_hash_set() = default;
+
+        using base::base;
+        using base::operator=;
+    };
+
+    /**
+     * A hash set with the same table as flat_hash_set, whose slots point to
+     * elements allocated one by one, so that the elements never move.
+     */
+    template<class K,
+            class Hash = detail_flat_hash::hash_default_hash<K>,
+            class Eq = detail_flat_hash::hash_default_eq<K>,
+            class Alloc = std::allocator<K>>
+    class node_hash_set
+            : public detail_flat_hash::raw_hash_set<detail_flat_hash::node_set_policy<K>, Hash, Eq, Alloc> {
+        using base = detail_flat_hash::raw_hash_set<detail_flat_hash::node_set_policy<K>, Hash, Eq, Alloc>;
+
+    public:
+        node_hash_set() = default;
+
+        using base::base;
+        using base::operator=;
+    };
+
+}  // namespace collie
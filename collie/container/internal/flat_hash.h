@@ -0,0 +1,1304 @@
+//
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include <collie/simd/simd.h>
+
+/**
+ * Implementation of an open-addressing hash table in the style of the
+ * "Swiss table" (Abseil): every slot has a control byte that is either
+ * empty, deleted, or holds 7 bits of the hash of the element in the slot.
+ * A lookup loads the control bytes of a group of slots at once and compares
+ * them in parallel with the 7 hash bits of the key, so that most slots are
+ * rejected without touching the elements.
+ *
+ * The table is one allocation: the control bytes, followed by the slots.
+ * The capacity is always 2^k - 1 and the control bytes are
+ *
+ *   [ slot 0 .. slot capacity-1 | sentinel | clones of the first group - 1 ]
+ *
+ * the clones allow loading a whole group at any slot without wrapping.
+ */
+namespace collie {
+
+    namespace detail_flat_hash {
+
+        using ctrl_t = int8_t;
+
+        inline constexpr ctrl_t kEmpty = -128;
+        inline constexpr ctrl_t kDeleted = -2;
+        inline constexpr ctrl_t kSentinel = -1;
+
+        inline bool is_full(ctrl_t c) { return c >= 0; }
+
+        inline bool is_empty(ctrl_t c) { return c == kEmpty; }
+
+        inline bool is_deleted(ctrl_t c) { return c == kDeleted; }
+
+        inline bool is_empty_or_deleted(ctrl_t c) { return c < kSentinel; }
+
+        inline int trailing_zeros64(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+            return __builtin_ctzll(x);
+#else
+            int n = 0;
+            for (; (x & 1) == 0; x >>= 1) {
+                ++n;
+            }
+            return n;
+#endif
+        }
+
+        inline int leading_zeros64(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+            return __builtin_clzll(x);
+#else
+            int n = 0;
+            for (uint64_t bit = uint64_t{1} << 63; (x & bit) == 0; bit >>= 1) {
+                ++n;
+            }
+            return n;
+#endif
+        }
+
+        /**
+         * The set bits of a group comparison, one per slot every 2^Shift bits.
+         * Iterating it yields the indices of the matching slots in the group.
+         */
+        template<int Width, int Shift>
+        class bit_mask {
+        public:
+            explicit bit_mask(uint64_t mask) : m_mask(mask) {}
+
+            bit_mask &operator++() {
+                m_mask &= m_mask - 1;
+                return *this;
+            }
+
+            explicit operator bool() const { return m_mask != 0; }
+
+            size_t operator*() const { return lowest_bit_set(); }
+
+            bit_mask begin() const { return *this; }
+
+            bit_mask end() const { return bit_mask(0); }
+
+            size_t lowest_bit_set() const { return trailing_zeros(); }
+
+            size_t trailing_zeros() const {
+                return static_cast<size_t>(trailing_zeros64(m_mask)) >> Shift;
+            }
+
+            size_t leading_zeros() const {
+                constexpr int total_bits = Width << Shift;
+                return static_cast<size_t>(leading_zeros64(m_mask) - (64 - total_bits)) >> Shift;
+            }
+
+            friend bool operator!=(const bit_mask &a, const bit_mask &b) { return a.m_mask != b.m_mask; }
+
+        private:
+            uint64_t m_mask;
+        };
+
+        /**
+         * 16 control bytes compared with one collie::simd batch each.
+         */
+        template<class Batch>
+        class group_simd {
+        public:
+            static constexpr size_t kWidth = 16;
+            using mask_type = bit_mask<16, 0>;
+
+            explicit group_simd(const ctrl_t *pos) : m_ctrl(Batch::load_unaligned(pos)) {}
+
+            mask_type match(ctrl_t h) const { return mask_type((m_ctrl == Batch(h)).mask()); }
+
+            mask_type mask_empty() const { return mask_type((m_ctrl == Batch(kEmpty)).mask()); }
+
+            mask_type mask_empty_or_deleted() const { return mask_type((m_ctrl < Batch(kSentinel)).mask()); }
+
+        private:
+            Batch m_ctrl;
+        };
+
+        /**
+         * 8 control bytes compared in a 64-bit word, for targets without a
+         * 16 byte vector. match() can report false positives, which the key
+         * comparison rejects.
+         */
+        class group_portable {
+        public:
+            static constexpr size_t kWidth = 8;
+            using mask_type = bit_mask<8, 3>;
+
+            explicit group_portable(const ctrl_t *pos) {
+                std::memcpy(&m_ctrl, pos, sizeof(m_ctrl));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+                m_ctrl = __builtin_bswap64(m_ctrl);
+#endif
+            }
+
+            mask_type match(ctrl_t h) const {
+                auto x = m_ctrl ^ (kLsbs * static_cast<uint8_t>(h));
+                return mask_type((x - kLsbs) & ~x & kMsbs);
+            }
+
+            mask_type mask_empty() const { return mask_type(m_ctrl & (~m_ctrl << 6) & kMsbs); }
+
+            mask_type mask_empty_or_deleted() const { return mask_type(m_ctrl & (~m_ctrl << 7) & kMsbs); }
+
+        private:
+            static constexpr uint64_t kLsbs = 0x0101010101010101ULL;
+            static constexpr uint64_t kMsbs = 0x8080808080808080ULL;
+
+            uint64_t m_ctrl;
+        };
+
+#ifndef COLLIE_SIMD_NO_SUPPORTED_ARCHITECTURE
+        using group_batch = collie::simd::make_sized_batch_t<int8_t, 16>;
+        using group = std::conditional_t<std::is_void_v<group_batch>, group_portable, group_simd<group_batch>>;
+#else
+        using group = group_portable;
+#endif
+
+        inline constexpr size_t kNumClonedBytes = group::kWidth - 1;
+
+        // the control bytes of a table without slots: lookups stop at the
+        // first group, iteration at the sentinel
+        inline ctrl_t *empty_group() {
+            alignas(16) static constexpr ctrl_t kEmptyGroup[16] = {
+                    kSentinel, kEmpty, kEmpty, kEmpty, kEmpty, kEmpty, kEmpty, kEmpty,
+                    kEmpty, kEmpty, kEmpty, kEmpty, kEmpty, kEmpty, kEmpty, kEmpty};
+            return const_cast<ctrl_t *>(kEmptyGroup);
+        }
+
+        // spreads the entropy of hashes such as the identity std::hash of
+        // integers over all bits: h1 selects the first group, h2 goes into
+        // the control byte
+        inline size_t mix_hash(size_t h) {
+#if defined(__SIZEOF_INT128__)
+            if constexpr (sizeof(size_t) == 8) {
+                __uint128_t m = static_cast<__uint128_t>(h) * 0x9E3779B97F4A7C15ULL;
+                return static_cast<size_t>(static_cast<uint64_t>(m) ^ static_cast<uint64_t>(m >> 64));
+            }
+#endif
+            uint64_t x = h;
+            x ^= x >> 33;
+            x *= 0xff51afd7ed558ccdULL;
+            x ^= x >> 33;
+            return static_cast<size_t>(x);
+        }
+
+        inline size_t h1(size_t hash) { return hash >> 7; }
+
+        inline ctrl_t h2(size_t hash) { return static_cast<ctrl_t>(hash & 0x7F); }
+
+        // groups are probed triangularly, which visits every group once when
+        // the number of groups is a power of two
+        class probe_seq {
+        public:
+            probe_seq(size_t hash, size_t mask) : m_mask(mask), m_offset(hash & mask) {}
+
+            size_t offset() const { return m_offset; }
+
+            size_t offset(size_t i) const { return (m_offset + i) & m_mask; }
+
+            void next() {
+                m_index += group::kWidth;
+                m_offset += m_index;
+                m_offset &= m_mask;
+            }
+
+        private:
+            size_t m_mask;
+            size_t m_offset;
+            size_t m_index{0};
+        };
+
+        // the smallest 2^k - 1 not smaller than n
+        inline size_t normalize_capacity(size_t n) {
+            return n ? ~size_t{} >> leading_zeros64(n) : 1;
+        }
+
+        // the table is grown when it is 7/8 full
+        inline size_t capacity_to_growth(size_t capacity) {
+            if (group::kWidth == 8 && capacity == 7) {
+                // a full group of 8 would leave no empty slot to stop probing
+                return 6;
+            }
+            return capacity - capacity / 8;
+        }
+
+        inline size_t growth_to_lower_bound_capacity(size_t growth) {
+            if (group::kWidth == 8 && growth == 7) {
+                return 8;
+            }
+            return growth + static_cast<size_t>((static_cast<int64_t>(growth) - 1) / 7);
+        }
+
+        /*
+         * Default hash and equality: strings hash and compare as
+         * std::string_view so that a map keyed by std::string can be looked
+         * up with a std::string_view or a C string without a temporary.
+         */
+        struct string_hash {
+            using is_transparent = void;
+
+            size_t operator()(std::string_view v) const { return std::hash<std::string_view>()(v); }
+        };
+
+        struct string_eq {
+            using is_transparent = void;
+
+            bool operator()(std::string_view a, std::string_view b) const { return a == b; }
+        };
+
+        template<class T>
+        struct hash_eq {
+            using hash = std::hash<T>;
+            using eq = std::equal_to<T>;
+        };
+
+        template<>
+        struct hash_eq<std::string> {
+            using hash = string_hash;
+            using eq = string_eq;
+        };
+
+        template<>
+        struct hash_eq<std::string_view> {
+            using hash = string_hash;
+            using eq = string_eq;
+        };
+
+        template<class T>
+        using hash_default_hash = typename hash_eq<T>::hash;
+
+        template<class T>
+        using hash_default_eq = typename hash_eq<T>::eq;
+
+        template<class T, class = void>
+        struct is_transparent : std::false_type {};
+
+        template<class T>
+        struct is_transparent<T, std::void_t<typename T::is_transparent>> : std::true_type {};
+
+        // with a transparent hash and equality, lookups take any K; otherwise
+        // they take key_type. As an alias of K the argument stays deducible.
+        template<bool Transparent>
+        struct key_arg_helper {
+            template<class K, class Key>
+            using type = Key;
+        };
+
+        template<>
+        struct key_arg_helper<true> {
+            template<class K, class Key>
+            using type = K;
+        };
+
+        /*
+         * Policies describe what a slot holds and how it is built, moved and
+         * destroyed. Flat policies store the element in the slot, node
+         * policies store a pointer to an element allocated on its own, which
+         * keeps the element at the same address when the table is rehashed.
+         */
+
+        template<class Alloc, class T>
+        using rebind_traits = typename std::allocator_traits<Alloc>::template rebind_traits<T>;
+
+        template<class K>
+        struct flat_set_policy {
+            using slot_type = K;
+            using key_type = K;
+            using value_type = K;
+            static constexpr bool constant_iterators = true;
+
+            template<class Alloc, class... Args>
+            static void construct(Alloc &alloc, slot_type *slot, Args &&... args) {
+                typename rebind_traits<Alloc, K>::allocator_type a(alloc);
+                rebind_traits<Alloc, K>::construct(a, slot, std::forward<Args>(args)...);
+            }
+
+            template<class Alloc>
+            static void destroy(Alloc &alloc, slot_type *slot) {
+                typename rebind_traits<Alloc, K>::allocator_type a(alloc);
+                rebind_traits<Alloc, K>::destroy(a, slot);
+            }
+
+            template<class Alloc>
+            static void transfer(Alloc &alloc, slot_type *dst, slot_type *src) {
+                construct(alloc, dst, std::move(*src));
+                destroy(alloc, src);
+            }
+
+            static value_type &element(slot_type *slot) { return *slot; }
+
+            static const key_type &key(const slot_type *slot) { return *slot; }
+        };
+
+        // The slot holds a pair<const K, V>, but is moved as a pair<K, V> when
+        // the table is rehashed so that the key is moved and not copied; both
+        // have the same layout.
+        template<class K, class V>
+        union map_slot {
+            map_slot() {}
+
+            ~map_slot() = delete;
+
+            std::pair<const K, V> value;
+            std::pair<K, V> mutable_value;
+        };
+
+        template<class K, class V>
+        struct flat_map_policy {
+            using slot_type = map_slot<K, V>;
+            using key_type = K;
+            using mapped_type = V;
+            using value_type = std::pair<const K, V>;
+            static constexpr bool constant_iterators = false;
+
+            template<class Alloc, class... Args>
+            static void construct(Alloc &alloc, slot_type *slot, Args &&... args) {
+                typename rebind_traits<Alloc, value_type>::allocator_type a(alloc);
+                rebind_traits<Alloc, value_type>::construct(a, &slot->value, std::forward<Args>(args)...);
+            }
+
+            template<class Alloc>
+            static void destroy(Alloc &alloc, slot_type *slot) {
+                typename rebind_traits<Alloc, value_type>::allocator_type a(alloc);
+                rebind_traits<Alloc, value_type>::destroy(a, std::launder(&slot->value));
+            }
+
+            template<class Alloc>
+            static void transfer(Alloc &alloc, slot_type *dst, slot_type *src) {
+                using mutable_type = std::pair<K, V>;
+                typename rebind_traits<Alloc, mutable_type>::allocator_type a(alloc);
+                auto *from = std::launder(&src->mutable_value);
+                rebind_traits<Alloc, mutable_type>::construct(a, &dst->mutable_value, std::move(*from));
+                rebind_traits<Alloc, mutable_type>::destroy(a, from);
+            }
+
+            static value_type &element(slot_type *slot) { return *std::launder(&slot->value); }
+
+            static const key_type &key(const slot_type *slot) { return std::launder(&slot->value)->first; }
+        };
+
+        template<class Value>
+        struct node_policy_base {
+            using slot_type = Value *;
+            using value_type = Value;
+
+            template<class Alloc, class... Args>
+            static void construct(Alloc &alloc, slot_type *slot, Args &&... args) {
+                using traits = rebind_traits<Alloc, Value>;
+                typename traits::allocator_type a(alloc);
+                auto *node = std::addressof(*traits::allocate(a, 1));
+                try {
+                    traits::construct(a, node, std::forward<Args>(args)...);
+                } catch (...) {
+                    traits::deallocate(a, node, 1);
+                    throw;
+                }
+                *slot = node;
+            }
+
+            template<class Alloc>
+            static void destroy(Alloc &alloc, slot_type *slot) {
+                using traits = rebind_traits<Alloc, Value>;
+                typename traits::allocator_type a(alloc);
+                traits::destroy(a, *slot);
+                traits::deallocate(a, *slot, 1);
+            }
+
+            template<class Alloc>
+            static void transfer(Alloc &, slot_type *dst, slot_type *src) {
+                *dst = *src;
+            }
+
+            static value_type &element(slot_type *slot) { return **slot; }
+        };
+
+        template<class K>
+        struct node_set_policy : node_policy_base<K> {
+            using key_type = K;
+            static constexpr bool constant_iterators = true;
+
+            static const key_type &key(const K *const *slot) { return **slot; }
+        };
+
+        template<class K, class V>
+        struct node_map_policy : node_policy_base<std::pair<const K, V>> {
+            using key_type = K;
+            using mapped_type = V;
+            static constexpr bool constant_iterators = false;
+
+            static const key_type &key(const std::pair<const K, V> *const *slot) { return (*slot)->first; }
+        };
+
+        template<size_t Align>
+        struct alignas(Align) aligned_unit {
+            unsigned char data[Align];
+        };
+
+        /**
+         * The hash table shared by flat_hash_set, flat_hash_map,
+         * node_hash_set and node_hash_map.
+         */
+        template<class Policy, class Hash, class Eq, class Alloc>
+        class raw_hash_set {
+        protected:
+            using slot_type = typename Policy::slot_type;
+
+        public:
+            using key_type = typename Policy::key_type;
+            using value_type = typename Policy::value_type;
+            using size_type = std::size_t;
+            using difference_type = std::ptrdiff_t;
+            using hasher = Hash;
+            using key_equal = Eq;
+            using allocator_type = Alloc;
+            using reference = value_type &;
+            using const_reference = const value_type &;
+            using pointer = typename std::allocator_traits<Alloc>::template rebind_traits<value_type>::pointer;
+            using const_pointer = typename std::allocator_traits<Alloc>::template rebind_traits<value_type>::const_pointer;
+
+        protected:
+            template<class K>
+            using key_arg = typename key_arg_helper<is_transparent<Hash>::value &&
+                                                    is_transparent<Eq>::value>::template type<K, key_type>;
+
+        public:
+            class iterator {
+                friend class raw_hash_set;
+
+            public:
+                using iterator_category = std::forward_iterator_tag;
+                using value_type = typename raw_hash_set::value_type;
+                using reference = std::conditional_t<Policy::constant_iterators, const value_type &, value_type &>;
+                using pointer = std::remove_reference_t<reference> *;
+                using difference_type = std::ptrdiff_t;
+
+                iterator() = default;
+
+                reference operator*() const { return Policy::element(m_slot); }
+
+                pointer operator->() const { return &operator*(); }
+
+                iterator &operator++() {
+                    ++m_ctrl;
+                    ++m_slot;
+                    skip_empty_or_deleted();
+                    return *this;
+                }
+
+                iterator operator++(int) {
+                    auto tmp = *this;
+                    ++*this;
+                    return tmp;
+                }
+
+                friend bool operator==(const iterator &a, const iterator &b) { return a.m_ctrl == b.m_ctrl; }
+
+                friend bool operator!=(const iterator &a, const iterator &b) { return a.m_ctrl != b.m_ctrl; }
+
+            private:
+                iterator(ctrl_t *ctrl, slot_type *slot) : m_ctrl(ctrl), m_slot(slot) {}
+
+                // stops at the next full slot or at the sentinel
+                void skip_empty_or_deleted() {
+                    while (is_empty_or_deleted(*m_ctrl)) {
+                        ++m_ctrl;
+                        ++m_slot;
+                    }
+                }
+
+                ctrl_t *m_ctrl{nullptr};
+                slot_type *m_slot{nullptr};
+            };
+
+            class const_iterator {
+                friend class raw_hash_set;
+
+            public:
+                using iterator_category = std::forward_iterator_tag;
+                using value_type = typename raw_hash_set::value_type;
+                using reference = const value_type &;
+                using pointer = const value_type *;
+                using difference_type = std::ptrdiff_t;
+
+                const_iterator() = default;
+
+                const_iterator(iterator it) : m_it(it) {}
+
+                reference operator*() const { return *m_it; }
+
+                pointer operator->() const { return &operator*(); }
+
+                const_iterator &operator++() {
+                    ++m_it;
+                    return *this;
+                }
+
+                const_iterator operator++(int) {
+                    auto tmp = *this;
+                    ++m_it;
+                    return tmp;
+                }
+
+                friend bool operator==(const const_iterator &a, const const_iterator &b) { return a.m_it == b.m_it; }
+
+                friend bool operator!=(const const_iterator &a, const const_iterator &b) { return a.m_it != b.m_it; }
+
+            private:
+                iterator m_it;
+            };
+
+        public:
+            raw_hash_set() noexcept = default;
+
+            explicit raw_hash_set(size_type bucket_count, const hasher &hash = hasher(),
+                                  const key_equal &eq = key_equal(),
+                                  const allocator_type &alloc = allocator_type())
+                    : m_hash(hash), m_eq(eq), m_alloc(alloc) {
+                if (bucket_count) {
+                    initialize_slots(normalize_capacity(bucket_count));
+                }
+            }
+
+            raw_hash_set(size_type bucket_count, const hasher &hash, const allocator_type &alloc)
+                    : raw_hash_set(bucket_count, hash, key_equal(), alloc) {}
+
+            raw_hash_set(size_type bucket_count, const allocator_type &alloc)
+                    : raw_hash_set(bucket_count, hasher(), key_equal(), alloc) {}
+
+            explicit raw_hash_set(const allocator_type &alloc)
+                    : raw_hash_set(0, hasher(), key_equal(), alloc) {}
+
+            template<class InputIt>
+            raw_hash_set(InputIt first, InputIt last, size_type bucket_count = 0,
+                         const hasher &hash = hasher(), const key_equal &eq = key_equal(),
+                         const allocator_type &alloc = allocator_type())
+                    : raw_hash_set(bucket_count, hash, eq, alloc) {
+                insert(first, last);
+            }
+
+            template<class InputIt>
+            raw_hash_set(InputIt first, InputIt last, size_type bucket_count, const allocator_type &alloc)
+                    : raw_hash_set(first, last, bucket_count, hasher(), key_equal(), alloc) {}
+
+            raw_hash_set(std::initializer_list<value_type> init, size_type bucket_count = 0,
+                         const hasher &hash = hasher(), const key_equal &eq = key_equal(),
+                         const allocator_type &alloc = allocator_type())
+                    : raw_hash_set(init.begin(), init.end(), bucket_count, hash, eq, alloc) {}
+
+            raw_hash_set(std::initializer_list<value_type> init, size_type bucket_count,
+                         const allocator_type &alloc)
+                    : raw_hash_set(init, bucket_count, hasher(), key_equal(), alloc) {}
+
+            raw_hash_set(const raw_hash_set &other)
+                    : raw_hash_set(other, std::allocator_traits<allocator_type>::
+                    select_on_container_copy_construction(other.m_alloc)) {}
+
+            raw_hash_set(const raw_hash_set &other, const allocator_type &alloc)
+                    : raw_hash_set(0, other.m_hash, other.m_eq, alloc) {
+                reserve(other.size());
+                // the elements are known to be distinct, no need to look them up
+                for (const auto &v: other) {
+                    auto hash = hash_of(v);
+                    auto i = prepare_insert(hash);
+                    construct_or_undo(i, v);
+                }
+            }
+
+            raw_hash_set(raw_hash_set &&other) noexcept
+                    : m_ctrl(std::exchange(other.m_ctrl, empty_group())),
+                      m_slots(std::exchange(other.m_slots, nullptr)),
+                      m_size(std::exchange(other.m_size, 0)),
+                      m_capacity(std::exchange(other.m_capacity, 0)),
+                      m_growth_left(std::exchange(other.m_growth_left, 0)),
+                      m_hash(std::move(other.m_hash)),
+                      m_eq(std::move(other.m_eq)),
+                      m_alloc(std::move(other.m_alloc)) {}
+
+            raw_hash_set(raw_hash_set &&other, const allocator_type &alloc)
+                    : raw_hash_set(0, other.m_hash, other.m_eq, alloc) {
+                if (alloc == other.m_alloc) {
+                    swap_storage(other);
+                } else {
+                    reserve(other.size());
+                    for (auto &v: other) {
+                        emplace(std::move(v));
+                    }
+                }
+            }
+
+            raw_hash_set &operator=(const raw_hash_set &other) {
+                if (this != &other) {
+                    raw_hash_set tmp(other);
+                    swap(tmp);
+                }
+                return *this;
+            }
+
+            /**
+             * Takes over the storage of `other` when the allocator propagates
+             * or compares equal. Otherwise the memory of `other` cannot be
+             * freed by this set's allocator, so the elements are moved one by
+             * one.
+             */
+            raw_hash_set &operator=(raw_hash_set &&other) noexcept(
+                    std::allocator_traits<allocator_type>::propagate_on_container_move_assignment::value ||
+                    std::allocator_traits<allocator_type>::is_always_equal::value) {
+                if (this == &other) {
+                    return *this;
+                }
+                m_hash = other.m_hash;
+                m_eq = other.m_eq;
+                if constexpr (std::allocator_traits<allocator_type>::propagate_on_container_move_assignment::value) {
+                    take_storage(other);
+                    m_alloc = std::move(other.m_alloc);
+                } else if (m_alloc == other.m_alloc) {
+                    take_storage(other);
+                } else {
+                    clear();
+                    reserve(other.size());
+                    for (auto &v: other) {
+                        auto i = prepare_insert(hash_of(v));
+                        construct_or_undo(i, std::move(v));
+                    }
+                }
+                return *this;
+            }
+
+            raw_hash_set &operator=(std::initializer_list<value_type> ilist) {
+                clear();
+                insert(ilist);
+                return *this;
+            }
+
+            ~raw_hash_set() { destroy_slots(); }
+
+            /*
+             * Iterators
+             */
+            iterator begin() noexcept {
+                iterator it(m_ctrl, m_slots);
+                it.skip_empty_or_deleted();
+                return it;
+            }
+
+            iterator end() noexcept { return iterator(m_ctrl + m_capacity, m_slots + m_capacity); }
+
+            const_iterator begin() const noexcept { return const_cast<raw_hash_set *>(this)->begin(); }
+
+            const_iterator end() const noexcept { return const_cast<raw_hash_set *>(this)->end(); }
+
+            const_iterator cbegin() const noexcept { return begin(); }
+
+            const_iterator cend() const noexcept { return end(); }
+
+            /*
+             * Capacity
+             */
+            bool empty() const noexcept { return m_size == 0; }
+
+            size_type size() const noexcept { return m_size; }
+
+            size_type capacity() const noexcept { return m_capacity; }
+
+            size_type max_size() const noexcept { return (std::numeric_limits<size_type>::max)() / sizeof(slot_type); }
+
+            /*
+             * Modifiers
+             */
+
+            /**
+             * Destroys the elements but keeps the memory, so that refilling
+             * the table does not rehash.
+             */
+            void clear() noexcept {
+                if (m_capacity == 0) {
+                    return;
+                }
+                for (size_type i = 0; i < m_capacity; ++i) {
+                    if (is_full(m_ctrl[i])) {
+                        Policy::destroy(m_alloc, m_slots + i);
+                    }
+                }
+                m_size = 0;
+                reset_ctrl();
+                m_growth_left = capacity_to_growth(m_capacity);
+            }
+
+            std::pair<iterator, bool> insert(const value_type &value) {
+                return emplace_with_key(key_of(value), value);
+            }
+
+            std::pair<iterator, bool> insert(value_type &&value) {
+                return emplace_with_key(key_of(value), std::move(value));
+            }
+
+            iterator insert(const_iterator, const value_type &value) { return insert(value).first; }
+
+            iterator insert(const_iterator, value_type &&value) { return insert(std::move(value)).first; }
+
+            template<class InputIt>
+            void insert(InputIt first, InputIt last) {
+                if constexpr (std::is_base_of_v<std::forward_iterator_tag,
+                        typename std::iterator_traits<InputIt>::iterator_category>) {
+                    reserve(size() + static_cast<size_type>(std::distance(first, last)));
+                }
+                for (; first != last; ++first) {
+                    emplace(*first);
+                }
+            }
+
+            void insert(std::initializer_list<value_type> ilist) { insert(ilist.begin(), ilist.end()); }
+
+            /**
+             * The element is built before the lookup, since its key is only
+             * known then. It is destroyed if the key is already present.
+             */
+            template<class... Args>
+            std::pair<iterator, bool> emplace(Args &&... args) {
+                alignas(slot_type) unsigned char raw[sizeof(slot_type)];
+                auto *tmp = reinterpret_cast<slot_type *>(raw);
+                Policy::construct(m_alloc, tmp, std::forward<Args>(args)...);
+                std::pair<size_type, bool> res;
+                try {
+                    res = find_or_prepare_insert(Policy::key(tmp));
+                } catch (...) {
+                    // the table could not grow
+                    Policy::destroy(m_alloc, tmp);
+                    throw;
+                }
+                if (res.second) {
+                    Policy::transfer(m_alloc, m_slots + res.first, tmp);
+                } else {
+                    Policy::destroy(m_alloc, tmp);
+                }
+                return {iterator_at(res.first), res.second};
+            }
+
+            template<class... Args>
+            iterator emplace_hint(const_iterator, Args &&... args) {
+                return emplace(std::forward<Args>(args)...).first;
+            }
+
+            iterator erase(const_iterator pos) { return erase(pos.m_it); }
+
+            iterator erase(iterator pos) {
+                erase_at(pos);
+                ++pos;
+                return pos;
+            }
+
+            iterator erase(const_iterator first, const_iterator last) {
+                auto it = first.m_it;
+                while (it != last.m_it) {
+                    it = erase(it);
+                }
+                return it;
+            }
+
+            template<class K = key_type>
+            size_type erase(const key_arg<K> &key) {
+                auto it = find(key);
+                if (it == end()) {
+                    return 0;
+                }
+                erase_at(it);
+                return 1;
+            }
+
+            void swap(raw_hash_set &other) noexcept {
+                using std::swap;
+                swap_storage(other);
+                swap(m_hash, other.m_hash);
+                swap(m_eq, other.m_eq);
+                if constexpr (std::allocator_traits<allocator_type>::propagate_on_container_swap::value) {
+                    swap(m_alloc, other.m_alloc);
+                }
+            }
+
+            /*
+             * Lookup
+             */
+            template<class K = key_type>
+            iterator find(const key_arg<K> &key) {
+                auto hash = hash_of(key);
+                probe_seq seq(h1(hash), m_capacity);
+                while (true) {
+                    group g(m_ctrl + seq.offset());
+                    for (auto i: g.match(h2(hash))) {
+                        auto index = seq.offset(i);
+                        if (m_eq(Policy::key(m_slots + index), key)) {
+                            return iterator_at(index);
+                        }
+                    }
+                    if (g.mask_empty()) {
+                        return end();
+                    }
+                    seq.next();
+                }
+            }
+
+            template<class K = key_type>
+            const_iterator find(const key_arg<K> &key) const {
+                return const_cast<raw_hash_set *>(this)->find(key);
+            }
+
+            template<class K = key_type>
+            bool contains(const key_arg<K> &key) const { return find(key) != end(); }
+
+            template<class K = key_type>
+            size_type count(const key_arg<K> &key) const { return contains(key) ? 1 : 0; }
+
+            template<class K = key_type>
+            std::pair<iterator, iterator> equal_range(const key_arg<K> &key) {
+                auto it = find(key);
+                if (it == end()) {
+                    return {it, it};
+                }
+                return {it, std::next(it)};
+            }
+
+            template<class K = key_type>
+            std::pair<const_iterator, const_iterator> equal_range(const key_arg<K> &key) const {
+                return const_cast<raw_hash_set *>(this)->equal_range(key);
+            }
+
+            /*
+             * Bucket interface and hash policy
+             */
+            size_type bucket_count() const { return m_capacity; }
+
+            float load_factor() const {
+                return m_capacity ? static_cast<float>(m_size) / static_cast<float>(m_capacity) : 0.0f;
+            }
+
+            /**
+             * The table grows when it is 7/8 full; the maximum load factor
+             * cannot be changed.
+             */
+            float max_load_factor() const { return 0.875f; }
+
+            void max_load_factor(float) {}
+
+            /**
+             * Rehashes to hold at least `count` slots and all the elements.
+             * rehash(0) shrinks the table to fit its elements.
+             */
+            void rehash(size_type count) {
+                if (count == 0 && m_capacity == 0) {
+                    return;
+                }
+                if (count == 0 && m_size == 0) {
+                    destroy_slots();
+                    m_ctrl = empty_group();
+                    m_slots = nullptr;
+                    m_capacity = 0;
+                    m_growth_left = 0;
+                    return;
+                }
+                auto m = normalize_capacity((std::max)(count, growth_to_lower_bound_capacity(m_size)));
+                if (count == 0 || m > m_capacity) {
+                    resize(m);
+                }
+            }
+
+            /**
+             * Makes room for `count` elements without rehashing.
+             */
+            void reserve(size_type count) {
+                if (count > m_size + m_growth_left) {
+                    resize(normalize_capacity(growth_to_lower_bound_capacity(count)));
+                }
+            }
+
+            /*
+             * Observers
+             */
+            hasher hash_function() const { return m_hash; }
+
+            key_equal key_eq() const { return m_eq; }
+
+            allocator_type get_allocator() const { return m_alloc; }
+
+            friend bool operator==(const raw_hash_set &a, const raw_hash_set &b) {
+                if (a.size() != b.size()) {
+                    return false;
+                }
+                const raw_hash_set *outer = &a, *inner = &b;
+                if (outer->capacity() > inner->capacity()) {
+                    std::swap(outer, inner);
+                }
+                for (const value_type &elem: *outer) {
+                    auto it = inner->find(key_of(elem));
+                    if (it == inner->end() || !(*it == elem)) {
+                        return false;
+                    }
+                }
+                return true;
+            }
+
+            friend bool operator!=(const raw_hash_set &a, const raw_hash_set &b) { return !(a == b); }
+
+            friend void swap(raw_hash_set &a, raw_hash_set &b) noexcept { a.swap(b); }
+
+        protected:
+            static const key_type &key_of(const value_type &v) {
+                if constexpr (std::is_same_v<key_type, value_type>) {
+                    return v;
+                } else {
+                    return v.first;
+                }
+            }
+
+            /**
+             * Inserts the element built from `args` unless `key` is present.
+             * `key` is not used once the element is built, so it may refer to
+             * an argument the element is moved from.
+             */
+            template<class K, class... Args>
+            std::pair<iterator, bool> emplace_with_key(const K &key, Args &&... args) {
+                auto res = find_or_prepare_insert(key);
+                if (res.second) {
+                    construct_or_undo(res.first, std::forward<Args>(args)...);
+                }
+                return {iterator_at(res.first), res.second};
+            }
+
+        private:
+            using unit_type = aligned_unit<alignof(slot_type)>;
+            using unit_traits = typename std::allocator_traits<Alloc>::template rebind_traits<unit_type>;
+
+            template<class K>
+            size_t hash_of(const K &key) const { return mix_hash(m_hash(key)); }
+
+            size_t hash_of(const value_type &v) const { return mix_hash(m_hash(key_of(v))); }
+
+            iterator iterator_at(size_type i) { return iterator(m_ctrl + i, m_slots + i); }
+
+            // the index of the element with `key`, or of the slot reserved
+            // for it, with true in the latter case
+            template<class K>
+            std::pair<size_type, bool> find_or_prepare_insert(const K &key) {
+                auto hash = hash_of(key);
+                probe_seq seq(h1(hash), m_capacity);
+                while (true) {
+                    group g(m_ctrl + seq.offset());
+                    for (auto i: g.match(h2(hash))) {
+                        auto index = seq.offset(i);
+                        if (m_eq(Policy::key(m_slots + index), key)) {
+                            return {index, false};
+                        }
+                    }
+                    if (g.mask_empty()) {
+                        break;
+                    }
+                    seq.next();
+                }
+                return {prepare_insert(hash), true};
+            }
+
+            size_type find_first_non_full(size_t hash) const {
+                probe_seq seq(h1(hash), m_capacity);
+                while (true) {
+                    auto mask = group(m_ctrl + seq.offset()).mask_empty_or_deleted();
+                    if (mask) {
+                        return seq.offset(mask.lowest_bit_set());
+                    }
+                    seq.next();
+                }
+            }
+
+            // marks a slot for an element with `hash` as full, growing the
+            // table first if needed; the caller constructs the element
+            size_type prepare_insert(size_t hash) {
+                auto target = find_first_non_full(hash);
+                if (m_growth_left == 0 && !is_deleted(m_ctrl[target])) {
+                    rehash_and_grow_if_necessary();
+                    target = find_first_non_full(hash);
+                }
+                ++m_size;
+                m_growth_left -= is_empty(m_ctrl[target]);
+                set_ctrl(target, h2(hash));
+                return target;
+            }
+
+            template<class... Args>
+            void construct_or_undo(size_type i, Args &&... args) {
+                try {
+                    Policy::construct(m_alloc, m_slots + i, std::forward<Args>(args)...);
+                } catch (...) {
+                    erase_meta_only(i);
+                    throw;
+                }
+            }
+
+            void rehash_and_grow_if_necessary() {
+                if (m_capacity == 0) {
+                    resize(1);
+                } else if (m_capacity > group::kWidth && m_size * 32 <= m_capacity * 25) {
+                    // mostly tombstones: rebuild at the same size to purge them
+                    resize(m_capacity);
+                } else {
+                    resize(m_capacity * 2 + 1);
+                }
+            }
+
+            void erase_at(iterator it) {
+                Policy::destroy(m_alloc, it.m_slot);
+                erase_meta_only(static_cast<size_type>(it.m_ctrl - m_ctrl));
+            }
+
+            // a slot can go back to empty, rather than deleted, when no probe
+            // sequence could have passed over it: there has been an empty
+            // slot within a group width on both sides since it was filled
+            void erase_meta_only(size_type index) {
+                --m_size;
+                auto index_before = (index - group::kWidth) & m_capacity;
+                auto empty_after = group(m_ctrl + index).mask_empty();
+                auto empty_before = group(m_ctrl + index_before).mask_empty();
+                bool was_never_full = empty_before && empty_after &&
+                                      empty_after.trailing_zeros() + empty_before.leading_zeros() < group::kWidth;
+                set_ctrl(index, was_never_full ? kEmpty : kDeleted);
+                m_growth_left += was_never_full;
+            }
+
+            void set_ctrl(size_type i, ctrl_t h) {
+                m_ctrl[i] = h;
+                m_ctrl[((i - kNumClonedBytes) & m_capacity) + (kNumClonedBytes & m_capacity)] = h;
+            }
+
+            void reset_ctrl() {
+                std::memset(m_ctrl, kEmpty, m_capacity + group::kWidth);
+                m_ctrl[m_capacity] = kSentinel;
+            }
+
+            static size_type slot_offset(size_type capacity) {
+                return (capacity + group::kWidth + alignof(slot_type) - 1) & ~(alignof(slot_type) - 1);
+            }
+
+            static size_type alloc_units(size_type capacity) {
+                auto bytes = slot_offset(capacity) + capacity * sizeof(slot_type);
+                return (bytes + sizeof(unit_type) - 1) / sizeof(unit_type);
+            }
+
+            void initialize_slots(size_type capacity) {
+                typename unit_traits::allocator_type a(m_alloc);
+                auto *mem = reinterpret_cast<char *>(std::addressof(*unit_traits::allocate(a, alloc_units(capacity))));
+                m_ctrl = reinterpret_cast<ctrl_t *>(mem);
+                m_slots = reinterpret_cast<slot_type *>(mem + slot_offset(capacity));
+                m_capacity = capacity;
+                reset_ctrl();
+                m_growth_left = capacity_to_growth(capacity) - m_size;
+            }
+
+            static void deallocate(allocator_type &alloc, ctrl_t *ctrl, size_type capacity) {
+                typename unit_traits::allocator_type a(alloc);
+                unit_traits::deallocate(a, reinterpret_cast<unit_type *>(ctrl), alloc_units(capacity));
+            }
+
+            // moves every element into a table of `new_capacity` slots; the
+            // elements are moved, not copied, and must not throw doing so
+            void resize(size_type new_capacity) {
+                auto *old_ctrl = m_ctrl;
+                auto *old_slots = m_slots;
+                auto old_capacity = m_capacity;
+                initialize_slots(new_capacity);
+                for (size_type i = 0; i < old_capacity; ++i) {
+                    if (is_full(old_ctrl[i])) {
+                        auto hash = hash_of(Policy::key(old_slots + i));
+                        auto target = find_first_non_full(hash);
+                        set_ctrl(target, h2(hash));
+                        Policy::transfer(m_alloc, m_slots + target, old_slots + i);
+                    }
+                }
+                if (old_capacity) {
+                    deallocate(m_alloc, old_ctrl, old_capacity);
+                }
+            }
+
+            void destroy_slots() {
+                if (m_capacity == 0) {
+                    return;
+                }
+                for (size_type i = 0; i < m_capacity; ++i) {
+                    if (is_full(m_ctrl[i])) {
+                        Policy::destroy(m_alloc, m_slots + i);
+                    }
+                }
+                deallocate(m_alloc, m_ctrl, m_capacity);
+            }
+
+            // frees the elements and memory of this set, then steals those
+            // of `other`, which is left empty
+            void take_storage(raw_hash_set &other) noexcept {
+                destroy_slots();
+                m_ctrl = std::exchange(other.m_ctrl, empty_group());
+                m_slots = std::exchange(other.m_slots, nullptr);
+                m_size = std::exchange(other.m_size, 0);
+                m_capacity = std::exchange(other.m_capacity, 0);
+                m_growth_left = std::exchange(other.m_growth_left, 0);
+            }
+
+            void swap_storage(raw_hash_set &other) noexcept {
+                std::swap(m_ctrl, other.m_ctrl);
+                std::swap(m_slots, other.m_slots);
+                std::swap(m_size, other.m_size);
+                std::swap(m_capacity, other.m_capacity);
+                std::swap(m_growth_left, other.m_growth_left);
+            }
+
+            ctrl_t *m_ctrl{empty_group()};
+            slot_type *m_slots{nullptr};
+            size_type m_size{0};
+            size_type m_capacity{0};
+            size_type m_growth_left{0};
+            hasher m_hash;
+            key_equal m_eq;
+            allocator_type m_alloc;
+        };
+
+        /**
+         * raw_hash_set with the element access of a map.
+         */
+        template<class Policy, class Hash, class Eq, class Alloc>
+        class raw_hash_map : public raw_hash_set<Policy, Hash, Eq, Alloc> {
+            using base = raw_hash_set<Policy, Hash, Eq, Alloc>;
+
+            template<class K>
+            using key_arg = typename base::template key_arg<K>;
+
+        public:
+            using key_type = typename Policy::key_type;
+            using mapped_type = typename Policy::mapped_type;
+            using iterator = typename base::iterator;
+            using const_iterator = typename base::const_iterator;
+            using value_type = typename base::value_type;
+
+            using base::base;
+            using base::insert;
+
+            raw_hash_map() = default;
+
+            template<class P, std::enable_if_t<std::is_constructible_v<value_type, P &&> &&
+                                               !std::is_same_v<std::decay_t<P>, value_type>, int> = 0>
+            std::pair<iterator, bool> insert(P &&value) {
+                return this->emplace(std::forward<P>(value));
+            }
+
+            template<class P, std::enable_if_t<std::is_constructible_v<value_type, P &&> &&
+                                               !std::is_same_v<std::decay_t<P>, value_type>, int> = 0>
+            iterator insert(const_iterator, P &&value) {
+                return this->emplace(std::forward<P>(value)).first;
+            }
+
+            template<class K = key_type, class... Args>
+            std::pair<iterator, bool> try_emplace(key_arg<K> &&key, Args &&... args) {
+                return this->emplace_with_key(key, std::piecewise_construct,
+                                              std::forward_as_tuple(std::forward<K>(key)),
+                                              std::forward_as_tuple(std::forward<Args>(args)...));
+            }
+
+            template<class K = key_type, class... Args>
+            std::pair<iterator, bool> try_emplace(const key_arg<K> &key, Args &&... args) {
+                return this->emplace_with_key(key, std::piecewise_construct,
+                                              std::forward_as_tuple(key),
+                                              std::forward_as_tuple(std::forward<Args>(args)...));
+            }
+
+            template<class K = key_type, class... Args>
+            iterator try_emplace(const_iterator, key_arg<K> &&key, Args &&... args) {
+                return try_emplace(std::forward<K>(key), std::forward<Args>(args)...).first;
+            }
+
+            template<class K = key_type, class... Args>
+            iterator try_emplace(const_iterator, const key_arg<K> &key, Args &&... args) {
+                return try_emplace(key, std::forward<Args>(args)...).first;
+            }
+
+            template<class K = key_type, class M>
+            std::pair<iterator, bool> insert_or_assign(key_arg<K> &&key, M &&obj) {
+                auto res = try_emplace(std::forward<K>(key), std::forward<M>(obj));
+                if (!res.second) {
+                    res.first->second = std::forward<M>(obj);
+                }
+                return res;
+            }
+
+            template<class K = key_type, class M>
+            std::pair<iterator, bool> insert_or_assign(const key_arg<K> &key, M &&obj) {
+                auto res = try_emplace(key, std::forward<M>(obj));
+                if (!res.second) {
+                    res.first->second = std::forward<M>(obj);
+                }
+                return res;
+            }
+
+            template<class K = key_type>
+            mapped_type &at(const key_arg<K> &key) {
+                auto it = this->find(key);
+                if (it == this->end()) {
+                    throw std::out_of_range("Couldn't find key.");
+                }
+                return it->second;
+            }
+
+            template<class K = key_type>
+            const mapped_type &at(const key_arg<K> &key) const {
+                auto it = this->find(key);
+                if (it == this->end()) {
+                    throw std::out_of_range("Couldn't find key.");
+                }
+                return it->second;
+            }
+
+            template<class K = key_type>
+            mapped_type &operator[](key_arg<K> &&key) {
+                return try_emplace(std::forward<K>(key)).first->second;
+            }
+
+            template<class K = key_type>
+            mapped_type &operator[](const key_arg<K> &key) {
+                return try_emplace(key).first->second;
+            }
+        };
+
+    }  // namespace detail_flat_hash
+}  // namespace collie
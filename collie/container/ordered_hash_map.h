@@ -0,0 +1,902 @@
+//
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include <collie/container/internal/flat_hash.h>
+
+namespace collie {
+
+    /**
+     * A hash map that iterates in insertion order, like fifo_map and
+     * nlohmann::ordered_map, with O(1) lookups.
+     *
+     * The elements live in one contiguous array in the order they were
+     * inserted. A separate open-addressing index maps hashes to positions in
+     * that array: each bucket is 8 bytes (a 32-bit position and 32 bits of
+     * hash), probed linearly and kept at most 3/4 full. Erasing an element
+     * leaves a tombstone in the array; tombstones are dropped when the array
+     * is reallocated, or compacted in place once they outnumber the
+     * elements, so iterating never costs more than twice the size.
+     *
+     * The interface is the one of fifo_map: comparisons are lexicographic
+     * in insertion order, and lower_bound/upper_bound follow the insertion
+     * order. An erased key that is inserted again goes to the back.
+     * Iterators are bidirectional; `it + n` is provided for code written
+     * against a vector of pairs, and steps over the n elements.
+     *
+     * With the default hash and equality, a map keyed by std::string can be
+     * looked up and erased with a std::string_view or a C string.
+     *
+     * Iterators invalidation:
+     *  - clear, operator=, reserve, shrink_to_fit: always invalidate the
+     *    iterators.
+     *  - insert, emplace, try_emplace, operator[]: invalidate the iterators
+     *    and references if the array grows.
+     *  - erase: invalidates the iterators to the erased elements, and all
+     *    the iterators when it compacts the array; the returned iterator
+     *    is always valid.
+     */
+    template<class K, class V,
+            class Hash = detail_flat_hash::hash_default_hash<K>,
+            class Eq = detail_flat_hash::hash_default_eq<K>,
+            class Alloc = std::allocator<std::pair<const K, V>>>
+    class ordered_hash_map {
+    public:
+        using key_type = K;
+        using mapped_type = V;
+        using value_type = std::pair<const K, V>;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using hasher = Hash;
+        using key_equal = Eq;
+        using allocator_type = Alloc;
+        using reference = value_type &;
+        using const_reference = const value_type &;
+        using pointer = typename std::allocator_traits<Alloc>::pointer;
+        using const_pointer = typename std::allocator_traits<Alloc>::const_pointer;
+
+    private:
+        template<class Key>
+        using key_arg = typename detail_flat_hash::key_arg_helper<
+                detail_flat_hash::is_transparent<Hash>::value &&
+                detail_flat_hash::is_transparent<Eq>::value>::template type<Key, key_type>;
+
+        using mutable_value_type = std::pair<K, V>;
+
+        // The element is built as a pair<const K, V>, and moved as a
+        // pair<K, V> when the array is compacted so that the key is moved
+        // and not copied; both have the same layout.
+        struct entry {
+            entry() {}
+
+            ~entry() {}
+
+            uint32_t hash;
+            bool alive;
+            union {
+                value_type value;
+                mutable_value_type mutable_value;
+            };
+        };
+
+        struct bucket {
+            uint32_t entry;
+            uint32_t hash;
+        };
+
+        static constexpr uint32_t kEmptyBucket = ~uint32_t{0};
+        static constexpr size_type kNotFound = ~size_type{0};
+        static constexpr size_type kMinCapacity = 4;
+        // erase compacts the array when it holds more tombstones than this
+        // and than elements
+        static constexpr size_type kMinTombstones = 16;
+
+        using entry_traits = detail_flat_hash::rebind_traits<Alloc, entry>;
+        using bucket_traits = detail_flat_hash::rebind_traits<Alloc, bucket>;
+
+    public:
+        template<bool Const>
+        class basic_iterator {
+            friend class ordered_hash_map;
+            friend class basic_iterator<!Const>;
+
+        public:
+            using iterator_category = std::bidirectional_iterator_tag;
+            using value_type = typename ordered_hash_map::value_type;
+            using reference = std::conditional_t<Const, const value_type &, value_type &>;
+            using pointer = std::remove_reference_t<reference> *;
+            using difference_type = std::ptrdiff_t;
+
+            basic_iterator() = default;
+
+            template<bool C = Const, std::enable_if_t<C, int> = 0>
+            basic_iterator(const basic_iterator<false> &it) : m_entry(it.m_entry) {}
+
+            reference operator*() const { return *std::launder(&m_entry->value); }
+
+            pointer operator->() const { return &operator*(); }
+
+            // tombstones are skipped; the entry past the last element is
+            // always marked alive and stops the scan
+            basic_iterator &operator++() {
+                do {
+                    ++m_entry;
+                } while (!m_entry->alive);
+                return *this;
+            }
+
+            basic_iterator operator++(int) {
+                auto tmp = *this;
+                ++*this;
+                return tmp;
+            }
+
+            basic_iterator &operator--() {
+                do {
+                    --m_entry;
+                } while (!m_entry->alive);
+                return *this;
+            }
+
+            basic_iterator operator--(int) {
+                auto tmp = *this;
+                --*this;
+                return tmp;
+            }
+
+            basic_iterator &operator+=(difference_type n) {
+                for (; n > 0; --n) {
+                    ++*this;
+                }
+                for (; n < 0; ++n) {
+                    --*this;
+                }
+                return *this;
+            }
+
+            basic_iterator &operator-=(difference_type n) { return *this += -n; }
+
+            friend basic_iterator operator+(basic_iterator it, difference_type n) { return it += n; }
+
+            friend basic_iterator operator-(basic_iterator it, difference_type n) { return it -= n; }
+
+            friend bool operator==(const basic_iterator &a, const basic_iterator &b) { return a.m_entry == b.m_entry; }
+
+            friend bool operator!=(const basic_iterator &a, const basic_iterator &b) { return a.m_entry != b.m_entry; }
+
+        private:
+            explicit basic_iterator(entry *e) : m_entry(e) {}
+
+            entry *m_entry{nullptr};
+        };
+
+        using iterator = basic_iterator<false>;
+        using const_iterator = basic_iterator<true>;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    public:
+        ordered_hash_map() noexcept(std::is_nothrow_default_constructible_v<Alloc>) = default;
+
+        explicit ordered_hash_map(const allocator_type &alloc) : m_alloc(alloc) {}
+
+        template<class InputIt>
+        ordered_hash_map(InputIt first, InputIt last, const allocator_type &alloc = allocator_type())
+                : ordered_hash_map(alloc) {
+            insert(first, last);
+        }
+
+        ordered_hash_map(std::initializer_list<value_type> init, const allocator_type &alloc = allocator_type())
+                : ordered_hash_map(init.begin(), init.end(), alloc) {}
+
+        ordered_hash_map(const ordered_hash_map &other)
+                : ordered_hash_map(other, std::allocator_traits<allocator_type>::
+                select_on_container_copy_construction(other.m_alloc)) {}
+
+        ordered_hash_map(const ordered_hash_map &other, const allocator_type &alloc)
+                : m_hash(other.m_hash), m_eq(other.m_eq), m_alloc(alloc) {
+            reserve(other.size());
+            // the keys are known to be distinct, no need to look them up
+            for (auto it = other.begin(); it != other.end(); ++it) {
+                append(it.m_entry->hash, *it);
+            }
+        }
+
+        ordered_hash_map(ordered_hash_map &&other) noexcept
+                : m_entries(std::exchange(other.m_entries, nullptr)),
+                  m_buckets(std::exchange(other.m_buckets, nullptr)),
+                  m_capacity(std::exchange(other.m_capacity, 0)),
+                  m_bucket_mask(std::exchange(other.m_bucket_mask, 0)),
+                  m_used(std::exchange(other.m_used, 0)),
+                  m_size(std::exchange(other.m_size, 0)),
+                  m_dead(std::exchange(other.m_dead, 0)),
+                  m_first(std::exchange(other.m_first, 0)),
+                  m_hash(std::move(other.m_hash)),
+                  m_eq(std::move(other.m_eq)),
+                  m_alloc(std::move(other.m_alloc)) {}
+
+        ordered_hash_map &operator=(const ordered_hash_map &other) {
+            if (this != &other) {
+                ordered_hash_map tmp(other);
+                swap(tmp);
+            }
+            return *this;
+        }
+
+        ordered_hash_map &operator=(ordered_hash_map &&other) noexcept {
+            ordered_hash_map tmp(std::move(other));
+            swap(tmp);
+            return *this;
+        }
+
+        ordered_hash_map &operator=(std::initializer_list<value_type> ilist) {
+            clear();
+            insert(ilist);
+            return *this;
+        }
+
+        ~ordered_hash_map() { release(); }
+
+        /*
+         * Element access
+         */
+
+        template<class Key = key_type>
+        mapped_type &at(const key_arg<Key> &key) {
+            auto it = find(key);
+            if (it == end()) {
+                throw std::out_of_range("Couldn't find key.");
+            }
+            return it->second;
+        }
+
+        template<class Key = key_type>
+        const mapped_type &at(const key_arg<Key> &key) const {
+            auto it = find(key);
+            if (it == end()) {
+                throw std::out_of_range("Couldn't find key.");
+            }
+            return it->second;
+        }
+
+        template<class Key = key_type>
+        mapped_type &operator[](key_arg<Key> &&key) {
+            return try_emplace(std::forward<Key>(key)).first->second;
+        }
+
+        template<class Key = key_type>
+        mapped_type &operator[](const key_arg<Key> &key) {
+            return try_emplace(key).first->second;
+        }
+
+        /*
+         * Iterators
+         */
+
+        iterator begin() noexcept { return m_entries ? iterator(m_entries + m_first) : iterator(); }
+
+        iterator end() noexcept { return m_entries ? iterator(m_entries + m_used) : iterator(); }
+
+        const_iterator begin() const noexcept { return const_cast<ordered_hash_map *>(this)->begin(); }
+
+        const_iterator end() const noexcept { return const_cast<ordered_hash_map *>(this)->end(); }
+
+        const_iterator cbegin() const noexcept { return begin(); }
+
+        const_iterator cend() const noexcept { return end(); }
+
+        reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+
+        reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+
+        const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+
+        const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+        const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+
+        const_reverse_iterator crend() const noexcept { return rend(); }
+
+        /*
+         * Capacity
+         */
+
+        bool empty() const noexcept { return m_size == 0; }
+
+        size_type size() const noexcept { return m_size; }
+
+        // positions are stored on 32 bits, one of them marks empty buckets
+        size_type max_size() const noexcept { return kEmptyBucket - 1; }
+
+        /// number of elements and tombstones the array holds before growing
+        size_type capacity() const noexcept { return m_capacity; }
+
+        /// makes room for n elements, dropping the tombstones
+        void reserve(size_type n) {
+            if (n > m_capacity) {
+                reallocate(n);
+            }
+        }
+
+        /// fits the array to the elements, dropping the tombstones
+        void shrink_to_fit() {
+            if (m_size == 0) {
+                release();
+            } else if (m_size != m_capacity) {
+                reallocate(m_size);
+            }
+        }
+
+        /*
+         * Modifiers
+         */
+
+        /**
+         * Destroys the elements but keeps the memory, so that refilling the
+         * map does not reallocate.
+         */
+        void clear() noexcept {
+            if (m_entries == nullptr) {
+                return;
+            }
+            for (size_type i = m_first; i < m_used; ++i) {
+                if (m_entries[i].alive) {
+                    destroy_value(m_entries + i);
+                }
+            }
+            m_used = m_size = m_dead = m_first = 0;
+            m_entries[0].alive = true;
+            std::fill(m_buckets, m_buckets + m_bucket_mask + 1, bucket{kEmptyBucket, 0});
+        }
+
+        std::pair<iterator, bool> insert(const value_type &value) {
+            return try_emplace_impl(value.first, value.second);
+        }
+
+        std::pair<iterator, bool> insert(value_type &&value) {
+            return try_emplace_impl(value.first, std::move(value.second));
+        }
+
+        template<class P, std::enable_if_t<std::is_constructible_v<value_type, P &&> &&
+                                           !std::is_same_v<std::decay_t<P>, value_type>, int> = 0>
+        std::pair<iterator, bool> insert(P &&value) {
+            return emplace(std::forward<P>(value));
+        }
+
+        iterator insert(const_iterator, const value_type &value) { return insert(value).first; }
+
+        iterator insert(const_iterator, value_type &&value) { return insert(std::move(value)).first; }
+
+        template<class P, std::enable_if_t<std::is_constructible_v<value_type, P &&> &&
+                                           !std::is_same_v<std::decay_t<P>, value_type>, int> = 0>
+        iterator insert(const_iterator, P &&value) {
+            return emplace(std::forward<P>(value)).first;
+        }
+
+        template<class InputIt>
+        void insert(InputIt first, InputIt last) {
+            if constexpr (std::is_base_of_v<std::forward_iterator_tag,
+                    typename std::iterator_traits<InputIt>::iterator_category>) {
+                reserve(size() + static_cast<size_type>(std::distance(first, last)));
+            }
+            for (; first != last; ++first) {
+                insert(*first);
+            }
+        }
+
+        void insert(std::initializer_list<value_type> ilist) { insert(ilist.begin(), ilist.end()); }
+
+        /**
+         * The element is built before its key is looked up; prefer
+         * try_emplace, which builds nothing when the key is present.
+         */
+        template<class... Args>
+        std::pair<iterator, bool> emplace(Args &&... args) {
+            mutable_value_type value(std::forward<Args>(args)...);
+            return try_emplace_impl(std::move(value.first), std::move(value.second));
+        }
+
+        template<class... Args>
+        iterator emplace_hint(const_iterator, Args &&... args) {
+            return emplace(std::forward<Args>(args)...).first;
+        }
+
+        template<class Key = key_type, class... Args>
+        std::pair<iterator, bool> try_emplace(key_arg<Key> &&key, Args &&... args) {
+            return try_emplace_impl(std::forward<Key>(key), std::forward<Args>(args)...);
+        }
+
+        template<class Key = key_type, class... Args>
+        std::pair<iterator, bool> try_emplace(const key_arg<Key> &key, Args &&... args) {
+            return try_emplace_impl(key, std::forward<Args>(args)...);
+        }
+
+        template<class Key = key_type, class M>
+        std::pair<iterator, bool> insert_or_assign(key_arg<Key> &&key, M &&obj) {
+            auto res = try_emplace(std::forward<Key>(key), std::forward<M>(obj));
+            if (!res.second) {
+                res.first->second = std::forward<M>(obj);
+            }
+            return res;
+        }
+
+        template<class Key = key_type, class M>
+        std::pair<iterator, bool> insert_or_assign(const key_arg<Key> &key, M &&obj) {
+            auto res = try_emplace(key, std::forward<M>(obj));
+            if (!res.second) {
+                res.first->second = std::forward<M>(obj);
+            }
+            return res;
+        }
+
+        /// removes the element at pos, returns the iterator to the next one
+        iterator erase(const_iterator pos) {
+            auto i = index_of(pos);
+            auto next = i + 1;
+            while (!m_entries[next].alive) {
+                ++next;
+            }
+            erase_at(i);
+            return iterator(m_entries + maybe_compact(next));
+        }
+
+        iterator erase(iterator pos) { return erase(const_iterator(pos)); }
+
+        iterator erase(const_iterator first, const_iterator last) {
+            if (first == last) {
+                return iterator(last.m_entry);
+            }
+            auto stop = index_of(last);
+            for (auto i = index_of(first); i < stop; ++i) {
+                if (m_entries[i].alive) {
+                    erase_at(i);
+                }
+            }
+            return iterator(m_entries + maybe_compact(stop));
+        }
+
+        template<class Key = key_type>
+        size_type erase(const key_arg<Key> &key) {
+            auto i = find_index(key, hash_of(key));
+            if (i == kNotFound) {
+                return 0;
+            }
+            erase_at(i);
+            maybe_compact(m_used);
+            return 1;
+        }
+
+        void swap(ordered_hash_map &other) noexcept {
+            using std::swap;
+            swap(m_entries, other.m_entries);
+            swap(m_buckets, other.m_buckets);
+            swap(m_capacity, other.m_capacity);
+            swap(m_bucket_mask, other.m_bucket_mask);
+            swap(m_used, other.m_used);
+            swap(m_size, other.m_size);
+            swap(m_dead, other.m_dead);
+            swap(m_first, other.m_first);
+            swap(m_hash, other.m_hash);
+            swap(m_eq, other.m_eq);
+            swap(m_alloc, other.m_alloc);
+        }
+
+        /*
+         * Lookup
+         */
+
+        template<class Key = key_type>
+        iterator find(const key_arg<Key> &key) {
+            if (m_size == 0) {
+                return end();
+            }
+            auto i = find_index(key, hash_of(key));
+            return i == kNotFound ? end() : iterator(m_entries + i);
+        }
+
+        template<class Key = key_type>
+        const_iterator find(const key_arg<Key> &key) const {
+            return const_cast<ordered_hash_map *>(this)->find(key);
+        }
+
+        template<class Key = key_type>
+        bool contains(const key_arg<Key> &key) const { return find(key) != end(); }
+
+        template<class Key = key_type>
+        size_type count(const key_arg<Key> &key) const { return contains(key) ? 1 : 0; }
+
+        template<class Key = key_type>
+        std::pair<iterator, iterator> equal_range(const key_arg<Key> &key) {
+            auto it = find(key);
+            return {it, it == end() ? it : std::next(it)};
+        }
+
+        template<class Key = key_type>
+        std::pair<const_iterator, const_iterator> equal_range(const key_arg<Key> &key) const {
+            auto it = find(key);
+            return {it, it == end() ? it : std::next(it)};
+        }
+
+        /// in insertion order: the element with this key, or end()
+        template<class Key = key_type>
+        iterator lower_bound(const key_arg<Key> &key) { return find(key); }
+
+        template<class Key = key_type>
+        const_iterator lower_bound(const key_arg<Key> &key) const { return find(key); }
+
+        /// in insertion order: the element after the one with this key, or end()
+        template<class Key = key_type>
+        iterator upper_bound(const key_arg<Key> &key) { return equal_range(key).second; }
+
+        template<class Key = key_type>
+        const_iterator upper_bound(const key_arg<Key> &key) const { return equal_range(key).second; }
+
+        /*
+         * Observers
+         */
+
+        hasher hash_function() const { return m_hash; }
+
+        key_equal key_eq() const { return m_eq; }
+
+        allocator_type get_allocator() const { return m_alloc; }
+
+        /*
+         * Non-member functions
+         */
+
+        friend bool operator==(const ordered_hash_map &lhs, const ordered_hash_map &rhs) {
+            return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+        }
+
+        friend bool operator!=(const ordered_hash_map &lhs, const ordered_hash_map &rhs) { return !(lhs == rhs); }
+
+        friend bool operator<(const ordered_hash_map &lhs, const ordered_hash_map &rhs) {
+            return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+        }
+
+        friend bool operator<=(const ordered_hash_map &lhs, const ordered_hash_map &rhs) { return !(rhs < lhs); }
+
+        friend bool operator>(const ordered_hash_map &lhs, const ordered_hash_map &rhs) { return rhs < lhs; }
+
+        friend bool operator>=(const ordered_hash_map &lhs, const ordered_hash_map &rhs) { return !(lhs < rhs); }
+
+        friend void swap(ordered_hash_map &lhs, ordered_hash_map &rhs) noexcept { lhs.swap(rhs); }
+
+    private:
+        template<class Key>
+        uint32_t hash_of(const Key &key) const {
+            return static_cast<uint32_t>(detail_flat_hash::mix_hash(m_hash(key)));
+        }
+
+        size_type index_of(const_iterator it) const { return static_cast<size_type>(it.m_entry - m_entries); }
+
+        template<class Key>
+        size_type find_index(const Key &key, uint32_t hash) const {
+            if (m_buckets == nullptr) {
+                return kNotFound;
+            }
+            for (size_type b = hash & m_bucket_mask;; b = (b + 1) & m_bucket_mask) {
+                const bucket &bk = m_buckets[b];
+                if (bk.entry == kEmptyBucket) {
+                    return kNotFound;
+                }
+                if (bk.hash == hash && m_eq(std::launder(&m_entries[bk.entry].value)->first, key)) {
+                    return bk.entry;
+                }
+            }
+        }
+
+        template<class Key, class... Args>
+        std::pair<iterator, bool> try_emplace_impl(Key &&key, Args &&... args) {
+            auto hash = hash_of(key);
+            auto i = find_index(key, hash);
+            if (i != kNotFound) {
+                return {iterator(m_entries + i), false};
+            }
+            return {append(hash, std::piecewise_construct,
+                           std::forward_as_tuple(std::forward<Key>(key)),
+                           std::forward_as_tuple(std::forward<Args>(args)...)), true};
+        }
+
+        /**
+         * Builds a new element after the last one. When the array is full,
+         * the element is built in the new array before the others are moved,
+         * so that args may refer to elements of this map.
+         */
+        template<class... Args>
+        iterator append(uint32_t hash, Args &&... args) {
+            if (m_used < m_capacity) {
+                entry *e = m_entries + m_used;
+                construct_value(e, std::forward<Args>(args)...);
+                e->hash = hash;
+                ::new(static_cast<void *>(e + 1)) entry;
+                e[1].alive = true;
+                ++m_used;
+                ++m_size;
+                insert_bucket(m_used - 1, hash);
+                return iterator(e);
+            }
+
+            auto capacity = (std::max)(kMinCapacity, m_size * 2);
+            auto *entries = allocate_entries(capacity);
+            bucket *buckets;
+            try {
+                buckets = allocate_buckets(capacity);
+            } catch (...) {
+                deallocate_entries(entries, capacity);
+                throw;
+            }
+            entry *e = entries + m_size;
+            ::new(static_cast<void *>(e)) entry;
+            try {
+                construct_value(e, std::forward<Args>(args)...);
+            } catch (...) {
+                deallocate_buckets(buckets, capacity);
+                deallocate_entries(entries, capacity);
+                throw;
+            }
+            e->hash = hash;
+            e->alive = true;
+            transfer_to(entries);
+            ::new(static_cast<void *>(e + 1)) entry;
+            e[1].alive = true;
+            install(entries, buckets, capacity);
+            m_used = ++m_size;
+            rebuild_index();
+            return iterator(e);
+        }
+
+        // moves the array to one of the given capacity, dropping the tombstones
+        void reallocate(size_type capacity) {
+            auto *entries = allocate_entries(capacity);
+            bucket *buckets;
+            try {
+                buckets = allocate_buckets(capacity);
+            } catch (...) {
+                deallocate_entries(entries, capacity);
+                throw;
+            }
+            transfer_to(entries);
+            ::new(static_cast<void *>(entries + m_size)) entry;
+            entries[m_size].alive = true;
+            install(entries, buckets, capacity);
+            m_used = m_size;
+            rebuild_index();
+        }
+
+        // moves the elements in order to the front of entries
+        void transfer_to(entry *entries) {
+            size_type dst = 0;
+            for (size_type src = m_first; src < m_used; ++src) {
+                if (m_entries[src].alive) {
+                    ::new(static_cast<void *>(entries + dst)) entry;
+                    transfer_value(entries + dst, m_entries + src);
+                    entries[dst].hash = m_entries[src].hash;
+                    ++dst;
+                }
+            }
+        }
+
+        // frees the old storage, the elements must have been moved out
+        void install(entry *entries, bucket *buckets, size_type capacity) {
+            if (m_entries != nullptr) {
+                deallocate_buckets(m_buckets, m_capacity);
+                deallocate_entries(m_entries, m_capacity);
+            }
+            m_entries = entries;
+            m_buckets = buckets;
+            m_capacity = capacity;
+            m_bucket_mask = bucket_count_for(capacity) - 1;
+            m_dead = 0;
+            m_first = 0;
+        }
+
+        void release() noexcept {
+            if (m_entries == nullptr) {
+                return;
+            }
+            clear();
+            deallocate_buckets(m_buckets, m_capacity);
+            deallocate_entries(m_entries, m_capacity);
+            m_entries = nullptr;
+            m_buckets = nullptr;
+            m_capacity = 0;
+            m_bucket_mask = 0;
+        }
+
+        /**
+         * Destroys the element at i and leaves a tombstone. Tombstones at the
+         * back are dropped at once, and begin() skips the ones at the front.
+         */
+        void erase_at(size_type i) {
+            entry *e = m_entries + i;
+            erase_bucket(i, e->hash);
+            destroy_value(e);
+            e->alive = false;
+            --m_size;
+            ++m_dead;
+            if (i + 1 == m_used) {
+                while (m_used > 0 && !m_entries[m_used - 1].alive) {
+                    --m_used;
+                    --m_dead;
+                }
+                m_entries[m_used].alive = true;
+            }
+            if (m_size == 0) {
+                m_first = 0;
+            } else if (i == m_first) {
+                while (!m_entries[m_first].alive) {
+                    ++m_first;
+                }
+            }
+        }
+
+        /**
+         * Compacts the array in place once the tombstones outnumber the
+         * elements. Returns where the entry at index track is afterwards.
+         */
+        size_type maybe_compact(size_type track) {
+            if (track > m_used) {
+                track = m_used;
+            }
+            if (m_dead < kMinTombstones || m_dead <= m_size) {
+                return track;
+            }
+            size_type dst = 0;
+            size_type moved = m_size;
+            for (size_type src = m_first; src < m_used; ++src) {
+                if (src == track) {
+                    moved = dst;
+                }
+                if (m_entries[src].alive) {
+                    if (dst != src) {
+                        transfer_value(m_entries + dst, m_entries + src);
+                        m_entries[dst].hash = m_entries[src].hash;
+                        m_entries[dst].alive = true;
+                    }
+                    ++dst;
+                }
+            }
+            m_used = m_size;
+            m_entries[m_used].alive = true;
+            m_dead = 0;
+            m_first = 0;
+            rebuild_index();
+            return moved;
+        }
+
+        static size_type bucket_count_for(size_type capacity) {
+            size_type n = 8;
+            while (n < capacity + capacity / 3 + 1) {
+                n <<= 1;
+            }
+            return n;
+        }
+
+        void rebuild_index() {
+            std::fill(m_buckets, m_buckets + m_bucket_mask + 1, bucket{kEmptyBucket, 0});
+            for (size_type i = m_first; i < m_used; ++i) {
+                if (m_entries[i].alive) {
+                    insert_bucket(i, m_entries[i].hash);
+                }
+            }
+        }
+
+        void insert_bucket(size_type i, uint32_t hash) {
+            size_type b = hash & m_bucket_mask;
+            while (m_buckets[b].entry != kEmptyBucket) {
+                b = (b + 1) & m_bucket_mask;
+            }
+            m_buckets[b] = bucket{static_cast<uint32_t>(i), hash};
+        }
+
+        // backward shift deletion: the buckets after the erased one are
+        // moved back when that brings them closer to their home bucket, so
+        // that no probe sequence is broken and no tombstone is needed
+        void erase_bucket(size_type i, uint32_t hash) {
+            size_type hole = hash & m_bucket_mask;
+            while (m_buckets[hole].entry != i) {
+                hole = (hole + 1) & m_bucket_mask;
+            }
+            for (size_type b = (hole + 1) & m_bucket_mask;
+                 m_buckets[b].entry != kEmptyBucket; b = (b + 1) & m_bucket_mask) {
+                size_type home = m_buckets[b].hash & m_bucket_mask;
+                if (((b - home) & m_bucket_mask) >= ((b - hole) & m_bucket_mask)) {
+                    m_buckets[hole] = m_buckets[b];
+                    hole = b;
+                }
+            }
+            m_buckets[hole].entry = kEmptyBucket;
+        }
+
+        template<class... Args>
+        void construct_value(entry *e, Args &&... args) {
+            using traits = detail_flat_hash::rebind_traits<Alloc, value_type>;
+            typename traits::allocator_type a(m_alloc);
+            traits::construct(a, &e->value, std::forward<Args>(args)...);
+            e->alive = true;
+        }
+
+        void destroy_value(entry *e) noexcept {
+            using traits = detail_flat_hash::rebind_traits<Alloc, value_type>;
+            typename traits::allocator_type a(m_alloc);
+            traits::destroy(a, std::launder(&e->value));
+        }
+
+        void transfer_value(entry *dst, entry *src) {
+            using traits = detail_flat_hash::rebind_traits<Alloc, mutable_value_type>;
+            typename traits::allocator_type a(m_alloc);
+            auto *from = std::launder(&src->mutable_value);
+            traits::construct(a, &dst->mutable_value, std::move(*from));
+            traits::destroy(a, from);
+            dst->alive = true;
+            src->alive = false;
+        }
+
+        // one more entry than the capacity holds the end marker
+        entry *allocate_entries(size_type capacity) {
+            typename entry_traits::allocator_type a(m_alloc);
+            return std::addressof(*entry_traits::allocate(a, capacity + 1));
+        }
+
+        void deallocate_entries(entry *entries, size_type capacity) noexcept {
+            typename entry_traits::allocator_type a(m_alloc);
+            entry_traits::deallocate(a, entries, capacity + 1);
+        }
+
+        bucket *allocate_buckets(size_type capacity) {
+            typename bucket_traits::allocator_type a(m_alloc);
+            auto n = bucket_count_for(capacity);
+            auto *buckets = std::addressof(*bucket_traits::allocate(a, n));
+            std::fill(buckets, buckets + n, bucket{kEmptyBucket, 0});
+            return buckets;
+        }
+
+        void deallocate_buckets(bucket *buckets, size_type capacity) noexcept {
+            typename bucket_traits::allocator_type a(m_alloc);
+            bucket_traits::deallocate(a, buckets, bucket_count_for(capacity));
+        }
+
+        entry *m_entries{nullptr};
+        bucket *m_buckets{nullptr};
+        size_type m_capacity{0};
+        size_type m_bucket_mask{0};
+        // entries in use, elements and tombstones
+        size_type m_used{0};
+        size_type m_size{0};
+        size_type m_dead{0};
+        // no element before this entry
+        size_type m_first{0};
+        hasher m_hash;
+        key_equal m_eq;
+        allocator_type m_alloc;
+    };
+
+}  // namespace collie
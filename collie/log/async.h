@@ -102,6 +102,12 @@ inline void init_thread_pool(size_t q_size,
     init_thread_pool(q_size, thread_count, on_thread_start, [] {});
 }
 
+// in per_thread mode each logging thread gets its own ring of q_size messages
+inline void init_thread_pool(size_t q_size, size_t thread_count, async_queue_mode queue_mode) {
+    auto tp = std::make_shared<details::thread_pool>(q_size, thread_count, queue_mode);
+    details::registry::instance().set_tp(std::move(tp));
+}
+
 inline void init_thread_pool(size_t q_size, size_t thread_count) {
     init_thread_pool(
         q_size, thread_count, [] {}, [] {});
@@ -69,6 +69,25 @@ CLOG_LOGGER_CATCH(source_loc())
 // backend functions - called from the thread pool to do the actual job
 //
 inline void collie::log::async_logger::backend_sink_it_(const details::log_msg &msg) {
+    if (msg.format_deferred != nullptr) {
+        memory_buf_t buf;
+        bool formatted = false;
+        CLOG_TRY {
+            msg.format_deferred(msg.payload, msg.deferred_args.data(), buf);
+            formatted = true;
+        }
+        CLOG_LOGGER_CATCH(msg.source)
+        if (!formatted) {
+            return;
+        }
+        details::log_msg formatted_msg(msg);
+        formatted_msg.payload = details::to_string_view(buf);
+        formatted_msg.format_deferred = nullptr;
+        formatted_msg.deferred_args = string_view_t{};
+        backend_sink_it_(formatted_msg);
+        return;
+    }
+
     for (auto &sink : sinks_) {
         if (sink->should_log(msg.level)) {
             CLOG_TRY { sink->log(msg); }
@@ -81,6 +100,58 @@ inline void collie::log::async_logger::backend_sink_it_(const details::log_msg &
     }
 }
 
+inline void collie::log::async_logger::backend_sink_batch_(std::vector<details::log_msg> &msgs) {
+    // the deferred messages are formatted one after the other into the same buffer,
+    // their payloads are pointed at it once it stopped growing.
+    memory_buf_t deferred_buf;
+    std::vector<size_t> deferred_ends;
+    size_t kept = 0;
+    for (auto &msg : msgs) {
+        if (msg.format_deferred != nullptr) {
+            auto start = deferred_buf.size();
+            bool formatted = false;
+            CLOG_TRY {
+                msg.format_deferred(msg.payload, msg.deferred_args.data(), deferred_buf);
+                formatted = true;
+            }
+            CLOG_LOGGER_CATCH(msg.source)
+            if (!formatted) {
+                deferred_buf.resize(start);
+                continue;
+            }
+            deferred_ends.push_back(deferred_buf.size());
+        }
+        msgs[kept++] = msg;
+    }
+    msgs.resize(kept);
+
+    bool should_flush = false;
+    size_t deferred_index = 0;
+    for (auto &msg : msgs) {
+        if (msg.format_deferred != nullptr) {
+            auto start = deferred_index == 0 ? 0 : deferred_ends[deferred_index - 1];
+            auto end = deferred_ends[deferred_index++];
+            msg.payload = string_view_t(deferred_buf.data() + start, end - start);
+            msg.format_deferred = nullptr;
+            msg.deferred_args = string_view_t{};
+        }
+        should_flush = should_flush || should_flush_(msg);
+    }
+
+    if (msgs.empty()) {
+        return;
+    }
+
+    for (auto &sink : sinks_) {
+        CLOG_TRY { sink->log_batch(collie::span<const details::log_msg>(msgs.data(), msgs.size())); }
+        CLOG_LOGGER_CATCH(msgs.front().source)
+    }
+
+    if (should_flush) {
+        backend_flush_();
+    }
+}
+
 inline void collie::log::async_logger::backend_flush_() {
     for (auto &sink : sinks_) {
         CLOG_TRY { sink->flush(); }
@@ -88,6 +159,18 @@ inline void collie::log::async_logger::backend_flush_() {
     }
 }
 
+inline void collie::log::async_logger::enable_deferred_format() {
+    deferred_format_.store(true, std::memory_order_relaxed);
+}
+
+inline void collie::log::async_logger::disable_deferred_format() {
+    deferred_format_.store(false, std::memory_order_relaxed);
+}
+
+inline bool collie::log::async_logger::deferred_format_enabled() const {
+    return deferred_format_.load(std::memory_order_relaxed);
+}
+
 inline std::shared_ptr<collie::log::logger> collie::log::async_logger::clone(std::string new_name) {
     auto cloned = std::make_shared<collie::log::async_logger>(*this);
     cloned->name_ = std::move(new_name);
@@ -40,6 +40,14 @@ enum class async_overflow_policy {
     discard_new      // Discard new message if the queue is full when trying to add new item.
 };
 
+enum class async_queue_mode {
+    shared,     // All threads post to one mpmc queue.
+    per_thread  // Each thread posts to its own spsc ring, the workers sweep the rings
+                // round-robin. Messages of one thread keep their order, messages of
+                // different threads may be interleaved differently. overrun_oldest
+                // drops the new message instead (counted as overrun).
+};
+
 namespace details {
 class thread_pool;
 }
@@ -71,10 +79,22 @@ public:
 
     std::shared_ptr<logger> clone(std::string new_name) override;
 
+    // deferred formatting: log calls whose arguments are all deferrable (numbers,
+    // enums, void pointers, see collie::log::is_deferrable) only copy the raw
+    // arguments, the formatting runs on the backend thread.
+    // Other calls are still formatted by the caller.
+    void enable_deferred_format();
+
+    void disable_deferred_format();
+
+    bool deferred_format_enabled() const;
+
 protected:
     void sink_it_(const details::log_msg &msg) override;
     void flush_() override;
     void backend_sink_it_(const details::log_msg &incoming_log_msg);
+    // formats the deferred messages in place, then calls log_batch() of each sink.
+    void backend_sink_batch_(std::vector<details::log_msg> &msgs);
     void backend_flush_();
 
 private:
@@ -0,0 +1,366 @@
+//
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+
+#pragma once
+
+// compiled_pattern - a formatter whose pattern is parsed at compile time.
+//
+// The pattern is split into tokens by constexpr functions and each token is
+// mapped to its flag formatter type. The formatters are stored by value and
+// called directly (no heap allocation, no virtual call per flag).
+// Like pattern_formatter, the leading date/time part is rendered once per second.
+// Same flags and padding syntax as pattern_formatter, custom flags are not
+// supported.
+//
+// Usage:
+//     static constexpr char my_pattern[] = "[%Y-%m-%d %H:%M:%S.%e] [%l] %v";
+//     logger->set_formatter(collie::log::details::make_unique<
+//             collie::log::compiled_pattern<my_pattern>>());
+
+#include <collie/log/pattern_formatter.h>
+
+#include <chrono>
+#include <cstring>
+#include <ctime>
+#include <memory>
+#include <string>
+#include <utility>
+
+namespace collie::log {
+namespace details {
+
+// token of a pattern: a run of plain text or a flag with its padding spec.
+struct pattern_token {
+    bool is_flag = false;
+    size_t begin = 0;
+    size_t size = 0;
+    size_t end = 0;
+    char flag = '\0';
+    bool padded = false;
+    size_t width = 0;
+    padding_info::pad_side side = padding_info::pad_side::left;
+    bool truncate = false;
+};
+
+// scan the token starting at pos.
+// the padding spec syntax mirrors pattern_formatter::handle_padspec_()
+constexpr pattern_token scan_pattern_token(const char *pattern, size_t pos) {
+    pattern_token token;
+    token.begin = pos;
+    if (pattern[pos] != '%') {
+        size_t i = pos;
+        while (pattern[i] != '\0' && pattern[i] != '%') {
+            ++i;
+        }
+        token.size = i - pos;
+        token.end = i;
+        return token;
+    }
+
+    size_t i = pos + 1;
+    if (pattern[i] == '-') {
+        token.side = padding_info::pad_side::right;
+        ++i;
+    } else if (pattern[i] == '=') {
+        token.side = padding_info::pad_side::center;
+        ++i;
+    }
+    if (pattern[i] >= '0' && pattern[i] <= '9') {
+        token.padded = true;
+        for (; pattern[i] >= '0' && pattern[i] <= '9'; ++i) {
+            token.width = token.width * 10 + static_cast<size_t>(pattern[i] - '0');
+        }
+        if (token.width > 64) {
+            token.width = 64;
+        }
+        if (pattern[i] == '!') {
+            token.truncate = true;
+            ++i;
+        }
+    }
+
+    if (pattern[i] == '\0') {
+        // dangling '%' at the end of the pattern is ignored
+        token.end = i;
+        return token;
+    }
+    token.is_flag = true;
+    token.flag = pattern[i];
+    token.end = i + 1;
+    return token;
+}
+
+constexpr size_t count_pattern_tokens(const char *pattern) {
+    size_t count = 0;
+    for (size_t pos = 0; pattern[pos] != '\0'; pos = scan_pattern_token(pattern, pos).end) {
+        ++count;
+    }
+    return count;
+}
+
+constexpr pattern_token pattern_token_at(const char *pattern, size_t index) {
+    size_t pos = 0;
+    for (size_t i = 0; i < index; i++) {
+        pos = scan_pattern_token(pattern, pos).end;
+    }
+    return scan_pattern_token(pattern, pos);
+}
+
+constexpr bool is_flag_in(char flag, const char *flags) {
+    for (; *flags != '\0'; ++flags) {
+        if (*flags == flag) {
+            return true;
+        }
+    }
+    return false;
+}
+
+constexpr bool pattern_needs_localtime(const char *pattern) {
+    for (size_t pos = 0; pattern[pos] != '\0';) {
+        auto token = scan_pattern_token(pattern, pos);
+        if (token.is_flag && is_flag_in(token.flag, "+aAbBcCYDxmdHIMSprRTXz")) {
+            return true;
+        }
+        pos = token.end;
+    }
+    return false;
+}
+
+// number of leading tokens whose output only changes once per second
+// (same rule as pattern_formatter's cached date prefix).
+constexpr size_t pattern_prefix_tokens(const char *pattern) {
+    size_t count = 0;
+    for (size_t pos = 0; pattern[pos] != '\0'; ++count) {
+        auto token = scan_pattern_token(pattern, pos);
+        if (token.is_flag && !is_flag_in(token.flag, "aAbBcCYDxmdHIMSprRTXz")) {
+            break;
+        }
+        pos = token.end;
+    }
+    return count;
+}
+
+// plain text of the pattern
+template <const char *Pattern, size_t Begin, size_t Size>
+struct compiled_text {
+    explicit compiled_text(padding_info) {}
+
+    void format(const log_msg &, const std::tm &, memory_buf_t &dest) {
+        fmt_helper::append_string_view(string_view_t(Pattern + Begin, Size), dest);
+    }
+};
+
+template <char... Chars>
+struct compiled_chars {
+    explicit compiled_chars(padding_info) {}
+
+    void format(const log_msg &, const std::tm &, memory_buf_t &dest) {
+        static constexpr char chars[] = {Chars...};
+        fmt_helper::append_string_view(string_view_t(chars, sizeof...(Chars)), dest);
+    }
+};
+
+// "%10!]" - the '!' was meant as funcname flag, see pattern_formatter::handle_flag_()
+template <typename ScopedPadder, char Flag>
+struct compiled_funcname_then_char {
+    explicit compiled_funcname_then_char(padding_info padinfo)
+        : funcname_(padding_info(padinfo.width_, padinfo.side_, false)) {}
+
+    void format(const log_msg &msg, const std::tm &tm_time, memory_buf_t &dest) {
+        funcname_.format(msg, tm_time, dest);
+        dest.push_back(Flag);
+    }
+
+    source_funcname_formatter<ScopedPadder> funcname_;
+};
+
+// flag -> formatter type, unknown flags appear as is
+template <char Flag, typename ScopedPadder, bool Truncate>
+struct compiled_flag {
+    using type = typename std::conditional<Truncate,
+                                           compiled_funcname_then_char<ScopedPadder, Flag>,
+                                           compiled_chars<'%', Flag>>::type;
+};
+
+#define CLOG_COMPILED_FLAG(flag_char, ...)                   \
+    template <typename ScopedPadder, bool Truncate>          \
+    struct compiled_flag<flag_char, ScopedPadder, Truncate> { \
+        using type = __VA_ARGS__;                            \
+    }
+
+CLOG_COMPILED_FLAG('+', full_formatter);
+CLOG_COMPILED_FLAG('n', name_formatter<ScopedPadder>);
+CLOG_COMPILED_FLAG('l', level_formatter<ScopedPadder>);
+CLOG_COMPILED_FLAG('L', short_level_formatter<ScopedPadder>);
+CLOG_COMPILED_FLAG('t', t_formatter<ScopedPadder>);
+CLOG_COMPILED_FLAG('v', v_formatter<ScopedPadder>);
+CLOG_COMPILED_FLAG('a', a_formatter<ScopedPadder>);
+CLOG_COMPILED_FLAG('A', A_formatter<ScopedPadder>);
+CLOG_COMPILED_FLAG('b', b_formatter<ScopedPadder>);
+CLOG_COMPILED_FLAG('h', b_formatter<ScopedPadder>);
+CLOG_COMPILED_FLAG('B', B_formatter<ScopedPadder>);
+CLOG_COMPILED_FLAG('c', c_formatter<ScopedPadder>);
+CLOG_COMPILED_FLAG('C', C_formatter<ScopedPadder>);
+CLOG_COMPILED_FLAG('Y', Y_formatter<ScopedPadder>);
+CLOG_COMPILED_FLAG('D', D_formatter<ScopedPadder>);
+CLOG_COMPILED_FLAG('x', D_formatter<ScopedPadder>);
+CLOG_COMPILED_FLAG('m', m_formatter<ScopedPadder>);
+CLOG_COMPILED_FLAG('d', d_formatter<ScopedPadder>);
+CLOG_COMPILED_FLAG('H', H_formatter<ScopedPadder>);
+CLOG_COMPILED_FLAG('I', I_formatter<ScopedPadder>);
+CLOG_COMPILED_FLAG('M', M_formatter<ScopedPadder>);
+CLOG_COMPILED_FLAG('S', S_formatter<ScopedPadder>);
+CLOG_COMPILED_FLAG('e', e_formatter<ScopedPadder>);
+CLOG_COMPILED_FLAG('f', f_formatter<ScopedPadder>);
+CLOG_COMPILED_FLAG('F', F_formatter<ScopedPadder>);
+CLOG_COMPILED_FLAG('E', E_formatter<ScopedPadder>);
+CLOG_COMPILED_FLAG('p', p_formatter<ScopedPadder>);
+CLOG_COMPILED_FLAG('r', r_formatter<ScopedPadder>);
+CLOG_COMPILED_FLAG('R', R_formatter<ScopedPadder>);
+CLOG_COMPILED_FLAG('T', T_formatter<ScopedPadder>);
+CLOG_COMPILED_FLAG('X', T_formatter<ScopedPadder>);
+CLOG_COMPILED_FLAG('z', z_formatter<ScopedPadder>);
+CLOG_COMPILED_FLAG('P', pid_formatter<ScopedPadder>);
+CLOG_COMPILED_FLAG('^', color_start_formatter);
+CLOG_COMPILED_FLAG('$', color_stop_formatter);
+CLOG_COMPILED_FLAG('@', source_location_formatter<ScopedPadder>);
+CLOG_COMPILED_FLAG('s', short_filename_formatter<ScopedPadder>);
+CLOG_COMPILED_FLAG('g', source_filename_formatter<ScopedPadder>);
+CLOG_COMPILED_FLAG('#', source_linenum_formatter<ScopedPadder>);
+CLOG_COMPILED_FLAG('!', source_funcname_formatter<ScopedPadder>);
+CLOG_COMPILED_FLAG('%', compiled_chars<'%'>);
+CLOG_COMPILED_FLAG('u', elapsed_formatter<ScopedPadder, std::chrono::nanoseconds>);
+CLOG_COMPILED_FLAG('i', elapsed_formatter<ScopedPadder, std::chrono::microseconds>);
+CLOG_COMPILED_FLAG('o', elapsed_formatter<ScopedPadder, std::chrono::milliseconds>);
+CLOG_COMPILED_FLAG('O', elapsed_formatter<ScopedPadder, std::chrono::seconds>);
+
+#undef CLOG_COMPILED_FLAG
+
+// formatter type and padding of the token at Index
+template <const char *Pattern, size_t Index>
+struct compiled_token {
+    static constexpr pattern_token token = pattern_token_at(Pattern, Index);
+
+    using padder = typename std::conditional<token.padded, scoped_padder, null_scoped_padder>::type;
+
+    using type = typename std::conditional<
+        token.is_flag,
+        typename compiled_flag<token.flag, padder, token.truncate>::type,
+        compiled_text<Pattern, token.begin, token.size>>::type;
+
+    static padding_info padding() {
+        return token.padded ? padding_info(token.width, token.side, token.truncate)
+                            : padding_info{};
+    }
+};
+
+// the formatter of one token, constructed in place
+template <size_t Index, typename Formatter>
+struct compiled_slot {
+    explicit compiled_slot(padding_info padinfo)
+        : formatter(padinfo) {}
+
+    Formatter formatter;
+};
+
+template <const char *Pattern, typename Indices>
+struct compiled_tokens;
+
+template <const char *Pattern, size_t... Is>
+struct compiled_tokens<Pattern, std::index_sequence<Is...>>
+    : compiled_slot<Is, typename compiled_token<Pattern, Is>::type>... {
+    compiled_tokens()
+        : compiled_slot<Is, typename compiled_token<Pattern, Is>::type>(
+              compiled_token<Pattern, Is>::padding())... {}
+
+    // format the tokens in [Begin, End)
+    template <size_t Begin, size_t End>
+    void format(const log_msg &msg, const std::tm &tm_time, memory_buf_t &dest) {
+        (format_token_<Is, Begin, End>(msg, tm_time, dest), ...);
+    }
+
+private:
+    template <size_t Index, size_t Begin, size_t End>
+    void format_token_(const log_msg &msg, const std::tm &tm_time, memory_buf_t &dest) {
+        if constexpr (Index >= Begin && Index < End) {
+            compiled_slot<Index, typename compiled_token<Pattern, Index>::type>::formatter.format(
+                msg, tm_time, dest);
+        }
+    }
+};
+
+}  // namespace details
+
+template <const char *Pattern>
+class compiled_pattern final : public formatter {
+    static constexpr size_t token_count = details::count_pattern_tokens(Pattern);
+    static constexpr bool need_localtime = details::pattern_needs_localtime(Pattern);
+    static constexpr size_t prefix_tokens = details::pattern_prefix_tokens(Pattern);
+    using indices = std::make_index_sequence<token_count>;
+
+public:
+    explicit compiled_pattern(pattern_time_type time_type = pattern_time_type::local,
+                              std::string eol = collie::log::details::os::default_eol)
+        : eol_(std::move(eol)),
+          pattern_time_type_(time_type) {
+        std::memset(&cached_tm_, 0, sizeof(cached_tm_));
+    }
+
+    compiled_pattern(const compiled_pattern &other) = delete;
+    compiled_pattern &operator=(const compiled_pattern &other) = delete;
+
+    std::unique_ptr<formatter> clone() const override {
+        return details::make_unique<compiled_pattern>(pattern_time_type_, eol_);
+    }
+
+    void format(const details::log_msg &msg, memory_buf_t &dest) override {
+        const auto secs = std::chrono::duration_cast<std::chrono::seconds>(msg.time.time_since_epoch());
+        if constexpr (need_localtime) {
+            if (secs != last_log_secs_) {
+                cached_tm_ = pattern_time_type_ == pattern_time_type::local
+                                 ? details::os::localtime(log_clock::to_time_t(msg.time))
+                                 : details::os::gmtime(log_clock::to_time_t(msg.time));
+                last_log_secs_ = secs;
+            }
+        }
+        if constexpr (prefix_tokens > 0) {
+            if (secs != cached_prefix_secs_) {
+                cached_prefix_.clear();
+                formatters_.template format<0, prefix_tokens>(msg, cached_tm_, cached_prefix_);
+                cached_prefix_secs_ = secs;
+            }
+            dest.append(cached_prefix_.begin(), cached_prefix_.end());
+        }
+        formatters_.template format<prefix_tokens, token_count>(msg, cached_tm_, dest);
+        details::fmt_helper::append_string_view(eol_, dest);
+    }
+
+    static constexpr const char *pattern() { return Pattern; }
+
+private:
+    std::string eol_;
+    pattern_time_type pattern_time_type_;
+    std::tm cached_tm_;
+    std::chrono::seconds last_log_secs_{0};
+    memory_buf_t cached_prefix_;
+    std::chrono::seconds cached_prefix_secs_{std::chrono::seconds::min()};
+    details::compiled_tokens<Pattern, indices> formatters_;
+};
+
+}  // namespace collie::log
@@ -0,0 +1,113 @@
+//
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+
+#pragma once
+
+// deferred formatting support.
+// When an async logger has deferred formatting enabled and all the arguments
+// of a log call are deferrable, the calling thread only packs the raw bytes of
+// the arguments next to the format string. The backend thread unpacks them and
+// runs the formatting.
+// Calls with any other argument type are formatted eagerly as usual.
+
+#include <collie/log/common.h>
+
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace collie::log {
+
+// Arguments of these types are copied by value and formatted later on the
+// backend thread. Pointers to characters, strings and views are not deferrable:
+// the memory they refer to may be gone by then.
+// Specialize for trivially copyable user types that own all their data.
+template <typename T, typename = void>
+struct is_deferrable
+        : std::integral_constant<bool,
+                std::is_arithmetic<T>::value || std::is_enum<T>::value ||
+                std::is_same<T, void *>::value || std::is_same<T, const void *>::value ||
+                std::is_same<T, std::nullptr_t>::value> {
+};
+
+namespace details {
+
+template <typename... Args>
+struct all_deferrable : std::integral_constant<bool,
+        (sizeof...(Args) > 0) && (is_deferrable<remove_cvref_t<Args>>::value && ...)> {
+};
+
+// byte offset of each packed argument, the last entry is the total size.
+template <typename... Args>
+constexpr std::array<size_t, sizeof...(Args) + 1> deferred_offsets() {
+    constexpr size_t sizes[] = {sizeof(Args)..., 0};
+    std::array<size_t, sizeof...(Args) + 1> offsets{};
+    for (size_t i = 0; i < sizeof...(Args); i++) {
+        offsets[i + 1] = offsets[i] + sizes[i];
+    }
+    return offsets;
+}
+
+template <typename... Args>
+constexpr size_t deferred_args_size() {
+    return deferred_offsets<Args...>()[sizeof...(Args)];
+}
+
+template <typename... Args, size_t... I>
+void pack_deferred_args_impl(char *dest, std::index_sequence<I...>, const Args &...args) {
+    constexpr auto offsets = deferred_offsets<Args...>();
+    (std::memcpy(dest + offsets[I], &args, sizeof(Args)), ...);
+}
+
+// pack the arguments without padding into dest (deferred_args_size<Args...>() bytes).
+template <typename... Args>
+void pack_deferred_args(char *dest, const Args &...args) {
+    static_assert((std::is_trivially_copyable<Args>::value && ...),
+                  "deferred log arguments must be trivially copyable");
+    pack_deferred_args_impl(dest, std::index_sequence_for<Args...>{}, args...);
+}
+
+template <typename T>
+T load_deferred_arg(const char *src) {
+    T value;
+    std::memcpy(&value, src, sizeof(T));
+    return value;
+}
+
+template <typename... Args, size_t... I>
+void format_deferred_args_impl(string_view_t fmt,
+                               const char *data,
+                               memory_buf_t &dest,
+                               std::index_sequence<I...>) {
+    constexpr auto offsets = deferred_offsets<Args...>();
+    std::tuple<Args...> args{load_deferred_arg<Args>(data + offsets[I])...};
+    fmt::vformat_to(fmt::appender(dest), fmt, fmt::make_format_args(std::get<I>(args)...));
+}
+
+// unpack the arguments packed by pack_deferred_args<Args...>() and format them.
+template <typename... Args>
+void format_deferred_args(string_view_t fmt, const char *data, memory_buf_t &dest) {
+    format_deferred_args_impl<Args...>(fmt, data, dest, std::index_sequence_for<Args...>{});
+}
+
+}  // namespace details
+}  // namespace collie::log
@@ -110,10 +110,12 @@ inline void file_helper::close() {
 }
 
 inline void file_helper::write(const memory_buf_t &buf) {
+    write(buf.data(), buf.size());
+}
+
+inline void file_helper::write(const char *data, size_t size) {
     if(fd_ == nullptr) return;
-    size_t msg_size = buf.size();
-    auto data = buf.data();
-    if (std::fwrite(data, 1, msg_size, fd_) != msg_size) {
+    if (std::fwrite(data, 1, size, fd_) != size) {
         throw_clog_ex("Failed writing to file " + os::filename_to_str(filename_), errno);
     }
 }
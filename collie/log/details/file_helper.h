@@ -53,6 +53,8 @@ namespace collie::log {
 
             void write(const memory_buf_t &buf);
 
+            void write(const char *data, size_t size);
+
             size_t size() const;
 
             const filename_t &filename() const;
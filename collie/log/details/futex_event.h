@@ -0,0 +1,197 @@
+//
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+
+#pragma once
+
+// futex_event - a parking spot for threads waiting on a lock-free condition.
+//
+// Usage (waiter side):
+//     auto key = ev.prepare_wait();
+//     if (condition_became_true()) { ev.cancel_wait(); } else { ev.commit_wait(key); }
+// Usage (notifier side):
+//     make_condition_true();
+//     ev.notify_all();
+//
+// notify_all() costs one fence and one relaxed load when nobody is parked,
+// so the fast path never enters the kernel.
+// On linux the waiters sleep on a futex, elsewhere on a condition variable.
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+#if defined(__linux__)
+#include <climits>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#else
+#include <condition_variable>
+#include <mutex>
+#endif
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#include <immintrin.h>
+#endif
+
+namespace collie::log {
+namespace details {
+
+// hint the cpu that we are in a spin loop.
+inline void cpu_relax() noexcept {
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    _mm_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield" ::: "memory");
+#else
+    std::this_thread::yield();
+#endif
+}
+
+// bounded spin with exponential backoff, falls back to yielding.
+// return false once the budget is exhausted and the caller should park.
+class spin_backoff {
+public:
+    explicit spin_backoff(uint32_t max_spins = 1024, uint32_t max_yields = 16) noexcept
+        : max_spins_(max_spins),
+          max_yields_(max_yields) {}
+
+    bool next() noexcept {
+        if (spins_ < max_spins_) {
+            for (uint32_t i = 0; i < step_; ++i) {
+                cpu_relax();
+            }
+            spins_ += step_;
+            if (step_ < 64) {
+                step_ <<= 1;
+            }
+            return true;
+        }
+        if (yields_ < max_yields_) {
+            ++yields_;
+            std::this_thread::yield();
+            return true;
+        }
+        return false;
+    }
+
+    void reset() noexcept {
+        step_ = 1;
+        spins_ = 0;
+        yields_ = 0;
+    }
+
+private:
+    uint32_t max_spins_;
+    uint32_t max_yields_;
+    uint32_t step_{1};
+    uint32_t spins_{0};
+    uint32_t yields_{0};
+};
+
+class futex_event {
+public:
+    futex_event() = default;
+
+    futex_event(const futex_event &) = delete;
+
+    futex_event &operator=(const futex_event &) = delete;
+
+    // register as a waiter and return the key to pass to commit_wait().
+    // the caller must re-check its condition after this call.
+    uint32_t prepare_wait() noexcept {
+        waiters_.fetch_add(1, std::memory_order_seq_cst);
+        return epoch_.load(std::memory_order_seq_cst);
+    }
+
+    void cancel_wait() noexcept { waiters_.fetch_sub(1, std::memory_order_relaxed); }
+
+    // sleep until notified (or spuriously woken).
+    void commit_wait(uint32_t key) noexcept {
+#if defined(__linux__)
+        futex_wait_(key, nullptr);
+#else
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [&] { return epoch_.load(std::memory_order_relaxed) != key; });
+        }
+#endif
+        waiters_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    // sleep until notified, spuriously woken or timeout.
+    void commit_wait_for(uint32_t key, std::chrono::nanoseconds timeout) noexcept {
+        if (timeout.count() > 0) {
+#if defined(__linux__)
+            struct timespec ts;
+            ts.tv_sec = static_cast<time_t>(timeout.count() / 1000000000);
+            ts.tv_nsec = static_cast<long>(timeout.count() % 1000000000);
+            futex_wait_(key, &ts);
+#else
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait_for(lock, timeout,
+                         [&] { return epoch_.load(std::memory_order_relaxed) != key; });
+#endif
+        }
+        waiters_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    // wake up all parked waiters, if any.
+    void notify_all() noexcept {
+        // order the caller's state change before reading the waiter count
+        // (pairs with the seq_cst increment in prepare_wait()).
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (waiters_.load(std::memory_order_relaxed) == 0) {
+            return;
+        }
+#if defined(__linux__)
+        epoch_.fetch_add(1, std::memory_order_seq_cst);
+        ::syscall(SYS_futex, reinterpret_cast<uint32_t *>(&epoch_), FUTEX_WAKE_PRIVATE, INT_MAX,
+                  nullptr, nullptr, 0);
+#else
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            epoch_.fetch_add(1, std::memory_order_seq_cst);
+        }
+        cv_.notify_all();
+#endif
+    }
+
+private:
+#if defined(__linux__)
+    void futex_wait_(uint32_t key, const struct timespec *timeout) noexcept {
+        ::syscall(SYS_futex, reinterpret_cast<uint32_t *>(&epoch_), FUTEX_WAIT_PRIVATE, key,
+                  timeout, nullptr, 0);
+    }
+#endif
+
+    static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t),
+                  "futex_event requires a lock free 32 bit atomic");
+    std::atomic<uint32_t> epoch_{0};
+    std::atomic<uint32_t> waiters_{0};
+#if !defined(__linux__)
+    std::mutex mutex_;
+    std::condition_variable cv_;
+#endif
+};
+
+}  // namespace details
+}  // namespace collie::log
@@ -25,6 +25,9 @@
 
 namespace collie::log {
     namespace details {
+        // format the deferred arguments (packed raw bytes) with the given format string.
+        using deferred_format_fn = void (*)(string_view_t fmt, const char *args, memory_buf_t &dest);
+
         struct log_msg {
             log_msg() = default;
 
@@ -53,6 +56,12 @@ namespace collie::log {
 
             source_loc source;
             string_view_t payload;
+
+            // deferred formatting (async loggers only): when set, payload holds the
+            // format string and deferred_args the packed arguments, the backend
+            // formats them before handing the message to the sinks.
+            deferred_format_fn format_deferred{nullptr};
+            string_view_t deferred_args;
         };
     }  // namespace details
 }  // namespace collie::log
@@ -27,6 +27,7 @@ inline log_msg_buffer::log_msg_buffer(const log_msg &orig_msg)
     : log_msg{orig_msg} {
     buffer.append(logger_name.begin(), logger_name.end());
     buffer.append(payload.begin(), payload.end());
+    buffer.append(deferred_args.begin(), deferred_args.end());
     update_string_views();
 }
 
@@ -34,6 +35,7 @@ inline log_msg_buffer::log_msg_buffer(const log_msg_buffer &other)
     : log_msg{other} {
     buffer.append(logger_name.begin(), logger_name.end());
     buffer.append(payload.begin(), payload.end());
+    buffer.append(deferred_args.begin(), deferred_args.end());
     update_string_views();
 }
 
@@ -61,6 +63,8 @@ inline log_msg_buffer &log_msg_buffer::operator=(log_msg_buffer &&other) noexcep
 inline void log_msg_buffer::update_string_views() {
     logger_name = string_view_t{buffer.data(), logger_name.size()};
     payload = string_view_t{buffer.data() + logger_name.size(), payload.size()};
+    deferred_args = string_view_t{buffer.data() + logger_name.size() + payload.size(),
+                                  deferred_args.size()};
 }
 
 }  // namespace details
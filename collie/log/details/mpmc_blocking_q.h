@@ -25,6 +25,8 @@
 // the queue.
 // dequeue_for(..) - will block until the queue is not empty or timeout have
 // passed.
+// dequeue_bulk(..) - will block until the queue is not empty, then take up to
+// max_items items under one lock.
 
 #include <collie/log/details/circular_q.h>
 
@@ -105,6 +107,22 @@ public:
         pop_cv_.notify_one();
     }
 
+    // blocking dequeue of up to max_items items into the given array.
+    // Return number of items dequeued (at least 1).
+    size_t dequeue_bulk(T *items, size_t max_items) {
+        size_t n = 0;
+        {
+            std::unique_lock<std::mutex> lock(queue_mutex_);
+            push_cv_.wait(lock, [this] { return !this->q_.empty(); });
+            while (n < max_items && !q_.empty()) {
+                items[n++] = std::move(q_.front());
+                q_.pop_front();
+            }
+        }
+        pop_cv_.notify_all();
+        return n;
+    }
+
 #else
     // apparently mingw deadlocks if the mutex is released before cv.notify_one(),
     // so release the mutex at the very end each function.
@@ -161,6 +179,20 @@ public:
         pop_cv_.notify_one();
     }
 
+    // blocking dequeue of up to max_items items into the given array.
+    // Return number of items dequeued (at least 1).
+    size_t dequeue_bulk(T *items, size_t max_items) {
+        std::unique_lock<std::mutex> lock(queue_mutex_);
+        push_cv_.wait(lock, [this] { return !this->q_.empty(); });
+        size_t n = 0;
+        while (n < max_items && !q_.empty()) {
+            items[n++] = std::move(q_.front());
+            q_.pop_front();
+        }
+        pop_cv_.notify_all();
+        return n;
+    }
+
 #endif
 
     size_t overrun_counter() {
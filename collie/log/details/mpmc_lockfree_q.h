@@ -0,0 +1,282 @@
+//
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+
+#pragma once
+
+// lock-free multi producer-multi consumer bounded queue.
+// drop-in replacement of mpmc_blocking_queue with the same interface.
+//
+// Each slot of the power-of-two ring carries a sequence number telling whether
+// it is free for the producer of the current lap or ready for its consumer
+// (D. Vyukov's bounded mpmc queue), so producers and consumers only contend
+// on a single CAS of their own cache line.
+//
+// enqueue(..) - spin/back off while full, then park on a futex until room found.
+// enqueue_nowait(..) - overrun oldest message in the queue if no room left.
+// enqueue_if_have_room(..) - discard the new message if no room left.
+// dequeue_for(..) - will block until the queue is not empty or timeout have
+// passed.
+// dequeue_bulk(..) - block until at least one item is available, then take as
+// many ready items as fit with a single CAS.
+//
+// Note: the capacity is rounded up to the next power of two (minimum 2).
+
+#include <collie/log/details/futex_event.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+
+namespace collie::log {
+namespace details {
+
+template <typename T>
+class mpmc_lockfree_queue {
+    static constexpr size_t cache_line_size = 64;
+
+    struct cell {
+        std::atomic<size_t> sequence;
+        T data;
+    };
+
+public:
+    using item_type = T;
+
+    explicit mpmc_lockfree_queue(size_t max_items)
+        : capacity_(round_up_pow2_(max_items)),
+          mask_(capacity_ - 1),
+          buffer_(new cell[capacity_]) {
+        for (size_t i = 0; i < capacity_; i++) {
+            buffer_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    mpmc_lockfree_queue(const mpmc_lockfree_queue &) = delete;
+
+    mpmc_lockfree_queue &operator=(const mpmc_lockfree_queue &) = delete;
+
+    // try to enqueue and block if no room left
+    void enqueue(T &&item) {
+        spin_backoff backoff;
+        while (!try_enqueue_(item)) {
+            if (backoff.next()) {
+                continue;
+            }
+            auto key = not_full_.prepare_wait();
+            if (try_enqueue_(item)) {
+                not_full_.cancel_wait();
+                break;
+            }
+            not_full_.commit_wait(key);
+        }
+        not_empty_.notify_all();
+    }
+
+    // enqueue immediately. overrun oldest message in the queue if no room left.
+    void enqueue_nowait(T &&item) {
+        while (!try_enqueue_(item)) {
+            T dropped;
+            if (try_dequeue_(dropped)) {
+                overrun_counter_.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+        not_empty_.notify_all();
+    }
+
+    void enqueue_if_have_room(T &&item) {
+        if (try_enqueue_(item)) {
+            not_empty_.notify_all();
+        } else {
+            discard_counter_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    // dequeue with a timeout.
+    // Return true, if succeeded dequeue item, false otherwise
+    bool dequeue_for(T &popped_item, std::chrono::milliseconds wait_duration) {
+        if (try_dequeue_(popped_item)) {
+            not_full_.notify_all();
+            return true;
+        }
+        if (wait_duration <= std::chrono::milliseconds::zero()) {
+            return false;
+        }
+
+        auto deadline = std::chrono::steady_clock::now() + wait_duration;
+        spin_backoff backoff;
+        while (!try_dequeue_(popped_item)) {
+            if (backoff.next()) {
+                continue;
+            }
+            auto now = std::chrono::steady_clock::now();
+            if (now >= deadline) {
+                return false;
+            }
+            auto key = not_empty_.prepare_wait();
+            if (try_dequeue_(popped_item)) {
+                not_empty_.cancel_wait();
+                break;
+            }
+            not_empty_.commit_wait_for(key, deadline - now);
+        }
+        not_full_.notify_all();
+        return true;
+    }
+
+    // blocking dequeue without a timeout.
+    void dequeue(T &popped_item) {
+        wait_dequeue_(popped_item);
+        not_full_.notify_all();
+    }
+
+    // blocking dequeue of up to max_items items into the given array.
+    // Return number of items dequeued (at least 1).
+    size_t dequeue_bulk(T *items, size_t max_items) {
+        if (max_items == 0) {
+            return 0;
+        }
+        size_t n = try_dequeue_bulk_(items, max_items);
+        if (n == 0) {
+            wait_dequeue_(items[0]);
+            n = 1 + try_dequeue_bulk_(items + 1, max_items - 1);
+        }
+        not_full_.notify_all();
+        return n;
+    }
+
+    size_t overrun_counter() { return overrun_counter_.load(std::memory_order_relaxed); }
+
+    size_t discard_counter() { return discard_counter_.load(std::memory_order_relaxed); }
+
+    size_t size() {
+        size_t head = dequeue_pos_.load(std::memory_order_acquire);
+        size_t tail = enqueue_pos_.load(std::memory_order_acquire);
+        return tail > head ? (std::min)(tail - head, capacity_) : 0;
+    }
+
+    size_t capacity() const { return capacity_; }
+
+    void reset_overrun_counter() { overrun_counter_.store(0, std::memory_order_relaxed); }
+
+    void reset_discard_counter() { discard_counter_.store(0, std::memory_order_relaxed); }
+
+private:
+    static size_t round_up_pow2_(size_t n) {
+        size_t r = 2;
+        while (r < n) {
+            r <<= 1;
+        }
+        return r;
+    }
+
+    // the item is moved from only if the enqueue succeeded.
+    bool try_enqueue_(T &item) {
+        size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+        for (;;) {
+            cell &c = buffer_[pos & mask_];
+            size_t seq = c.sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+            if (diff == 0) {
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    c.data = std::move(item);
+                    c.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                // the slot still holds the item of the previous lap - full
+                return false;
+            } else {
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool try_dequeue_(T &item) { return try_dequeue_bulk_(&item, 1) == 1; }
+
+    // claim a run of consecutive ready slots with a single CAS.
+    size_t try_dequeue_bulk_(T *items, size_t max_items) {
+        if (max_items == 0) {
+            return 0;
+        }
+        size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+        for (;;) {
+            size_t n = 0;
+            std::ptrdiff_t diff = 0;
+            while (n < max_items) {
+                size_t seq = buffer_[(pos + n) & mask_].sequence.load(std::memory_order_acquire);
+                diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos + n + 1);
+                if (diff != 0) {
+                    break;
+                }
+                ++n;
+            }
+
+            if (n == 0) {
+                if (diff < 0) {
+                    // the slot was not published yet - empty
+                    return 0;
+                }
+                pos = dequeue_pos_.load(std::memory_order_relaxed);
+                continue;
+            }
+
+            if (dequeue_pos_.compare_exchange_weak(pos, pos + n, std::memory_order_relaxed)) {
+                for (size_t i = 0; i < n; i++) {
+                    cell &c = buffer_[(pos + i) & mask_];
+                    items[i] = std::move(c.data);
+                    c.sequence.store(pos + i + mask_ + 1, std::memory_order_release);
+                }
+                return n;
+            }
+        }
+    }
+
+    void wait_dequeue_(T &item) {
+        spin_backoff backoff;
+        while (!try_dequeue_(item)) {
+            if (backoff.next()) {
+                continue;
+            }
+            auto key = not_empty_.prepare_wait();
+            if (try_dequeue_(item)) {
+                not_empty_.cancel_wait();
+                return;
+            }
+            not_empty_.commit_wait(key);
+        }
+    }
+
+    const size_t capacity_;
+    const size_t mask_;
+    std::unique_ptr<cell[]> buffer_;
+
+    alignas(cache_line_size) std::atomic<size_t> enqueue_pos_{0};
+    alignas(cache_line_size) std::atomic<size_t> dequeue_pos_{0};
+
+    alignas(cache_line_size) futex_event not_empty_;
+    alignas(cache_line_size) futex_event not_full_;
+
+    alignas(cache_line_size) std::atomic<size_t> overrun_counter_{0};
+    std::atomic<size_t> discard_counter_{0};
+};
+}  // namespace details
+}  // namespace collie::log
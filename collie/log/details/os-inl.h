@@ -22,6 +22,10 @@
 
 #include <collie/log/common.h>
 
+#ifdef CLOG_CLOCK_TSC
+#include <collie/log/details/tsc_clock.h>
+#endif
+
 #include <algorithm>
 #include <array>
 #include <chrono>
@@ -86,7 +90,10 @@
 namespace collie::log::details::os {
 
     inline collie::log::log_clock::time_point now() noexcept {
-#if defined __linux__ && defined CLOG_CLOCK_COARSE
+#if defined CLOG_CLOCK_TSC
+        return tsc_clock::now();
+
+#elif defined __linux__ && defined CLOG_CLOCK_COARSE
         timespec ts;
         ::clock_gettime(CLOCK_REALTIME_COARSE, &ts);
         return std::chrono::time_point<log_clock, typename log_clock::duration>(
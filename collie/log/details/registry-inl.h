@@ -58,6 +58,7 @@ namespace collie::log::details {
         loggers_[default_logger_name] = default_logger_;
 
 #endif  // CLOG_DISABLE_DEFAULT_LOGGER
+        publish_snapshot_();
     }
 
     inline registry::~registry() = default;
@@ -92,9 +93,22 @@ namespace collie::log::details {
     }
 
     inline std::shared_ptr<logger> registry::get(const std::string &logger_name) {
-        std::lock_guard<std::mutex> lock(logger_map_mutex_);
-        auto found = loggers_.find(logger_name);
-        return found == loggers_.end() ? nullptr : found->second;
+        struct cached_snapshot {
+            const registry *owner{nullptr};
+            uint64_t version{0};
+            std::shared_ptr<const logger_snapshot> snapshot;
+        };
+        static thread_local cached_snapshot cache;
+
+        auto version = snapshot_version_.load(std::memory_order_acquire);
+        if (cache.owner != this || cache.version != version || cache.snapshot == nullptr) {
+            std::lock_guard<std::mutex> lock(logger_map_mutex_);
+            cache.owner = this;
+            cache.version = snapshot_version_.load(std::memory_order_relaxed);
+            cache.snapshot = snapshot_;
+        }
+        auto found = cache.snapshot->loggers.find(logger_name);
+        return found == cache.snapshot->loggers.end() ? nullptr : found->second.lock();
     }
 
     inline std::shared_ptr<logger> registry::default_logger() {
@@ -120,6 +134,7 @@ namespace collie::log::details {
             loggers_[new_default_logger->name()] = new_default_logger;
         }
         default_logger_ = std::move(new_default_logger);
+        publish_snapshot_();
     }
 
     inline void registry::set_tp(std::shared_ptr<thread_pool> tp) {
@@ -212,12 +227,14 @@ namespace collie::log::details {
         if (is_default_logger) {
             default_logger_.reset();
         }
+        publish_snapshot_();
     }
 
     inline void registry::drop_all() {
         std::lock_guard<std::mutex> lock(logger_map_mutex_);
         loggers_.clear();
         default_logger_.reset();
+        publish_snapshot_();
     }
 
 // clean all resources and threads started by the registry
@@ -280,6 +297,17 @@ namespace collie::log::details {
         auto logger_name = new_logger->name();
         throw_if_exists_(logger_name);
         loggers_[logger_name] = std::move(new_logger);
+        publish_snapshot_();
+    }
+
+    inline void registry::publish_snapshot_() {
+        auto snapshot = std::make_shared<logger_snapshot>();
+        snapshot->loggers.reserve(loggers_.size());
+        for (auto &l: loggers_) {
+            snapshot->loggers.emplace(l.first, l.second);
+        }
+        snapshot_ = std::move(snapshot);
+        snapshot_version_.fetch_add(1, std::memory_order_release);
     }
 
 }  // namespace collie::log::details
@@ -23,11 +23,16 @@
 // An attempt to create a logger with an already existing name will result with CLogEx exception.
 // If user requests a non existing logger, nullptr will be returned
 // This class is thread safe
+// get() is lock free: the name->logger map is also published as an immutable
+// snapshot, each thread keeps a reference to the last snapshot it saw and only
+// takes the mutex to refresh it after a logger was registered or dropped.
 
 #include <collie/log/common.h>
 #include <collie/log/details/periodic_worker.h>
 
+#include <atomic>
 #include <chrono>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <mutex>
@@ -126,9 +131,20 @@ namespace collie::log::details {
 
         bool set_level_from_cfg_(logger *logger);
 
+        // rebuild the lookup snapshot from loggers_, call with logger_map_mutex_ held.
+        void publish_snapshot_();
+
+        // immutable copy of loggers_ for lock free lookups. holds weak pointers so a
+        // stale snapshot never keeps a dropped logger alive.
+        struct logger_snapshot {
+            std::unordered_map<std::string, std::weak_ptr<logger>> loggers;
+        };
+
         std::mutex logger_map_mutex_, flusher_mutex_;
         std::recursive_mutex tp_mutex_;
         std::unordered_map<std::string, std::shared_ptr<logger>> loggers_;
+        std::shared_ptr<const logger_snapshot> snapshot_;
+        std::atomic<uint64_t> snapshot_version_{0};
         log_levels log_levels_;
         std::unique_ptr<formatter> formatter_;
         collie::log::level::level_enum global_log_level_ = level::info;
@@ -0,0 +1,123 @@
+//
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+
+#pragma once
+
+// single producer-single consumer bounded ring.
+// try_push(..) - called by the owning producer thread only, return false if full.
+// try_pop_bulk(..) - called by one consumer at a time, take up to max_items
+// items and release their slots with a single store.
+//
+// The producer only writes its own tail index and the consumer its own head
+// index. Each side keeps a private copy of the other side's index and only
+// re-reads the shared one when the copy says the ring is full or holds less
+// than a full batch.
+//
+// Note: the capacity is rounded up to the next power of two (minimum 2).
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+namespace collie::log {
+namespace details {
+
+template <typename T>
+class spsc_ring {
+    static constexpr size_t cache_line_size = 64;
+
+public:
+    using item_type = T;
+
+    explicit spsc_ring(size_t max_items)
+        : capacity_(round_up_pow2_(max_items)),
+          mask_(capacity_ - 1),
+          buffer_(new T[capacity_]) {}
+
+    spsc_ring(const spsc_ring &) = delete;
+
+    spsc_ring &operator=(const spsc_ring &) = delete;
+
+    // the item is moved from only if the push succeeded.
+    bool try_push(T &item) {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - producer_cached_head_ >= capacity_) {
+            producer_cached_head_ = head_.load(std::memory_order_acquire);
+            if (tail - producer_cached_head_ >= capacity_) {
+                return false;
+            }
+        }
+        buffer_[tail & mask_] = std::move(item);
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    size_t try_pop_bulk(T *items, size_t max_items) {
+        size_t head = head_.load(std::memory_order_relaxed);
+        if (consumer_cached_tail_ - head < max_items) {
+            // take everything published so far
+            consumer_cached_tail_ = tail_.load(std::memory_order_acquire);
+            if (consumer_cached_tail_ == head) {
+                return 0;
+            }
+        }
+        size_t n = (std::min)(consumer_cached_tail_ - head, max_items);
+        for (size_t i = 0; i < n; i++) {
+            items[i] = std::move(buffer_[(head + i) & mask_]);
+        }
+        head_.store(head + n, std::memory_order_release);
+        return n;
+    }
+
+    bool empty() const {
+        return tail_.load(std::memory_order_acquire) == head_.load(std::memory_order_acquire);
+    }
+
+    size_t size() const {
+        size_t head = head_.load(std::memory_order_acquire);
+        size_t tail = tail_.load(std::memory_order_acquire);
+        return tail > head ? tail - head : 0;
+    }
+
+    size_t capacity() const { return capacity_; }
+
+private:
+    static size_t round_up_pow2_(size_t n) {
+        size_t r = 2;
+        while (r < n) {
+            r <<= 1;
+        }
+        return r;
+    }
+
+    const size_t capacity_;
+    const size_t mask_;
+    std::unique_ptr<T[]> buffer_;
+
+    // producer side
+    alignas(cache_line_size) std::atomic<size_t> tail_{0};
+    size_t producer_cached_head_{0};
+
+    // consumer side
+    alignas(cache_line_size) std::atomic<size_t> head_{0};
+    size_t consumer_cached_tail_{0};
+};
+}  // namespace details
+}  // namespace collie::log
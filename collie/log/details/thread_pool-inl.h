@@ -19,6 +19,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cassert>
 #include <collie/log/common.h>
 
@@ -28,8 +29,15 @@ namespace details {
 inline thread_pool::thread_pool(size_t q_max_items,
                                        size_t threads_n,
                                        std::function<void()> on_thread_start,
-                                       std::function<void()> on_thread_stop)
-    : q_(q_max_items) {
+                                       std::function<void()> on_thread_stop,
+                                       async_queue_mode queue_mode)
+    : queue_mode_(queue_mode),
+      q_(queue_mode == async_queue_mode::per_thread ? 0 : q_max_items),
+      ring_max_items_(q_max_items),
+      id_([] {
+          static std::atomic<uint64_t> next_id{0};
+          return next_id.fetch_add(1, std::memory_order_relaxed);
+      }()) {
     if (threads_n == 0 || threads_n > 1000) {
         throw_clog_ex(
             "collie::log::thread_pool(): invalid threads_n param (valid "
@@ -38,12 +46,23 @@ inline thread_pool::thread_pool(size_t q_max_items,
     for (size_t i = 0; i < threads_n; i++) {
         threads_.emplace_back([this, on_thread_start, on_thread_stop] {
             on_thread_start();
-            this->thread_pool::worker_loop_();
+            if (queue_mode_ == async_queue_mode::per_thread) {
+                this->thread_pool::rings_worker_loop_();
+            } else {
+                this->thread_pool::worker_loop_();
+            }
             on_thread_stop();
         });
     }
 }
 
+inline thread_pool::thread_pool(size_t q_max_items,
+                                       size_t threads_n,
+                                       std::function<void()> on_thread_start,
+                                       std::function<void()> on_thread_stop)
+    : thread_pool(q_max_items, threads_n, on_thread_start, on_thread_stop,
+                  async_queue_mode::shared) {}
+
 inline thread_pool::thread_pool(size_t q_max_items,
                                        size_t threads_n,
                                        std::function<void()> on_thread_start)
@@ -53,16 +72,31 @@ inline thread_pool::thread_pool(size_t q_max_items, size_t threads_n)
     : thread_pool(
           q_max_items, threads_n, [] {}, [] {}) {}
 
+inline thread_pool::thread_pool(size_t q_max_items, size_t threads_n, async_queue_mode queue_mode)
+    : thread_pool(
+          q_max_items, threads_n, [] {}, [] {}, queue_mode) {}
+
 // message all threads to terminate gracefully join them
 inline thread_pool::~thread_pool() {
     CLOG_TRY {
-        for (size_t i = 0; i < threads_.size(); i++) {
-            post_async_msg_(async_msg(async_msg_type::terminate), async_overflow_policy::block);
+        if (queue_mode_ == async_queue_mode::per_thread) {
+            // the workers drain all rings before they exit
+            stopping_.store(true, std::memory_order_release);
+            rings_not_empty_.notify_all();
+        } else {
+            for (size_t i = 0; i < threads_.size(); i++) {
+                post_async_msg_(async_msg(async_msg_type::terminate), async_overflow_policy::block);
+            }
         }
 
         for (auto &t : threads_) {
             t.join();
         }
+
+        std::lock_guard<std::mutex> lock(rings_mutex_);
+        for (auto &ring : rings_) {
+            ring->detached.store(true, std::memory_order_release);
+        }
     }
     CLOG_CATCH_STD
 }
@@ -79,19 +113,40 @@ void inline thread_pool::post_flush(async_logger_ptr &&worker_ptr,
     post_async_msg_(async_msg(std::move(worker_ptr), async_msg_type::flush), overflow_policy);
 }
 
-size_t inline thread_pool::overrun_counter() { return q_.overrun_counter(); }
+size_t inline thread_pool::overrun_counter() {
+    return q_.overrun_counter() + rings_overrun_counter_.load(std::memory_order_relaxed);
+}
 
-void inline thread_pool::reset_overrun_counter() { q_.reset_overrun_counter(); }
+void inline thread_pool::reset_overrun_counter() {
+    q_.reset_overrun_counter();
+    rings_overrun_counter_.store(0, std::memory_order_relaxed);
+}
 
-size_t inline thread_pool::discard_counter() { return q_.discard_counter(); }
+size_t inline thread_pool::discard_counter() {
+    return q_.discard_counter() + rings_discard_counter_.load(std::memory_order_relaxed);
+}
+
+void inline thread_pool::reset_discard_counter() {
+    q_.reset_discard_counter();
+    rings_discard_counter_.store(0, std::memory_order_relaxed);
+}
 
-void inline thread_pool::reset_discard_counter() { q_.reset_discard_counter(); }
+size_t inline thread_pool::queue_size() {
+    size_t size = q_.size();
+    std::lock_guard<std::mutex> lock(rings_mutex_);
+    for (auto &ring : rings_) {
+        size += ring->ring.size();
+    }
+    return size;
+}
 
-size_t inline thread_pool::queue_size() { return q_.size(); }
+async_queue_mode inline thread_pool::queue_mode() const { return queue_mode_; }
 
 void inline thread_pool::post_async_msg_(async_msg &&new_msg,
                                                 async_overflow_policy overflow_policy) {
-    if (overflow_policy == async_overflow_policy::block) {
+    if (queue_mode_ == async_queue_mode::per_thread) {
+        post_to_ring_(std::move(new_msg), overflow_policy);
+    } else if (overflow_policy == async_overflow_policy::block) {
         q_.enqueue(std::move(new_msg));
     } else if (overflow_policy == async_overflow_policy::overrun_oldest) {
         q_.enqueue_nowait(std::move(new_msg));
@@ -101,38 +156,223 @@ void inline thread_pool::post_async_msg_(async_msg &&new_msg,
     }
 }
 
+void inline thread_pool::post_to_ring_(async_msg &&new_msg,
+                                              async_overflow_policy overflow_policy) {
+    auto &r = local_ring_();
+    if (!r.ring.try_push(new_msg)) {
+        if (overflow_policy == async_overflow_policy::block) {
+            spin_backoff backoff;
+            while (!r.ring.try_push(new_msg)) {
+                if (backoff.next()) {
+                    continue;
+                }
+                auto key = rings_not_full_.prepare_wait();
+                if (r.ring.try_push(new_msg)) {
+                    rings_not_full_.cancel_wait();
+                    break;
+                }
+                rings_not_full_.commit_wait(key);
+            }
+        } else if (overflow_policy == async_overflow_policy::overrun_oldest) {
+            // the oldest message belongs to the consumer side of the ring,
+            // drop the new one instead.
+            rings_overrun_counter_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        } else {
+            assert(overflow_policy == async_overflow_policy::discard_new);
+            rings_discard_counter_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+    }
+    rings_not_empty_.notify_all();
+}
+
+inline producer_ring &thread_pool::local_ring_() {
+    struct ring_cache {
+        std::vector<std::pair<uint64_t, std::shared_ptr<producer_ring>>> rings;
+
+        ~ring_cache() {
+            for (auto &entry : rings) {
+                entry.second->retired.store(true, std::memory_order_release);
+            }
+        }
+    };
+    static thread_local ring_cache cache;
+
+    for (auto &entry : cache.rings) {
+        if (entry.first == id_) {
+            return *entry.second;
+        }
+    }
+
+    // first message of this thread to this pool, forget rings of dead pools
+    cache.rings.erase(std::remove_if(cache.rings.begin(), cache.rings.end(),
+                                     [](const std::pair<uint64_t, std::shared_ptr<producer_ring>> &entry) {
+                                         return entry.second->detached.load(std::memory_order_acquire);
+                                     }),
+                      cache.rings.end());
+    auto ring = std::make_shared<producer_ring>(ring_max_items_);
+    {
+        std::lock_guard<std::mutex> lock(rings_mutex_);
+        rings_.push_back(ring);
+        rings_version_.fetch_add(1, std::memory_order_release);
+    }
+    cache.rings.emplace_back(id_, ring);
+    return *ring;
+}
+
+void inline thread_pool::prune_retired_rings_() {
+    std::lock_guard<std::mutex> lock(rings_mutex_);
+    auto it = std::remove_if(rings_.begin(), rings_.end(), [](const std::shared_ptr<producer_ring> &r) {
+        return r->retired.load(std::memory_order_acquire) && r->ring.empty();
+    });
+    if (it != rings_.end()) {
+        rings_.erase(it, rings_.end());
+        rings_version_.fetch_add(1, std::memory_order_release);
+    }
+}
+
 void inline thread_pool::worker_loop_() {
-    while (process_next_msg_()) {
+    std::vector<async_msg> batch(max_batch_size);
+    std::vector<log_msg> msgs;
+    msgs.reserve(max_batch_size);
+    while (process_next_batch_(batch, msgs)) {
     }
 }
 
-// process next message in the queue
-// return true if this thread should still be active (while no terminate msg
-// was received)
-bool inline thread_pool::process_next_msg_() {
-    async_msg incoming_async_msg;
-    q_.dequeue(incoming_async_msg);
+// sweep the producer rings round-robin, drain each one in batches.
+// exit once the pool is stopping and a whole sweep found nothing.
+void inline thread_pool::rings_worker_loop_() {
+    std::vector<async_msg> batch(max_batch_size);
+    std::vector<log_msg> msgs;
+    msgs.reserve(max_batch_size);
+    std::vector<std::shared_ptr<producer_ring>> rings;
+    uint64_t version = 0;
+    bool first_sweep = true;
+    spin_backoff backoff;
+
+    auto refresh_rings = [&] {
+        std::lock_guard<std::mutex> lock(rings_mutex_);
+        rings = rings_;
+        version = rings_version_.load(std::memory_order_relaxed);
+    };
 
-    switch (incoming_async_msg.msg_type) {
-        case async_msg_type::log: {
-            incoming_async_msg.worker_ptr->backend_sink_it_(incoming_async_msg);
-            return true;
+    for (;;) {
+        bool stopping = stopping_.load(std::memory_order_acquire);
+        if (first_sweep || rings_version_.load(std::memory_order_acquire) != version) {
+            refresh_rings();
+            first_sweep = false;
         }
-        case async_msg_type::flush: {
-            incoming_async_msg.worker_ptr->backend_flush_();
-            return true;
+
+        size_t drained = 0;
+        bool has_retired = false;
+        for (auto &r : rings) {
+            if (r->consumer_lock.test_and_set(std::memory_order_acquire)) {
+                continue;  // drained by another worker right now
+            }
+            // read before popping: retired and empty means no more messages
+            bool retired = r->retired.load(std::memory_order_acquire);
+            size_t n = r->ring.try_pop_bulk(batch.data(), batch.size());
+            if (n > 0) {
+                // processed under the ring lock to keep the messages of one thread in order
+                process_batch_(batch, n, msgs);
+            }
+            r->consumer_lock.clear(std::memory_order_release);
+            drained += n;
+            has_retired = has_retired || (retired && n == 0);
         }
 
-        case async_msg_type::terminate: {
-            return false;
+        if (has_retired) {
+            prune_retired_rings_();
         }
 
-        default: {
-            assert(false);
+        if (drained > 0) {
+            rings_not_full_.notify_all();
+            backoff.reset();
+            continue;
+        }
+
+        if (stopping) {
+            return;
+        }
+
+        if (backoff.next()) {
+            continue;
+        }
+
+        auto key = rings_not_empty_.prepare_wait();
+        bool ready = stopping_.load(std::memory_order_acquire) ||
+                     rings_version_.load(std::memory_order_acquire) != version;
+        for (size_t i = 0; !ready && i < rings.size(); i++) {
+            ready = !rings[i]->ring.empty();
+        }
+        if (ready) {
+            rings_not_empty_.cancel_wait();
+        } else {
+            rings_not_empty_.commit_wait(key);
+        }
+        backoff.reset();
+    }
+}
+
+// process next batch of messages in the queue
+// return true if this thread should still be active (while no terminate msg
+// was received)
+bool inline thread_pool::process_next_batch_(std::vector<async_msg> &batch,
+                                             std::vector<log_msg> &msgs) {
+    size_t n = q_.dequeue_bulk(batch.data(), batch.size());
+    size_t terminate_count = process_batch_(batch, n, msgs);
+
+    // each worker must see its own terminate msg, hand the extra ones over.
+    for (size_t i = 1; i < terminate_count; i++) {
+        post_async_msg_(async_msg(async_msg_type::terminate), async_overflow_policy::block);
+    }
+
+    return terminate_count == 0;
+}
+
+size_t inline thread_pool::process_batch_(std::vector<async_msg> &batch,
+                                          size_t n,
+                                          std::vector<log_msg> &msgs) {
+    size_t terminate_count = 0;
+
+    for (size_t i = 0; i < n;) {
+        auto &incoming_async_msg = batch[i];
+        size_t next = i + 1;
+        switch (incoming_async_msg.msg_type) {
+            case async_msg_type::log: {
+                // hand the consecutive messages of the same logger to its sinks at once
+                msgs.clear();
+                msgs.push_back(incoming_async_msg);
+                while (next < n && batch[next].msg_type == async_msg_type::log &&
+                       batch[next].worker_ptr == incoming_async_msg.worker_ptr) {
+                    msgs.push_back(batch[next]);
+                    ++next;
+                }
+                incoming_async_msg.worker_ptr->backend_sink_batch_(msgs);
+                break;
+            }
+            case async_msg_type::flush: {
+                incoming_async_msg.worker_ptr->backend_flush_();
+                break;
+            }
+
+            case async_msg_type::terminate: {
+                ++terminate_count;
+                break;
+            }
+
+            default: {
+                assert(false);
+            }
+        }
+        // don't keep the logger alive while the slots wait to be reused
+        for (; i < next; i++) {
+            batch[i].worker_ptr.reset();
         }
     }
 
-    return true;
+    return terminate_count;
 }
 
 }  // namespace details
@@ -19,13 +19,18 @@
 
 #pragma once
 
+#include <collie/log/details/futex_event.h>
 #include <collie/log/details/log_msg_buffer.h>
 #include <collie/log/details/mpmc_blocking_q.h>
+#include <collie/log/details/mpmc_lockfree_q.h>
 #include <collie/log/details/os.h>
+#include <collie/log/details/spsc_ring.h>
 
+#include <atomic>
 #include <chrono>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <thread>
 #include <vector>
 
@@ -89,10 +94,30 @@ namespace collie::log {
                     : async_msg{nullptr, the_type} {}
         };
 
+        // staging ring of one producer thread (async_queue_mode::per_thread)
+        struct producer_ring {
+            explicit producer_ring(size_t max_items)
+                    : ring(max_items) {}
+
+            spsc_ring<async_msg> ring;
+            // set when the producer thread exits, the ring is dropped once drained
+            std::atomic<bool> retired{false};
+            // set when the thread pool is destroyed
+            std::atomic<bool> detached{false};
+            // held by the worker currently draining the ring
+            std::atomic_flag consumer_lock = ATOMIC_FLAG_INIT;
+        };
+
         class thread_pool {
         public:
             using item_type = async_msg;
+#ifdef CLOG_LOCKFREE_QUEUE
+            using q_type = details::mpmc_lockfree_queue<item_type>;
+#else
             using q_type = details::mpmc_blocking_queue<item_type>;
+#endif
+            // max number of messages a worker takes from the queue at once
+            static constexpr size_t max_batch_size = 64;
 
             thread_pool(size_t q_max_items,
                         size_t threads_n,
@@ -103,6 +128,15 @@ namespace collie::log {
 
             thread_pool(size_t q_max_items, size_t threads_n);
 
+            // in per_thread mode q_max_items is the size of each thread's ring
+            thread_pool(size_t q_max_items,
+                        size_t threads_n,
+                        std::function<void()> on_thread_start,
+                        std::function<void()> on_thread_stop,
+                        async_queue_mode queue_mode);
+
+            thread_pool(size_t q_max_items, size_t threads_n, async_queue_mode queue_mode);
+
             // message all threads to terminate gracefully and join them
             ~thread_pool();
 
@@ -126,19 +160,48 @@ namespace collie::log {
 
             size_t queue_size();
 
+            async_queue_mode queue_mode() const;
+
         private:
+            async_queue_mode queue_mode_;
             q_type q_;
 
             std::vector<std::thread> threads_;
 
+            // per_thread mode state
+            const size_t ring_max_items_;
+            const uint64_t id_;
+            std::mutex rings_mutex_;
+            std::vector<std::shared_ptr<producer_ring>> rings_;
+            std::atomic<uint64_t> rings_version_{0};
+            std::atomic<bool> stopping_{false};
+            futex_event rings_not_empty_;
+            futex_event rings_not_full_;
+            std::atomic<size_t> rings_overrun_counter_{0};
+            std::atomic<size_t> rings_discard_counter_{0};
+
             void post_async_msg_(async_msg &&new_msg, async_overflow_policy overflow_policy);
 
+            void post_to_ring_(async_msg &&new_msg, async_overflow_policy overflow_policy);
+
+            // ring of the calling thread, registered on first use
+            producer_ring &local_ring_();
+
+            void prune_retired_rings_();
+
             void worker_loop_();
 
-            // process next message in the queue
+            void rings_worker_loop_();
+
+            // process the first n messages of the batch, msgs is scratch space for
+            // the log_msg views handed to the sinks.
+            // return the number of terminate messages found
+            size_t process_batch_(std::vector<async_msg> &batch, size_t n, std::vector<log_msg> &msgs);
+
+            // process next batch of messages in the queue
             // return true if this thread should still be active (while no terminate msg
             // was received)
-            bool process_next_msg_();
+            bool process_next_batch_(std::vector<async_msg> &batch, std::vector<log_msg> &msgs);
         };
 
     }  // namespace details
@@ -0,0 +1,139 @@
+//
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+
+#pragma once
+
+// wall clock derived from the cpu time stamp counter (used when CLOG_CLOCK_TSC
+// is defined).
+// The counter is anchored to the system clock and the tick period is measured
+// between two anchors, so reading the time is a rdtsc and a multiply.
+// The anchor is refreshed about once per second to keep the drift and the
+// system clock adjustments in check.
+// Requires an invariant counter synchronized across cores (any recent x86 cpu).
+// Until the first calibration is done (10ms after the first call), and on other
+// architectures, the system clock is returned.
+
+#include <collie/log/common.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#define CLOG_HAS_TSC 1
+#endif
+
+namespace collie::log {
+namespace details {
+
+class tsc_clock {
+public:
+    static log_clock::time_point now() noexcept {
+#ifdef CLOG_HAS_TSC
+        return instance_().now_();
+#else
+        return log_clock::now();
+#endif
+    }
+
+private:
+#ifdef CLOG_HAS_TSC
+    static constexpr int64_t calibration_ns = 10 * 1000 * 1000;
+    static constexpr int64_t resync_ns = 1000 * 1000 * 1000;
+
+    static tsc_clock &instance_() noexcept {
+        static tsc_clock clock;
+        return clock;
+    }
+
+    static int64_t system_ns_() noexcept {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                       log_clock::now().time_since_epoch())
+            .count();
+    }
+
+    static log_clock::time_point to_time_point_(int64_t ns) noexcept {
+        return log_clock::time_point(
+            std::chrono::duration_cast<log_clock::duration>(std::chrono::nanoseconds(ns)));
+    }
+
+    log_clock::time_point now_() noexcept {
+        uint64_t tsc = __rdtsc();
+        // seqlock read of the anchor
+        for (;;) {
+            uint32_t seq = seq_.load(std::memory_order_acquire);
+            if (seq & 1) {
+                return to_time_point_(system_ns_());  // being updated
+            }
+            uint64_t anchor_tsc = anchor_tsc_.load(std::memory_order_relaxed);
+            int64_t anchor_ns = anchor_ns_.load(std::memory_order_relaxed);
+            double ns_per_tick = ns_per_tick_.load(std::memory_order_relaxed);
+            uint64_t resync_ticks = resync_ticks_.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (seq_.load(std::memory_order_relaxed) != seq) {
+                continue;
+            }
+
+            uint64_t elapsed = tsc - anchor_tsc;
+            if (ns_per_tick > 0 && tsc >= anchor_tsc && elapsed < resync_ticks) {
+                return to_time_point_(anchor_ns + static_cast<int64_t>(elapsed * ns_per_tick));
+            }
+            return to_time_point_(resync_(seq, tsc, anchor_tsc, anchor_ns));
+        }
+    }
+
+    // re-anchor to the system clock, return the system time.
+    // only the thread winning the seqlock updates the anchor.
+    int64_t resync_(uint32_t seq, uint64_t tsc, uint64_t anchor_tsc, int64_t anchor_ns) noexcept {
+        int64_t ns = system_ns_();
+        bool first = anchor_tsc == 0;
+        int64_t measured_ns = ns - anchor_ns;
+        if (!first && measured_ns < calibration_ns && tsc >= anchor_tsc) {
+            return ns;  // too early to measure the tick period
+        }
+        if (!seq_.compare_exchange_strong(seq, seq + 1, std::memory_order_acquire)) {
+            return ns;
+        }
+        std::atomic_thread_fence(std::memory_order_release);
+        if (!first && tsc > anchor_tsc && measured_ns > 0) {
+            double ns_per_tick = static_cast<double>(measured_ns) / static_cast<double>(tsc - anchor_tsc);
+            ns_per_tick_.store(ns_per_tick, std::memory_order_relaxed);
+            resync_ticks_.store(static_cast<uint64_t>(resync_ns / ns_per_tick), std::memory_order_relaxed);
+        }
+        anchor_tsc_.store(tsc, std::memory_order_relaxed);
+        anchor_ns_.store(ns, std::memory_order_relaxed);
+        seq_.store(seq + 2, std::memory_order_release);
+        return ns;
+    }
+
+    std::atomic<uint32_t> seq_{0};
+    std::atomic<uint64_t> anchor_tsc_{0};
+    std::atomic<int64_t> anchor_ns_{0};
+    std::atomic<double> ns_per_tick_{0};
+    std::atomic<uint64_t> resync_ticks_{0};
+#endif
+};
+
+}  // namespace details
+}  // namespace collie::log
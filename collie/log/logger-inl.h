@@ -33,7 +33,8 @@ namespace collie::log {
               level_(other.level_.load(std::memory_order_relaxed)),
               flush_level_(other.flush_level_.load(std::memory_order_relaxed)),
               custom_err_handler_(other.custom_err_handler_),
-              tracer_(other.tracer_) {}
+              tracer_(other.tracer_),
+              deferred_format_(other.deferred_format_.load(std::memory_order_relaxed)) {}
 
     inline logger::logger(logger &&other) noexcept
             : name_(std::move(other.name_)),
@@ -41,7 +42,8 @@ namespace collie::log {
               level_(other.level_.load(std::memory_order_relaxed)),
               flush_level_(other.flush_level_.load(std::memory_order_relaxed)),
               custom_err_handler_(std::move(other.custom_err_handler_)),
-              tracer_(std::move(other.tracer_)) {}
+              tracer_(std::move(other.tracer_)),
+              deferred_format_(other.deferred_format_.load(std::memory_order_relaxed)) {}
 
     inline logger &logger::operator=(logger other) noexcept {
         this->swap(other);
@@ -64,14 +66,20 @@ namespace collie::log {
 
         custom_err_handler_.swap(other.custom_err_handler_);
         std::swap(tracer_, other.tracer_);
+
+        auto other_deferred = other.deferred_format_.load();
+        other.deferred_format_.store(deferred_format_.exchange(other_deferred));
     }
 
     inline void swap(logger &a, logger &b) { a.swap(b); }
 
-    inline void logger::set_level(level::level_enum log_level) { level_.store(log_level); }
+    // the level checks are a single relaxed load, no ordering needed on the store either.
+    inline void logger::set_level(level::level_enum log_level) {
+        level_.store(log_level, std::memory_order_relaxed);
+    }
 
     inline void logger::set_vlog_level(int v) {
-        vlog_level_.store(v);
+        vlog_level_.store(v, std::memory_order_relaxed);
     }
 
     inline level::level_enum logger::level() const {
@@ -30,6 +30,7 @@
 
 #include <collie/log/common.h>
 #include <collie/log/details/backtracer.h>
+#include <collie/log/details/deferred_args.h>
 #include <collie/log/details/log_msg.h>
 
 #ifdef CLOG_WCHAR_TO_UTF8_SUPPORT
@@ -337,6 +338,8 @@ namespace collie::log {
         collie::log::level_t vlog_level_{0};
         err_handler custom_err_handler_{nullptr};
         details::backtracer tracer_;
+        // format on the backend thread when possible (see async_logger::enable_deferred_format)
+        std::atomic<bool> deferred_format_{false};
 
         // common implementation for after templated public api has been resolved
         template<typename... Args>
@@ -347,6 +350,17 @@ namespace collie::log {
                 return;
             }
             CLOG_TRY {
+                if constexpr (details::all_deferrable<Args...>::value) {
+                    if (!traceback_enabled && deferred_format_.load(std::memory_order_relaxed)) {
+                        char packed[details::deferred_args_size<remove_cvref_t<Args>...>()];
+                        details::pack_deferred_args<remove_cvref_t<Args>...>(packed, args...);
+                        details::log_msg log_msg(loc, name_, lvl, fmt);
+                        log_msg.format_deferred = &details::format_deferred_args<remove_cvref_t<Args>...>;
+                        log_msg.deferred_args = string_view_t(packed, sizeof(packed));
+                        log_it_(log_msg, log_enabled, traceback_enabled);
+                        return;
+                    }
+                }
                 memory_buf_t buf;
                 fmt::vformat_to(fmt::appender(buf), fmt, fmt::make_format_args(args...));
                 details::log_msg log_msg(loc, name_, lvl, string_view_t(buf.data(), buf.size()));
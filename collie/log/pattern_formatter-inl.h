@@ -888,7 +888,9 @@ inline pattern_formatter::pattern_formatter(std::string pattern,
       pattern_time_type_(time_type),
       need_localtime_(false),
       last_log_secs_(0),
-      custom_handlers_(std::move(custom_user_flags)) {
+      custom_handlers_(std::move(custom_user_flags)),
+      prefix_formatters_(0),
+      cached_prefix_secs_(std::chrono::seconds::min()) {
     std::memset(&cached_tm_, 0, sizeof(cached_tm_));
     compile_pattern_(pattern_);
 }
@@ -899,7 +901,9 @@ inline pattern_formatter::pattern_formatter(pattern_time_type time_type, std::st
       eol_(std::move(eol)),
       pattern_time_type_(time_type),
       need_localtime_(true),
-      last_log_secs_(0) {
+      last_log_secs_(0),
+      prefix_formatters_(0),
+      cached_prefix_secs_(std::chrono::seconds::min()) {
     std::memset(&cached_tm_, 0, sizeof(cached_tm_));
     formatters_.push_back(details::make_unique<details::full_formatter>(details::padding_info{}));
 }
@@ -920,17 +924,25 @@ inline std::unique_ptr<formatter> pattern_formatter::clone() const {
 }
 
 inline void pattern_formatter::format(const details::log_msg &msg, memory_buf_t &dest) {
-    if (need_localtime_) {
-        const auto secs =
-            std::chrono::duration_cast<std::chrono::seconds>(msg.time.time_since_epoch());
-        if (secs != last_log_secs_) {
-            cached_tm_ = get_time_(msg);
-            last_log_secs_ = secs;
+    const auto secs = std::chrono::duration_cast<std::chrono::seconds>(msg.time.time_since_epoch());
+    if (need_localtime_ && secs != last_log_secs_) {
+        cached_tm_ = get_time_(msg);
+        last_log_secs_ = secs;
+    }
+
+    if (prefix_formatters_ > 0) {
+        if (secs != cached_prefix_secs_) {
+            cached_prefix_.clear();
+            for (size_t i = 0; i < prefix_formatters_; i++) {
+                formatters_[i]->format(msg, cached_tm_, cached_prefix_);
+            }
+            cached_prefix_secs_ = secs;
         }
+        dest.append(cached_prefix_.begin(), cached_prefix_.end());
     }
 
-    for (auto &f : formatters_) {
-        f->format(msg, cached_tm_, dest);
+    for (size_t i = prefix_formatters_; i < formatters_.size(); i++) {
+        formatters_[i]->format(msg, cached_tm_, dest);
     }
     // write eol
     details::fmt_helper::append_string_view(eol_, dest);
@@ -1240,15 +1252,27 @@ inline details::padding_info pattern_formatter::handle_padspec_(
     return details::padding_info{std::min<size_t>(width, max_width), side, truncate};
 }
 
+inline bool pattern_formatter::is_per_second_flag_(char flag) const {
+    static const char per_second_flags[] = "aAbBcCYDxmdHIMSprRTXz";
+    return flag != '\0' && std::strchr(per_second_flags, flag) != nullptr &&
+           custom_handlers_.find(flag) == custom_handlers_.end();
+}
+
 inline void pattern_formatter::compile_pattern_(const std::string &pattern) {
     auto end = pattern.end();
     std::unique_ptr<details::aggregate_formatter> user_chars;
     formatters_.clear();
+    prefix_formatters_ = 0;
+    cached_prefix_secs_ = std::chrono::seconds::min();
+    bool in_prefix = true;
     for (auto it = pattern.begin(); it != end; ++it) {
         if (*it == '%') {
             if (user_chars)  // append user chars found so far
             {
                 formatters_.push_back(std::move(user_chars));
+                if (in_prefix) {
+                    prefix_formatters_ = formatters_.size();
+                }
             }
 
             auto padding = handle_padspec_(++it, end);
@@ -1259,6 +1283,10 @@ inline void pattern_formatter::compile_pattern_(const std::string &pattern) {
                 } else {
                     handle_flag_<details::null_scoped_padder>(*it, padding);
                 }
+                in_prefix = in_prefix && is_per_second_flag_(*it);
+                if (in_prefix) {
+                    prefix_formatters_ = formatters_.size();
+                }
             } else {
                 break;
             }
@@ -1273,6 +1301,9 @@ inline void pattern_formatter::compile_pattern_(const std::string &pattern) {
     if (user_chars)  // append raw chars found so far
     {
         formatters_.push_back(std::move(user_chars));
+        if (in_prefix) {
+            prefix_formatters_ = formatters_.size();
+        }
     }
 }
 }  // namespace collie::log
@@ -113,6 +113,13 @@ private:
     std::vector<std::unique_ptr<details::flag_formatter>> formatters_;
     custom_flags custom_handlers_;
 
+    // the leading formatters whose output only changes once per second (date/time
+    // flags and plain text, e.g. "[%Y-%m-%d %H:%M:%S.") are rendered into
+    // cached_prefix_ once per second, each message only appends the rest.
+    size_t prefix_formatters_;
+    memory_buf_t cached_prefix_;
+    std::chrono::seconds cached_prefix_secs_;
+
     std::tm get_time_(const details::log_msg &msg);
     template <typename Padder>
     void handle_flag_(char flag, details::padding_info padding);
@@ -123,6 +130,9 @@ private:
     static details::padding_info handle_padspec_(std::string::const_iterator &it,
                                                  std::string::const_iterator end);
 
+    // true if the built-in flag output only depends on the second of the message time.
+    bool is_per_second_flag_(char flag) const;
+
     void compile_pattern_(const std::string &pattern);
 };
 }  // namespace collie::log
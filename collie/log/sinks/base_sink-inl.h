@@ -40,6 +40,12 @@ void inline collie::log::sinks::base_sink<Mutex>::log(const details::log_msg &ms
     sink_it_(msg);
 }
 
+template<typename Mutex>
+void inline collie::log::sinks::base_sink<Mutex>::log_batch(collie::span<const details::log_msg> msgs) {
+    std::lock_guard<Mutex> lock(mutex_);
+    sink_batch_(msgs);
+}
+
 template<typename Mutex>
 void inline collie::log::sinks::base_sink<Mutex>::flush() {
     std::lock_guard<Mutex> lock(mutex_);
@@ -59,6 +65,15 @@ collie::log::sinks::base_sink<Mutex>::set_formatter(std::unique_ptr<collie::log:
     set_formatter_(std::move(sink_formatter));
 }
 
+template<typename Mutex>
+void inline collie::log::sinks::base_sink<Mutex>::sink_batch_(collie::span<const details::log_msg> msgs) {
+    for (auto &msg : msgs) {
+        if (should_log(msg.level)) {
+            sink_it_(msg);
+        }
+    }
+}
+
 template<typename Mutex>
 void inline collie::log::sinks::base_sink<Mutex>::set_pattern_(const std::string &pattern) {
     set_formatter_(details::make_unique<collie::log::pattern_formatter>(pattern));
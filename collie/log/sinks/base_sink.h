@@ -21,6 +21,7 @@
 //
 // base sink templated over a mutex (either dummy or real)
 // concrete implementation should override the sink_it_() and flush_()  methods.
+// sinks that can write many messages at once may also override sink_batch_().
 // locking is taken care of in this class - no locking needed by the
 // implementers..
 //
@@ -50,6 +51,8 @@ namespace collie::log {
 
             void log(const details::log_msg &msg) final;
 
+            void log_batch(collie::span<const details::log_msg> msgs) final;
+
             void flush() final;
 
             void set_pattern(const std::string &pattern) final;
@@ -63,6 +66,10 @@ namespace collie::log {
 
             virtual void sink_it_(const details::log_msg &msg) = 0;
 
+            // called with the mutex held, default calls sink_it_() for each message
+            // that passes the sink level.
+            virtual void sink_batch_(collie::span<const details::log_msg> msgs);
+
             virtual void flush_() = 0;
 
             virtual void set_pattern_(const std::string &pattern);
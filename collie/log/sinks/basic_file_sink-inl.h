@@ -46,6 +46,18 @@ inline void basic_file_sink<Mutex>::sink_it_(const details::log_msg &msg) {
     file_helper_.write(formatted);
 }
 
+// format the whole batch into one buffer and write it at once.
+template <typename Mutex>
+inline void basic_file_sink<Mutex>::sink_batch_(collie::span<const details::log_msg> msgs) {
+    memory_buf_t formatted;
+    for (auto &msg : msgs) {
+        if (base_sink<Mutex>::should_log(msg.level)) {
+            base_sink<Mutex>::formatter_->format(msg, formatted);
+        }
+    }
+    file_helper_.write(formatted);
+}
+
 template <typename Mutex>
 inline void basic_file_sink<Mutex>::flush_() {
     file_helper_.flush();
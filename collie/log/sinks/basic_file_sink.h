@@ -42,6 +42,7 @@ public:
 
 protected:
     void sink_it_(const details::log_msg &msg) override;
+    void sink_batch_(collie::span<const details::log_msg> msgs) override;
     void flush_() override;
 
 private:
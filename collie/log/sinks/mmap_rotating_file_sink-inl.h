@@ -0,0 +1,274 @@
+//
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+
+#pragma once
+
+#include <collie/log/common.h>
+#include <collie/log/details/os.h>
+#include <collie/log/sinks/rotating_file_sink.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <mutex>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace collie::log {
+namespace sinks {
+
+template <typename Mutex>
+inline mmap_rotating_file_sink<Mutex>::mmap_rotating_file_sink(filename_t base_filename,
+                                                              std::size_t max_size,
+                                                              std::size_t max_files,
+                                                              bool rotate_on_open)
+    : base_filename_(std::move(base_filename)),
+      max_size_(max_size),
+      max_files_(max_files) {
+    if (max_size == 0) {
+        throw_clog_ex("mmap rotating sink constructor: max_size arg cannot be zero");
+    }
+    if (max_files > 200000) {
+        throw_clog_ex("mmap rotating sink constructor: max_files arg cannot exceed 200000");
+    }
+    open_();
+    if (rotate_on_open && tail_ > 0) {
+        rotate_();
+    }
+}
+
+template <typename Mutex>
+inline mmap_rotating_file_sink<Mutex>::~mmap_rotating_file_sink() {
+    CLOG_TRY { close_(); }
+    CLOG_CATCH_STD
+}
+
+template <typename Mutex>
+inline filename_t mmap_rotating_file_sink<Mutex>::filename() {
+    std::lock_guard<Mutex> lock(base_sink<Mutex>::mutex_);
+    return base_filename_;
+}
+
+template <typename Mutex>
+inline std::size_t mmap_rotating_file_sink<Mutex>::current_size() {
+    std::lock_guard<Mutex> lock(base_sink<Mutex>::mutex_);
+    return tail_;
+}
+
+template <typename Mutex>
+inline void mmap_rotating_file_sink<Mutex>::sync() {
+    std::lock_guard<Mutex> lock(base_sink<Mutex>::mutex_);
+    if (map_ != nullptr && ::msync(map_, max_size_, MS_SYNC) != 0) {
+        throw_clog_ex("Failed msync of file " + details::os::filename_to_str(base_filename_), errno);
+    }
+    synced_ = tail_;
+}
+
+template <typename Mutex>
+inline void mmap_rotating_file_sink<Mutex>::sink_it_(const details::log_msg &msg) {
+    memory_buf_t formatted;
+    base_sink<Mutex>::formatter_->format(msg, formatted);
+    append_(formatted.data(), formatted.size());
+}
+
+template <typename Mutex>
+inline void mmap_rotating_file_sink<Mutex>::sink_batch_(collie::span<const details::log_msg> msgs) {
+    memory_buf_t formatted;
+    for (auto &msg : msgs) {
+        if (!base_sink<Mutex>::should_log(msg.level)) {
+            continue;
+        }
+        auto msg_start = formatted.size();
+        base_sink<Mutex>::formatter_->format(msg, formatted);
+        // keep whole messages in each file
+        if (tail_ + formatted.size() > max_size_ && msg_start > 0) {
+            append_(formatted.data(), msg_start);
+            auto msg_size = formatted.size() - msg_start;
+            std::copy_n(formatted.data() + msg_start, msg_size, formatted.data());
+            formatted.resize(msg_size);
+        }
+    }
+    append_(formatted.data(), formatted.size());
+}
+
+// schedule the write back of the pages written since the last flush.
+template <typename Mutex>
+inline void mmap_rotating_file_sink<Mutex>::flush_() {
+    if (map_ == nullptr || tail_ == synced_) {
+        return;
+    }
+    auto page_size = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    auto start = synced_ - synced_ % page_size;
+    if (::msync(map_ + start, tail_ - start, MS_ASYNC) != 0) {
+        throw_clog_ex("Failed msync of file " + details::os::filename_to_str(base_filename_), errno);
+    }
+    synced_ = tail_;
+}
+
+template <typename Mutex>
+inline void mmap_rotating_file_sink<Mutex>::append_(const char *data, std::size_t size) {
+    if (size == 0) {
+        return;
+    }
+    // a previous rotation could not reopen the file - try again before writing
+    if (map_ == nullptr) {
+        open_();
+    }
+    if (tail_ + size > max_size_ && tail_ > 0) {
+        rotate_();
+    }
+    size = (std::min)(size, max_size_ - tail_);
+    std::memcpy(map_ + tail_, data, size);
+    tail_ += size;
+}
+
+// open the base file, preallocate it to max_size_ and map it.
+// an existing file is appended to. on failure the sink is left closed and empty.
+template <typename Mutex>
+inline void mmap_rotating_file_sink<Mutex>::open_() {
+    const auto fname = details::os::filename_to_str(base_filename_);
+    tail_ = synced_ = opened_size_ = 0;
+    details::os::create_dir(details::os::dir_name(base_filename_));
+    fd_ = ::open(fname.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd_ == -1) {
+        throw_clog_ex("Failed opening file " + fname + " for writing", errno);
+    }
+
+    struct stat st;
+    if (::fstat(fd_, &st) != 0) {
+        auto err = errno;
+        ::close(fd_);
+        fd_ = -1;
+        throw_clog_ex("Failed getting size of file " + fname, err);
+    }
+    opened_size_ = static_cast<std::size_t>(st.st_size);
+    tail_ = synced_ = (std::min)(opened_size_, max_size_);
+
+    // reserve the blocks up front. a write to an unbacked page raises SIGBUS once
+    // the disk is full, so a sparse file is only used where the file system cannot
+    // preallocate. this also runs on reopen: the file may be sparse from such a fallback.
+    int rv = -1;
+    int err = EOPNOTSUPP;
+#ifdef __linux__
+    rv = ::fallocate(fd_, 0, 0, static_cast<off_t>(max_size_));
+    if (rv != 0) {
+        err = errno;
+    }
+#endif
+    if (rv != 0 && err != EOPNOTSUPP && err != ENOSYS) {
+        ::close(fd_);
+        fd_ = -1;
+        throw_clog_ex("Failed preallocating file " + fname, err);
+    }
+    if (rv != 0 && opened_size_ < max_size_) {
+        rv = ::ftruncate(fd_, static_cast<off_t>(max_size_));
+    }
+    void *map = rv == 0 || opened_size_ >= max_size_
+                    ? ::mmap(nullptr, max_size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0)
+                    : MAP_FAILED;
+    if (map == MAP_FAILED) {
+        err = errno;
+        ::close(fd_);
+        fd_ = -1;
+        throw_clog_ex("Failed mapping file " + fname, err);
+    }
+    map_ = static_cast<char *>(map);
+
+    // preallocated file left by a crash - skip the unused zero filled tail
+    if (opened_size_ == max_size_) {
+        while (tail_ > 0 && map_[tail_ - 1] == '\0') {
+            --tail_;
+        }
+        synced_ = tail_;
+    }
+}
+
+// unmap and truncate the file to the bytes actually written.
+template <typename Mutex>
+inline void mmap_rotating_file_sink<Mutex>::close_() {
+    if (fd_ == -1) {
+        return;
+    }
+    if (map_ != nullptr) {
+        ::munmap(map_, max_size_);
+        map_ = nullptr;
+    }
+    // a file found larger than max_size_ is left as is
+    auto real_size = opened_size_ > max_size_ ? opened_size_ : tail_;
+    int rv = ::ftruncate(fd_, static_cast<off_t>(real_size));
+    auto err = errno;
+    ::close(fd_);
+    fd_ = -1;
+    if (rv != 0) {
+        throw_clog_ex("Failed truncating file " + details::os::filename_to_str(base_filename_), err);
+    }
+}
+
+// Rotate files:
+// log.txt -> log.1.txt
+// log.1.txt -> log.2.txt
+// log.2.txt -> log.3.txt
+// log.3.txt -> delete
+template <typename Mutex>
+inline void mmap_rotating_file_sink<Mutex>::rotate_() {
+    using details::os::filename_to_str;
+    using details::os::path_exists;
+
+    close_();
+    for (auto i = max_files_; i > 0; --i) {
+        filename_t src = rotating_file_sink_st::calc_filename(base_filename_, i - 1);
+        if (!path_exists(src)) {
+            continue;
+        }
+        filename_t target = rotating_file_sink_st::calc_filename(base_filename_, i);
+        if (!rename_file_(src, target)) {
+            // if failed try again after a small delay (see rotating_file_sink).
+            details::os::sleep_for_millis(100);
+            if (!rename_file_(src, target)) {
+                // truncate the log file anyway to prevent it to grow beyond its limit!
+                (void)details::os::remove(base_filename_);
+                open_();
+                throw_clog_ex("mmap_rotating_file_sink: failed renaming " + filename_to_str(src) +
+                                  " to " + filename_to_str(target),
+                              errno);
+            }
+        }
+    }
+    if (max_files_ == 0) {
+        (void)details::os::remove(base_filename_);
+    }
+    open_();
+}
+
+// delete the target if exists, and rename the src file  to target
+// return true on success, false otherwise.
+template <typename Mutex>
+inline bool mmap_rotating_file_sink<Mutex>::rename_file_(const filename_t &src_filename,
+                                                         const filename_t &target_filename) {
+    // try to delete the target file in case it already exists.
+    (void)details::os::remove(target_filename);
+    return details::os::rename(src_filename, target_filename) == 0;
+}
+
+}  // namespace sinks
+}  // namespace collie::log
@@ -0,0 +1,114 @@
+//
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+
+#pragma once
+
+#include <collie/log/details/null_mutex.h>
+#include <collie/log/details/synchronous_factory.h>
+#include <collie/log/sinks/base_sink.h>
+
+#include <mutex>
+#include <string>
+
+namespace collie::log {
+    namespace sinks {
+        //
+        // Rotating file sink based on size, writing through a memory mapping (posix only).
+        // Each file is preallocated to max_size and mapped, messages are copied into
+        // the mapping - no stdio buffer and no write syscall per message.
+        // flush() schedules the write back of the dirty pages (msync MS_ASYNC), so a
+        // periodic flush (collie::log::flush_every) bounds the amount of unsynced data.
+        // The file is truncated to its real size when rotated or closed. After a crash
+        // the tail of the last file is zero filled up to max_size, the zeros are
+        // skipped when the file is opened again.
+        // A message longer than max_size is cut at max_size.
+        //
+        template<typename Mutex>
+        class mmap_rotating_file_sink final : public base_sink<Mutex> {
+        public:
+            mmap_rotating_file_sink(filename_t base_filename,
+                                    std::size_t max_size,
+                                    std::size_t max_files,
+                                    bool rotate_on_open = false);
+
+            ~mmap_rotating_file_sink() override;
+
+            filename_t filename();
+
+            // bytes written to the current file
+            std::size_t current_size();
+
+            // write back the dirty pages and wait for it (msync MS_SYNC)
+            void sync();
+
+        protected:
+            void sink_it_(const details::log_msg &msg) override;
+            void sink_batch_(collie::span<const details::log_msg> msgs) override;
+            void flush_() override;
+
+        private:
+            // copy the data into the mapping, rotate when it doesn't fit.
+            void append_(const char *data, std::size_t size);
+
+            void open_();
+            void close_();
+            void rotate_();
+            bool rename_file_(const filename_t &src_filename, const filename_t &target_filename);
+
+            filename_t base_filename_;
+            std::size_t max_size_;
+            std::size_t max_files_;
+            int fd_{-1};
+            char *map_{nullptr};
+            std::size_t tail_{0};
+            // size of the file when opened, kept if larger than max_size_
+            std::size_t opened_size_{0};
+            // start of the range not passed to msync yet
+            std::size_t synced_{0};
+        };
+
+        using mmap_rotating_file_sink_mt = mmap_rotating_file_sink<std::mutex>;
+        using mmap_rotating_file_sink_st = mmap_rotating_file_sink<details::null_mutex>;
+    }  // namespace sinks
+
+//
+// factory functions
+//
+    template<typename Factory = collie::log::synchronous_factory>
+    inline std::shared_ptr<logger> mmap_rotating_logger_mt(const std::string &logger_name,
+                                                           const filename_t &filename,
+                                                           size_t max_file_size,
+                                                           size_t max_files,
+                                                           bool rotate_on_open = false) {
+        return Factory::template create<sinks::mmap_rotating_file_sink_mt>(
+                logger_name, filename, max_file_size, max_files, rotate_on_open);
+    }
+
+    template<typename Factory = collie::log::synchronous_factory>
+    inline std::shared_ptr<logger> mmap_rotating_logger_st(const std::string &logger_name,
+                                                           const filename_t &filename,
+                                                           size_t max_file_size,
+                                                           size_t max_files,
+                                                           bool rotate_on_open = false) {
+        return Factory::template create<sinks::mmap_rotating_file_sink_st>(
+                logger_name, filename, max_file_size, max_files, rotate_on_open);
+    }
+}  // namespace collie::log
+
+#include <collie/log/sinks/mmap_rotating_file_sink-inl.h>
@@ -24,6 +24,7 @@
 #include <collie/log/details/null_mutex.h>
 #include <collie/strings/fmt/format.h>
 
+#include <algorithm>
 #include <cerrno>
 #include <chrono>
 #include <ctime>
@@ -100,6 +101,37 @@ inline void rotating_file_sink<Mutex>::sink_it_(const details::log_msg &msg) {
     current_size_ = new_size;
 }
 
+// format the batch into one buffer and write it at once.
+// if a message would cross max_size_, the messages before it go to the current
+// file and the rest of the batch starts the rotated one.
+template <typename Mutex>
+inline void rotating_file_sink<Mutex>::sink_batch_(collie::span<const details::log_msg> msgs) {
+    memory_buf_t formatted;
+    for (auto &msg : msgs) {
+        if (!base_sink<Mutex>::should_log(msg.level)) {
+            continue;
+        }
+        auto msg_start = formatted.size();
+        base_sink<Mutex>::formatter_->format(msg, formatted);
+        if (current_size_ + formatted.size() > max_size_) {
+            file_helper_.write(formatted.data(), msg_start);
+            current_size_ += msg_start;
+            file_helper_.flush();
+            if (file_helper_.size() > 0) {
+                rotate_();
+                current_size_ = 0;
+            }
+            if (msg_start > 0) {
+                auto msg_size = formatted.size() - msg_start;
+                std::copy_n(formatted.data() + msg_start, msg_size, formatted.data());
+                formatted.resize(msg_size);
+            }
+        }
+    }
+    file_helper_.write(formatted);
+    current_size_ += formatted.size();
+}
+
 template <typename Mutex>
 inline void rotating_file_sink<Mutex>::flush_() {
     file_helper_.flush();
@@ -31,3 +31,11 @@ inline void collie::log::sinks::sink::set_level(level::level_enum log_level) {
 inline collie::log::level::level_enum collie::log::sinks::sink::level() const {
     return static_cast<collie::log::level::level_enum>(level_.load(std::memory_order_relaxed));
 }
+
+inline void collie::log::sinks::sink::log_batch(collie::span<const details::log_msg> msgs) {
+    for (auto &msg : msgs) {
+        if (should_log(msg.level)) {
+            log(msg);
+        }
+    }
+}
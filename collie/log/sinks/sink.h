@@ -19,6 +19,7 @@
 
 #pragma once
 
+#include <collie/container/span.h>
 #include <collie/log/details/log_msg.h>
 #include <collie/log/formatter.h>
 
@@ -29,6 +30,10 @@ class  sink {
 public:
     virtual ~sink() = default;
     virtual void log(const details::log_msg &msg) = 0;
+    // log a batch of messages (called by the async worker with everything it
+    // dequeued). messages below the sink level are skipped by the sink.
+    // the default implementation calls log() for each message.
+    virtual void log_batch(collie::span<const details::log_msg> msgs);
     virtual void flush() = 0;
     virtual void set_pattern(const std::string &pattern) = 0;
     virtual void set_formatter(std::unique_ptr<collie::log::formatter> sink_formatter) = 0;
@@ -33,6 +33,15 @@
 // #define CLOG_CLOCK_COARSE
 ///////////////////////////////////////////////////////////////////////////////
 
+///////////////////////////////////////////////////////////////////////////////
+// Uncomment to read the log time from the cpu time stamp counter, calibrated
+// against the system clock and re-anchored about once per second.
+// Cheaper than the regular clock on x86, requires an invariant tsc.
+// Takes precedence over CLOG_CLOCK_COARSE.
+//
+// #define CLOG_CLOCK_TSC
+///////////////////////////////////////////////////////////////////////////////
+
 ///////////////////////////////////////////////////////////////////////////////
 // Uncomment if source location logging is not needed.
 // This will prevent clog from using __FILE__, __LINE__ and CLOG_FUNCTION
@@ -58,6 +67,15 @@
 #define CLOG_NO_ATOMIC_LEVELS
 ///////////////////////////////////////////////////////////////////////////////
 
+///////////////////////////////////////////////////////////////////////////////
+// Uncomment to use the lock-free bounded queue (details/mpmc_lockfree_q.h) in
+// the async thread pool instead of the mutex based one.
+// It scales much better with many logging threads, producers only park when
+// the queue is full. The queue size is rounded up to the next power of two.
+//
+// #define CLOG_LOCKFREE_QUEUE
+///////////////////////////////////////////////////////////////////////////////
+
 ///////////////////////////////////////////////////////////////////////////////
 // Uncomment to enable usage of wchar_t for file names on Windows.
 //
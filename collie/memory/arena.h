@@ -0,0 +1,302 @@
+//
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#ifndef COLLIE_MEMORY_ARENA_H_
+#define COLLIE_MEMORY_ARENA_H_
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace collie {
+
+    /**
+     * @class monotonic_arena
+     * @brief Bump allocator over a chain of chunks
+     *
+     * Allocating moves a pointer forward in the current chunk; when the
+     * chunk is full a new one is chained, each one twice the size of the
+     * previous one up to max_chunk_size. Allocations larger than half a
+     * chunk get a chunk of their own, which does not waste the space left in
+     * the current one. Nothing is freed one by one: reset() frees everything
+     * at once and keeps one chunk for the next round, which makes the arena
+     * a good fit for per-request scratch data.
+     *
+     * Objects built with create() have their destructor called by reset()
+     * and by the destructor of the arena, in reverse order of creation.
+     * Memory from allocate() and allocate_array() is raw.
+     *
+     * An arena is not thread safe.
+     */
+    class monotonic_arena {
+    public:
+        static constexpr size_t kDefaultChunkSize = 4096;
+        static constexpr size_t kMaxChunkSize = size_t{1} << 20;
+
+        explicit monotonic_arena(size_t initial_chunk_size = kDefaultChunkSize,
+                                 size_t max_chunk_size = kMaxChunkSize) noexcept
+                : m_next_chunk_size((std::max)(initial_chunk_size, kMinChunkSize)),
+                  m_max_chunk_size((std::max)(max_chunk_size, m_next_chunk_size)) {}
+
+        /**
+         * Allocates from the caller's buffer first, for instance an array on
+         * the stack; the buffer is not freed by the arena.
+         */
+        monotonic_arena(void *buffer, size_t size, size_t max_chunk_size = kMaxChunkSize) noexcept
+                : monotonic_arena((std::max)(size * 2, kDefaultChunkSize), max_chunk_size) {
+            m_initial_buffer = static_cast<char *>(buffer);
+            m_initial_size = size;
+            m_cur = m_initial_buffer;
+            m_end = m_initial_buffer + size;
+        }
+
+        monotonic_arena(const monotonic_arena &) = delete;
+
+        monotonic_arena &operator=(const monotonic_arena &) = delete;
+
+        ~monotonic_arena() { release(); }
+
+        /**
+         * Returns size bytes aligned on align, which must be a power of two.
+         */
+        void *allocate(size_t size, size_t align = alignof(std::max_align_t)) {
+            assert((align & (align - 1)) == 0 && "alignment must be a power of two");
+            auto p = align_up(m_cur, align);
+            if (m_cur != nullptr && size <= static_cast<size_t>(m_end - m_cur) &&
+                p - m_cur <= static_cast<std::ptrdiff_t>(static_cast<size_t>(m_end - m_cur) - size)) {
+                m_cur = p + size;
+                return p;
+            }
+            return allocate_slow(size, align);
+        }
+
+        /// uninitialized storage for n objects of type T
+        template<class T>
+        T *allocate_array(size_t n) {
+            if (n > SIZE_MAX / sizeof(T)) {
+                throw std::bad_array_new_length();
+            }
+            return static_cast<T *>(allocate(sizeof(T) * n, alignof(T)));
+        }
+
+        /// builds a T in the arena, destroyed by reset()
+        template<class T, class... Args>
+        T *create(Args &&... args) {
+            if constexpr (std::is_trivially_destructible_v<T>) {
+                return ::new(allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+            } else {
+                auto *node = static_cast<cleanup *>(allocate(sizeof(cleanup), alignof(cleanup)));
+                auto *object = ::new(allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+                node->object = object;
+                node->destroy = [](void *p) { static_cast<T *>(p)->~T(); };
+                node->next = m_cleanups;
+                m_cleanups = node;
+                return object;
+            }
+        }
+
+        /// copies s into the arena
+        std::string_view copy(std::string_view s) {
+            if (s.empty()) {
+                return {};
+            }
+            auto *p = static_cast<char *>(allocate(s.size(), 1));
+            std::memcpy(p, s.data(), s.size());
+            return {p, s.size()};
+        }
+
+        /**
+         * Destroys the objects built by create() and rewinds the arena. The
+         * chunks are merged into one, up to max_chunk_size, so that the same
+         * workload runs in a single chunk the next time.
+         */
+        void reset() noexcept {
+            run_cleanups();
+            if (m_chunks == nullptr) {
+                m_cur = m_initial_buffer;
+                m_end = m_initial_buffer + m_initial_size;
+                return;
+            }
+            if (m_chunks->prev != nullptr) {
+                auto total = reserved();
+                free_chunks(m_chunks->prev);
+                m_chunks->prev = nullptr;
+                if (total <= m_max_chunk_size) {
+                    // keeps the last chunk if the merged one cannot be had
+                    if (auto *c = new_chunk(total, std::nothrow)) {
+                        free_chunks(m_chunks);
+                        m_chunks = c;
+                    }
+                }
+            }
+            m_cur = m_chunks->data();
+            m_end = m_cur + m_chunks->size;
+        }
+
+        /// destroys the objects built by create() and frees every chunk
+        void release() noexcept {
+            run_cleanups();
+            free_chunks(m_chunks);
+            m_chunks = nullptr;
+            m_cur = m_initial_buffer;
+            m_end = m_initial_buffer + m_initial_size;
+        }
+
+        /// bytes obtained from the system, the initial buffer excluded
+        size_t reserved() const noexcept {
+            size_t n = 0;
+            for (auto *c = m_chunks; c != nullptr; c = c->prev) {
+                n += c->size;
+            }
+            return n;
+        }
+
+    private:
+        static constexpr size_t kMinChunkSize = 256;
+
+        struct alignas(std::max_align_t) chunk {
+            chunk *prev;
+            size_t size;
+
+            char *data() noexcept { return reinterpret_cast<char *>(this + 1); }
+        };
+
+        struct cleanup {
+            cleanup *next;
+            void (*destroy)(void *);
+            void *object;
+        };
+
+        static char *align_up(char *p, size_t align) noexcept {
+            auto v = reinterpret_cast<uintptr_t>(p);
+            return p + ((align - (v & (align - 1))) & (align - 1));
+        }
+
+        void *allocate_slow(size_t size, size_t align) {
+            size_t needed = size + (align > alignof(std::max_align_t) ? align : 0);
+            if (needed > m_next_chunk_size / 2) {
+                // a chunk of its own, chained behind the current one which
+                // keeps serving the small allocations
+                auto *c = new_chunk(needed);
+                if (m_chunks != nullptr) {
+                    c->prev = m_chunks->prev;
+                    m_chunks->prev = c;
+                } else {
+                    m_chunks = c;
+                }
+                return align_up(c->data(), align);
+            }
+            auto *c = new_chunk(m_next_chunk_size);
+            c->prev = m_chunks;
+            m_chunks = c;
+            m_next_chunk_size = (std::min)(m_next_chunk_size * 2, m_max_chunk_size);
+            m_cur = c->data();
+            m_end = m_cur + c->size;
+            auto p = align_up(m_cur, align);
+            m_cur = p + size;
+            return p;
+        }
+
+        static chunk *new_chunk(size_t size) {
+            return init_chunk(::operator new(sizeof(chunk) + size), size);
+        }
+
+        static chunk *new_chunk(size_t size, const std::nothrow_t &) noexcept {
+            auto *p = ::operator new(sizeof(chunk) + size, std::nothrow);
+            return p ? init_chunk(p, size) : nullptr;
+        }
+
+        static chunk *init_chunk(void *p, size_t size) noexcept {
+            auto *c = static_cast<chunk *>(p);
+            c->prev = nullptr;
+            c->size = size;
+            return c;
+        }
+
+        static void free_chunks(chunk *c) noexcept {
+            while (c != nullptr) {
+                auto *prev = c->prev;
+                ::operator delete(c);
+                c = prev;
+            }
+        }
+
+        void run_cleanups() noexcept {
+            for (auto *node = m_cleanups; node != nullptr; node = node->next) {
+                node->destroy(node->object);
+            }
+            m_cleanups = nullptr;
+        }
+
+        char *m_cur{nullptr};
+        char *m_end{nullptr};
+        chunk *m_chunks{nullptr};
+        cleanup *m_cleanups{nullptr};
+        size_t m_next_chunk_size;
+        size_t m_max_chunk_size;
+        char *m_initial_buffer{nullptr};
+        size_t m_initial_size{0};
+    };
+
+    /**
+     * @class arena_allocator
+     * @brief Standard allocator drawing from a monotonic_arena
+     *
+     * deallocate() does nothing, the memory comes back when the arena is
+     * reset. Copies share the arena, and compare equal when they do.
+     */
+    template<class T>
+    class arena_allocator {
+    public:
+        using value_type = T;
+
+        explicit arena_allocator(monotonic_arena &arena) noexcept: m_arena(&arena) {}
+
+        template<class U>
+        arena_allocator(const arena_allocator<U> &other) noexcept : m_arena(other.arena()) {}
+
+        T *allocate(size_t n) { return m_arena->allocate_array<T>(n); }
+
+        void deallocate(T *, size_t) noexcept {}
+
+        monotonic_arena *arena() const noexcept { return m_arena; }
+
+        template<class U>
+        friend bool operator==(const arena_allocator &lhs, const arena_allocator<U> &rhs) noexcept {
+            return lhs.arena() == rhs.arena();
+        }
+
+        template<class U>
+        friend bool operator!=(const arena_allocator &lhs, const arena_allocator<U> &rhs) noexcept {
+            return lhs.arena() != rhs.arena();
+        }
+
+    private:
+        monotonic_arena *m_arena;
+    };
+
+}  // namespace collie
+
+#endif  // COLLIE_MEMORY_ARENA_H_
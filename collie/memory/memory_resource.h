@@ -0,0 +1,110 @@
+//
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#ifndef COLLIE_MEMORY_MEMORY_RESOURCE_H_
+#define COLLIE_MEMORY_MEMORY_RESOURCE_H_
+
+#include <cstddef>
+#include <memory_resource>
+#include <new>
+
+#include <collie/memory/arena.h>
+#include <collie/memory/size_class_pool.h>
+
+namespace collie {
+
+    /**
+     * @class arena_resource
+     * @brief std::pmr::memory_resource over a monotonic_arena
+     *
+     * Gives the arena to anything built on std::pmr::polymorphic_allocator,
+     * such as the std::pmr containers. Deallocating does nothing; resetting
+     * the arena frees everything at once, after the containers are gone.
+     */
+    class arena_resource : public std::pmr::memory_resource {
+    public:
+        explicit arena_resource(monotonic_arena &arena) noexcept: m_arena(&arena) {}
+
+        monotonic_arena &arena() const noexcept { return *m_arena; }
+
+    private:
+        void *do_allocate(size_t bytes, size_t alignment) override { return m_arena->allocate(bytes, alignment); }
+
+        void do_deallocate(void *, size_t, size_t) override {}
+
+        bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override { return this == &other; }
+
+        monotonic_arena *m_arena;
+    };
+
+    /**
+     * @class pool_resource
+     * @brief std::pmr::memory_resource over size_class_pool
+     *
+     * All the instances share the process-wide pool and compare equal.
+     * Over-aligned requests go to the aligned operator new.
+     */
+    class pool_resource : public std::pmr::memory_resource {
+    private:
+        void *do_allocate(size_t bytes, size_t alignment) override {
+            if (alignment > size_class_pool::kAlignment) {
+                return ::operator new(bytes, std::align_val_t(alignment));
+            }
+            return size_class_pool::allocate(bytes);
+        }
+
+        void do_deallocate(void *p, size_t bytes, size_t alignment) override {
+            if (alignment > size_class_pool::kAlignment) {
+                ::operator delete(p, std::align_val_t(alignment));
+                return;
+            }
+            size_class_pool::deallocate(p, bytes);
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override {
+            return dynamic_cast<const pool_resource *>(&other) != nullptr;
+        }
+    };
+
+    /**
+     * @class scoped_default_resource
+     * @brief Installs a resource as the std::pmr default for a scope
+     *
+     * Allocators that are default constructed, such as the AllocatorType of
+     * nlohmann::basic_json instantiated with std::pmr::polymorphic_allocator,
+     * take std::pmr::get_default_resource(). The default is process-wide:
+     * other threads allocating in the scope use the resource too.
+     */
+    class scoped_default_resource {
+    public:
+        explicit scoped_default_resource(std::pmr::memory_resource *resource) noexcept
+                : m_previous(std::pmr::set_default_resource(resource)) {}
+
+        scoped_default_resource(const scoped_default_resource &) = delete;
+
+        scoped_default_resource &operator=(const scoped_default_resource &) = delete;
+
+        ~scoped_default_resource() { std::pmr::set_default_resource(m_previous); }
+
+    private:
+        std::pmr::memory_resource *m_previous;
+    };
+
+}  // namespace collie
+
+#endif  // COLLIE_MEMORY_MEMORY_RESOURCE_H_
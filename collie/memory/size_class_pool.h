@@ -0,0 +1,344 @@
+//
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#ifndef COLLIE_MEMORY_SIZE_CLASS_POOL_H_
+#define COLLIE_MEMORY_SIZE_CLASS_POOL_H_
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace collie {
+
+    namespace memory_internal {
+
+        // 16-byte steps up to 256 bytes, then four classes per doubling
+        inline constexpr std::array<uint32_t, 28> kSizeClasses = {
+                16, 32, 48, 64, 80, 96, 112, 128, 144, 160, 176, 192, 208, 224, 240, 256,
+                320, 384, 448, 512, 640, 768, 896, 1024, 1536, 2048, 3072, 4096};
+
+        inline constexpr size_t kSpanSize = 64 * 1024;
+
+        inline size_t size_class_of(size_t size) noexcept {
+            if (size <= 256) {
+                return size == 0 ? 0 : (size - 1) / 16;
+            }
+            size_t c = 16;
+            while (kSizeClasses[c] < size) {
+                ++c;
+            }
+            return c;
+        }
+
+        // objects moved at once between a thread cache and the shared lists
+        inline constexpr uint32_t batch_size_of(size_t cls) noexcept {
+            return static_cast<uint32_t>(std::clamp<size_t>(16 * 1024 / kSizeClasses[cls], 4, 64));
+        }
+
+        struct free_object {
+            free_object *next;
+        };
+
+        struct batch {
+            free_object *head;
+            uint32_t count;
+        };
+
+        /**
+         * The lists shared by all the threads, one per size class. They are
+         * fed by the thread caches and by new spans, and are never freed:
+         * the pool keeps its memory for the life of the process.
+         */
+        class central_lists {
+        public:
+            static central_lists &instance() {
+                // leaked so that threads exiting late can still return their cache
+                static auto *lists = new central_lists();
+                return *lists;
+            }
+
+            batch pop(size_t cls) {
+                auto &list = m_lists[cls];
+                {
+                    std::lock_guard<std::mutex> lock(list.mutex);
+                    if (!list.batches.empty()) {
+                        auto b = list.batches.back();
+                        list.batches.pop_back();
+                        return b;
+                    }
+                }
+                return carve_span(cls);
+            }
+
+            void push(size_t cls, batch b) {
+                auto &list = m_lists[cls];
+                std::lock_guard<std::mutex> lock(list.mutex);
+                list.batches.push_back(b);
+            }
+
+        private:
+            struct alignas(64) list {
+                std::mutex mutex;
+                std::vector<batch> batches;
+            };
+
+            // cuts a new span into batches, keeps all but the first one
+            batch carve_span(size_t cls) {
+                const size_t size = kSizeClasses[cls];
+                const uint32_t per_batch = batch_size_of(cls);
+                const size_t count = kSpanSize / size;
+                auto *span = static_cast<char *>(::operator new(kSpanSize));
+
+                std::vector<batch> batches;
+                batches.reserve(count / per_batch + 1);
+                for (size_t i = 0; i < count; i += per_batch) {
+                    const auto n = static_cast<uint32_t>((std::min)(count - i, size_t{per_batch}));
+                    auto *head = reinterpret_cast<free_object *>(span + i * size);
+                    auto *obj = head;
+                    for (uint32_t j = 1; j < n; ++j) {
+                        auto *next = reinterpret_cast<free_object *>(span + (i + j) * size);
+                        obj->next = next;
+                        obj = next;
+                    }
+                    obj->next = nullptr;
+                    batches.push_back(batch{head, n});
+                }
+                auto first = batches.front();
+                auto &list = m_lists[cls];
+                std::lock_guard<std::mutex> lock(list.mutex);
+                list.batches.insert(list.batches.end(), batches.begin() + 1, batches.end());
+                return first;
+            }
+
+            std::array<list, kSizeClasses.size()> m_lists;
+        };
+
+        // set when the cache of the thread is destroyed; a plain bool has no
+        // destructor, so it stays readable from any other thread_local destructor
+        inline thread_local bool thread_cache_destroyed = false;
+
+        /**
+         * The free lists of one thread. Allocating and freeing only touch
+         * them; a batch is moved from or to the shared lists when a list is
+         * empty or holds two batches.
+         */
+        class thread_cache {
+        public:
+            ~thread_cache() {
+                flush();
+                thread_cache_destroyed = true;
+            }
+
+            void *allocate(size_t cls) {
+                auto &list = m_lists[cls];
+                if (list.head == nullptr) {
+                    auto b = central_lists::instance().pop(cls);
+                    list.head = b.head;
+                    list.count = b.count;
+                }
+                auto *obj = list.head;
+                list.head = obj->next;
+                --list.count;
+                return obj;
+            }
+
+            void deallocate(void *p, size_t cls) noexcept {
+                auto &list = m_lists[cls];
+                auto *obj = static_cast<free_object *>(p);
+                obj->next = list.head;
+                list.head = obj;
+                if (++list.count >= 2 * batch_size_of(cls)) {
+                    release_batch(cls);
+                }
+            }
+
+            void flush() noexcept {
+                for (size_t cls = 0; cls < m_lists.size(); ++cls) {
+                    auto &list = m_lists[cls];
+                    if (list.head != nullptr) {
+                        push_or_leak(cls, batch{list.head, list.count});
+                        list.head = nullptr;
+                        list.count = 0;
+                    }
+                }
+            }
+
+            /// the cache of the calling thread, or nullptr once it is destroyed:
+            /// the destructors of other thread_local objects may still use the pool
+            static thread_cache *local() {
+                if (thread_cache_destroyed) {
+                    return nullptr;
+                }
+                thread_local thread_cache cache;
+                return &cache;
+            }
+
+            // goes straight to the shared lists, for threads without a cache
+            static void *allocate_uncached(size_t cls) {
+                auto b = central_lists::instance().pop(cls);
+                auto *obj = b.head;
+                if (b.count > 1) {
+                    push_or_leak(cls, batch{obj->next, b.count - 1});
+                }
+                return obj;
+            }
+
+            static void deallocate_uncached(void *p, size_t cls) noexcept {
+                auto *obj = static_cast<free_object *>(p);
+                obj->next = nullptr;
+                push_or_leak(cls, batch{obj, 1});
+            }
+
+        private:
+            struct list {
+                free_object *head{nullptr};
+                uint32_t count{0};
+            };
+
+            // hands the first batch_size objects to the shared lists
+            void release_batch(size_t cls) noexcept {
+                auto &list = m_lists[cls];
+                const uint32_t n = batch_size_of(cls);
+                auto *head = list.head;
+                auto *last = head;
+                for (uint32_t i = 1; i < n; ++i) {
+                    last = last->next;
+                }
+                list.head = last->next;
+                list.count -= n;
+                last->next = nullptr;
+                push_or_leak(cls, batch{head, n});
+            }
+
+            // the memory is only lost if the shared list cannot grow
+            static void push_or_leak(size_t cls, batch b) noexcept {
+                try {
+                    central_lists::instance().push(cls, b);
+                } catch (...) {
+                }
+            }
+
+            std::array<list, kSizeClasses.size()> m_lists;
+        };
+
+    }  // namespace memory_internal
+
+    /**
+     * @class size_class_pool
+     * @brief Process-wide pool of small blocks with per-thread caches
+     *
+     * This is tf::ObjectPool generalized from one type to any size: sizes up
+     * to kMaxSize are rounded up to one of 28 size classes, and each thread
+     * allocates and frees from its own free lists, without locking. Lists
+     * are refilled from, and trimmed to, lists shared by all the threads one
+     * batch at a time; the shared lists are fed with 64 KiB spans. Larger
+     * sizes go to operator new.
+     *
+     * A block may be freed by another thread than the one that allocated
+     * it. The memory of the spans is never given back to the system, which
+     * suits the small objects that a program allocates over and over.
+     * Blocks are aligned on 16 bytes.
+     */
+    class size_class_pool {
+    public:
+        static constexpr size_t kMaxSize = memory_internal::kSizeClasses.back();
+        static constexpr size_t kAlignment = 16;
+
+        static void *allocate(size_t size) {
+            if (size > kMaxSize) {
+                return ::operator new(size);
+            }
+            const auto cls = memory_internal::size_class_of(size);
+            if (auto *cache = memory_internal::thread_cache::local()) {
+                return cache->allocate(cls);
+            }
+            return memory_internal::thread_cache::allocate_uncached(cls);
+        }
+
+        /// size must be the one given to allocate()
+        static void deallocate(void *p, size_t size) noexcept {
+            if (p == nullptr) {
+                return;
+            }
+            if (size > kMaxSize) {
+                ::operator delete(p);
+                return;
+            }
+            const auto cls = memory_internal::size_class_of(size);
+            if (auto *cache = memory_internal::thread_cache::local()) {
+                cache->deallocate(p, cls);
+            } else {
+                memory_internal::thread_cache::deallocate_uncached(p, cls);
+            }
+        }
+
+        /// the size of the block allocate(size) returns
+        static size_t block_size(size_t size) noexcept {
+            return size > kMaxSize ? size : memory_internal::kSizeClasses[memory_internal::size_class_of(size)];
+        }
+
+        /// returns the blocks cached by the calling thread to the shared lists
+        static void flush_thread_cache() noexcept {
+            if (auto *cache = memory_internal::thread_cache::local()) {
+                cache->flush();
+            }
+        }
+    };
+
+    /**
+     * @class pool_allocator
+     * @brief Stateless standard allocator over size_class_pool
+     *
+     * Node-based containers such as std::map and std::list allocate one
+     * small block per element, which is where the pool shines.
+     */
+    template<class T>
+    class pool_allocator {
+    public:
+        using value_type = T;
+
+        pool_allocator() noexcept = default;
+
+        template<class U>
+        pool_allocator(const pool_allocator<U> &) noexcept {}
+
+        T *allocate(size_t n) {
+            static_assert(alignof(T) <= size_class_pool::kAlignment,
+                          "pool_allocator cannot over-align the blocks");
+            if (n > SIZE_MAX / sizeof(T)) {
+                throw std::bad_array_new_length();
+            }
+            return static_cast<T *>(size_class_pool::allocate(n * sizeof(T)));
+        }
+
+        void deallocate(T *p, size_t n) noexcept { size_class_pool::deallocate(p, n * sizeof(T)); }
+
+        template<class U>
+        friend bool operator==(const pool_allocator &, const pool_allocator<U> &) noexcept { return true; }
+
+        template<class U>
+        friend bool operator!=(const pool_allocator &, const pool_allocator<U> &) noexcept { return false; }
+    };
+
+}  // namespace collie
+
+#endif  // COLLIE_MEMORY_SIZE_CLASS_POOL_H_
@@ -615,7 +615,7 @@ using has_erase_with_key_type = typename std::conditional <
                                 std::false_type >::type;
 
 // a naive helper to check if a type is an ordered_map (exploits the fact that
-// ordered_map inherits capacity() from std::vector)
+// ordered_map inherits capacity() from collie::ordered_hash_map)
 template <typename T>
 struct is_ordered_map
 {
@@ -24,6 +24,7 @@
 #include <string_view>
 #include <collie/strings/ascii.h>
 #include <collie/strings/inlined_string.h>
+#include <collie/strings/internal/str_simd_internal.h>
 
 namespace collie {
 
@@ -53,9 +54,7 @@ namespace collie {
         if (s->empty()) {
             return;
         }
-        for (auto &c : *s) {
-            c = collie::ascii_to_lower(c);
-        }
+        strings_internal::simd_case_convert(s->data(), s->data(), s->size(), false);
     }
 
     /**
@@ -71,11 +70,8 @@ namespace collie {
      * @param s The string to convert to lowercase.
      */
     inline std::string str_to_lower(std::string_view s) {
-        std::string result;
-        result.reserve(s.size());
-        for (auto c : s) {
-            result.append(1, collie::ascii_to_lower(c));
-        }
+        std::string result(s.size(), '\0');
+        strings_internal::simd_case_convert(s.data(), result.data(), s.size(), false);
         return result;
     }
 
@@ -96,9 +92,7 @@ namespace collie {
         if (s->empty()) {
             return;
         }
-        for (auto &c : *s) {
-            c = collie::ascii_to_upper(c);
-        }
+        strings_internal::simd_case_convert(s->data(), s->data(), s->size(), true);
     }
 
     /**
@@ -114,12 +108,9 @@ namespace collie {
      * @param s The string to convert to uppercase.
      */
     inline std::string str_to_upper(std::string_view s) {
-          std::string result;
-            result.reserve(s.size());
-            for (auto c : s) {
-                result.append(1, collie::ascii_to_upper(c));
-            }
-            return result;
+        std::string result(s.size(), '\0');
+        strings_internal::simd_case_convert(s.data(), result.data(), s.size(), true);
+        return result;
     }
 
 }  // namespace collie
@@ -20,67 +20,293 @@
 #ifndef COLLIE_STRINGS_CAT_H_
 #define COLLIE_STRINGS_CAT_H_
 
+#include <cstdint>
+#include <cstring>
+#include <functional>
 #include <string>
+#include <type_traits>
 #include <vector>
 #include <string_view>
 #include <collie/strings/fmt/format.h>
 
 namespace collie {
 
-    template <typename T>
-    std::string str_cat(const T &t) {
-        return fmt::format("{}", t);
-    }
+    namespace strings_internal {
 
-    template <typename T, typename... Args>
-    std::string str_cat(const T &t, const Args &... args) {
-        return fmt::format("{}{}", t, str_cat(args...));
-    }
+        // "00" "01" ... "99", written two digits at a time
+        inline constexpr char kTwoDigits[] =
+                "0001020304050607080910111213141516171819"
+                "2021222324252627282930313233343536373839"
+                "4041424344454647484950515253545556575859"
+                "6061626364656667686970717273747576777879"
+                "8081828384858687888990919293949596979899";
 
-    template <typename... Args>
-    std::string str_cat(const std::vector<std::string> &vec, const Args &... args) {
-        std::string result;
-        for (const auto &s : vec) {
-            result += s;
+        inline constexpr uint64_t kPowersOf10[] = {
+                0, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL,
+                100000000ULL, 1000000000ULL, 10000000000ULL, 100000000000ULL,
+                1000000000000ULL, 10000000000000ULL, 100000000000000ULL,
+                1000000000000000ULL, 10000000000000000ULL, 100000000000000000ULL,
+                1000000000000000000ULL, 10000000000000000000ULL
+        };
+
+        // number of decimal digits of n: log10 is approximated from the bit
+        // width and corrected with the table above.
+        inline int count_digits(uint64_t n) {
+#if defined(__GNUC__) || defined(__clang__)
+            int bits = 64 - __builtin_clzll(n | 1);
+#else
+            int bits = 1;
+            for (uint64_t m = n; m >>= 1;) {
+                ++bits;
+            }
+#endif
+            int t = (bits * 1233) >> 12;
+            return t + 1 - (n < kPowersOf10[t]);
         }
-        return str_cat(result, args...);
-    }
 
-    template <typename... Args>
-    std::string str_cat(const std::vector<std::string_view> &vec, const Args &... args) {
-        std::string result;
-        for (const auto &s : vec) {
-            result += s;
+        // writes the n digits of v ending at out + n.
+        inline char *write_digits(char *out, uint64_t v, int n) {
+            char *p = out + n;
+            while (v >= 100) {
+                auto i = static_cast<size_t>(v % 100) * 2;
+                v /= 100;
+                *--p = kTwoDigits[i + 1];
+                *--p = kTwoDigits[i];
+            }
+            if (v >= 10) {
+                auto i = static_cast<size_t>(v) * 2;
+                *--p = kTwoDigits[i + 1];
+                *--p = kTwoDigits[i];
+            } else {
+                *--p = static_cast<char>('0' + v);
+            }
+            return out + n;
         }
-        return str_cat(result, args...);
-    }
 
-    template <typename T>
-    std::string &str_cat_append(std::string &result, const T &t) {
-        result += fmt::format("{}", t);
-        return result;
-    }
+        // A piece of a concatenation. Each piece knows its size before it is
+        // written, so that str_cat can size the result once and write every
+        // piece in place. Pieces that refer to outside characters also tell
+        // whether those lie in a given range, so that appending a string to
+        // itself does not read from a buffer the resize has freed.
 
-    template <typename T, typename... Args>
-    std::string &str_cat_append(std::string &result, const T &t, const Args &... args) {
-        result += fmt::format("{}{}", t, str_cat(args...));
-        return result;
-    }
+        inline bool overlaps(std::string_view s, const char *begin, const char *end) {
+            std::less<const char *> less;
+            return !s.empty() && less(s.data(), end) && less(begin, s.data() + s.size());
+        }
+
+        class StringPiece {
+        public:
+            explicit StringPiece(std::string_view s) : _s(s) {}
+
+            size_t size() const { return _s.size(); }
+
+            bool overlaps(const char *begin, const char *end) const {
+                return strings_internal::overlaps(_s, begin, end);
+            }
+
+            char *write(char *out) const {
+                if (!_s.empty()) {
+                    std::memcpy(out, _s.data(), _s.size());
+                }
+                return out + _s.size();
+            }
+
+        private:
+            std::string_view _s;
+        };
+
+        class IntegerPiece {
+        public:
+            template<typename T>
+            explicit IntegerPiece(T v) {
+                if constexpr (std::is_signed_v<T>) {
+                    _negative = v < 0;
+                    // negate in unsigned arithmetic to handle the minimum value
+                    _abs = _negative ? 0 - static_cast<uint64_t>(v) : static_cast<uint64_t>(v);
+                } else {
+                    _abs = static_cast<uint64_t>(v);
+                }
+                _digits = count_digits(_abs);
+            }
+
+            size_t size() const { return static_cast<size_t>(_digits) + _negative; }
+
+            bool overlaps(const char *, const char *) const { return false; }
+
+            char *write(char *out) const {
+                if (_negative) {
+                    *out++ = '-';
+                }
+                return write_digits(out, _abs, _digits);
+            }
+
+        private:
+            uint64_t _abs;
+            int _digits;
+            bool _negative{false};
+        };
+
+        // floating-point values are formatted into a bounded buffer, large
+        // enough for the shortest round-trip form of any float or double.
+        class FloatPiece {
+        public:
+            template<typename T>
+            explicit FloatPiece(T v) {
+                auto r = fmt::format_to_n(_buf, sizeof(_buf), "{}", v);
+                _size = static_cast<size_t>(r.out - _buf);
+            }
+
+            size_t size() const { return _size; }
 
-    template <typename... Args>
-    std::string &str_cat_append(std::string &result, const std::vector<std::string> &vec, const Args &... args) {
-        for (const auto &s : vec) {
-            result += s;
+            bool overlaps(const char *, const char *) const { return false; }
+
+            char *write(char *out) const {
+                std::memcpy(out, _buf, _size);
+                return out + _size;
+            }
+
+        private:
+            char _buf[32];
+            size_t _size;
+        };
+
+        template<typename S>
+        class RangePiece {
+        public:
+            explicit RangePiece(const std::vector<S> &v) : _v(v) {
+                for (const auto &s: v) {
+                    _size += s.size();
+                }
+            }
+
+            size_t size() const { return _size; }
+
+            bool overlaps(const char *begin, const char *end) const {
+                for (const auto &s: _v) {
+                    if (strings_internal::overlaps(s, begin, end)) {
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            char *write(char *out) const {
+                for (const auto &s: _v) {
+                    out = StringPiece(s).write(out);
+                }
+                return out;
+            }
+
+        private:
+            const std::vector<S> &_v;
+            size_t _size{0};
+        };
+
+        // anything else is formatted by fmt into a string owned by the piece
+        class FormattedPiece {
+        public:
+            template<typename T>
+            explicit FormattedPiece(const T &v) : _s(fmt::format("{}", v)) {}
+
+            size_t size() const { return _s.size(); }
+
+            bool overlaps(const char *, const char *) const { return false; }
+
+            char *write(char *out) const { return StringPiece(_s).write(out); }
+
+        private:
+            std::string _s;
+        };
+
+        template<typename T>
+        auto make_piece(const T &v) {
+            using U = std::decay_t<T>;
+            if constexpr (std::is_convertible_v<const T &, std::string_view>) {
+                return StringPiece(std::string_view(v));
+            } else if constexpr (std::is_same_v<U, char>) {
+                return StringPiece(std::string_view(&v, 1));
+            } else if constexpr (std::is_same_v<U, bool>) {
+                return StringPiece(v ? std::string_view("true") : std::string_view("false"));
+            } else if constexpr (std::is_integral_v<U> && sizeof(U) <= sizeof(uint64_t)) {
+                return IntegerPiece(v);
+            } else if constexpr (std::is_same_v<U, float> || std::is_same_v<U, double>) {
+                return FloatPiece(v);
+            } else if constexpr (std::is_same_v<U, std::vector<std::string>> ||
+                                 std::is_same_v<U, std::vector<std::string_view>>) {
+                return RangePiece<typename U::value_type>(v);
+            } else {
+                return FormattedPiece(v);
+            }
         }
-        return str_cat(result, args...);
-    }
 
-    template <typename... Args>
-    std::string &str_cat_append(std::string &result, const std::vector<std::string_view> &vec, const Args &... args) {
-        for (const auto &s : vec) {
-            result += s;
+        template<typename Dest, typename = void>
+        struct has_resize_for_overwrite : std::false_type {};
+
+        template<typename Dest>
+        struct has_resize_for_overwrite<Dest, std::void_t<decltype(std::declval<Dest &>().resize_for_overwrite(0))>>
+                : std::true_type {};
+
+        template<typename Dest, typename... Pieces>
+        Dest &append_pieces(Dest &dest, const Pieces &... pieces) {
+            size_t old = dest.size();
+            size_t n = old + (pieces.size() + ... + size_t{0});
+            const char *begin = dest.data();
+            if ((pieces.overlaps(begin, begin + old) || ...)) {
+                // a piece reads from dest, which the resize may reallocate
+                std::string tail(n - old, '\0');
+                [[maybe_unused]] char *out = tail.data();
+                ((out = pieces.write(out)), ...);
+                dest.resize(n);
+                std::memcpy(dest.data() + old, tail.data(), tail.size());
+                return dest;
+            }
+            // every byte is written below, no need to initialize them
+            if constexpr (has_resize_for_overwrite<Dest>::value) {
+                dest.resize_for_overwrite(n);
+            } else {
+                dest.resize(n);
+            }
+            [[maybe_unused]] char *out = dest.data() + old;
+            ((out = pieces.write(out)), ...);
+            return dest;
         }
-        return str_cat(result, args...);
+
+    }  // namespace strings_internal
+
+    /**
+     * @brief concatenates the string representations of the arguments
+     *
+     * Strings, characters, integers and floating-point values are sized up
+     * front and written into a single buffer allocated once; other types are
+     * formatted with fmt. A std::vector of strings or string views
+     * contributes all its elements.
+     *
+     * @code
+     * auto key = collie::str_cat("user:", id, ':', 3.5);  // "user:42:3.5"
+     * @endcode
+     */
+    template<typename... Args>
+    std::string str_cat(const Args &... args) {
+        std::string result;
+        return strings_internal::append_pieces(result, strings_internal::make_piece(args)...);
+    }
+
+    /**
+     * @brief appends the string representations of the arguments to @c dest
+     *
+     * @c dest can be a std::string or any string-like buffer with size,
+     * resize and data, such as collie::InlinedString. It grows once for all
+     * the arguments and no temporary string is created, so keys can be built
+     * in a reused buffer without allocating.
+     *
+     * @code
+     * collie::InlinedString<64> key;
+     * collie::str_cat_append(key, "user:", id, ':', shard);
+     * @endcode
+     */
+    template<typename Dest, typename... Args>
+    Dest &str_cat_append(Dest &dest, const Args &... args) {
+        return strings_internal::append_pieces(dest, strings_internal::make_piece(args)...);
     }
 }  // namespace collie
 
@@ -0,0 +1,355 @@
+//
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// -----------------------------------------------------------------------------
+// File: str_simd_internal.h
+// -----------------------------------------------------------------------------
+//
+// This file declares the vectorized byte-scanning kernels behind the string
+// utilities: byte and byte-set search, substring search and ASCII case
+// conversion. Each kernel is a functor templated on the collie::simd
+// architecture and is selected at runtime with collie::simd::simd_dispatch
+// among the architectures the translation unit is compiled for (16 bytes per
+// step with SSE2/NEON, 32 with AVX2, 64 with AVX-512BW).
+//
+// Inputs shorter than one vector, and builds without any SIMD architecture,
+// use the scalar loops, which are also exposed for testing and benchmarks.
+//
+// DO NOT INCLUDE THIS FILE DIRECTLY. It is included by the string utilities.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <collie/simd/simd.h>
+
+namespace collie::strings_internal {
+
+    // byte sets larger than this are searched with a lookup table
+    inline constexpr size_t kMaxSimdSetSize = 16;
+
+    // inputs shorter than this are not worth a dispatch
+    inline constexpr size_t kMinSimdSize = 16;
+
+    // -------------------------------------------------------------------------
+    // scalar kernels
+    // -------------------------------------------------------------------------
+
+    struct ByteSet {
+        explicit ByteSet(std::string_view set) {
+            for (auto c: set) {
+                bits[static_cast<unsigned char>(c)] = true;
+            }
+        }
+
+        bool contains(char c) const { return bits[static_cast<unsigned char>(c)]; }
+
+        bool bits[256] = {};
+    };
+
+    inline size_t scalar_find_byte(const char *p, size_t n, char c) {
+        for (size_t i = 0; i < n; ++i) {
+            if (p[i] == c) {
+                return i;
+            }
+        }
+        return n;
+    }
+
+    inline size_t scalar_find_any(const char *p, size_t n, std::string_view set, bool in_set = true) {
+        ByteSet bs(set);
+        for (size_t i = 0; i < n; ++i) {
+            if (bs.contains(p[i]) == in_set) {
+                return i;
+            }
+        }
+        return n;
+    }
+
+    inline size_t scalar_rfind_any(const char *p, size_t n, std::string_view set, bool in_set = true) {
+        ByteSet bs(set);
+        for (size_t i = n; i > 0; --i) {
+            if (bs.contains(p[i - 1]) == in_set) {
+                return i - 1;
+            }
+        }
+        return n;
+    }
+
+    inline size_t scalar_find_substr(const char *p, size_t n, std::string_view needle) {
+        auto pos = std::string_view(p, n).find(needle);
+        return pos == std::string_view::npos ? n : pos;
+    }
+
+    inline void scalar_case_convert(const char *in, char *out, size_t n, bool upper) {
+        const char lo = upper ? 'a' : 'A';
+        for (size_t i = 0; i < n; ++i) {
+            auto c = in[i];
+            out[i] = static_cast<unsigned char>(c - lo) < 26 ? static_cast<char>(c ^ 0x20) : c;
+        }
+    }
+
+#ifndef COLLIE_SIMD_NO_SUPPORTED_ARCHITECTURE
+
+    // -------------------------------------------------------------------------
+    // vector kernels
+    // -------------------------------------------------------------------------
+
+    template<class Arch>
+    using byte_batch = collie::simd::batch<int8_t, Arch>;
+
+    template<class Arch>
+    inline byte_batch<Arch> load_bytes(const char *p) {
+        return byte_batch<Arch>::load_unaligned(reinterpret_cast<const int8_t *>(p));
+    }
+
+    // bit i of the result is set if byte i of v belongs to the set
+    template<class Arch>
+    inline uint64_t match_set(const byte_batch<Arch> &v, std::string_view set) {
+        auto m = (v == byte_batch<Arch>(static_cast<int8_t>(set[0])));
+        for (size_t k = 1; k < set.size(); ++k) {
+            m = m | (v == byte_batch<Arch>(static_cast<int8_t>(set[k])));
+        }
+        return m.mask();
+    }
+
+    template<class Arch>
+    inline constexpr uint64_t full_mask() {
+        constexpr size_t B = byte_batch<Arch>::size;
+        return B >= 64 ? ~uint64_t{0} : (uint64_t{1} << B) - 1;
+    }
+
+    inline size_t lowest_bit(uint64_t m) {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<size_t>(__builtin_ctzll(m));
+#else
+        size_t i = 0;
+        while ((m & 1) == 0) {
+            m >>= 1;
+            ++i;
+        }
+        return i;
+#endif
+    }
+
+    inline size_t highest_bit(uint64_t m) {
+#if defined(__GNUC__) || defined(__clang__)
+        return 63 - static_cast<size_t>(__builtin_clzll(m));
+#else
+        size_t i = 63;
+        while ((m >> i) == 0) {
+            --i;
+        }
+        return i;
+#endif
+    }
+
+    struct FindByteKernel {
+        template<class Arch>
+        size_t operator()(Arch, const char *p, size_t n, char c) const {
+            constexpr size_t B = byte_batch<Arch>::size;
+            const byte_batch<Arch> needle(static_cast<int8_t>(c));
+            size_t i = 0;
+            for (; i + B <= n; i += B) {
+                if (auto m = (load_bytes<Arch>(p + i) == needle).mask(); m) {
+                    return i + lowest_bit(m);
+                }
+            }
+            return i + scalar_find_byte(p + i, n - i, c);
+        }
+    };
+
+    // finds the first byte in (or not in) a set of at most kMaxSimdSetSize bytes
+    struct FindAnyKernel {
+        template<class Arch>
+        size_t operator()(Arch, const char *p, size_t n, std::string_view set, bool in_set) const {
+            constexpr size_t B = byte_batch<Arch>::size;
+            const uint64_t flip = in_set ? 0 : full_mask<Arch>();
+            size_t i = 0;
+            for (; i + B <= n; i += B) {
+                if (auto m = match_set<Arch>(load_bytes<Arch>(p + i), set) ^ flip; m) {
+                    return i + lowest_bit(m);
+                }
+            }
+            return i + scalar_find_any(p + i, n - i, set, in_set);
+        }
+    };
+
+    // finds the last byte in (or not in) a set of at most kMaxSimdSetSize bytes
+    struct RFindAnyKernel {
+        template<class Arch>
+        size_t operator()(Arch, const char *p, size_t n, std::string_view set, bool in_set) const {
+            constexpr size_t B = byte_batch<Arch>::size;
+            const uint64_t flip = in_set ? 0 : full_mask<Arch>();
+            size_t i = n;
+            for (; i >= B; i -= B) {
+                if (auto m = match_set<Arch>(load_bytes<Arch>(p + i - B), set) ^ flip; m) {
+                    return i - B + highest_bit(m);
+                }
+            }
+            auto r = scalar_rfind_any(p, i, set, in_set);
+            return r == i ? n : r;
+        }
+    };
+
+    // Substring search filtering the candidate positions with the first and the
+    // last byte of the needle, one vector of positions at a time, and checking
+    // the remaining bytes only where both match.
+    struct FindSubstrKernel {
+        template<class Arch>
+        size_t operator()(Arch, const char *p, size_t n, std::string_view needle) const {
+            constexpr size_t B = byte_batch<Arch>::size;
+            const size_t m = needle.size();
+            const byte_batch<Arch> first(static_cast<int8_t>(needle.front()));
+            const byte_batch<Arch> last(static_cast<int8_t>(needle.back()));
+            size_t i = 0;
+            for (; i + m - 1 + B <= n; i += B) {
+                auto bits = ((load_bytes<Arch>(p + i) == first) &
+                             (load_bytes<Arch>(p + i + m - 1) == last)).mask();
+                while (bits) {
+                    size_t j = i + lowest_bit(bits);
+                    if (m <= 2 || std::memcmp(p + j + 1, needle.data() + 1, m - 2) == 0) {
+                        return j;
+                    }
+                    bits &= bits - 1;
+                }
+            }
+            return i + scalar_find_substr(p + i, n - i, needle);
+        }
+    };
+
+    struct CaseConvertKernel {
+        template<class Arch>
+        void operator()(Arch, const char *in, char *out, size_t n, bool upper) const {
+            constexpr size_t B = byte_batch<Arch>::size;
+            // bytes >= 0x80 are negative and never in range
+            const byte_batch<Arch> lo(static_cast<int8_t>(upper ? 'a' : 'A'));
+            const byte_batch<Arch> hi(static_cast<int8_t>(upper ? 'z' : 'Z'));
+            const byte_batch<Arch> bit(static_cast<int8_t>(0x20));
+            size_t i = 0;
+            for (; i + B <= n; i += B) {
+                auto v = load_bytes<Arch>(in + i);
+                auto r = collie::simd::select((v >= lo) & (v <= hi), v ^ bit, v);
+                r.store_unaligned(reinterpret_cast<int8_t *>(out + i));
+            }
+            scalar_case_convert(in + i, out + i, n - i, upper);
+        }
+    };
+
+#endif  // COLLIE_SIMD_NO_SUPPORTED_ARCHITECTURE
+
+    // -------------------------------------------------------------------------
+    // dispatching entry points, returning n when nothing is found
+    // -------------------------------------------------------------------------
+
+    inline size_t simd_find_byte(const char *p, size_t n, char c) {
+#ifndef COLLIE_SIMD_NO_SUPPORTED_ARCHITECTURE
+        if (n >= kMinSimdSize) {
+            return collie::simd::simd_dispatch(FindByteKernel{})(p, n, c);
+        }
+#endif
+        return scalar_find_byte(p, n, c);
+    }
+
+    inline size_t simd_find_any(const char *p, size_t n, std::string_view set, bool in_set = true) {
+        if (set.empty()) {
+            return in_set || n == 0 ? n : 0;
+        }
+        if (set.size() == 1 && in_set) {
+            return simd_find_byte(p, n, set[0]);
+        }
+#ifndef COLLIE_SIMD_NO_SUPPORTED_ARCHITECTURE
+        if (n >= kMinSimdSize && set.size() <= kMaxSimdSetSize) {
+            return collie::simd::simd_dispatch(FindAnyKernel{})(p, n, set, in_set);
+        }
+#endif
+        return scalar_find_any(p, n, set, in_set);
+    }
+
+    inline size_t simd_rfind_any(const char *p, size_t n, std::string_view set, bool in_set = true) {
+        if (set.empty()) {
+            return in_set || n == 0 ? n : n - 1;
+        }
+#ifndef COLLIE_SIMD_NO_SUPPORTED_ARCHITECTURE
+        if (n >= kMinSimdSize && set.size() <= kMaxSimdSetSize) {
+            return collie::simd::simd_dispatch(RFindAnyKernel{})(p, n, set, in_set);
+        }
+#endif
+        return scalar_rfind_any(p, n, set, in_set);
+    }
+
+    inline size_t simd_find_substr(const char *p, size_t n, std::string_view needle) {
+        if (needle.empty()) {
+            return 0;
+        }
+        if (needle.size() > n) {
+            return n;
+        }
+        if (needle.size() == 1) {
+            return simd_find_byte(p, n, needle[0]);
+        }
+#ifndef COLLIE_SIMD_NO_SUPPORTED_ARCHITECTURE
+        if (n >= kMinSimdSize) {
+            return collie::simd::simd_dispatch(FindSubstrKernel{})(p, n, needle);
+        }
+#endif
+        return scalar_find_substr(p, n, needle);
+    }
+
+    inline void simd_case_convert(const char *in, char *out, size_t n, bool upper) {
+#ifndef COLLIE_SIMD_NO_SUPPORTED_ARCHITECTURE
+        if (n >= kMinSimdSize) {
+            collie::simd::simd_dispatch(CaseConvertKernel{})(in, out, n, upper);
+            return;
+        }
+#endif
+        scalar_case_convert(in, out, n, upper);
+    }
+
+    // std::string_view-like wrappers, returning std::string_view::npos
+    // when nothing is found
+
+    inline size_t find_byte(std::string_view text, char c, size_t pos = 0) {
+        if (pos >= text.size()) {
+            return std::string_view::npos;
+        }
+        auto r = simd_find_byte(text.data() + pos, text.size() - pos, c);
+        return r == text.size() - pos ? std::string_view::npos : pos + r;
+    }
+
+    inline size_t find_first_of(std::string_view text, std::string_view set, size_t pos = 0) {
+        if (pos >= text.size() || set.empty()) {
+            return std::string_view::npos;
+        }
+        auto r = simd_find_any(text.data() + pos, text.size() - pos, set);
+        return r == text.size() - pos ? std::string_view::npos : pos + r;
+    }
+
+    inline size_t find_substr(std::string_view text, std::string_view needle, size_t pos = 0) {
+        if (pos > text.size()) {
+            return std::string_view::npos;
+        }
+        if (needle.empty()) {
+            return pos;
+        }
+        auto n = text.size() - pos;
+        auto r = simd_find_substr(text.data() + pos, n, needle);
+        return r == n ? std::string_view::npos : pos + r;
+    }
+
+}  // namespace collie::strings_internal
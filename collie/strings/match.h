@@ -26,6 +26,7 @@
 #include <string_view>
 #include <collie/strings/ascii.h>
 #include <collie/strings/case_conv.h>
+#include <collie/strings/internal/str_simd_internal.h>
 
 namespace collie {
 
@@ -41,14 +42,14 @@ namespace collie {
      * @param needle The substring to search for.
      * @return true if the substring is found, false otherwise.
      */
-    [[nodiscard]] constexpr bool str_contains(std::string_view haystack,
+    [[nodiscard]] inline bool str_contains(std::string_view haystack,
                             std::string_view needle) noexcept {
 
-        return haystack.find(needle, 0) != haystack.npos;
+        return strings_internal::find_substr(haystack, needle) != haystack.npos;
     }
 
-    [[nodiscard]] constexpr bool str_contains(std::string_view haystack, char needle) noexcept {
-        return haystack.find(needle) != haystack.npos;
+    [[nodiscard]] inline bool str_contains(std::string_view haystack, char needle) noexcept {
+        return strings_internal::find_byte(haystack, needle) != haystack.npos;
     }
 
     /**
@@ -20,8 +20,15 @@
 
 #include <cstdlib>
 #include <cstdint>
+#include <cerrno>
 #include <climits>
+#include <charconv>
+#include <iterator>
+#include <string>
 #include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <collie/strings/internal/str_simd_internal.h>
 
 // It's common to encode data into strings separated by special characters
 // and decode them back, but functions such as `split_string' has to modify
@@ -46,6 +53,13 @@
 // respectively. Notice that "s.field()" may not end with '\0' because
 // we don't modify input. You can copy the field to a dedicated buffer
 // or apply a function supporting length.
+//
+// split_view() yields the same fields as std::string_view in a range-for,
+// and parse_field() converts a field without needing a '\0' after it:
+//     for (std::string_view f : split_view(line, '\t', ALLOW_EMPTY_FIELD)) {
+//         double v;
+//         if (parse_field(f, &v) == 0) { ... }
+//     }
 
 namespace collie {
 
@@ -54,6 +68,120 @@ namespace collie {
         ALLOW_EMPTY_FIELD
     };
 
+    // Parse the whole of `field' as a decimal integer or a floating-point
+    // number and write it into `pv'. Returns 0 on success, -1 if `field' is
+    // not entirely a number or the value does not fit in T, in which case
+    // `pv' is left untouched.
+    // Based on std::from_chars: locale independent and reads nothing past
+    // the end of `field'. Unlike strtol/strtod, leading whitespace is not
+    // skipped and unsigned types reject a minus sign; a leading '+' is
+    // accepted.
+    template<typename T>
+    inline std::enable_if_t<std::is_arithmetic_v<T> && !std::is_same_v<T, bool>, int>
+    parse_field(std::string_view field, T *pv) {
+        const char *first = field.data();
+        const char *last = first + field.size();
+        if (first != last && *first == '+' && last - first > 1 && first[1] != '-') {
+            ++first;
+        }
+        T v;
+        std::from_chars_result r;
+        if constexpr (std::is_integral_v<T>) {
+            r = std::from_chars(first, last, v, 10);
+        } else {
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+            r = std::from_chars(first, last, v, std::chars_format::general);
+#else
+            // no floating-point from_chars, strtod needs a '\0' terminated copy
+            std::string copy(first, last);
+            char *end = nullptr;
+            errno = 0;
+            v = static_cast<T>(strtold(copy.c_str(), &end));
+            r.ptr = first + (end - copy.c_str());
+            r.ec = errno == ERANGE ? std::errc::result_out_of_range : std::errc();
+            if (end == copy.c_str()) {
+                r.ec = std::errc::invalid_argument;
+            }
+#endif
+        }
+        if (r.ec != std::errc() || r.ptr != last || first == last) {
+            return -1;
+        }
+        *pv = v;
+        return 0;
+    }
+
+    // A lazy range over the fields of `input' separated by one character,
+    // yielding std::string_view without allocating or copying. The fields
+    // are the same as StringSplitter's; `input' must outlive the range.
+    class SplitView {
+    public:
+        class iterator {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = std::string_view;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const std::string_view *;
+            using reference = std::string_view;
+
+            iterator() = default;
+
+            reference operator*() const {
+                return std::string_view(_head, static_cast<size_t>(_tail - _head));
+            }
+
+            inline iterator &operator++();
+
+            iterator operator++(int) {
+                iterator tmp = *this;
+                operator++();
+                return tmp;
+            }
+
+            friend bool operator==(const iterator &a, const iterator &b) { return a._head == b._head; }
+
+            friend bool operator!=(const iterator &a, const iterator &b) { return a._head != b._head; }
+
+        private:
+            friend class SplitView;
+
+            inline iterator(const char *begin, const char *end, char sep, EmptyFieldAction action);
+
+            inline void skip_empty();
+
+            inline void find_tail();
+
+            // _head is nullptr at the end
+            const char *_head{nullptr};
+            const char *_tail{nullptr};
+            const char *_end{nullptr};
+            char _sep{0};
+            EmptyFieldAction _empty_field_action{SKIP_EMPTY_FIELD};
+        };
+
+        using const_iterator = iterator;
+
+        SplitView(std::string_view input, char separator,
+                  EmptyFieldAction action = SKIP_EMPTY_FIELD)
+                : _input(input), _sep(separator), _empty_field_action(action) {}
+
+        iterator begin() const {
+            return iterator(_input.data(), _input.data() + _input.size(), _sep, _empty_field_action);
+        }
+
+        iterator end() const { return iterator(); }
+
+    private:
+        std::string_view _input;
+        char _sep;
+        EmptyFieldAction _empty_field_action;
+    };
+
+    inline SplitView split_view(std::string_view input, char separator,
+                                EmptyFieldAction action = SKIP_EMPTY_FIELD) {
+        return SplitView(input, separator, action);
+    }
+
     // Split a string with one character
     class StringSplitter {
     public:
@@ -89,8 +217,7 @@ namespace collie {
         inline std::string_view field_sp() const;
 
         // Cast field to specific type, and write the value into `pv'.
-        // Returns 0 on success, -1 otherwise.
-        // NOTE: If separator is a digit, casting functions always return -1.
+        // Returns 0 on success, -1 otherwise. See parse_field().
         inline int to_int8(int8_t *pv) const;
 
         inline int to_uint8(uint8_t *pv) const;
@@ -114,6 +241,9 @@ namespace collie {
     private:
         inline bool not_end(const char *p) const;
 
+        // the first separator at or after p, or the end of the input
+        inline const char *find_sep(const char *p) const;
+
         inline void init();
 
         const char *_head;
@@ -158,8 +288,7 @@ namespace collie {
         inline std::string_view field_sp() const;
 
         // Cast field to specific type, and write the value into `pv'.
-        // Returns 0 on success, -1 otherwise.
-        // NOTE: If separators contains digit, casting functions always return -1.
+        // Returns 0 on success, -1 otherwise. See parse_field().
         inline int to_int8(int8_t *pv) const;
 
         inline int to_uint8(uint8_t *pv) const;
@@ -185,6 +314,9 @@ namespace collie {
 
         inline bool not_end(const char *p) const;
 
+        // the first separator at or after p, or the end of the input
+        inline const char *find_sep(const char *p) const;
+
         inline void init();
 
         const char *_head;
@@ -286,7 +418,7 @@ namespace collie {
             if (_empty_field_action == SKIP_EMPTY_FIELD) {
                 for (; _sep == *_head && not_end(_head); ++_head) {}
             }
-            for (_tail = _head; *_tail != _sep && not_end(_tail); ++_tail) {}
+            _tail = find_sep(_head);
         } else {
             _tail = nullptr;
         }
@@ -301,7 +433,7 @@ namespace collie {
                 }
             }
             _head = _tail;
-            for (; *_tail != _sep && not_end(_tail); ++_tail) {}
+            _tail = find_sep(_tail);
         }
         return *this;
     }
@@ -332,76 +464,54 @@ namespace collie {
         return (_str_tail == nullptr) ? *p : (p != _str_tail);
     }
 
-    inline int StringSplitter::to_int8(int8_t *pv) const {
-        long v = 0;
-        if (to_long(&v) == 0 && v >= -128 && v <= 127) {
-            *pv = (int8_t) v;
-            return 0;
+    inline const char *StringSplitter::find_sep(const char *p) const {
+        // the length of a bounded input is known, scan it a vector at a time
+        if (_str_tail != nullptr) {
+            auto n = static_cast<size_t>(_str_tail - p);
+            return p + strings_internal::simd_find_byte(p, n, _sep);
         }
-        return -1;
+        for (; *p != _sep && *p; ++p) {}
+        return p;
+    }
+
+    inline int StringSplitter::to_int8(int8_t *pv) const {
+        return parse_field(field_sp(), pv);
     }
 
     inline int StringSplitter::to_uint8(uint8_t *pv) const {
-        unsigned long v = 0;
-        if (to_ulong(&v) == 0 && v <= 255) {
-            *pv = (uint8_t) v;
-            return 0;
-        }
-        return -1;
+        return parse_field(field_sp(), pv);
     }
 
     inline int StringSplitter::to_int(int *pv) const {
-        long v = 0;
-        if (to_long(&v) == 0 && v >= INT_MIN && v <= INT_MAX) {
-            *pv = (int) v;
-            return 0;
-        }
-        return -1;
+        return parse_field(field_sp(), pv);
     }
 
     inline int StringSplitter::to_uint(unsigned int *pv) const {
-        unsigned long v = 0;
-        if (to_ulong(&v) == 0 && v <= UINT_MAX) {
-            *pv = (unsigned int) v;
-            return 0;
-        }
-        return -1;
+        return parse_field(field_sp(), pv);
     }
 
     inline int StringSplitter::to_long(long *pv) const {
-        char *endptr = nullptr;
-        *pv = strtol(field(), &endptr, 10);
-        return (endptr == field() + length()) ? 0 : -1;
+        return parse_field(field_sp(), pv);
     }
 
     inline int StringSplitter::to_ulong(unsigned long *pv) const {
-        char *endptr = nullptr;
-        *pv = strtoul(field(), &endptr, 10);
-        return (endptr == field() + length()) ? 0 : -1;
+        return parse_field(field_sp(), pv);
     }
 
     inline int StringSplitter::to_longlong(long long *pv) const {
-        char *endptr = nullptr;
-        *pv = strtoll(field(), &endptr, 10);
-        return (endptr == field() + length()) ? 0 : -1;
+        return parse_field(field_sp(), pv);
     }
 
     inline int StringSplitter::to_ulonglong(unsigned long long *pv) const {
-        char *endptr = nullptr;
-        *pv = strtoull(field(), &endptr, 10);
-        return (endptr == field() + length()) ? 0 : -1;
+        return parse_field(field_sp(), pv);
     }
 
     inline int StringSplitter::to_float(float *pv) const {
-        char *endptr = nullptr;
-        *pv = strtof(field(), &endptr);
-        return (endptr == field() + length()) ? 0 : -1;
+        return parse_field(field_sp(), pv);
     }
 
     inline int StringSplitter::to_double(double *pv) const {
-        char *endptr = nullptr;
-        *pv = strtod(field(), &endptr);
-        return (endptr == field() + length()) ? 0 : -1;
+        return parse_field(field_sp(), pv);
     }
 
     inline StringMultiSplitter::StringMultiSplitter(
@@ -422,7 +532,7 @@ namespace collie {
             if (_empty_field_action == SKIP_EMPTY_FIELD) {
                 for (; is_sep(*_head) && not_end(_head); ++_head) {}
             }
-            for (_tail = _head; !is_sep(*_tail) && not_end(_tail); ++_tail) {}
+            _tail = find_sep(_head);
         } else {
             _tail = nullptr;
         }
@@ -437,7 +547,7 @@ namespace collie {
                 }
             }
             _head = _tail;
-            for (; !is_sep(*_tail) && not_end(_tail); ++_tail) {}
+            _tail = find_sep(_tail);
         }
         return *this;
     }
@@ -477,76 +587,86 @@ namespace collie {
         return (_str_tail == nullptr) ? *p : (p != _str_tail);
     }
 
-    inline int StringMultiSplitter::to_int8(int8_t *pv) const {
-        long v = 0;
-        if (to_long(&v) == 0 && v >= -128 && v <= 127) {
-            *pv = (int8_t) v;
-            return 0;
+    inline const char *StringMultiSplitter::find_sep(const char *p) const {
+        // the length of a bounded input is known, scan it a vector at a time
+        if (_str_tail != nullptr) {
+            auto n = static_cast<size_t>(_str_tail - p);
+            return p + strings_internal::simd_find_any(p, n, _seps);
         }
-        return -1;
+        for (; !is_sep(*p) && *p; ++p) {}
+        return p;
+    }
+
+    inline int StringMultiSplitter::to_int8(int8_t *pv) const {
+        return parse_field(field_sp(), pv);
     }
 
     inline int StringMultiSplitter::to_uint8(uint8_t *pv) const {
-        unsigned long v = 0;
-        if (to_ulong(&v) == 0 && v <= 255) {
-            *pv = (uint8_t) v;
-            return 0;
-        }
-        return -1;
+        return parse_field(field_sp(), pv);
     }
 
     inline int StringMultiSplitter::to_int(int *pv) const {
-        long v = 0;
-        if (to_long(&v) == 0 && v >= INT_MIN && v <= INT_MAX) {
-            *pv = (int) v;
-            return 0;
-        }
-        return -1;
+        return parse_field(field_sp(), pv);
     }
 
     inline int StringMultiSplitter::to_uint(unsigned int *pv) const {
-        unsigned long v = 0;
-        if (to_ulong(&v) == 0 && v <= UINT_MAX) {
-            *pv = (unsigned int) v;
-            return 0;
-        }
-        return -1;
+        return parse_field(field_sp(), pv);
     }
 
     inline int StringMultiSplitter::to_long(long *pv) const {
-        char *endptr = nullptr;
-        *pv = strtol(field(), &endptr, 10);
-        return (endptr == field() + length()) ? 0 : -1;
+        return parse_field(field_sp(), pv);
     }
 
     inline int StringMultiSplitter::to_ulong(unsigned long *pv) const {
-        char *endptr = nullptr;
-        *pv = strtoul(field(), &endptr, 10);
-        return (endptr == field() + length()) ? 0 : -1;
+        return parse_field(field_sp(), pv);
     }
 
     inline int StringMultiSplitter::to_longlong(long long *pv) const {
-        char *endptr = nullptr;
-        *pv = strtoll(field(), &endptr, 10);
-        return (endptr == field() + length()) ? 0 : -1;
+        return parse_field(field_sp(), pv);
     }
 
     inline int StringMultiSplitter::to_ulonglong(unsigned long long *pv) const {
-        char *endptr = nullptr;
-        *pv = strtoull(field(), &endptr, 10);
-        return (endptr == field() + length()) ? 0 : -1;
+        return parse_field(field_sp(), pv);
     }
 
     inline int StringMultiSplitter::to_float(float *pv) const {
-        char *endptr = nullptr;
-        *pv = strtof(field(), &endptr);
-        return (endptr == field() + length()) ? 0 : -1;
+        return parse_field(field_sp(), pv);
     }
 
     inline int StringMultiSplitter::to_double(double *pv) const {
-        char *endptr = nullptr;
-        *pv = strtod(field(), &endptr);
-        return (endptr == field() + length()) ? 0 : -1;
+        return parse_field(field_sp(), pv);
+    }
+
+    inline SplitView::iterator::iterator(const char *begin, const char *end,
+                                         char sep, EmptyFieldAction action)
+            : _head(begin), _tail(begin), _end(end), _sep(sep), _empty_field_action(action) {
+        skip_empty();
+        find_tail();
+    }
+
+    inline SplitView::iterator &SplitView::iterator::operator++() {
+        if (_tail != _end) {
+            ++_tail;
+            skip_empty();
+        }
+        _head = _tail;
+        find_tail();
+        return *this;
+    }
+
+    inline void SplitView::iterator::skip_empty() {
+        if (_empty_field_action == SKIP_EMPTY_FIELD) {
+            for (; _tail != _end && *_tail == _sep; ++_tail) {}
+            _head = _tail;
+        }
+    }
+
+    inline void SplitView::iterator::find_tail() {
+        if (_head == _end) {
+            _head = _tail = nullptr;
+            return;
+        }
+        _tail = _head + strings_internal::simd_find_byte(_head, static_cast<size_t>(_end - _head), _sep);
     }
 
     inline void KeyValuePairsSplitter::UpdateDelimiterPosition() {
@@ -43,6 +43,7 @@
 #include <utility>
 #include <vector>
 #include <string_view>
+#include <collie/strings/internal/str_simd_internal.h>
 #include <collie/strings/internal/str_split_internal.h>
 #include <collie/strings/trim.h>
 
@@ -555,8 +556,8 @@ namespace collie {
         // shared between the ByString and ByAnyChar delimiters. The FindPolicy
         // template parameter allows each delimiter to customize the actual find
         // function to use and the length of the found delimiter. For example, the
-        // Literal delimiter will ultimately use std::string_view::find(), and the
-        // AnyOf delimiter will use std::string_view::find_first_of().
+        // Literal delimiter will ultimately use a vectorized substring search, and
+        // the AnyOf delimiter a vectorized byte-set search.
         template<typename FindPolicy>
         inline std::string_view GenericFind(std::string_view text,
                                      std::string_view delimiter, size_t pos,
@@ -577,21 +578,21 @@ namespace collie {
             return found;
         }
 
-        // Finds using std::string_view::find(), therefore the length of the found
-        // delimiter is delimiter.length().
+        // Finds the whole delimiter, therefore the length of the found delimiter
+        // is delimiter.length().
         struct LiteralPolicy {
             size_t Find(std::string_view text, std::string_view delimiter, size_t pos) {
-                return text.find(delimiter, pos);
+                return strings_internal::find_substr(text, delimiter, pos);
             }
 
             size_t Length(std::string_view delimiter) { return delimiter.length(); }
         };
 
-        // Finds using std::string_view::find_first_of(), therefore the length of the
-        // found delimiter is 1.
+        // Finds any byte of the delimiter, therefore the length of the found
+        // delimiter is 1.
         struct AnyOfPolicy {
             size_t Find(std::string_view text, std::string_view delimiter, size_t pos) {
-                return text.find_first_of(delimiter, pos);
+                return strings_internal::find_first_of(text, delimiter, pos);
             }
 
             size_t Length(std::string_view /* delimiter */) { return 1; }
@@ -609,7 +610,7 @@ namespace collie {
         if (delimiter_.length() == 1) {
             // Much faster to call find on a single character than on an
             // std::string_view.
-            size_t found_pos = text.find(delimiter_[0], pos);
+            size_t found_pos = strings_internal::find_byte(text, delimiter_[0], pos);
             if (found_pos == std::string_view::npos)
                 return std::string_view(text.data() + text.size(), 0);
             return text.substr(found_pos, 1);
@@ -622,7 +623,7 @@ namespace collie {
     //
 
     inline std::string_view ByChar::Find(std::string_view text, size_t pos) const {
-        size_t found_pos = text.find(c_, pos);
+        size_t found_pos = strings_internal::find_byte(text, c_, pos);
         if (found_pos == std::string_view::npos)
             return std::string_view(text.data() + text.size(), 0);
         return text.substr(found_pos, 1);
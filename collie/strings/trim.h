@@ -23,6 +23,7 @@
 #include <collie/strings/ascii.h>
 #include <collie/strings/case_conv.h>
 #include <collie/strings/match.h>
+#include <collie/strings/internal/str_simd_internal.h>
 
 namespace collie {
 
@@ -43,6 +44,13 @@ namespace collie {
             return trimmer.find(c) != std::string_view::npos;
         }
 
+        /**
+         * @brief the characters to trim
+         */
+        std::string_view chars() const {
+            return trimmer;
+        }
+
     private:
         std::string_view trimmer;
     };
@@ -59,6 +67,43 @@ namespace collie {
         }
     };
 
+    namespace strings_internal {
+
+        // the bytes for which ascii_is_space() is true
+        inline constexpr std::string_view kWhiteSpaceChars = " \t\n\v\f\r";
+
+        // by_white_space and by_any_of match a plain byte set and are scanned
+        // with the vector kernels, any other predicate byte by byte.
+
+        template<typename Pred>
+        size_t trim_left_size(std::string_view str, Pred &pred) {
+            if constexpr (std::is_same_v<Pred, by_white_space>) {
+                return simd_find_any(str.data(), str.size(), kWhiteSpaceChars, false);
+            } else if constexpr (std::is_same_v<Pred, by_any_of>) {
+                return simd_find_any(str.data(), str.size(), pred.chars(), false);
+            } else {
+                auto it = std::find_if_not(str.begin(), str.end(), pred);
+                return static_cast<size_t>(it - str.begin());
+            }
+        }
+
+        // the size of str without its trailing bytes matching pred
+        template<typename Pred>
+        size_t trim_right_size(std::string_view str, Pred &pred) {
+            size_t r;
+            if constexpr (std::is_same_v<Pred, by_white_space>) {
+                r = simd_rfind_any(str.data(), str.size(), kWhiteSpaceChars, false);
+            } else if constexpr (std::is_same_v<Pred, by_any_of>) {
+                r = simd_rfind_any(str.data(), str.size(), pred.chars(), false);
+            } else {
+                auto it = std::find_if_not(str.rbegin(), str.rend(), pred);
+                return static_cast<size_t>(str.rend() - it);
+            }
+            return r == str.size() ? 0 : r + 1;
+        }
+
+    }  // namespace strings_internal
+
     /**
      * @ingroup collie_strings_trim
      * @brief trim_left() removes whitespace from the beginning of the given string.
@@ -77,8 +122,7 @@ namespace collie {
      */
     template<typename Pred = by_white_space>
     [[nodiscard]] inline std::string_view trim_left(std::string_view str, Pred pred = Pred()) {
-        auto it = std::find_if_not(str.begin(), str.end(), pred);
-        return str.substr(static_cast<size_t>(it - str.begin()));
+        return str.substr(strings_internal::trim_left_size(str, pred));
     }
 
     /**
@@ -102,8 +146,7 @@ namespace collie {
     template<typename Pred = by_white_space>
     inline void
     trim_left(std::string *str, Pred pred = Pred()) {
-        auto it = std::find_if_not(str->begin(), str->end(), pred);
-        str->erase(str->begin(), it);
+        str->erase(0, strings_internal::trim_left_size(*str, pred));
     }
 
     /**
@@ -124,8 +167,7 @@ namespace collie {
      */
     template<typename Pred = by_white_space>
     [[nodiscard]] inline std::string_view trim_right(std::string_view str, Pred pred = Pred()) {
-        auto it = std::find_if_not(str.rbegin(), str.rend(), pred);
-        return str.substr(0, static_cast<size_t>(str.rend() - it));
+        return str.substr(0, strings_internal::trim_right_size(str, pred));
     }
 
     /**
@@ -148,8 +190,7 @@ namespace collie {
      */
     template<typename Pred = by_white_space>
     inline void trim_right(std::string *str, Pred pred = Pred()) {
-        auto it = std::find_if_not(str->rbegin(), str->rend(), pred);
-        str->erase(static_cast<size_t>(str->rend() - it));
+        str->erase(strings_internal::trim_right_size(*str, pred));
     }
 
     /**
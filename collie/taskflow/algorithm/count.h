@@ -0,0 +1,101 @@
+//
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <collie/taskflow/algorithm/reduce.h>
+#include <collie/taskflow/algorithm/for_each.h>
+
+namespace collie::tf {
+
+// Function: make_count_if_task
+template <typename B, typename E, typename T, typename UOP, typename P = DefaultPartitioner>
+auto make_count_if_task(B b, E e, T& result, UOP predicate, P part = P()) {
+  return [=, &result] (Runtime& rt) mutable {
+    result = T{0};
+    make_transform_reduce_task(b, e, result, std::plus<T>{}, [&predicate](const auto& item) {
+      return predicate(item) ? T{1} : T{0};
+    }, part)(rt);
+  };
+}
+
+// Function: make_histogram_task
+template <typename B, typename E, typename H, typename F, typename P = DefaultPartitioner>
+auto make_histogram_task(B b, E e, H h, size_t num_bins, F bin, P part = P()) {
+
+  using B_t = std::decay_t<unwrap_ref_decay_t<B>>;
+  using E_t = std::decay_t<unwrap_ref_decay_t<E>>;
+  using H_t = std::decay_t<unwrap_ref_decay_t<H>>;
+
+  return [=] (Runtime& rt) mutable {
+
+    // fetch the stateful values
+    B_t beg = b;
+    E_t end = e;
+    H_t bins = h;
+
+    size_t W = rt.executor().num_workers();
+    size_t N = std::distance(beg, end);
+    size_t M = detail::num_blocks(N, W);
+
+    // each block counts into its own bins
+    std::vector<size_t> counts(M * num_bins, 0);
+
+    detail::for_each_block(rt, N, M, [&](size_t m, size_t lo, size_t hi) {
+      auto local = counts.data() + m * num_bins;
+      for(auto itr = std::next(beg, lo); lo < hi; ++lo, ++itr) {
+        if(auto k = static_cast<size_t>(bin(*itr)); k < num_bins) {
+          ++local[k];
+        }
+      }
+    }, part);
+
+    // sum up the private bins
+    detail::for_each_block(rt, num_bins, detail::num_blocks(num_bins, W), [&](size_t, size_t lo, size_t hi) {
+      for(size_t k = lo; k < hi; ++k) {
+        size_t sum = 0;
+        for(size_t m = 0; m < M; ++m) {
+          sum += counts[m * num_bins + k];
+        }
+        bins[k] = sum;
+      }
+    }, part);
+  };
+}
+
+// ----------------------------------------------------------------------------
+// count_if
+// ----------------------------------------------------------------------------
+
+// Function: count_if
+template <typename B, typename E, typename T, typename UOP, typename P>
+Task FlowBuilder::count_if(B first, E last, T& result, UOP predicate, P part) {
+  return emplace(make_count_if_task(first, last, result, predicate, part));
+}
+
+// ----------------------------------------------------------------------------
+// histogram
+// ----------------------------------------------------------------------------
+
+// Function: histogram
+template <typename B, typename E, typename H, typename F, typename P>
+Task FlowBuilder::histogram(B first, E last, H bins, size_t num_bins, F bin, P part) {
+  return emplace(make_histogram_task(first, last, bins, num_bins, bin, part));
+}
+
+}  // end of namespace collie::tf -----------------------------------------------------
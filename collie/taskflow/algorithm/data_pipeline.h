@@ -360,6 +360,29 @@ class DataPipeline {
   */
   size_t num_tokens() const noexcept;
 
+  /**
+  @brief queries the number of consecutive tokens a line carries through
+         each pipe before handing off to the next line
+  */
+  size_t batch_size() const noexcept;
+
+  /**
+  @brief sets the number of consecutive tokens a line carries through
+         each pipe before handing off to the next line
+
+  @param batch_size the number of tokens per batch (at least one)
+
+  With a batch size of @c B, the first pipe is called for up to @c B
+  consecutive tokens on the same line, and each of the following pipes is
+  called for the same tokens in order, before the line hands off.
+  Each line buffers the data of @c B tokens.
+  This amortizes the scheduling overhead of pipelines of small pipes
+  (see collie::tf::Pipeline::batch_size).
+
+  The batch size must not be changed while the pipeline is running.
+  */
+  void batch_size(size_t batch_size);
+
   /**
   @brief obtains the graph object associated with the pipeline construct
 
@@ -374,6 +397,11 @@ class DataPipeline {
 
   size_t _num_tokens;
 
+  size_t _batch_size {1};
+
+  // set when the first pipe stops in the middle of a batch
+  bool _stopped {false};
+
   std::tuple<Ps...> _pipes;
   std::array<PipeMeta, sizeof...(Ps)> _meta;
   std::vector<std::array<Line, sizeof...(Ps)>> _lines;
@@ -459,6 +487,22 @@ size_t DataPipeline<Ps...>::num_tokens() const noexcept {
   return _num_tokens;
 }
 
+// Function: batch_size
+template <typename... Ps>
+size_t DataPipeline<Ps...>::batch_size() const noexcept {
+  return _batch_size;
+}
+
+// Function: batch_size
+template <typename... Ps>
+void DataPipeline<Ps...>::batch_size(size_t batch_size) {
+  if(batch_size == 0) {
+    TF_THROW("batch size must be at least one");
+  }
+  _batch_size = batch_size;
+  _buffer.resize(num_lines() * batch_size);
+}
+
 // Function: graph
 template <typename... Ps>
 Graph& DataPipeline<Ps...>::graph() {
@@ -470,6 +514,7 @@ template <typename... Ps>
 void DataPipeline<Ps...>::reset() {
 
   _num_tokens = 0;
+  _stopped = false;
 
   for(size_t l = 0; l<num_lines(); l++) {
     _pipeflows[l]._pipe = 0;
@@ -501,6 +546,9 @@ void DataPipeline<Ps...>::reset() {
 template <typename... Ps>
 void DataPipeline<Ps...>::_on_pipe(Pipeflow& pf, Runtime&) {
 
+  // each line buffers the data of the tokens in its batch
+  auto& data = _buffer[pf._line * _batch_size + pf._batch_index].data;
+
   visit_tuple([&](auto&& pipe){
 
     using data_pipe_t = std::decay_t<decltype(pipe)>;
@@ -515,18 +563,18 @@ void DataPipeline<Ps...>::_on_pipe(Pipeflow& pf, Runtime&) {
         pipe._callable(pf);
       // [](collie::tf::Pipeflow&) -> output_t {}
       } else {
-        _buffer[pf._line].data = pipe._callable(pf);
+        data = pipe._callable(pf);
       }
     }
     // other pipes without pipeflow in the second argument
     else if constexpr (std::is_invocable_v<callable_t, std::add_lvalue_reference_t<input_t> >) {
       // [](input_t&) -> void {}, i.e., the last pipe
       if constexpr (std::is_void_v<output_t>) {
-        pipe._callable(std::get<input_t>(_buffer[pf._line].data));
+        pipe._callable(std::get<input_t>(data));
       // [](input_t&) -> output_t {}
       } else {
-        _buffer[pf._line].data = pipe._callable(
-          std::get<input_t>(_buffer[pf._line].data)
+        data = pipe._callable(
+          std::get<input_t>(data)
         );
       }
     }
@@ -534,11 +582,11 @@ void DataPipeline<Ps...>::_on_pipe(Pipeflow& pf, Runtime&) {
     else if constexpr (std::is_invocable_v<callable_t, input_t&, Pipeflow&>) {
       // [](input_t&, collie::tf::Pipeflow&) -> void {}
       if constexpr (std::is_void_v<output_t>) {
-        pipe._callable(std::get<input_t>(_buffer[pf._line].data), pf);
+        pipe._callable(std::get<input_t>(data), pf);
       // [](input_t&, collie::tf::Pipeflow&) -> output_t {}
       } else {
-        _buffer[pf._line].data = pipe._callable(
-          std::get<input_t>(_buffer[pf._line].data), pf
+        data = pipe._callable(
+          std::get<input_t>(data), pf
         );
       }
     }
@@ -578,16 +626,42 @@ void DataPipeline<Ps...>::_build() {
       );
 
       if (pf->_pipe == 0) {
-        pf->_token = _num_tokens;
-        if (pf->_stop = false, _on_pipe(*pf, rt); pf->_stop == true) {
+
+        // a previous batch was stopped in the middle
+        if (_stopped) {
+          return;
+        }
+
+        size_t b = 0;
+
+        for (; b < _batch_size; ++b) {
+          pf->_token = _num_tokens + b;
+          pf->_batch_index = b;
+          if (pf->_stop = false, _on_pipe(*pf, rt); pf->_stop == true) {
+            break;
+          }
+        }
+
+        if (b == 0) {
           // here, the pipeline is not stopped yet because other
           // lines of tasks may still be running their last stages
           return;
         }
-        ++_num_tokens;
+
+        _stopped = (b < _batch_size);
+        pf->_token = _num_tokens;
+        pf->_batch_size = b;
+        _num_tokens += b;
       }
+      // other pipes run the tokens of the batch in order
       else {
-        _on_pipe(*pf, rt);
+        size_t first = pf->_token;
+        for (size_t b = 0; b < pf->_batch_size; ++b) {
+          pf->_token = first + b;
+          pf->_batch_index = b;
+          _on_pipe(*pf, rt);
+        }
+        pf->_token = first;
       }
 
       size_t c_f = pf->_pipe;
@@ -161,6 +161,59 @@ auto make_for_each_index_task(B b, E e, S s, C c, P part = P()){
   };
 }
 
+// Function: make_for_each_index_task
+template <typename R, typename C, typename P = DefaultPartitioner>
+auto make_for_each_index_task(R r, C c, P part = P()) {
+
+  using R_t = std::decay_t<unwrap_ref_decay_t<R>>;
+
+  static_assert(is_index_range_v<R_t>, "range must be a collie::tf::IndexRange");
+
+  return [=] (Runtime& rt) mutable {
+
+    // fetch the range value
+    R_t range = r;
+
+    // nothing to be done if the range is invalid
+    if(range.is_invalid() || range.empty()) {
+      return;
+    }
+
+    // each tile is the unit of scheduling for the partitioner
+    range = range.tiled(rt.executor().num_workers());
+
+    make_for_each_index_task(size_t{0}, range.num_tiles(), size_t{1}, [&](size_t t) {
+      if constexpr(std::is_invocable_v<C&, const R_t&>) {
+        c(range.tile(t));
+      }
+      else {
+        range.tile(t).for_each(c);
+      }
+    }, part)(rt);
+  };
+}
+
+namespace detail {
+
+// Function: num_blocks
+// number of blocks of at least min_size items to split N items into,
+// at most one per worker
+inline size_t num_blocks(size_t N, size_t W, size_t min_size = 1024) {
+  return std::max(size_t{1}, std::min(W, N / min_size));
+}
+
+// Function: for_each_block
+// splits [0, N) into num_blocks contiguous blocks and calls c(b, block_beg, block_end)
+// for each of them, scheduled with the given partitioner
+template <typename C, typename P>
+void for_each_block(Runtime& rt, size_t N, size_t num_blocks, C&& c, P& part) {
+  make_for_each_index_task(size_t{0}, num_blocks, size_t{1}, [&](size_t b) {
+    c(b, b * N / num_blocks, (b + 1) * N / num_blocks);
+  }, part)(rt);
+}
+
+}  // end of namespace collie::tf::detail ---------------------------------------------
+
 // ----------------------------------------------------------------------------
 // for_each
 // ----------------------------------------------------------------------------
@@ -185,6 +238,13 @@ Task FlowBuilder::for_each_index(B beg, E end, S inc, C c, P part){
   );
 }
 
+// Function: for_each_index
+template <typename R, typename C, typename P>
+Task FlowBuilder::for_each_index(R range, C c, P part){
+  return emplace(
+    make_for_each_index_task(range, c, part)
+  );
+}
 
 }  // end of namespace collie::tf -----------------------------------------------------
 
@@ -0,0 +1,94 @@
+//
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <collie/taskflow/algorithm/sort.h>
+
+namespace collie::tf {
+
+// Function: make_merge_task
+template <typename B1, typename E1, typename B2, typename E2, typename O, typename C,
+  typename P = DefaultPartitioner
+>
+auto make_merge_task(B1 b1, E1 e1, B2 b2, E2 e2, O d, C cmp, P part = P()) {
+
+  using B1_t = std::decay_t<unwrap_ref_decay_t<B1>>;
+  using E1_t = std::decay_t<unwrap_ref_decay_t<E1>>;
+  using B2_t = std::decay_t<unwrap_ref_decay_t<B2>>;
+  using E2_t = std::decay_t<unwrap_ref_decay_t<E2>>;
+  using O_t  = std::decay_t<unwrap_ref_decay_t<O>>;
+
+  return [=] (Runtime& rt) mutable {
+
+    // fetch the stateful values
+    B1_t beg1 = b1;
+    E1_t end1 = e1;
+    B2_t beg2 = b2;
+    E2_t end2 = e2;
+    O_t  d_beg = d;
+
+    size_t W = rt.executor().num_workers();
+    size_t N1 = std::distance(beg1, end1);
+    size_t N2 = std::distance(beg2, end2);
+    size_t M = detail::num_blocks(N1 + N2, W);
+
+    // only myself - no need to spawn another graph
+    if(M == 1) {
+      launch_loop(part, [&](){
+        std::merge(beg1, end1, beg2, end2, d_beg, cmp);
+      });
+      return;
+    }
+
+    // each block writes an equal slice of the output, whose inputs are
+    // located with merge-path co-ranking
+    detail::for_each_block(rt, N1 + N2, M, [&](size_t, size_t k0, size_t k1) {
+      size_t i0 = detail::merge_path_co_rank(k0, beg1, N1, beg2, N2, cmp);
+      size_t i1 = detail::merge_path_co_rank(k1, beg1, N1, beg2, N2, cmp);
+      std::merge(
+        beg1 + i0, beg1 + i1, beg2 + (k0 - i0), beg2 + (k1 - i1), d_beg + k0, cmp
+      );
+    }, part);
+  };
+}
+
+// Function: make_merge_task
+template <typename B1, typename E1, typename B2, typename E2, typename O>
+auto make_merge_task(B1 b1, E1 e1, B2 b2, E2 e2, O d) {
+  using value_type = typename std::iterator_traits<std::decay_t<unwrap_ref_decay_t<B1>>>::value_type;
+  return make_merge_task(b1, e1, b2, e2, d, std::less<value_type>{});
+}
+
+// ----------------------------------------------------------------------------
+// merge
+// ----------------------------------------------------------------------------
+
+// Function: merge
+template <typename B1, typename E1, typename B2, typename E2, typename O, typename C, typename P>
+Task FlowBuilder::merge(B1 first1, E1 last1, B2 first2, E2 last2, O d_first, C cmp, P part) {
+  return emplace(make_merge_task(first1, last1, first2, last2, d_first, cmp, part));
+}
+
+// Function: merge
+template <typename B1, typename E1, typename B2, typename E2, typename O>
+Task FlowBuilder::merge(B1 first1, E1 last1, B2 first2, E2 last2, O d_first) {
+  return emplace(make_merge_task(first1, last1, first2, last2, d_first));
+}
+
+}  // end of namespace collie::tf -----------------------------------------------------
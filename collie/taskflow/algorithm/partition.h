@@ -0,0 +1,260 @@
+//
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <collie/taskflow/algorithm/for_each.h>
+
+namespace collie::tf {
+
+// Function: make_copy_if_task
+template <typename B, typename E, typename D, typename T, typename UOP, typename P = DefaultPartitioner>
+auto make_copy_if_task(B b, E e, D d, T& result, UOP predicate, P part = P()) {
+
+  using B_t = std::decay_t<unwrap_ref_decay_t<B>>;
+  using E_t = std::decay_t<unwrap_ref_decay_t<E>>;
+  using D_t = std::decay_t<unwrap_ref_decay_t<D>>;
+
+  return [=, &result] (Runtime& rt) mutable {
+
+    // fetch the stateful values
+    B_t beg = b;
+    E_t end = e;
+    D_t d_beg = d;
+
+    size_t W = rt.executor().num_workers();
+    size_t N = std::distance(beg, end);
+    size_t M = detail::num_blocks(N, W);
+
+    // only myself - no need to spawn another graph
+    if(M == 1) {
+      launch_loop(part, [&](){
+        result = std::copy_if(beg, end, d_beg, predicate);
+      });
+      return;
+    }
+
+    // count the selected elements of each block and scan the counts
+    // into the output offset of each block
+    std::vector<size_t> offsets(M + 1, 0);
+
+    detail::for_each_block(rt, N, M, [&](size_t m, size_t lo, size_t hi) {
+      size_t count = 0;
+      for(auto itr = std::next(beg, lo); lo < hi; ++lo, ++itr) {
+        count += static_cast<bool>(predicate(*itr));
+      }
+      offsets[m + 1] = count;
+    }, part);
+
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+    detail::for_each_block(rt, N, M, [&](size_t m, size_t lo, size_t hi) {
+      std::copy_if(
+        std::next(beg, lo), std::next(beg, hi), std::next(d_beg, offsets[m]), predicate
+      );
+    }, part);
+
+    result = std::next(d_beg, offsets[M]);
+  };
+}
+
+// Function: make_partition_task
+template <typename B, typename E, typename T, typename UOP, typename P = DefaultPartitioner>
+auto make_partition_task(B b, E e, T& result, UOP predicate, P part = P()) {
+
+  using B_t = std::decay_t<unwrap_ref_decay_t<B>>;
+  using E_t = std::decay_t<unwrap_ref_decay_t<E>>;
+  using value_type = typename std::iterator_traits<B_t>::value_type;
+
+  return [=, &result] (Runtime& rt) mutable {
+
+    // fetch the stateful values
+    B_t beg = b;
+    E_t end = e;
+
+    size_t W = rt.executor().num_workers();
+    size_t N = std::distance(beg, end);
+    size_t M = detail::num_blocks(N, W);
+
+    // only myself - no need to spawn another graph
+    if(M == 1) {
+      launch_loop(part, [&](){
+        result = std::stable_partition(beg, end, predicate);
+      });
+      return;
+    }
+
+    // number of selected elements before each block
+    std::vector<size_t> offsets(M + 1, 0);
+
+    detail::for_each_block(rt, N, M, [&](size_t m, size_t lo, size_t hi) {
+      size_t count = 0;
+      for(auto itr = std::next(beg, lo); lo < hi; ++lo, ++itr) {
+        count += static_cast<bool>(predicate(*itr));
+      }
+      offsets[m + 1] = count;
+    }, part);
+
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+    // the selected elements of block m go to [offsets[m], ...) and the others
+    // to [offsets[M] + lo - offsets[m], ...), both in their original order
+    std::vector<value_type> buffer(N);
+
+    detail::for_each_block(rt, N, M, [&](size_t m, size_t lo, size_t hi) {
+      size_t t = offsets[m];
+      size_t f = offsets[M] + lo - offsets[m];
+      for(auto itr = std::next(beg, lo); lo < hi; ++lo, ++itr) {
+        if(predicate(*itr)) {
+          buffer[t++] = std::move(*itr);
+        }
+        else {
+          buffer[f++] = std::move(*itr);
+        }
+      }
+    }, part);
+
+    detail::for_each_block(rt, N, M, [&](size_t, size_t lo, size_t hi) {
+      std::move(buffer.begin() + lo, buffer.begin() + hi, std::next(beg, lo));
+    }, part);
+
+    result = std::next(beg, offsets[M]);
+  };
+}
+
+// Function: make_unique_task
+template <typename B, typename E, typename T, typename C, typename P = DefaultPartitioner>
+auto make_unique_task(B b, E e, T& result, C equal, P part = P()) {
+
+  using B_t = std::decay_t<unwrap_ref_decay_t<B>>;
+  using E_t = std::decay_t<unwrap_ref_decay_t<E>>;
+  using value_type = typename std::iterator_traits<B_t>::value_type;
+
+  return [=, &result] (Runtime& rt) mutable {
+
+    // fetch the stateful values
+    B_t beg = b;
+    E_t end = e;
+
+    size_t W = rt.executor().num_workers();
+    size_t N = std::distance(beg, end);
+    size_t M = detail::num_blocks(N, W);
+
+    // only myself - no need to spawn another graph
+    if(M == 1) {
+      launch_loop(part, [&](){
+        result = std::unique(beg, end, equal);
+      });
+      return;
+    }
+
+    // an element is kept if it differs from its predecessor; whether the
+    // first element of each block is kept is recorded before any move
+    std::vector<size_t> offsets(M + 1, 0);
+    std::vector<char> first_kept(M, 1);
+
+    detail::for_each_block(rt, N, M, [&](size_t m, size_t lo, size_t hi) {
+      auto prev = std::next(beg, lo == 0 ? 0 : lo - 1);
+      auto itr = std::next(beg, lo);
+      size_t count = 0;
+      for(size_t i = lo; i < hi; ++i, ++itr) {
+        bool kept = (i == 0) || !equal(*prev, *itr);
+        if(i == lo) {
+          first_kept[m] = kept;
+        }
+        count += kept;
+        prev = itr;
+      }
+      offsets[m + 1] = count;
+    }, part);
+
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+    std::vector<value_type> buffer(offsets[M]);
+
+    detail::for_each_block(rt, N, M, [&](size_t m, size_t lo, size_t hi) {
+      size_t k = offsets[m];
+      auto itr = std::next(beg, lo);
+      // a kept predecessor has already moved to the buffer
+      bool prev_kept = false;
+      for(size_t i = lo; i < hi; ++i, ++itr) {
+        bool kept;
+        if(i == lo) {
+          kept = first_kept[m];
+        }
+        else {
+          kept = prev_kept ? !equal(buffer[k-1], *itr) : !equal(*std::prev(itr), *itr);
+        }
+        if(kept) {
+          buffer[k++] = std::move(*itr);
+        }
+        prev_kept = kept;
+      }
+    }, part);
+
+    detail::for_each_block(rt, offsets[M], M, [&](size_t, size_t lo, size_t hi) {
+      std::move(buffer.begin() + lo, buffer.begin() + hi, std::next(beg, lo));
+    }, part);
+
+    result = std::next(beg, offsets[M]);
+  };
+}
+
+// Function: make_unique_task
+template <typename B, typename E, typename T>
+auto make_unique_task(B b, E e, T& result) {
+  return make_unique_task(b, e, result, std::equal_to<>{});
+}
+
+// ----------------------------------------------------------------------------
+// copy_if
+// ----------------------------------------------------------------------------
+
+// Function: copy_if
+template <typename B, typename E, typename D, typename T, typename UOP, typename P>
+Task FlowBuilder::copy_if(B first, E last, D d_first, T& result, UOP predicate, P part) {
+  return emplace(make_copy_if_task(first, last, d_first, result, predicate, part));
+}
+
+// ----------------------------------------------------------------------------
+// partition
+// ----------------------------------------------------------------------------
+
+// Function: partition
+template <typename B, typename E, typename T, typename UOP, typename P>
+Task FlowBuilder::partition(B first, E last, T& result, UOP predicate, P part) {
+  return emplace(make_partition_task(first, last, result, predicate, part));
+}
+
+// ----------------------------------------------------------------------------
+// unique
+// ----------------------------------------------------------------------------
+
+// Function: unique
+template <typename B, typename E, typename T, typename C, typename P>
+Task FlowBuilder::unique(B first, E last, T& result, C equal, P part) {
+  return emplace(make_unique_task(first, last, result, equal, part));
+}
+
+// Function: unique
+template <typename B, typename E, typename T>
+Task FlowBuilder::unique(B first, E last, T& result) {
+  return emplace(make_unique_task(first, last, result));
+}
+
+}  // end of namespace collie::tf -----------------------------------------------------
@@ -156,6 +156,19 @@ class Pipeflow {
     return _token;
   }
 
+  /**
+  @brief queries the position of the present token in the batch of
+         consecutive tokens carried by its line
+
+  The position is in the range <tt>[0, batch_size)</tt> of the pipeline
+  and is always zero if the pipeline does not batch tokens.
+  Pipes that keep per-token data for each line can index it by
+  <tt>(line(), batch_index())</tt>.
+  */
+  size_t batch_index() const {
+    return _batch_index;
+  }
+
   /**
   @brief stops the pipeline scheduling
 
@@ -196,6 +209,10 @@ class Pipeflow {
   size_t _pipe;
   size_t _token;
   bool   _stop;
+
+  // Data field for batched tokens
+  size_t _batch_index {0};
+  size_t _batch_size {1};
   
   // Data field for token dependencies
   size_t _num_deferrals; 
@@ -427,7 +444,8 @@ class Pipeline {
   @private
   */
   struct Line {
-    std::atomic<size_t> join_counter;
+    // padded so that neighbouring lines and pipes do not false-share
+    alignas(TF_CACHELINE_SIZE) std::atomic<size_t> join_counter;
   };
 
   /**
@@ -500,6 +518,39 @@ class Pipeline {
   */
   size_t num_tokens() const noexcept;
 
+  /**
+  @brief queries the number of consecutive tokens a line carries through
+         each pipe before handing off to the next line
+  */
+  size_t batch_size() const noexcept;
+
+  /**
+  @brief sets the number of consecutive tokens a line carries through
+         each pipe before handing off to the next line
+
+  @param batch_size the number of tokens per batch (at least one)
+
+  By default, each line carries a single token and every token costs
+  one scheduling round-trip per pipe.
+  With a batch size of @c B, the first pipe is called for up to @c B
+  consecutive tokens on the same line, and each of the following pipes is
+  called for the same tokens in order, before the line hands off.
+  This amortizes the scheduling overhead of pipelines of small pipes.
+  Pipes that keep per-token data for each line can use
+  collie::tf::Pipeflow::batch_index to index it.
+  Stopping the pipeline in the middle of a batch stops it after the tokens
+  generated so far.
+  Token deferral is not supported with batches of more than one token.
+
+  The batch size must not be changed while the pipeline is running.
+
+  @code{.cpp}
+  collie::tf::Pipeline pl(num_lines, pipes...);
+  pl.batch_size(16);
+  @endcode
+  */
+  void batch_size(size_t batch_size);
+
   /**
   @brief obtains the graph object associated with the pipeline construct
 
@@ -515,6 +566,11 @@ class Pipeline {
 
   size_t _num_tokens;
 
+  size_t _batch_size {1};
+
+  // set when the first pipe stops in the middle of a batch
+  bool _stopped {false};
+
   std::tuple<Ps...> _pipes;
   std::array<PipeMeta, sizeof...(Ps)> _meta;
   std::vector<std::array<Line, sizeof...(Ps)>> _lines;
@@ -632,6 +688,21 @@ size_t Pipeline<Ps...>::num_tokens() const noexcept {
   return _num_tokens;
 }
 
+// Function: batch_size
+template <typename... Ps>
+size_t Pipeline<Ps...>::batch_size() const noexcept {
+  return _batch_size;
+}
+
+// Function: batch_size
+template <typename... Ps>
+void Pipeline<Ps...>::batch_size(size_t batch_size) {
+  if(batch_size == 0) {
+    TF_THROW("batch size must be at least one");
+  }
+  _batch_size = batch_size;
+}
+
 // Function: graph
 template <typename... Ps>
 Graph& Pipeline<Ps...>::graph() {
@@ -643,6 +714,7 @@ template <typename... Ps>
 void Pipeline<Ps...>::reset() {
 
   _num_tokens = 0;
+  _stopped = false;
 
   for(size_t l = 0; l<num_lines(); l++) {
     _pipeflows[l]._pipe = 0;
@@ -837,8 +909,44 @@ void Pipeline<Ps...>::_build() {
         static_cast<size_t>(_meta[pf->_pipe].type), std::memory_order_relaxed
       );
       
+      // First pipe generates up to _batch_size consecutive tokens, which
+      // carry no token dependencies
+      if (pf->_pipe == 0 && _batch_size > 1) {
+
+        // a previous batch was stopped in the middle
+        if (_stopped) {
+          return;
+        }
+
+        size_t b = 0;
+
+        for (; b < _batch_size; ++b) {
+          pf->_token = _num_tokens + b;
+          pf->_num_deferrals = 0;
+          pf->_batch_index = b;
+          if (pf->_stop = false, _on_pipe(*pf, rt); pf->_stop == true) {
+            break;
+          }
+          if (pf->_dependents.empty() == false) {
+            TF_THROW("token deferral is not supported in batched pipelines");
+          }
+        }
+
+        if (b == 0) {
+          return;
+        }
+
+        _stopped = (b < _batch_size);
+        pf->_token = _num_tokens;
+        pf->_batch_size = b;
+        _num_tokens += b;
+      }
       // First pipe does all jobs of initialization and token dependencies
-      if (pf->_pipe == 0) {
+      else if (pf->_pipe == 0) {
+
+        pf->_batch_index = 0;
+        pf->_batch_size = 1;
+
         // _ready_tokens queue is not empty
         // substitute pf with the token at the front of the queue
         if (!_ready_tokens.empty()) {
@@ -888,8 +996,15 @@ void Pipeline<Ps...>::_build() {
           _resolve_token_dependencies(*pf); 
         }
       }
+      // other pipes run the tokens of the batch in order
       else {
-        _on_pipe(*pf, rt);
+        size_t first = pf->_token;
+        for (size_t b = 0; b < pf->_batch_size; ++b) {
+          pf->_token = first + b;
+          pf->_batch_index = b;
+          _on_pipe(*pf, rt);
+        }
+        pf->_token = first;
       }
 
       size_t c_f = pf->_pipe;
@@ -1093,7 +1208,8 @@ class ScalablePipeline {
   @private
   */
   struct Line {
-    std::atomic<size_t> join_counter;
+    // padded so that neighbouring lines and pipes do not false-share
+    alignas(TF_CACHELINE_SIZE) std::atomic<size_t> join_counter;
   };
 
 
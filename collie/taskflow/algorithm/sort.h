@@ -19,6 +19,9 @@
 #pragma once
 
 #include <collie/taskflow/core/async.h>
+#include <collie/taskflow/algorithm/for_each.h>
+
+#include <cstring>
 
 namespace collie::tf::detail {
 
@@ -640,6 +643,233 @@ namespace collie::tf::detail {
         //rt.join();
     }
 
+// ----------------------------------------------------------------------------
+// radix sort
+// ----------------------------------------------------------------------------
+
+    // maps an arithmetic key to an unsigned integer of the same order
+    template<typename K>
+    auto radix_ordered_key(K k) {
+
+        static_assert(std::is_arithmetic_v<K>, "radix sort key must be arithmetic");
+
+        if constexpr (std::is_same_v<K, bool>) {
+            return static_cast<uint8_t>(k);
+        } else if constexpr (std::is_floating_point_v<K>) {
+            static_assert(sizeof(K) == 4 || sizeof(K) == 8, "radix sort supports float and double keys");
+            using U = std::conditional_t<sizeof(K) == 4, uint32_t, uint64_t>;
+            constexpr U sign = U{1} << (sizeof(U) * 8 - 1);
+            U u;
+            std::memcpy(&u, &k, sizeof(K));
+            // negative numbers are reversed, positive ones move above them
+            return (u & sign) ? static_cast<U>(~u) : static_cast<U>(u | sign);
+        } else if constexpr (std::is_signed_v<K>) {
+            using U = std::make_unsigned_t<K>;
+            return static_cast<U>(static_cast<U>(k) ^ (U{1} << (sizeof(U) * 8 - 1)));
+        } else {
+            return k;
+        }
+    }
+
+    // number of blocks to split N elements of type I into, one per worker
+    template<typename I>
+    size_t parallel_sort_blocks(size_t N, size_t W) {
+        constexpr auto cutoff = parallel_sort_cutoff<I>();
+        return std::max(size_t{1}, std::min(W, N / cutoff));
+    }
+
+    // scatters the elements of src into dst by the 8-bit digit at shift,
+    // stably, and returns false if all the elements share the same digit
+    // (in which case nothing is moved)
+    template<typename P, typename S, typename D, typename K>
+    bool parallel_radix_pass(
+            Runtime &rt, P &part, S src, D dst, size_t N, size_t num_blocks,
+            K &key, size_t shift, std::vector<size_t> &counts
+    ) {
+
+        auto block_begin = [N, num_blocks](size_t b) { return b * N / num_blocks; };
+
+        auto digit = [&key, shift](auto &item) {
+            return static_cast<size_t>((radix_ordered_key(key(item)) >> shift) & 0xff);
+        };
+
+        // per-block histograms
+        std::fill(counts.begin(), counts.end(), 0);
+        make_for_each_index_task(size_t{0}, num_blocks, size_t{1}, [&](size_t b) {
+            auto *hist = &counts[b << 8];
+            for (size_t i = block_begin(b), e = block_begin(b + 1); i < e; ++i) {
+                ++hist[digit(src[i])];
+            }
+        }, part)(rt);
+
+        // a digit shared by all the elements leaves the order as it is
+        for (size_t d = 0; d < 256; ++d) {
+            size_t total = 0;
+            for (size_t b = 0; b < num_blocks; ++b) {
+                total += counts[(b << 8) + d];
+            }
+            if (total == N) {
+                return false;
+            }
+            if (total != 0) {
+                break;
+            }
+        }
+
+        // exclusive prefix sum in digit-major, block-minor order so that
+        // each block scatters to its own slice of each bucket
+        size_t sum = 0;
+        for (size_t d = 0; d < 256; ++d) {
+            for (size_t b = 0; b < num_blocks; ++b) {
+                auto c = counts[(b << 8) + d];
+                counts[(b << 8) + d] = sum;
+                sum += c;
+            }
+        }
+
+        // scatter
+        make_for_each_index_task(size_t{0}, num_blocks, size_t{1}, [&](size_t b) {
+            auto *offset = &counts[b << 8];
+            for (size_t i = block_begin(b), e = block_begin(b + 1); i < e; ++i) {
+                dst[offset[digit(src[i])]++] = std::move(src[i]);
+            }
+        }, part)(rt);
+
+        return true;
+    }
+
+    // LSD radix sort of [beg, beg + N) by 8-bit digits of the key
+    template<typename B, typename K, typename P>
+    void parallel_radix_sort(Runtime &rt, B beg, size_t N, K &key, P &part) {
+
+        using value_type = typename std::iterator_traits<B>::value_type;
+        using key_type = decltype(radix_ordered_key(key(*beg)));
+
+        size_t W = rt.executor().num_workers();
+        size_t num_blocks = parallel_sort_blocks<B>(N, W);
+
+        std::vector<value_type> tmp(N);
+        std::vector<size_t> counts(num_blocks << 8);
+
+        bool in_tmp = false;
+
+        for (size_t shift = 0; shift < sizeof(key_type) * 8; shift += 8) {
+            bool moved = in_tmp ?
+                         parallel_radix_pass(rt, part, tmp.data(), beg, N, num_blocks, key, shift, counts) :
+                         parallel_radix_pass(rt, part, beg, tmp.data(), N, num_blocks, key, shift, counts);
+            in_tmp ^= moved;
+        }
+
+        if (in_tmp) {
+            make_for_each_index_task(size_t{0}, num_blocks, size_t{1}, [&](size_t b) {
+                std::move(tmp.data() + b * N / num_blocks, tmp.data() + (b + 1) * N / num_blocks,
+                          beg + b * N / num_blocks);
+            }, part)(rt);
+        }
+    }
+
+// ----------------------------------------------------------------------------
+// stable merge sort
+// ----------------------------------------------------------------------------
+
+    // number of elements the first k elements of the stable merge of
+    // a[0, m) and b[0, n) take from a (merge-path partitioning)
+    template<typename A, typename B, typename C>
+    size_t merge_path_co_rank(size_t k, A a, size_t m, B b, size_t n, C &cmp) {
+        size_t lo = k > n ? k - n : 0;
+        size_t hi = std::min(k, m);
+        while (lo < hi) {
+            size_t i = lo + (hi - lo) / 2;
+            // a[i] goes before b[k-i-1] if it is not greater
+            if (!cmp(b[k - i - 1], a[i])) {
+                lo = i + 1;
+            } else {
+                hi = i;
+            }
+        }
+        return lo;
+    }
+
+    // merges the adjacent sorted runs of length run of src into dst
+    template<typename P, typename S, typename D, typename C>
+    void parallel_merge_round(
+            Runtime &rt, P &part, S src, D dst, size_t N, size_t run, size_t piece, C &cmp
+    ) {
+
+        struct Job {
+            size_t lo, mid, hi;  // runs [lo, mid) and [mid, hi)
+            size_t k0, k1;       // output range [lo+k0, lo+k1)
+            size_t i0, i1;       // elements taken from the first run
+        };
+
+        std::vector<Job> jobs;
+        for (size_t lo = 0; lo < N; lo += 2 * run) {
+            size_t mid = std::min(lo + run, N);
+            size_t hi = std::min(lo + 2 * run, N);
+            for (size_t k0 = 0; k0 < hi - lo; k0 += piece) {
+                jobs.push_back(Job{lo, mid, hi, k0, std::min(hi - lo, k0 + piece), 0, 0});
+            }
+        }
+
+        // split points are searched before any element is moved
+        make_for_each_index_task(size_t{0}, jobs.size(), size_t{1}, [&](size_t j) {
+            auto &job = jobs[j];
+            auto m = job.mid - job.lo;
+            auto n = job.hi - job.mid;
+            job.i0 = merge_path_co_rank(job.k0, src + job.lo, m, src + job.mid, n, cmp);
+            job.i1 = merge_path_co_rank(job.k1, src + job.lo, m, src + job.mid, n, cmp);
+        }, part)(rt);
+
+        make_for_each_index_task(size_t{0}, jobs.size(), size_t{1}, [&](size_t j) {
+            auto &job = jobs[j];
+            auto a = src + job.lo;
+            auto b = src + job.mid;
+            std::merge(
+                    std::make_move_iterator(a + job.i0), std::make_move_iterator(a + job.i1),
+                    std::make_move_iterator(b + (job.k0 - job.i0)), std::make_move_iterator(b + (job.k1 - job.i1)),
+                    dst + job.lo + job.k0, cmp
+            );
+        }, part)(rt);
+    }
+
+    // stable merge sort of [beg, beg + N)
+    template<typename B, typename C, typename P>
+    void parallel_stable_sort(Runtime &rt, B beg, size_t N, C &cmp, P &part) {
+
+        using value_type = typename std::iterator_traits<B>::value_type;
+
+        size_t W = rt.executor().num_workers();
+        size_t num_blocks = parallel_sort_blocks<B>(N, W);
+        size_t run = (N + num_blocks - 1) / num_blocks;
+
+        // sort one run per block
+        make_for_each_index_task(size_t{0}, num_blocks, size_t{1}, [&](size_t b) {
+            std::stable_sort(beg + std::min(N, b * run), beg + std::min(N, (b + 1) * run), cmp);
+        }, part)(rt);
+
+        std::vector<value_type> tmp(N);
+        bool in_tmp = false;
+
+        // each round is split into about one merge piece per block
+        const size_t piece = run;
+
+        for (; run < N; run <<= 1) {
+            if (in_tmp) {
+                parallel_merge_round(rt, part, tmp.data(), beg, N, run, piece, cmp);
+            } else {
+                parallel_merge_round(rt, part, beg, tmp.data(), N, run, piece, cmp);
+            }
+            in_tmp = !in_tmp;
+        }
+
+        if (in_tmp) {
+            make_for_each_index_task(size_t{0}, num_blocks, size_t{1}, [&](size_t b) {
+                std::move(tmp.data() + b * N / num_blocks, tmp.data() + (b + 1) * N / num_blocks,
+                          beg + b * N / num_blocks);
+            }, part)(rt);
+        }
+    }
+
 }  // end of namespace collie::tf::detail ---------------------------------------------
 
 namespace collie::tf {
@@ -686,6 +916,70 @@ namespace collie::tf {
         return make_sort_task(beg, end, std::less<value_type>{});
     }
 
+// Function: make_radix_sort_task
+    template<typename B, typename E, typename K, typename P = DefaultPartitioner>
+    TF_FORCE_INLINE auto make_radix_sort_task(B b, E e, K key, P part = P()) {
+
+        return [b, e, key, part](Runtime &rt) mutable {
+
+            using B_t = std::decay_t<unwrap_ref_decay_t<B>>;
+            using E_t = std::decay_t<unwrap_ref_decay_t<E>>;
+
+            // fetch the iterator values
+            B_t beg = b;
+            E_t end = e;
+
+            size_t N = std::distance(beg, end);
+
+            // too small to pay for the buffer and the histograms
+            if (N <= 256) {
+                std::stable_sort(beg, end, [&key](const auto &l, const auto &r) {
+                    return detail::radix_ordered_key(key(l)) < detail::radix_ordered_key(key(r));
+                });
+                return;
+            }
+
+            detail::parallel_radix_sort(rt, beg, N, key, part);
+        };
+    }
+
+    template<typename B, typename E>
+    TF_FORCE_INLINE auto make_radix_sort_task(B beg, E end) {
+        return make_radix_sort_task(beg, end, [](const auto &item) { return item; });
+    }
+
+// Function: make_stable_sort_task
+    template<typename B, typename E, typename C, typename P = DefaultPartitioner>
+    TF_FORCE_INLINE auto make_stable_sort_task(B b, E e, C cmp, P part = P()) {
+
+        return [b, e, cmp, part](Runtime &rt) mutable {
+
+            using B_t = std::decay_t<unwrap_ref_decay_t<B>>;
+            using E_t = std::decay_t<unwrap_ref_decay_t<E>>;
+
+            // fetch the iterator values
+            B_t beg = b;
+            E_t end = e;
+
+            size_t W = rt.executor().num_workers();
+            size_t N = std::distance(beg, end);
+
+            // only myself - no need to spawn another graph
+            if (W <= 1 || N <= detail::parallel_sort_cutoff<B_t>()) {
+                std::stable_sort(beg, end, cmp);
+                return;
+            }
+
+            detail::parallel_stable_sort(rt, beg, N, cmp, part);
+        };
+    }
+
+    template<typename B, typename E>
+    TF_FORCE_INLINE auto make_stable_sort_task(B beg, E end) {
+        using value_type = std::decay_t<decltype(*std::declval<B>())>;
+        return make_stable_sort_task(beg, end, std::less<value_type>{});
+    }
+
 // ----------------------------------------------------------------------------
 // collie::tf::Taskflow::sort
 // ----------------------------------------------------------------------------
@@ -702,5 +996,28 @@ namespace collie::tf {
         return emplace(make_sort_task(beg, end));
     }
 
-}  // namespace collie::tf ------------------------------------------------------------
+// Function: radix_sort
+    template<typename B, typename E, typename K, typename P>
+    Task FlowBuilder::radix_sort(B beg, E end, K key, P part) {
+        return emplace(make_radix_sort_task(beg, end, key, part));
+    }
+
+// Function: radix_sort
+    template<typename B, typename E>
+    Task FlowBuilder::radix_sort(B beg, E end) {
+        return emplace(make_radix_sort_task(beg, end));
+    }
+
+// Function: stable_sort
+    template<typename B, typename E, typename C, typename P>
+    Task FlowBuilder::stable_sort(B beg, E end, C cmp, P part) {
+        return emplace(make_stable_sort_task(beg, end, cmp, part));
+    }
 
+// Function: stable_sort
+    template<typename B, typename E>
+    Task FlowBuilder::stable_sort(B beg, E end) {
+        return emplace(make_stable_sort_task(beg, end));
+    }
+
+}  // namespace collie::tf ------------------------------------------------------------
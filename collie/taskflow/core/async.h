@@ -36,19 +36,18 @@ namespace collie::tf {
 
         using R = std::invoke_result_t<std::decay_t<F>>;
 
-        std::packaged_task<R()> p(std::forward<F>(f));
-        auto fu{p.get_future()};
+        auto state = future_state_pool<R>.animate();
 
         auto node = node_pool.animate(
                 std::forward<P>(params), nullptr, nullptr, 0,
                 // handle
                 std::in_place_type_t<Node::Async>{},
-                [p = make_moc(std::move(p))]() mutable { p.object(); }
+                [p = AsyncPromise<R>(state), f = std::forward<F>(f)]() mutable { p(f); }
         );
 
         _schedule_async_task(node);
 
-        return fu;
+        return AsyncFuture<R>(state);
     }
 
     // Function: async
@@ -209,15 +208,14 @@ namespace collie::tf {
 
         using R = std::invoke_result_t<std::decay_t<F>>;
 
-        std::packaged_task<R()> p(std::forward<F>(func));
-        auto fu{p.get_future()};
+        auto state = future_state_pool<R>.animate();
 
         size_t num_dependents = sizeof...(tasks);
 
         AsyncTask task(node_pool.animate(
                 std::forward<P>(params), nullptr, nullptr, num_dependents,
                 std::in_place_type_t<Node::DependentAsync>{},
-                [p = make_moc(std::move(p))]() mutable { p.object(); }
+                [p = AsyncPromise<R>(state), f = std::forward<F>(func)]() mutable { p(f); }
         ));
 
         if constexpr (sizeof...(Tasks) > 0) {
@@ -228,7 +226,7 @@ namespace collie::tf {
             _schedule_async_task(task._node);
         }
 
-        return std::make_pair(std::move(task), std::move(fu));
+        return std::make_pair(std::move(task), AsyncFuture<R>(state));
     }
 
     // Function: dependent_async
@@ -249,15 +247,14 @@ namespace collie::tf {
 
         using R = std::invoke_result_t<std::decay_t<F>>;
 
-        std::packaged_task<R()> p(std::forward<F>(func));
-        auto fu{p.get_future()};
+        auto state = future_state_pool<R>.animate();
 
         size_t num_dependents = std::distance(first, last);
 
         AsyncTask task(node_pool.animate(
                 std::forward<P>(params), nullptr, nullptr, num_dependents,
                 std::in_place_type_t<Node::DependentAsync>{},
-                [p = make_moc(std::move(p))]() mutable { p.object(); }
+                [p = AsyncPromise<R>(state), f = std::forward<F>(func)]() mutable { p(f); }
         ));
 
         for (; first != last; first++) {
@@ -268,7 +265,7 @@ namespace collie::tf {
             _schedule_async_task(task._node);
         }
 
-        return std::make_pair(std::move(task), std::move(fu));
+        return std::make_pair(std::move(task), AsyncFuture<R>(state));
     }
 
     // ----------------------------------------------------------------------------
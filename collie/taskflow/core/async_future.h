@@ -0,0 +1,471 @@
+//
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <collie/taskflow/utility/object_pool.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <future>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+/**
+@file async_future.h
+@brief async future include file
+*/
+
+namespace collie::tf {
+
+    template<typename T>
+    class AsyncPromise;
+
+    template<typename T>
+    class AsyncFuture;
+
+    namespace detail {
+        template<typename T>
+        struct AsyncFutureAwaiter;
+    }
+
+    // ----------------------------------------------------------------------------
+    // FutureState
+    // ----------------------------------------------------------------------------
+
+    /**
+    @private
+
+    The state shared by an asynchronous task and its future.
+    States come from a per-type object pool, like nodes do from node_pool,
+    and are returned to the pool when both the task and the future release them.
+    */
+    template<typename T>
+    class FutureState {
+
+        template<typename U> friend class AsyncPromise;
+
+        template<typename U> friend class AsyncFuture;
+
+        template<typename U> friend struct detail::AsyncFutureAwaiter;
+
+        template<typename U, size_t S> friend class ObjectPool;
+
+        void *_object_pool_block;
+
+        constexpr static int PENDING = 0;
+        constexpr static int BRIDGED = 1;
+        constexpr static int READY = 2;
+        constexpr static int AWAITED = 3;
+
+        using value_type = std::conditional_t<std::is_void_v<T>, std::monostate,
+                std::conditional_t<std::is_reference_v<T>, std::remove_reference_t<T> *, T>
+        >;
+
+        std::atomic<int> _status{PENDING};
+        std::atomic<int> _use_count{2};
+        std::atomic<int> _num_waiters{0};
+
+        std::optional<value_type> _value;
+        std::exception_ptr _exception{nullptr};
+
+        std::mutex _mutex;
+        std::condition_variable _cv;
+
+        // promise of a std::future converted from the future before the result is ready
+        std::optional<std::promise<T>> _bridge;
+
+        // callback of a coroutine suspended on the future before the result is ready
+        void (*_callback)(void *){nullptr};
+        void *_callback_arg{nullptr};
+
+        void _complete();
+
+        bool _set_callback(void (*)(void *), void *);
+
+        void _release();
+
+        bool _is_ready() const;
+
+        void _wait();
+
+        template<typename C, typename D>
+        bool _wait_until(const std::chrono::time_point<C, D> &);
+
+        void _fulfil(std::promise<T> &);
+
+        T _get();
+    };
+
+    /**
+    @private
+    */
+    template<typename T>
+    inline ObjectPool<FutureState<T>> future_state_pool;
+
+    // Procedure: _complete
+    // publishes the result and wakes up the waiters, if any
+    template<typename T>
+    void FutureState<T>::_complete() {
+
+        switch (_status.exchange(READY)) {
+            case BRIDGED:
+                _fulfil(*_bridge);
+                break;
+
+            case AWAITED:
+                _callback(_callback_arg);
+                break;
+        }
+
+        // pairs with the increment of _num_waiters in _wait and _wait_until
+        if (_num_waiters.load() > 0) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _cv.notify_all();
+        }
+    }
+
+    // Function: _set_callback
+    // registers the callback to invoke when the result becomes ready,
+    // or returns false if the result is already ready
+    template<typename T>
+    bool FutureState<T>::_set_callback(void (*callback)(void *), void *arg) {
+        _callback = callback;
+        _callback_arg = arg;
+        int expected = PENDING;
+        return _status.compare_exchange_strong(expected, AWAITED);
+    }
+
+    // Procedure: _release
+    template<typename T>
+    void FutureState<T>::_release() {
+        if (_use_count.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            future_state_pool<T>.recycle(this);
+        }
+    }
+
+    // Function: _is_ready
+    template<typename T>
+    bool FutureState<T>::_is_ready() const {
+        return _status.load(std::memory_order_acquire) == READY;
+    }
+
+    // Procedure: _wait
+    template<typename T>
+    void FutureState<T>::_wait() {
+        if (_is_ready()) {
+            return;
+        }
+        _num_waiters.fetch_add(1);
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _cv.wait(lock, [this]() { return _status.load() == READY; });
+        }
+        _num_waiters.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    // Function: _wait_until
+    template<typename T>
+    template<typename C, typename D>
+    bool FutureState<T>::_wait_until(const std::chrono::time_point<C, D> &tp) {
+        if (_is_ready()) {
+            return true;
+        }
+        _num_waiters.fetch_add(1);
+        bool ready;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            ready = _cv.wait_until(lock, tp, [this]() { return _status.load() == READY; });
+        }
+        _num_waiters.fetch_sub(1, std::memory_order_relaxed);
+        return ready;
+    }
+
+    // Procedure: _fulfil
+    template<typename T>
+    void FutureState<T>::_fulfil(std::promise<T> &p) {
+        if (_exception) {
+            p.set_exception(_exception);
+        } else if constexpr (std::is_void_v<T>) {
+            p.set_value();
+        } else if constexpr (std::is_reference_v<T>) {
+            p.set_value(**_value);
+        } else {
+            p.set_value(std::move(*_value));
+        }
+    }
+
+    // Function: _get
+    template<typename T>
+    T FutureState<T>::_get() {
+        if (_exception) {
+            std::rethrow_exception(_exception);
+        }
+        if constexpr (std::is_void_v<T>) {
+            return;
+        } else if constexpr (std::is_reference_v<T>) {
+            return **_value;
+        } else {
+            return std::move(*_value);
+        }
+    }
+
+    // ----------------------------------------------------------------------------
+    // AsyncPromise
+    // ----------------------------------------------------------------------------
+
+    /**
+    @private
+
+    The producer side of a future state, owned by the work of an asynchronous task.
+    Like std::packaged_task, destroying the promise before it is invoked,
+    for example when the task is cancelled, stores a std::future_error with
+    std::future_errc::broken_promise to the future.
+    */
+    template<typename T>
+    class AsyncPromise {
+
+    public:
+
+        explicit AsyncPromise(FutureState<T> *state) : _state{state} {
+        }
+
+        AsyncPromise(AsyncPromise &&rhs) noexcept: _state{std::exchange(rhs._state, nullptr)} {
+        }
+
+        AsyncPromise(const AsyncPromise &) = delete;
+
+        AsyncPromise &operator=(const AsyncPromise &) = delete;
+
+        AsyncPromise &operator=(AsyncPromise &&) = delete;
+
+        ~AsyncPromise() {
+            if (_state) {
+                _state->_exception = std::make_exception_ptr(
+                        std::future_error(std::future_errc::broken_promise)
+                );
+                _finish();
+            }
+        }
+
+        // runs the callable and stores its result or exception
+        template<typename C>
+        void operator()(C &c) {
+            try {
+                if constexpr (std::is_void_v<T>) {
+                    c();
+                    _state->_value.emplace();
+                } else if constexpr (std::is_reference_v<T>) {
+                    _state->_value.emplace(std::addressof(c()));
+                } else {
+                    _state->_value.emplace(c());
+                }
+            }
+            catch (...) {
+                _state->_exception = std::current_exception();
+            }
+            _finish();
+        }
+
+    private:
+
+        FutureState<T> *_state;
+
+        void _finish() {
+            _state->_complete();
+            std::exchange(_state, nullptr)->_release();
+        }
+    };
+
+    // ----------------------------------------------------------------------------
+    // AsyncFuture
+    // ----------------------------------------------------------------------------
+
+    /**
+    @class AsyncFuture
+
+    @brief class to access the result of an asynchronous task
+
+    collie::tf::AsyncFuture is returned by collie::tf::Executor::async,
+    collie::tf::Executor::dependent_async and collie::tf::Runtime::async.
+    It provides the interface of std::future, but its shared state comes from
+    an object pool instead of the heap, so creating an asynchronous task
+    with a future does not allocate memory in the common case.
+
+    The future can be moved into a std::future, which keeps existing code
+    that stores the result of @c async in a std::future working.
+    The conversion allocates the shared state of a std::promise and thus
+    gives up the benefit of the pool.
+    Inside a collie::tf::co_task, the future can be awaited with @c co_await
+    without blocking the worker.
+
+    @code{.cpp}
+    collie::tf::AsyncFuture<int> fu = executor.async([](){ return 1; });
+    assert(fu.get() == 1);
+
+    std::future<int> std_fu = executor.async([](){ return 2; });
+    assert(std_fu.get() == 2);
+    @endcode
+    */
+    template<typename T>
+    class AsyncFuture {
+
+        friend class Executor;
+
+        friend class Runtime;
+
+        template<typename U> friend struct detail::AsyncFutureAwaiter;
+
+    public:
+
+        /**
+        @brief constructs a future with no shared state
+        */
+        AsyncFuture() = default;
+
+        /**
+        @brief move constructor
+        */
+        AsyncFuture(AsyncFuture &&rhs) noexcept: _state{std::exchange(rhs._state, nullptr)} {
+        }
+
+        /**
+        @brief move assignment
+        */
+        AsyncFuture &operator=(AsyncFuture &&rhs) noexcept {
+            if (this != &rhs) {
+                _reset();
+                _state = std::exchange(rhs._state, nullptr);
+            }
+            return *this;
+        }
+
+        /**
+        @brief disabled copy constructor
+        */
+        AsyncFuture(const AsyncFuture &) = delete;
+
+        /**
+        @brief disabled copy assignment
+        */
+        AsyncFuture &operator=(const AsyncFuture &) = delete;
+
+        /**
+        @brief destructs the future without waiting for the result
+        */
+        ~AsyncFuture() {
+            _reset();
+        }
+
+        /**
+        @brief queries if the future refers to a shared state
+        */
+        bool valid() const noexcept {
+            return _state != nullptr;
+        }
+
+        /**
+        @brief waits until the result is ready
+        */
+        void wait() const {
+            _check()->_wait();
+        }
+
+        /**
+        @brief waits until the result is ready or the given duration has elapsed
+        */
+        template<typename R, typename P>
+        std::future_status wait_for(const std::chrono::duration<R, P> &duration) const {
+            return wait_until(std::chrono::steady_clock::now() + duration);
+        }
+
+        /**
+        @brief waits until the result is ready or the given time point is reached
+        */
+        template<typename C, typename D>
+        std::future_status wait_until(const std::chrono::time_point<C, D> &tp) const {
+            return _check()->_wait_until(tp) ? std::future_status::ready : std::future_status::timeout;
+        }
+
+        /**
+        @brief waits for the result and returns it, rethrowing the exception
+               of the task, if any
+
+        After the call, the future no longer refers to the shared state.
+        */
+        T get() {
+            _check()->_wait();
+            FutureGuard guard{std::exchange(_state, nullptr)};
+            return guard.state->_get();
+        }
+
+        /**
+        @brief moves the future into a std::future
+        */
+        operator std::future<T>() &&{
+
+            FutureState<T> *s = _check();
+            _state = nullptr;
+
+            s->_bridge.emplace();
+            auto fu = s->_bridge->get_future();
+
+            // the task fulfils the promise if it has not completed yet
+            int expected = FutureState<T>::PENDING;
+            if (!s->_status.compare_exchange_strong(expected, FutureState<T>::BRIDGED)) {
+                s->_fulfil(*s->_bridge);
+            }
+
+            s->_release();
+
+            return fu;
+        }
+
+    private:
+
+        struct FutureGuard {
+            FutureState<T> *state;
+
+            ~FutureGuard() { state->_release(); }
+        };
+
+        FutureState<T> *_state{nullptr};
+
+        explicit AsyncFuture(FutureState<T> *state) : _state{state} {
+        }
+
+        FutureState<T> *_check() const {
+            if (_state == nullptr) {
+                throw std::future_error(std::future_errc::no_state);
+            }
+            return _state;
+        }
+
+        void _reset() {
+            if (_state) {
+                std::exchange(_state, nullptr)->_release();
+            }
+        }
+    };
+
+}  // end of namespace collie::tf -----------------------------------------------------
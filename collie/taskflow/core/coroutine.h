@@ -0,0 +1,440 @@
+//
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <collie/taskflow/core/executor.h>
+
+#if TF_HAS_COROUTINE
+
+#include <coroutine>
+
+/**
+@file coroutine.h
+@brief coroutine task include file
+*/
+
+namespace collie::tf {
+
+    namespace detail {
+
+        // ----------------------------------------------------------------------------
+        // CoroutinePromiseBase
+        // ----------------------------------------------------------------------------
+
+        // state common to the promises of all coroutine tasks
+        struct CoroutinePromiseBase {
+
+            // executor the coroutine runs on, inherited from the awaiting coroutine
+            Executor *executor{nullptr};
+
+            // coroutine to transfer to when this one finishes
+            std::coroutine_handle<> continuation{nullptr};
+
+            std::exception_ptr exception{nullptr};
+
+            std::suspend_always initial_suspend() noexcept {
+                return {};
+            }
+
+            void unhandled_exception() noexcept {
+                exception = std::current_exception();
+            }
+
+            // resumes the given coroutine from the task queue of the caller worker
+            void schedule(std::coroutine_handle<> h) {
+                executor->_schedule_coroutine([h]() { h.resume(); });
+            }
+        };
+
+        // ----------------------------------------------------------------------------
+        // CoroutineResult
+        // ----------------------------------------------------------------------------
+
+        // storage of the result, as a promise can have either return_value or return_void
+        template<typename T>
+        struct CoroutineResult : CoroutinePromiseBase {
+
+            std::optional<T> value;
+
+            template<typename U>
+            void return_value(U &&v) {
+                value.emplace(std::forward<U>(v));
+            }
+
+            T result() {
+                if (exception) {
+                    std::rethrow_exception(exception);
+                }
+                return std::move(*value);
+            }
+        };
+
+        template<>
+        struct CoroutineResult<void> : CoroutinePromiseBase {
+
+            void return_void() noexcept {
+            }
+
+            void result() {
+                if (exception) {
+                    std::rethrow_exception(exception);
+                }
+            }
+        };
+
+        // ----------------------------------------------------------------------------
+        // CoroutinePromise
+        // ----------------------------------------------------------------------------
+
+        template<typename T>
+        struct CoroutinePromise : CoroutineResult<T> {
+
+            static_assert(!std::is_reference_v<T>, "co_task cannot return a reference");
+
+            struct FinalAwaiter {
+
+                bool await_ready() noexcept {
+                    return false;
+                }
+
+                std::coroutine_handle<> await_suspend(std::coroutine_handle<CoroutinePromise> h) noexcept {
+
+                    auto &p = h.promise();
+
+                    // awaited by another coroutine: resume it on this worker
+                    if (p.continuation) {
+                        return p.continuation;
+                    }
+
+                    // launched by Executor::co_run: publish the result and free the frame
+                    if (p.root) {
+                        auto result = [&p]() -> T { return p.result(); };
+                        (*p.root)(result);
+                        h.destroy();
+                    }
+
+                    return std::noop_coroutine();
+                }
+
+                void await_resume() noexcept {
+                }
+            };
+
+            // producer of the future returned by Executor::co_run
+            std::optional<AsyncPromise<T>> root;
+
+            co_task<T> get_return_object() noexcept;
+
+            FinalAwaiter final_suspend() noexcept {
+                return {};
+            }
+        };
+
+        // ----------------------------------------------------------------------------
+        // AsyncFutureAwaiter
+        // ----------------------------------------------------------------------------
+
+        // suspends the awaiting coroutine until the future becomes ready, after
+        // which the producer of the future schedules its resumption
+        template<typename T>
+        struct AsyncFutureAwaiter {
+
+            AsyncFuture<T> &future;
+
+            CoroutinePromiseBase *promise{nullptr};
+
+            std::coroutine_handle<> handle{nullptr};
+
+            bool await_ready() const {
+                return future._check()->_is_ready();
+            }
+
+            template<typename P>
+            bool await_suspend(std::coroutine_handle<P> h) {
+                static_assert(std::is_base_of_v<CoroutinePromiseBase, P>,
+                              "collie::tf::AsyncFuture can only be awaited by a collie::tf::co_task");
+                promise = &h.promise();
+                handle = h;
+                return future._state->_set_callback(&AsyncFutureAwaiter::_on_ready, this);
+            }
+
+            T await_resume() {
+                return future.get();
+            }
+
+            static void _on_ready(void *arg) {
+                auto awaiter = static_cast<AsyncFutureAwaiter *>(arg);
+                awaiter->promise->schedule(awaiter->handle);
+            }
+        };
+
+        // ----------------------------------------------------------------------------
+        // FutureAwaiter
+        // ----------------------------------------------------------------------------
+
+        // suspends the awaiting coroutine until the future becomes ready, after
+        // which the worker tearing down the topology schedules its resumption
+        template<typename T>
+        struct FutureAwaiter {
+
+            Future<T> &future;
+
+            CoroutinePromiseBase *promise{nullptr};
+
+            std::coroutine_handle<> handle{nullptr};
+
+            bool await_ready() const {
+                return future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+            }
+
+            template<typename P>
+            bool await_suspend(std::coroutine_handle<P> h) {
+                static_assert(std::is_base_of_v<CoroutinePromiseBase, P>,
+                              "collie::tf::Future can only be awaited by a collie::tf::co_task");
+                promise = &h.promise();
+                handle = h;
+                // the topology is released only after its promise is set
+                auto tpg = future._topology.lock();
+                return tpg && tpg->_set_callback(&FutureAwaiter::_on_ready, this);
+            }
+
+            T await_resume() {
+                return future.get();
+            }
+
+            static void _on_ready(void *arg) {
+                auto awaiter = static_cast<FutureAwaiter *>(arg);
+                awaiter->promise->schedule(awaiter->handle);
+            }
+        };
+
+        // ----------------------------------------------------------------------------
+        // CoTaskAwaiter
+        // ----------------------------------------------------------------------------
+
+        // starts the awaited coroutine on the current worker by symmetric transfer;
+        // its final suspension transfers back to the awaiting coroutine
+        template<typename T>
+        struct CoTaskAwaiter {
+
+            std::coroutine_handle<CoroutinePromise<T>> handle;
+
+            bool await_ready() const noexcept {
+                return false;
+            }
+
+            template<typename P>
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<P> parent) noexcept {
+                static_assert(std::is_base_of_v<CoroutinePromiseBase, P>,
+                              "collie::tf::co_task can only be awaited by a collie::tf::co_task");
+                handle.promise().executor = parent.promise().executor;
+                handle.promise().continuation = parent;
+                return handle;
+            }
+
+            T await_resume() {
+                return handle.promise().result();
+            }
+        };
+
+    }  // end of namespace collie::tf::detail ---------------------------------------------
+
+    // ----------------------------------------------------------------------------
+    // co_task
+    // ----------------------------------------------------------------------------
+
+    /**
+    @class co_task
+
+    @brief class to create a coroutine task
+
+    @tparam T result type of the coroutine
+
+    A coroutine returning collie::tf::co_task<T> is lazily started:
+    it runs when it is launched by collie::tf::Executor::co_run or
+    awaited by another coroutine task.
+    Inside the coroutine, you can @c co_await
+      + another collie::tf::co_task, which runs inline on the same worker
+        and resumes the awaiting coroutine when it finishes,
+      + a collie::tf::AsyncFuture returned by collie::tf::Executor::async
+        or collie::tf::Runtime::async, or
+      + a collie::tf::Future returned by collie::tf::Executor::run.
+
+    If the awaited result is not ready, the coroutine suspends and the worker
+    goes back to run other tasks. The coroutine is resumed as an asynchronous
+    task of the executor when the result becomes ready, possibly on another worker.
+    Exceptions thrown by a coroutine propagate to its awaiter or to the future
+    returned by collie::tf::Executor::co_run.
+
+    @code{.cpp}
+    collie::tf::co_task<int> square(int x) {
+      co_return x * x;
+    }
+
+    collie::tf::co_task<int> sum_of_squares(collie::tf::Executor& executor) {
+      int a = co_await square(3);
+      int b = co_await executor.async([](){ return 16; });
+      co_return a + b;
+    }
+
+    collie::tf::Executor executor;
+    assert(executor.co_run(sum_of_squares(executor)).get() == 25);
+    @endcode
+    */
+    template<typename T = void>
+    class co_task {
+
+        friend class Executor;
+
+        friend struct detail::CoroutinePromise<T>;
+
+    public:
+
+        /**
+        @brief promise type of the coroutine
+        */
+        using promise_type = detail::CoroutinePromise<T>;
+
+        /**
+        @brief constructs an empty coroutine task
+        */
+        co_task() = default;
+
+        /**
+        @brief move constructor
+        */
+        co_task(co_task &&rhs) noexcept: _handle{std::exchange(rhs._handle, nullptr)} {
+        }
+
+        /**
+        @brief move assignment
+        */
+        co_task &operator=(co_task &&rhs) noexcept {
+            if (this != &rhs) {
+                _reset();
+                _handle = std::exchange(rhs._handle, nullptr);
+            }
+            return *this;
+        }
+
+        /**
+        @brief disabled copy constructor
+        */
+        co_task(const co_task &) = delete;
+
+        /**
+        @brief disabled copy assignment
+        */
+        co_task &operator=(const co_task &) = delete;
+
+        /**
+        @brief destroys the coroutine if it has not been launched
+        */
+        ~co_task() {
+            _reset();
+        }
+
+        /**
+        @brief queries if the task refers to a coroutine
+        */
+        bool valid() const noexcept {
+            return static_cast<bool>(_handle);
+        }
+
+        /**
+        @private
+        */
+        auto operator co_await() && noexcept {
+            return detail::CoTaskAwaiter<T>{_handle};
+        }
+
+    private:
+
+        std::coroutine_handle<promise_type> _handle{nullptr};
+
+        explicit co_task(std::coroutine_handle<promise_type> h) : _handle{h} {
+        }
+
+        void _reset() {
+            if (_handle) {
+                std::exchange(_handle, nullptr).destroy();
+            }
+        }
+    };
+
+    // Function: get_return_object
+    template<typename T>
+    co_task<T> detail::CoroutinePromise<T>::get_return_object() noexcept {
+        return co_task<T>(std::coroutine_handle<CoroutinePromise>::from_promise(*this));
+    }
+
+    /**
+    @brief awaits the result of a collie::tf::AsyncFuture in a collie::tf::co_task
+    */
+    template<typename T>
+    auto operator co_await(AsyncFuture<T> &future) {
+        return detail::AsyncFutureAwaiter<T>{future};
+    }
+
+    /**
+    @brief awaits the result of a collie::tf::AsyncFuture in a collie::tf::co_task
+    */
+    template<typename T>
+    auto operator co_await(AsyncFuture<T> &&future) {
+        return detail::AsyncFutureAwaiter<T>{future};
+    }
+
+    /**
+    @brief awaits the result of a collie::tf::Future in a collie::tf::co_task
+    */
+    template<typename T>
+    auto operator co_await(Future<T> &future) {
+        return detail::FutureAwaiter<T>{future};
+    }
+
+    /**
+    @brief awaits the result of a collie::tf::Future in a collie::tf::co_task
+    */
+    template<typename T>
+    auto operator co_await(Future<T> &&future) {
+        return detail::FutureAwaiter<T>{future};
+    }
+
+    // ----------------------------------------------------------------------------
+    // Executor::co_run
+    // ----------------------------------------------------------------------------
+
+    // Function: co_run
+    template<typename T>
+    AsyncFuture<T> Executor::co_run(co_task<T> task) {
+
+        auto state = future_state_pool<T>.animate();
+
+        auto h = std::exchange(task._handle, nullptr);
+        h.promise().executor = this;
+        h.promise().root.emplace(state);
+
+        _schedule_coroutine([h]() { h.resume(); });
+
+        return AsyncFuture<T>(state);
+    }
+
+}  // end of namespace collie::tf -----------------------------------------------------
+
+#endif
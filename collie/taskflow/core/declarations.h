@@ -49,6 +49,16 @@ class Future;
 template <typename...Fs>
 class Pipeline;
 
+template <typename T>
+class co_task;
+
+namespace detail {
+struct CoroutinePromiseBase;
+
+template <typename T>
+struct FutureAwaiter;
+}
+
 // ----------------------------------------------------------------------------
 // cudaFlow
 // ----------------------------------------------------------------------------
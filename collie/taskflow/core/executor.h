@@ -21,6 +21,7 @@
 #include <collie/taskflow/core/observer.h>
 #include <collie/taskflow/core/taskflow.h>
 #include <collie/taskflow/core/async_task.h>
+#include <collie/taskflow/core/async_future.h>
 
 /**
 @file executor.hpp
@@ -74,6 +75,8 @@ namespace collie::tf {
 
         friend class Runtime;
 
+        friend struct detail::CoroutinePromiseBase;
+
     public:
 
         /**
@@ -89,6 +92,37 @@ namespace collie::tf {
         */
         explicit Executor(size_t N = std::thread::hardware_concurrency());
 
+        /**
+        @brief constructs the executor with @c N worker threads pinned to cpus
+
+        @param N the number of workers
+        @param affinity the placement of the workers on the cpus
+
+        The workers are pinned as described by @c affinity (see collie::tf::WorkerAffinity)
+        and steal tasks from the workers closest to them in the cpu topology
+        before trying remote ones.
+
+        @code{.cpp}
+        collie::tf::Executor executor(
+          std::thread::hardware_concurrency(), collie::tf::WorkerAffinity::compact()
+        );
+        @endcode
+        */
+        Executor(size_t N, const WorkerAffinity &affinity, const IdlePolicy &idle = IdlePolicy());
+
+        /**
+        @brief constructs the executor with @c N worker threads idling as
+               described by @c idle
+
+        @param N the number of workers
+        @param idle the policy of the workers when they run out of tasks
+
+        @code{.cpp}
+        collie::tf::Executor executor(8, collie::tf::IdlePolicy::park());
+        @endcode
+        */
+        Executor(size_t N, const IdlePolicy &idle);
+
         /**
         @brief destructs the executor
 
@@ -527,6 +561,16 @@ namespace collie::tf {
         */
         size_t num_workers() const noexcept;
 
+        /**
+        @brief queries the policy of the workers when they run out of tasks
+
+        @code{.cpp}
+        collie::tf::Executor executor(4, collie::tf::IdlePolicy::spin());
+        assert(executor.idle_policy().kind() == collie::tf::IdlePolicy::SPIN);
+        @endcode
+        */
+        const IdlePolicy &idle_policy() const noexcept;
+
         /**
         @brief queries the number of running topologies at the time of this call
 
@@ -608,6 +652,55 @@ namespace collie::tf {
         */
         size_t num_observers() const noexcept;
 
+        // --------------------------------------------------------------------------
+        // Metrics methods
+        // --------------------------------------------------------------------------
+
+        /**
+        @brief takes a snapshot of the metrics of the workers
+
+        Each worker keeps its counters on cache lines of its own and updates
+        them with a few relaxed stores per task, so the metrics are always
+        collected and can be read at any time without stopping the executor.
+        Unlike an observer, nothing is recorded per task and the memory
+        used by the metrics does not grow.
+
+        @code{.cpp}
+        collie::tf::Executor executor(4);
+        executor.enable_task_timing();
+        executor.run(taskflow).wait();
+
+        auto m = executor.metrics();
+        std::cout << m.num_tasks() << " tasks, p99 < "
+                  << m.latency().percentile(99) << "ns\n";
+        for(const auto& w : m.workers) {
+          std::cout << "worker " << w.id << ": " << w.num_steals << " steals, "
+                    << w.busy.count() << "ns busy, " << w.idle.count() << "ns parked\n";
+        }
+        @endcode
+
+        This member function is thread-safe.
+        */
+        ExecutorMetrics metrics() const;
+
+        /**
+        @brief enables or disables measuring the run time of each task
+
+        Timing a task costs two reads of std::chrono::steady_clock, which is
+        why it is disabled by default. While disabled, the busy time and the
+        latency histogram of collie::tf::ExecutorMetrics do not grow;
+        all the other counters are always collected.
+
+        This member function is thread-safe and takes effect on the tasks
+        started after the call.
+        */
+        void enable_task_timing(bool flag = true) noexcept;
+
+        /**
+        @brief queries if the run time of each task is measured
+        */
+        bool task_timing_enabled() const noexcept;
+
         // --------------------------------------------------------------------------
         // Async Task Methods
         // --------------------------------------------------------------------------
@@ -621,14 +714,15 @@ namespace collie::tf {
         @param params task parameters
         @param func callable object
 
-        @return a @std_future that will hold the result of the execution
+        @return a collie::tf::AsyncFuture that will hold the result of the execution
 
         The method creates a parameterized asynchronous task
-        to run the given function and return a @std_future object
+        to run the given function and return a collie::tf::AsyncFuture object
         that eventually will hold the result of the execution.
+        The future can be moved into a @std_future if needed.
 
         @code{.cpp}
-        std::future<int> future = executor.async("name", [](){
+        collie::tf::AsyncFuture<int> future = executor.async("name", [](){
           std::cout << "create an asynchronous task with a name and returns 1\n";
           return 1;
         });
@@ -647,14 +741,16 @@ namespace collie::tf {
 
         @param func callable object
 
-        @return a @std_future that will hold the result of the execution
+        @return a collie::tf::AsyncFuture that will hold the result of the execution
 
         The method creates an asynchronous task to run the given function
-        and return a @std_future object that eventually will hold the result
+        and return a collie::tf::AsyncFuture object that eventually will hold the result
         of the return value.
+        The task and its shared state come from object pools and small callables
+        are stored inline, so no memory is allocated in the common case.
 
         @code{.cpp}
-        std::future<int> future = executor.async([](){
+        collie::tf::AsyncFuture<int> future = executor.async([](){
           std::cout << "create an asynchronous task and returns 1\n";
           return 1;
         });
@@ -884,7 +980,7 @@ namespace collie::tf {
 
         The example below creates three asynchronous tasks, @c A, @c B, and @c C,
         in which task @c C runs after task @c A and task @c B.
-        Task @c C returns a pair of its collie::tf::AsyncTask handle and a std::future<int>
+        Task @c C returns a pair of its collie::tf::AsyncTask handle and a collie::tf::AsyncFuture<int>
         that eventually will hold the result of the execution.
 
         @code{.cpp}
@@ -928,7 +1024,7 @@ namespace collie::tf {
 
         The example below creates three named asynchronous tasks, @c A, @c B, and @c C,
         in which task @c C runs after task @c A and task @c B.
-        Task @c C returns a pair of its collie::tf::AsyncTask handle and a std::future<int>
+        Task @c C returns a pair of its collie::tf::AsyncTask handle and a collie::tf::AsyncFuture<int>
         that eventually will hold the result of the execution.
         Assigned task names will appear in the observers of the executor.
 
@@ -973,7 +1069,7 @@ namespace collie::tf {
 
         The example below creates three asynchronous tasks, @c A, @c B, and @c C,
         in which task @c C runs after task @c A and task @c B.
-        Task @c C returns a pair of its collie::tf::AsyncTask handle and a std::future<int>
+        Task @c C returns a pair of its collie::tf::AsyncTask handle and a collie::tf::AsyncFuture<int>
         that eventually will hold the result of the execution.
 
         @code{.cpp}
@@ -1020,7 +1116,7 @@ namespace collie::tf {
 
         The example below creates three named asynchronous tasks, @c A, @c B, and @c C,
         in which task @c C runs after task @c A and task @c B.
-        Task @c C returns a pair of its collie::tf::AsyncTask handle and a std::future<int>
+        Task @c C returns a pair of its collie::tf::AsyncTask handle and a collie::tf::AsyncFuture<int>
         that eventually will hold the result of the execution.
         Assigned task names will appear in the observers of the executor.
 
@@ -1051,10 +1147,49 @@ namespace collie::tf {
         >
         auto dependent_async(P &&params, F &&func, I first, I last);
 
+#if TF_HAS_COROUTINE
+        // --------------------------------------------------------------------------
+        // Coroutine Methods
+        // --------------------------------------------------------------------------
+
+        /**
+        @brief runs a coroutine task on the executor
+
+        @tparam T result type of the coroutine
+
+        @param task coroutine task to run
+
+        @return a collie::tf::AsyncFuture that will hold the result of the coroutine
+
+        The coroutine starts on a worker of the executor.
+        Whenever it suspends on a @c co_await of a collie::tf::AsyncFuture or a
+        collie::tf::Future that is not ready, the worker returns to the
+        work-stealing loop instead of blocking, and the coroutine is resumed
+        through the task queues once the result is available.
+        Awaiting another collie::tf::co_task runs it inline on the same worker.
+
+        @code{.cpp}
+        collie::tf::co_task<int> read_block(collie::tf::Executor& executor) {
+          int block = co_await executor.async([](){ return load_block_from_disk(); });
+          co_return block + 1;
+        }
+
+        auto fu = executor.co_run(read_block(executor));
+        fu.get();
+        @endcode
+
+        This member function is thread-safe and requires C++20.
+        */
+        template<typename T>
+        AsyncFuture<T> co_run(co_task<T> task);
+#endif
+
     private:
 
         const size_t _MAX_STEALS;
 
+        const IdlePolicy _idle_policy;
+
         std::mutex _wsq_mutex;
         std::mutex _taskflows_mutex;
 
@@ -1080,18 +1215,29 @@ namespace collie::tf {
 
         std::unordered_set<std::shared_ptr<ObserverInterface>> _observers;
 
+        const std::chrono::steady_clock::time_point _origin{std::chrono::steady_clock::now()};
+
+        std::atomic<bool> _task_timing{false};
+
         Worker *_this_worker();
 
+        template<typename C>
+        void _schedule_coroutine(C &&);
+
         bool _wait_for_task(Worker &, Node *&);
 
         bool _invoke_module_task_internal(Worker &, Node *);
 
-        void _observer_prologue(Worker &, Node *);
+        uint64_t _observer_prologue(Worker &, Node *);
 
-        void _observer_epilogue(Worker &, Node *);
+        void _observer_epilogue(Worker &, Node *, uint64_t);
 
         void _spawn(size_t);
 
+        void _place(const WorkerAffinity &);
+
+        size_t _next_victim(Worker &, size_t);
+
         void _exploit_task(Worker &, Node *&);
 
         void _explore_task(Worker &, Node *&);
@@ -1151,8 +1297,17 @@ namespace collie::tf {
     };
 
 // Constructor
-    inline Executor::Executor(size_t N) :
+    inline Executor::Executor(size_t N) : Executor(N, WorkerAffinity()) {
+    }
+
+// Constructor
+    inline Executor::Executor(size_t N, const IdlePolicy &idle) : Executor(N, WorkerAffinity(), idle) {
+    }
+
+// Constructor
+    inline Executor::Executor(size_t N, const WorkerAffinity &affinity, const IdlePolicy &idle) :
             _MAX_STEALS{((N + 1) << 1)},
+            _idle_policy{idle},
             _threads{N},
             _workers{N},
             _notifier{N} {
@@ -1161,6 +1316,8 @@ namespace collie::tf {
             TF_THROW("executor must define at least one worker");
         }
 
+        _place(affinity);
+
         _spawn(N);
 
         // initialize the default observer if requested
@@ -1190,6 +1347,11 @@ namespace collie::tf {
         return _workers.size();
     }
 
+// Function: idle_policy
+    inline const IdlePolicy &Executor::idle_policy() const noexcept {
+        return _idle_policy;
+    }
+
 // Function: num_topologies
     inline size_t Executor::num_topologies() const {
 #ifdef __cpp_lib_atomic_wait
@@ -1232,6 +1394,7 @@ namespace collie::tf {
             _workers[id]._vtm = id;
             _workers[id]._executor = this;
             _workers[id]._waiter = &_notifier._waiters[id];
+            _workers[id]._idle_budget = _idle_policy.max_budget();
 
             _threads[id] = std::thread([&, &w = _workers[id]]() {
 
@@ -1266,13 +1429,17 @@ namespace collie::tf {
 
             });
 
-            // POSIX-like system can use the following to affine threads to cores
-            //cpu_set_t cpuset;
-            //CPU_ZERO(&cpuset);
-            //CPU_SET(id, &cpuset);
-            //pthread_setaffinity_np(
-            //  _threads[id].native_handle(), sizeof(cpu_set_t), &cpuset
-            //);
+#if TF_OS_LINUX
+            // affine the thread to the cpu chosen by _place
+            if (_workers[id]._cpu >= 0 && _workers[id]._cpu < CPU_SETSIZE) {
+                cpu_set_t cpuset;
+                CPU_ZERO(&cpuset);
+                CPU_SET(_workers[id]._cpu, &cpuset);
+                pthread_setaffinity_np(
+                  _threads[id].native_handle(), sizeof(cpu_set_t), &cpuset
+                );
+            }
+#endif
 
 #ifdef __cpp_lib_atomic_wait
             //_wids[_threads[id].get_id()] = id;
@@ -1291,12 +1458,68 @@ namespace collie::tf {
 #endif
     }
 
+// Procedure: _place
+    inline void Executor::_place(const WorkerAffinity &affinity) {
+
+        const size_t N = _workers.size();
+
+        std::vector<CpuInfo> cpus;
+        if (affinity.pinned()) {
+            cpus = affinity.assign(N, CpuTopology::detect());
+        }
+
+        for (size_t id = 0; id < N; ++id) {
+
+            auto &w = _workers[id];
+
+            // without pinning every worker is equally close to each other
+            if (cpus.empty()) {
+                w._victims.resize(N);
+                for (size_t v = 0; v < N; ++v) {
+                    w._victims[v] = (id + v) % N;
+                }
+                w._victim_tiers.assign(1, N);
+                continue;
+            }
+
+            w._cpu = static_cast<int>(cpus[id].cpu);
+
+            // order the victims by distance, the worker itself first
+            w._victims.clear();
+            w._victim_tiers.clear();
+            w._victims.push_back(id);
+            for (size_t d = 0; d <= 3; ++d) {
+                for (size_t v = 0; v < N; ++v) {
+                    if (v != id && CpuTopology::distance(cpus[id], cpus[v]) == d) {
+                        w._victims.push_back(v);
+                    }
+                }
+                if (w._victim_tiers.empty() || w._victim_tiers.back() != w._victims.size()) {
+                    w._victim_tiers.push_back(w._victims.size());
+                }
+            }
+        }
+    }
+
+// Function: _next_victim
+    inline size_t Executor::_next_victim(Worker &w, size_t num_steals) {
+        // steal from the closest tier of victims and widen the range
+        // after about two failed attempts per victim in it
+        size_t range = w._victims.size();
+        for (auto end: w._victim_tiers) {
+            if (num_steals < (end << 1)) {
+                range = end;
+                break;
+            }
+        }
+        std::uniform_int_distribution<size_t> rdvtm(0, range - 1);
+        return w._victims[rdvtm(w._rdgen)];
+    }
+
 // Function: _corun_until
     template<typename P>
     void Executor::_corun_until(Worker &w, P &&stop_predicate) {
 
-        std::uniform_int_distribution<size_t> rdvtm(0, _workers.size() - 1);
-
         exploit:
 
         while (!stop_predicate()) {
@@ -1313,13 +1536,15 @@ namespace collie::tf {
                 t = (w._id == w._vtm) ? _wsq.steal() : _workers[w._vtm]._wsq.steal();
 
                 if (t) {
+                    WorkerCounters::add(w._counters.num_steals);
                     _invoke(w, t);
                     goto exploit;
                 } else if (!stop_predicate()) {
+                    WorkerCounters::add(w._counters.num_failed_steals);
                     if (num_steals++ > _MAX_STEALS) {
                         std::this_thread::yield();
                     }
-                    w._vtm = rdvtm(w._rdgen);
+                    w._vtm = _next_victim(w, num_steals);
                     goto explore;
                 } else {
                     break;
@@ -1335,9 +1560,7 @@ namespace collie::tf {
         //assert(!t);
 
         size_t num_steals = 0;
-        size_t num_yields = 0;
-
-        std::uniform_int_distribution<size_t> rdvtm(0, _workers.size() - 1);
+        size_t num_idles = 0;
 
         // Here, we write do-while to make the worker steal at once
         // from the assigned victim.
@@ -1345,17 +1568,30 @@ namespace collie::tf {
             t = (w._id == w._vtm) ? _wsq.steal() : _workers[w._vtm]._wsq.steal();
 
             if (t) {
+                WorkerCounters::add(w._counters.num_steals);
+                // idling paid off, so idle longer next time
+                if (num_idles && _idle_policy.adaptive()) {
+                    w._idle_budget = std::min(
+                      _idle_policy.max_budget(), std::max<size_t>(w._idle_budget << 1, 1)
+                    );
+                }
                 break;
             }
 
+            WorkerCounters::add(w._counters.num_failed_steals);
+
             if (num_steals++ > _MAX_STEALS) {
-                std::this_thread::yield();
-                if (num_yields++ > 100) {
+                if (num_idles >= w._idle_budget) {
+                    // idling found nothing, so park sooner next time
+                    if (_idle_policy.adaptive()) {
+                        w._idle_budget = std::max(_idle_policy.min_budget(), w._idle_budget >> 1);
+                    }
                     break;
                 }
+                _idle_policy.idle(num_idles++);
             }
 
-            w._vtm = rdvtm(w._rdgen);
+            w._vtm = _next_victim(w, num_steals);
         } while (!_done);
 
     }
@@ -1408,7 +1644,11 @@ namespace collie::tf {
         }
 
         // Now I really need to relinguish my self to others
+        WorkerCounters::add(worker._counters.num_parks);
+        auto parked = metrics_stamp();
         _notifier.commit_wait(worker._waiter);
+        WorkerCounters::add(worker._counters.idle, metrics_stamp() - parked);
+        WorkerCounters::add(worker._counters.num_wakeups);
 
         goto explore_task;
     }
@@ -1449,6 +1689,45 @@ namespace collie::tf {
         return _observers.size();
     }
 
+// Function: metrics
+    inline ExecutorMetrics Executor::metrics() const {
+
+        ExecutorMetrics m;
+        m.uptime = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - _origin
+        );
+        m.workers.resize(_workers.size());
+
+        for (size_t i = 0; i < _workers.size(); ++i) {
+            const auto &c = _workers[i]._counters;
+            auto &w = m.workers[i];
+            w.id = i;
+            w.num_tasks = c.num_tasks.load(std::memory_order_relaxed);
+            w.num_steals = c.num_steals.load(std::memory_order_relaxed);
+            w.num_failed_steals = c.num_failed_steals.load(std::memory_order_relaxed);
+            w.num_parks = c.num_parks.load(std::memory_order_relaxed);
+            w.num_wakeups = c.num_wakeups.load(std::memory_order_relaxed);
+            w.queue_high_water = c.queue_high_water.load(std::memory_order_relaxed);
+            w.busy = std::chrono::nanoseconds(c.busy.load(std::memory_order_relaxed));
+            w.idle = std::chrono::nanoseconds(c.idle.load(std::memory_order_relaxed));
+            for (size_t b = 0; b < LatencyHistogram::NUM_BUCKETS; ++b) {
+                w.latency._buckets[b] = c.latency[b].load(std::memory_order_relaxed);
+            }
+        }
+
+        return m;
+    }
+
+// Function: enable_task_timing
+    inline void Executor::enable_task_timing(bool flag) noexcept {
+        _task_timing.store(flag, std::memory_order_relaxed);
+    }
+
+// Function: task_timing_enabled
+    inline bool Executor::task_timing_enabled() const noexcept {
+        return _task_timing.load(std::memory_order_relaxed);
+    }
+
 // Procedure: _schedule
     inline void Executor::_schedule(Worker &worker, Node *node) {
 
@@ -1464,6 +1743,7 @@ namespace collie::tf {
         // has shown no significant advantage.
         if (worker._executor == this) {
             worker._wsq.push(node, p);
+            worker._counters.watermark(worker._wsq.size());
             _notifier.notify(false);
             return;
         }
@@ -1518,6 +1798,7 @@ namespace collie::tf {
                 worker._wsq.push(nodes[i], p);
                 _notifier.notify(false);
             }
+            worker._counters.watermark(worker._wsq.size());
             return;
         }
 
@@ -1759,14 +2040,28 @@ namespace collie::tf {
     }
 
 // Procedure: _observer_prologue
-    inline void Executor::_observer_prologue(Worker &worker, Node *node) {
+    inline uint64_t Executor::_observer_prologue(Worker &worker, Node *node) {
         for (auto &observer: _observers) {
             observer->on_entry(WorkerView(worker), TaskView(*node));
         }
+        ++worker._depth;
+        // a zero stamp tells the epilogue that the task is not timed
+        return _task_timing.load(std::memory_order_relaxed) ? metrics_stamp() : 0;
     }
 
 // Procedure: _observer_epilogue
-    inline void Executor::_observer_epilogue(Worker &worker, Node *node) {
+    inline void Executor::_observer_epilogue(Worker &worker, Node *node, uint64_t beg) {
+        auto &counters = worker._counters;
+        WorkerCounters::add(counters.num_tasks);
+        if (beg) {
+            auto ns = metrics_stamp() - beg;
+            WorkerCounters::add(counters.latency[LatencyHistogram::bucket(ns)]);
+            // tasks run by a corunning task are already part of its run time
+            if (worker._depth == 1) {
+                WorkerCounters::add(counters.busy, ns);
+            }
+        }
+        --worker._depth;
         for (auto &observer: _observers) {
             observer->on_exit(WorkerView(worker), TaskView(*node));
         }
@@ -1799,7 +2094,7 @@ namespace collie::tf {
 
     // Procedure: _invoke_static_task
     inline void Executor::_invoke_static_task(Worker &worker, Node *node) {
-        _observer_prologue(worker, node);
+        auto beg = _observer_prologue(worker, node);
         TF_EXECUTOR_EXCEPTION_HANDLER(worker, node, {
             auto &work = std::get_if<Node::Static>(&node->_handle)->work;
             switch (work.index()) {
@@ -1814,12 +2109,12 @@ namespace collie::tf {
                     break;
             }
         });
-        _observer_epilogue(worker, node);
+        _observer_epilogue(worker, node, beg);
     }
 
     // Procedure: _invoke_subflow_task
     inline void Executor::_invoke_subflow_task(Worker &w, Node *node) {
-        _observer_prologue(w, node);
+        auto beg = _observer_prologue(w, node);
         TF_EXECUTOR_EXCEPTION_HANDLER(w, node, {
             auto handle = std::get_if<Node::Subflow>(&node->_handle);
             handle->subgraph._clear();
@@ -1830,7 +2125,7 @@ namespace collie::tf {
             }
             node->_process_exception();
         });
-        _observer_epilogue(w, node);
+        _observer_epilogue(w, node, beg);
     }
 
     // Procedure: _detach_subflow_task
@@ -1880,7 +2175,7 @@ namespace collie::tf {
     inline void Executor::_invoke_condition_task(
             Worker &worker, Node *node, InlinedVector<int> &conds
     ) {
-        _observer_prologue(worker, node);
+        auto beg = _observer_prologue(worker, node);
         TF_EXECUTOR_EXCEPTION_HANDLER(worker, node, {
             auto &work = std::get_if<Node::Condition>(&node->_handle)->work;
             switch (work.index()) {
@@ -1895,14 +2190,14 @@ namespace collie::tf {
                     break;
             }
         });
-        _observer_epilogue(worker, node);
+        _observer_epilogue(worker, node, beg);
     }
 
     // Procedure: _invoke_multi_condition_task
     inline void Executor::_invoke_multi_condition_task(
             Worker &worker, Node *node, InlinedVector<int> &conds
     ) {
-        _observer_prologue(worker, node);
+        auto beg = _observer_prologue(worker, node);
         TF_EXECUTOR_EXCEPTION_HANDLER(worker, node, {
             auto &work = std::get_if<Node::MultiCondition>(&node->_handle)->work;
             switch (work.index()) {
@@ -1917,17 +2212,17 @@ namespace collie::tf {
                     break;
             }
         });
-        _observer_epilogue(worker, node);
+        _observer_epilogue(worker, node, beg);
     }
 
     // Procedure: _invoke_module_task
     inline void Executor::_invoke_module_task(Worker &w, Node *node) {
-        _observer_prologue(w, node);
+        auto beg = _observer_prologue(w, node);
         TF_EXECUTOR_EXCEPTION_HANDLER(w, node, {
             _corun_graph(w, node, std::get_if<Node::Module>(&node->_handle)->graph);
             node->_process_exception();
         });
-        _observer_epilogue(w, node);
+        _observer_epilogue(w, node, beg);
     }
 
     //// Function: _invoke_module_task_internal
@@ -1951,7 +2246,7 @@ namespace collie::tf {
 
     // Procedure: _invoke_async_task
     inline void Executor::_invoke_async_task(Worker &worker, Node *node) {
-        _observer_prologue(worker, node);
+        auto beg = _observer_prologue(worker, node);
         TF_EXECUTOR_EXCEPTION_HANDLER(worker, node, {
             auto &work = std::get_if<Node::Async>(&node->_handle)->work;
             switch (work.index()) {
@@ -1965,12 +2260,12 @@ namespace collie::tf {
                     break;
             }
         });
-        _observer_epilogue(worker, node);
+        _observer_epilogue(worker, node, beg);
     }
 
     // Procedure: _invoke_dependent_async_task
     inline void Executor::_invoke_dependent_async_task(Worker &worker, Node *node) {
-        _observer_prologue(worker, node);
+        auto beg = _observer_prologue(worker, node);
         TF_EXECUTOR_EXCEPTION_HANDLER(worker, node, {
             auto &work = std::get_if<Node::DependentAsync>(&node->_handle)->work;
             switch (work.index()) {
@@ -1984,7 +2279,27 @@ namespace collie::tf {
                     break;
             }
         });
-        _observer_epilogue(worker, node);
+        _observer_epilogue(worker, node, beg);
+    }
+
+    // Procedure: _schedule_coroutine
+    // schedules the resumption of a suspended coroutine as an async task
+    // to the caller worker's queue
+    template<typename C>
+    void Executor::_schedule_coroutine(C &&resume) {
+
+        _increment_topology();
+
+        auto node = node_pool.animate(
+                DefaultTaskParams{}, nullptr, nullptr, 0,
+                std::in_place_type_t<Node::Async>{}, std::forward<C>(resume)
+        );
+
+        if (auto w = _this_worker(); w) {
+            _schedule(*w, node);
+        } else {
+            _schedule(node);
+        }
     }
 
     // Function: run
@@ -2232,6 +2547,7 @@ namespace collie::tf {
 
                 // Set the promise
                 tpg->_promise.set_value();
+                tpg->_complete();
                 f._topologies.pop();
                 tpg = f._topologies.front().get();
 
@@ -2403,18 +2719,17 @@ namespace collie::tf {
 
         using R = std::invoke_result_t<std::decay_t<F>>;
 
-        std::packaged_task<R()> p(std::forward<F>(f));
-        auto fu{p.get_future()};
+        auto state = future_state_pool<R>.animate();
 
         auto node = node_pool.animate(
                 std::forward<P>(params), _parent->_topology, _parent, 0,
                 std::in_place_type_t<Node::Async>{},
-                [p = make_moc(std::move(p))]() mutable { p.object(); }
+                [p = AsyncPromise<R>(state), f = std::forward<F>(f)]() mutable { p(f); }
         );
 
         _executor._schedule(w, node);
 
-        return fu;
+        return AsyncFuture<R>(state);
     }
 
     // Function: async
@@ -20,6 +20,7 @@
 
 #include <collie/taskflow/core/task.h>
 #include <collie/taskflow/algorithm/partitioner.h>
+#include <collie/taskflow/utility/index_range.h>
 
 /**
 @file flow_builder.hpp
@@ -413,6 +414,42 @@ namespace collie::tf {
                 B first, E last, S step, C callable, P part = P()
         );
 
+        /**
+        @brief constructs a parallel-for task over a multi-dimensional index range
+
+        @tparam R index range type (collie::tf::IndexRange)
+        @tparam C callable type
+        @tparam P partitioner type (default collie::tf::DefaultPartitioner)
+
+        @param range multi-dimensional index range
+        @param callable callable object to apply to each index or each tile
+        @param part partitioning algorithm to schedule parallel iterations
+
+        @return a collie::tf::Task handle
+
+        The task splits the range into rectangular tiles and schedules the tiles
+        with the partitioner, so the chunk size of the partitioner counts tiles.
+        If the callable takes the range type, it is called once per tile with
+        the tile as an untiled collie::tf::IndexRange;
+        otherwise it is called with the @c D indices of each index of a tile,
+        in row-major order.
+        For a two-dimensional range, this method is equivalent to the parallel
+        execution of the following loop, where the tiles keep the working set
+        of stencil-like callables in the cache:
+
+        @code{.cpp}
+        for(auto i=range.begin(0); i<range.end(0); i+=range.step(0)) {
+          for(auto j=range.begin(1); j<range.end(1); j+=range.step(1)) {
+            callable(i, j);
+          }
+        }
+        @endcode
+
+        The range is templated to enable stateful range using std::reference_wrapper.
+        */
+        template<typename R, typename C, typename P = DefaultPartitioner>
+        Task for_each_index(R range, C callable, P part = P());
+
         // ------------------------------------------------------------------------
         // transform
         // ------------------------------------------------------------------------
@@ -1116,6 +1153,226 @@ namespace collie::tf {
         template<typename B, typename E, typename T, typename C, typename P>
         Task max_element(B first, E last, T &result, C comp, P part);
 
+        // ------------------------------------------------------------------------
+        // copy_if, partition and unique
+        // ------------------------------------------------------------------------
+
+        /**
+        @brief constructs a task to perform STL-styled parallel copy-if algorithm
+
+        @tparam B beginning iterator type
+        @tparam E ending iterator type
+        @tparam D beginning output iterator type
+        @tparam T output iterator type of the result
+        @tparam UOP unary predicate type
+        @tparam P partitioner type (default collie::tf::DefaultPartitioner)
+
+        @param first start of the input range
+        @param last end of the input range
+        @param d_first start of the output range
+        @param result iterator past the last copied element
+        @param predicate unary predicate which returns @c true for the elements to copy
+        @param part partitioning algorithm to schedule parallel iterations
+
+        Copies the elements of <tt>[first, last)</tt> for which @c predicate
+        returns @c true to the output range, keeping their order,
+        and stores the end of the output range to @c result.
+        The range is split into one block per worker: each block counts its
+        selected elements, the counts are scanned into the output offset of
+        each block, and the blocks copy their elements in parallel.
+        The predicate is called twice on each element and must not have side effects.
+
+        @code{.cpp}
+        std::vector<int> input = {1, 6, 9, 10, 22, 5, 7, 8, 9, 11};
+        std::vector<int> output(input.size());
+        std::vector<int>::iterator result;
+        taskflow.copy_if(
+          input.begin(), input.end(), output.begin(), result, [](int i){ return i%2 == 0; }
+        );
+        executor.run(taskflow).wait();
+        // output is {6, 10, 22, 8}, result is output.begin() + 4
+        @endcode
+
+        Iterators are templated to enable stateful range using std::reference_wrapper.
+        */
+        template<typename B, typename E, typename D, typename T, typename UOP, typename P = DefaultPartitioner>
+        Task copy_if(B first, E last, D d_first, T &result, UOP predicate, P part = P());
+
+        /**
+        @brief constructs a task to perform STL-styled parallel stable partition
+
+        @tparam B beginning iterator type
+        @tparam E ending iterator type
+        @tparam T iterator type of the result
+        @tparam UOP unary predicate type
+        @tparam P partitioner type (default collie::tf::DefaultPartitioner)
+
+        @param first start of the input range
+        @param last end of the input range
+        @param result iterator to the first element of the second group
+        @param predicate unary predicate which returns @c true for the elements of the first group
+        @param part partitioning algorithm to schedule parallel iterations
+
+        Reorders the elements of <tt>[first, last)</tt> so that the elements
+        for which @c predicate returns @c true precede the others, keeping the
+        relative order of the elements in each group, like @c std::stable_partition.
+        The offsets of the two groups in each block are computed as in
+        collie::tf::FlowBuilder::copy_if and the elements move through a buffer,
+        so the element type must be default-constructible and movable.
+
+        Iterators are templated to enable stateful range using std::reference_wrapper.
+        */
+        template<typename B, typename E, typename T, typename UOP, typename P = DefaultPartitioner>
+        Task partition(B first, E last, T &result, UOP predicate, P part = P());
+
+        /**
+        @brief constructs a task to perform STL-styled parallel unique algorithm
+
+        @tparam B beginning iterator type
+        @tparam E ending iterator type
+        @tparam T iterator type of the result
+        @tparam C binary predicate type
+        @tparam P partitioner type (default collie::tf::DefaultPartitioner)
+
+        @param first start of the input range
+        @param last end of the input range
+        @param result iterator past the end of the unique range
+        @param equal binary predicate which returns @c true for equivalent elements
+        @param part partitioning algorithm to schedule parallel iterations
+
+        Removes all but the first element of every group of consecutive
+        equivalent elements of <tt>[first, last)</tt>, like @c std::unique,
+        and stores the end of the resulting range to @c result.
+        The predicate must be an equivalence relation.
+        The element type must be default-constructible and movable.
+
+        Iterators are templated to enable stateful range using std::reference_wrapper.
+        */
+        template<typename B, typename E, typename T, typename C, typename P = DefaultPartitioner>
+        Task unique(B first, E last, T &result, C equal, P part = P());
+
+        /**
+        @brief constructs a task to perform STL-styled parallel unique algorithm
+               using @c operator==
+
+        Iterators are templated to enable stateful range using std::reference_wrapper.
+        */
+        template<typename B, typename E, typename T>
+        Task unique(B first, E last, T &result);
+
+        // ------------------------------------------------------------------------
+        // merge
+        // ------------------------------------------------------------------------
+
+        /**
+        @brief constructs a task to perform STL-styled parallel merge
+
+        @tparam B1 beginning iterator type of the first range (random-accessible)
+        @tparam E1 ending iterator type of the first range (random-accessible)
+        @tparam B2 beginning iterator type of the second range (random-accessible)
+        @tparam E2 ending iterator type of the second range (random-accessible)
+        @tparam O beginning output iterator type (random-accessible)
+        @tparam C comparator type
+        @tparam P partitioner type (default collie::tf::DefaultPartitioner)
+
+        @param first1 start of the first sorted range
+        @param last1 end of the first sorted range
+        @param first2 start of the second sorted range
+        @param last2 end of the second sorted range
+        @param d_first start of the output range
+        @param cmp comparison operator
+        @param part partitioning algorithm to schedule parallel iterations
+
+        Merges two sorted ranges into the output range, like @c std::merge.
+        The output is split into one slice per worker and the inputs of each
+        slice are located with merge-path co-ranking, so the merge is stable
+        and balanced regardless of the distribution of the keys.
+
+        Iterators are templated to enable stateful range using std::reference_wrapper.
+        */
+        template<typename B1, typename E1, typename B2, typename E2, typename O, typename C,
+                typename P = DefaultPartitioner
+        >
+        Task merge(B1 first1, E1 last1, B2 first2, E2 last2, O d_first, C cmp, P part = P());
+
+        /**
+        @brief constructs a task to perform STL-styled parallel merge using
+               the @c std::less<T> comparator, where @c T is the element type
+
+        Iterators are templated to enable stateful range using std::reference_wrapper.
+        */
+        template<typename B1, typename E1, typename B2, typename E2, typename O>
+        Task merge(B1 first1, E1 last1, B2 first2, E2 last2, O d_first);
+
+        // ------------------------------------------------------------------------
+        // count_if and histogram
+        // ------------------------------------------------------------------------
+
+        /**
+        @brief constructs a task to perform STL-styled parallel count-if algorithm
+
+        @tparam B beginning iterator type
+        @tparam E ending iterator type
+        @tparam T count type
+        @tparam UOP unary predicate type
+        @tparam P partitioner type (default collie::tf::DefaultPartitioner)
+
+        @param first start of the input range
+        @param last end of the input range
+        @param result number of elements for which @c predicate returns @c true
+        @param predicate unary predicate
+        @param part partitioning algorithm to schedule parallel iterations
+
+        @code{.cpp}
+        std::vector<int> input = {1, 6, 9, 10, 22, 5, 7, 8, 9, 11};
+        size_t count;
+        taskflow.count_if(input.begin(), input.end(), count, [](int i){ return i > 8; });
+        executor.run(taskflow).wait();
+        assert(count == 5);
+        @endcode
+
+        Iterators are templated to enable stateful range using std::reference_wrapper.
+        */
+        template<typename B, typename E, typename T, typename UOP, typename P = DefaultPartitioner>
+        Task count_if(B first, E last, T &result, UOP predicate, P part = P());
+
+        /**
+        @brief constructs a task to compute a histogram in parallel
+
+        @tparam B beginning iterator type
+        @tparam E ending iterator type
+        @tparam H beginning iterator type of the bins (random-accessible)
+        @tparam F bin callable type
+        @tparam P partitioner type (default collie::tf::DefaultPartitioner)
+
+        @param first start of the input range
+        @param last end of the input range
+        @param bins start of the range of @c num_bins counts to write
+        @param num_bins number of bins
+        @param bin callable returning the bin index of an element
+        @param part partitioning algorithm to schedule parallel iterations
+
+        Counts the elements of <tt>[first, last)</tt> falling into each bin
+        and writes the counts to <tt>bins[0, num_bins)</tt>.
+        Elements whose bin index is not in <tt>[0, num_bins)</tt> are ignored.
+        Each worker counts a block of the range into its own private bins,
+        which are summed up at the end, so no atomic operation is involved.
+
+        @code{.cpp}
+        std::vector<int> input = {1, 6, 9, 10, 22, 5, 7, 8, 9, 11};
+        std::vector<size_t> bins(3);
+        taskflow.histogram(input.begin(), input.end(), bins.begin(), bins.size(),
+          [](int i){ return i / 10; }
+        );
+        executor.run(taskflow).wait();
+        // bins is {7, 2, 1}
+        @endcode
+
+        Iterators are templated to enable stateful range using std::reference_wrapper.
+        */
+        template<typename B, typename E, typename H, typename F, typename P = DefaultPartitioner>
+        Task histogram(B first, E last, H bins, size_t num_bins, F bin, P part = P());
+
         // ------------------------------------------------------------------------
         // sort
         // ------------------------------------------------------------------------
@@ -1162,6 +1419,98 @@ namespace collie::tf {
         template<typename B, typename E>
         Task sort(B first, E last);
 
+        /**
+        @brief constructs a dynamic task to perform parallel radix sort
+
+        @tparam B beginning iterator type (random-accessible)
+        @tparam E ending iterator type (random-accessible)
+        @tparam K key extractor type
+        @tparam P partitioner type (default collie::tf::DefaultPartitioner)
+
+        @param first iterator to the beginning (inclusive)
+        @param last iterator to the end (exclusive)
+        @param key callable returning the arithmetic sort key of an element
+        @param part partitioning algorithm to schedule parallel iterations
+
+        The task sorts elements in the range <tt>[first, last)</tt> by
+        ascending key with a parallel LSD radix sort.
+        The range is split into one block per worker; each pass counts the
+        8-bit digits of each block into its own histogram and then scatters
+        the block into a buffer.
+        Passes in which all the keys share the same digit are skipped.
+        The sort is stable, and the blocks are scheduled with the given
+        partitioner.
+        Keys can be integers, @c float or @c double.
+        The element type must be default-constructible and movable.
+
+        @code{.cpp}
+        std::vector<std::pair<uint32_t, std::string>> records = ...;
+        taskflow.radix_sort(records.begin(), records.end(), [](const auto& r){
+          return r.first;
+        });
+        @endcode
+
+        Iterators are templated to enable stateful range using std::reference_wrapper.
+        */
+        template<typename B, typename E, typename K, typename P = DefaultPartitioner>
+        Task radix_sort(B first, E last, K key, P part = P());
+
+        /**
+        @brief constructs a dynamic task to perform parallel radix sort
+               of arithmetic elements by their own value
+
+        @tparam B beginning iterator type (random-accessible)
+        @tparam E ending iterator type (random-accessible)
+
+        @param first iterator to the beginning (inclusive)
+        @param last iterator to the end (exclusive)
+
+        Iterators are templated to enable stateful range using std::reference_wrapper.
+        */
+        template<typename B, typename E>
+        Task radix_sort(B first, E last);
+
+        /**
+        @brief constructs a dynamic task to perform STL-styled parallel stable sort
+
+        @tparam B beginning iterator type (random-accessible)
+        @tparam E ending iterator type (random-accessible)
+        @tparam C comparator type
+        @tparam P partitioner type (default collie::tf::DefaultPartitioner)
+
+        @param first iterator to the beginning (inclusive)
+        @param last iterator to the end (exclusive)
+        @param cmp comparison operator
+        @param part partitioning algorithm to schedule parallel iterations
+
+        The task sorts elements in the range <tt>[first, last)</tt> in parallel
+        and keeps the order of equivalent elements.
+        It sorts one run per worker with @c std::stable_sort and then merges
+        adjacent runs pairwise. Each merge is split into pieces of equal output
+        size with merge-path partitioning, so all the workers take part
+        in the last merges too.
+        The element type must be default-constructible and movable.
+
+        Iterators are templated to enable stateful range using std::reference_wrapper.
+        */
+        template<typename B, typename E, typename C, typename P = DefaultPartitioner>
+        Task stable_sort(B first, E last, C cmp, P part = P());
+
+        /**
+        @brief constructs a dynamic task to perform STL-styled parallel stable sort
+               using the @c std::less<T> comparator, where @c T is the element type
+
+        @tparam B beginning iterator type (random-accessible)
+        @tparam E ending iterator type (random-accessible)
+
+        @param first iterator to the beginning (inclusive)
+        @param last iterator to the end (exclusive)
+
+        Iterators are templated to enable stateful range using std::reference_wrapper.
+        */
+        template<typename B, typename E>
+        Task stable_sort(B first, E last);
+
     protected:
 
         /**
@@ -25,6 +25,7 @@
 #include <collie/taskflow/utility/math.h>
 #include <collie/container/inlined_vector.h>
 #include <collie/taskflow/utility/serializer.h>
+#include <collie/taskflow/utility/small_function.h>
 #include <collie/taskflow/core/error.h>
 #include <collie/taskflow/core/declarations.h>
 #include <collie/taskflow/core/semaphore.h>
@@ -688,14 +689,14 @@ A graph object is move-only.
             Graph &graph;
         };
 
-        // Async work
+        // Async work, stored inline when small to avoid one allocation per task
         struct Async {
 
             template<typename T>
             Async(T &&);
 
             std::variant<
-                    std::function<void()>, std::function<void(Runtime &)>
+                    SmallFunction<void()>, SmallFunction<void(Runtime &)>
             > work;
         };
 
@@ -706,7 +707,7 @@ A graph object is move-only.
             DependentAsync(C &&);
 
             std::variant<
-                    std::function<void()>, std::function<void(Runtime &)>
+                    SmallFunction<void()>, SmallFunction<void(Runtime &)>
             > work;
 
             std::atomic<size_t> use_count{1};
@@ -0,0 +1,353 @@
+//
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+#include <collie/taskflow/utility/math.h>
+#include <collie/taskflow/utility/os.h>
+
+/**
+@file metrics.h
+@brief executor metrics include file
+*/
+
+namespace collie::tf {
+
+// ----------------------------------------------------------------------------
+// Class Definition: LatencyHistogram
+// ----------------------------------------------------------------------------
+
+/**
+@class LatencyHistogram
+
+@brief class to hold a log-bucketed histogram of task run times
+
+Bucket @c 0 counts the tasks that ran for less than two nanoseconds and
+bucket @c i counts the tasks that ran for <tt>[2^i, 2^(i+1))</tt> nanoseconds.
+The last bucket also counts everything longer.
+Percentiles are therefore accurate to a factor of two, which is what
+a monitoring dashboard needs at the cost of one increment per task.
+*/
+class LatencyHistogram {
+
+  friend class Executor;
+
+  public:
+
+    /**
+    @brief number of buckets, the last one starting at about 9 minutes
+    */
+    static constexpr size_t NUM_BUCKETS = 40;
+
+    /**
+    @brief queries the bucket that counts a run time of @c ns nanoseconds
+    */
+    static size_t bucket(uint64_t ns) {
+      if(ns < 2) {
+        return 0;
+      }
+#if defined(__GNUC__) || defined(__clang__)
+      size_t b = 63 - static_cast<size_t>(__builtin_clzll(ns));
+#else
+      size_t b = static_cast<size_t>(log2(ns));
+#endif
+      return b < NUM_BUCKETS ? b : NUM_BUCKETS - 1;
+    }
+
+    /**
+    @brief queries the smallest run time in nanoseconds counted by bucket @c b
+    */
+    static uint64_t lower_bound(size_t b) { return b == 0 ? 0 : uint64_t{1} << b; }
+
+    /**
+    @brief queries the run time in nanoseconds right past bucket @c b
+    */
+    static uint64_t upper_bound(size_t b) { return uint64_t{1} << (b + 1); }
+
+    /**
+    @brief queries the number of tasks in bucket @c b
+    */
+    size_t operator [] (size_t b) const { return _buckets[b]; }
+
+    /**
+    @brief queries the number of tasks in all the buckets
+    */
+    size_t count() const {
+      size_t n = 0;
+      for(auto c : _buckets) {
+        n += c;
+      }
+      return n;
+    }
+
+    /**
+    @brief queries an upper bound in nanoseconds of the @c p-th percentile,
+           @c p in <tt>[0, 100]</tt>, or @c 0 if the histogram is empty
+
+    @code{.cpp}
+    auto m = executor.metrics();
+    std::cout << "p99 < " << m.latency().percentile(99) << "ns\n";
+    @endcode
+    */
+    uint64_t percentile(double p) const {
+      size_t n = count();
+      if(n == 0) {
+        return 0;
+      }
+      // rank of the percentile in [1, n]
+      double r = p / 100.0 * static_cast<double>(n);
+      size_t rank = r < 1.0 ? 1 : (r >= static_cast<double>(n) ? n : static_cast<size_t>(r + 0.5));
+      size_t seen = 0;
+      for(size_t b=0; b<NUM_BUCKETS; ++b) {
+        if((seen += _buckets[b]) >= rank) {
+          return upper_bound(b);
+        }
+      }
+      return upper_bound(NUM_BUCKETS - 1);
+    }
+
+    /**
+    @brief adds the counts of another histogram to this histogram
+    */
+    LatencyHistogram& operator += (const LatencyHistogram& rhs) {
+      for(size_t b=0; b<NUM_BUCKETS; ++b) {
+        _buckets[b] += rhs._buckets[b];
+      }
+      return *this;
+    }
+
+  private:
+
+    std::array<size_t, NUM_BUCKETS> _buckets {};
+};
+
+// ----------------------------------------------------------------------------
+// Class Definition: WorkerMetrics
+// ----------------------------------------------------------------------------
+
+/**
+@struct WorkerMetrics
+
+@brief structure to hold a snapshot of the metrics of a worker
+
+Run times, and thus @c busy and @c latency, are only measured while
+task timing is enabled (see collie::tf::Executor::enable_task_timing).
+*/
+struct WorkerMetrics {
+
+  /**
+  @brief id of the worker
+  */
+  size_t id {0};
+
+  /**
+  @brief number of tasks the worker has run
+  */
+  size_t num_tasks {0};
+
+  /**
+  @brief number of tasks the worker has stolen
+  */
+  size_t num_steals {0};
+
+  /**
+  @brief number of steal attempts that found no task
+  */
+  size_t num_failed_steals {0};
+
+  /**
+  @brief number of times the worker parked on the notifier
+  */
+  size_t num_parks {0};
+
+  /**
+  @brief number of times the worker was woken up from parking
+  */
+  size_t num_wakeups {0};
+
+  /**
+  @brief largest number of tasks seen in the queue of the worker
+  */
+  size_t queue_high_water {0};
+
+  /**
+  @brief time spent running tasks
+  */
+  std::chrono::nanoseconds busy {0};
+
+  /**
+  @brief time spent parked on the notifier
+  */
+  std::chrono::nanoseconds idle {0};
+
+  /**
+  @brief histogram of the run times of the tasks
+  */
+  LatencyHistogram latency;
+};
+
+// ----------------------------------------------------------------------------
+// Class Definition: ExecutorMetrics
+// ----------------------------------------------------------------------------
+
+/**
+@struct ExecutorMetrics
+
+@brief structure to hold a snapshot of the metrics of an executor
+
+The snapshot is taken by collie::tf::Executor::metrics while the workers
+keep running, so the counters of different workers are not read at the
+same instant. Counters only grow; rates are obtained by subtracting two
+snapshots.
+
+@code{.cpp}
+auto m = executor.metrics();
+std::cout << m.num_tasks() << " tasks, "
+          << m.num_steals() << " steals, "
+          << m.utilization() * 100 << "% busy\n";
+@endcode
+*/
+struct ExecutorMetrics {
+
+  /**
+  @brief time since the executor was constructed
+  */
+  std::chrono::nanoseconds uptime {0};
+
+  /**
+  @brief metrics of each worker, indexed by worker id
+  */
+  std::vector<WorkerMetrics> workers;
+
+  /**
+  @brief queries the number of tasks run by all the workers
+  */
+  size_t num_tasks() const { return _sum(&WorkerMetrics::num_tasks); }
+
+  /**
+  @brief queries the number of tasks stolen by all the workers
+  */
+  size_t num_steals() const { return _sum(&WorkerMetrics::num_steals); }
+
+  /**
+  @brief queries the number of failed steal attempts of all the workers
+  */
+  size_t num_failed_steals() const { return _sum(&WorkerMetrics::num_failed_steals); }
+
+  /**
+  @brief queries the number of times any worker parked
+  */
+  size_t num_parks() const { return _sum(&WorkerMetrics::num_parks); }
+
+  /**
+  @brief queries the number of times any worker was woken up
+  */
+  size_t num_wakeups() const { return _sum(&WorkerMetrics::num_wakeups); }
+
+  /**
+  @brief queries the time all the workers spent running tasks
+  */
+  std::chrono::nanoseconds busy() const { return _sum(&WorkerMetrics::busy); }
+
+  /**
+  @brief queries the time all the workers spent parked
+  */
+  std::chrono::nanoseconds idle() const { return _sum(&WorkerMetrics::idle); }
+
+  /**
+  @brief queries the fraction of the worker time spent running tasks
+  */
+  double utilization() const {
+    auto total = uptime.count() * static_cast<double>(workers.size());
+    return total > 0 ? static_cast<double>(busy().count()) / total : 0.0;
+  }
+
+  /**
+  @brief queries the histogram of the run times of the tasks of all the workers
+  */
+  LatencyHistogram latency() const {
+    LatencyHistogram h;
+    for(const auto& w : workers) {
+      h += w.latency;
+    }
+    return h;
+  }
+
+  private:
+
+  template <typename T>
+  T _sum(T WorkerMetrics::*field) const {
+    T s {0};
+    for(const auto& w : workers) {
+      s += w.*field;
+    }
+    return s;
+  }
+};
+
+// ----------------------------------------------------------------------------
+// Class Definition: WorkerCounters
+// ----------------------------------------------------------------------------
+
+/**
+@private
+
+Counters live on cache lines of their own since they are written by the
+owning worker on every task, and only read when a snapshot is taken.
+A single writer lets each update be a relaxed load and store instead of
+a read-modify-write.
+*/
+struct alignas(TF_CACHELINE_SIZE) WorkerCounters {
+
+  std::atomic<size_t> num_tasks {0};
+  std::atomic<size_t> num_steals {0};
+  std::atomic<size_t> num_failed_steals {0};
+  std::atomic<size_t> num_parks {0};
+  std::atomic<size_t> num_wakeups {0};
+  std::atomic<size_t> queue_high_water {0};
+  std::atomic<uint64_t> busy {0};
+  std::atomic<uint64_t> idle {0};
+  std::array<std::atomic<size_t>, LatencyHistogram::NUM_BUCKETS> latency {};
+
+  template <typename T>
+  static void add(std::atomic<T>& counter, T n = 1) {
+    counter.store(counter.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+  }
+
+  void watermark(size_t n) {
+    if(n > queue_high_water.load(std::memory_order_relaxed)) {
+      queue_high_water.store(n, std::memory_order_relaxed);
+    }
+  }
+};
+
+/**
+@private
+*/
+inline uint64_t metrics_stamp() {
+  return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()
+  ).count());
+}
+
+}  // end of namespace collie::tf -----------------------------------------------
@@ -21,6 +21,14 @@
 #include <collie/taskflow/core/task.h>
 #include <collie/taskflow/core/worker.h>
 
+#include <cerrno>
+#include <csignal>
+
+#if TF_OS_UNIX
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
 /** 
 @file observer.hpp
 @brief observer include file
@@ -459,6 +467,8 @@ executor.run(taskflow).wait();
 observer->dump(std::cout);
 @endcode
 
+The observer records a segment per task and is meant for profiling runs.
+For counters that can be left on in production, use collie::tf::Executor::metrics.
 */
     class TFProfObserver : public ObserverInterface {
 
@@ -748,33 +758,38 @@ observer->dump(std::cout);
         }
     }
 
-// Procedure: dump
-    inline void TFProfObserver::dump(std::ostream &os) const {
+/**
+@private
+
+Dumps a timeline into the @TFProf format, shared by the observers that
+record segments per worker and level.
+*/
+    inline void dump_tfprof(std::ostream &os, const Timeline &timeline) {
 
         using namespace std::chrono;
 
         size_t first;
 
-        for (first = 0; first < _timeline.segments.size(); ++first) {
-            if (_timeline.segments[first].size() > 0) {
+        for (first = 0; first < timeline.segments.size(); ++first) {
+            if (timeline.segments[first].size() > 0) {
                 break;
             }
         }
 
         // not timeline data to dump
-        if (first == _timeline.segments.size()) {
+        if (first == timeline.segments.size()) {
             os << "{}\n";
             return;
         }
 
-        os << "{\"executor\":\"" << _timeline.uid << "\",\"data\":[";
+        os << "{\"executor\":\"" << timeline.uid << "\",\"data\":[";
 
         bool comma = false;
 
-        for (size_t w = first; w < _timeline.segments.size(); w++) {
-            for (size_t l = 0; l < _timeline.segments[w].size(); l++) {
+        for (size_t w = first; w < timeline.segments.size(); w++) {
+            for (size_t l = 0; l < timeline.segments[w].size(); l++) {
 
-                if (_timeline.segments[w][l].empty()) {
+                if (timeline.segments[w][l].empty()) {
                     continue;
                 }
 
@@ -785,17 +800,17 @@ observer->dump(std::cout);
                 }
 
                 os << "{\"worker\":" << w << ",\"level\":" << l << ",\"data\":[";
-                for (size_t i = 0; i < _timeline.segments[w][l].size(); ++i) {
+                for (size_t i = 0; i < timeline.segments[w][l].size(); ++i) {
 
-                    const auto &s = _timeline.segments[w][l][i];
+                    const auto &s = timeline.segments[w][l][i];
 
                     if (i) os << ',';
 
                     // span
                     os << "{\"span\":["
-                       << duration_cast<microseconds>(s.beg - _timeline.origin).count()
+                       << duration_cast<microseconds>(s.beg - timeline.origin).count()
                        << ","
-                       << duration_cast<microseconds>(s.end - _timeline.origin).count()
+                       << duration_cast<microseconds>(s.end - timeline.origin).count()
                        << "],";
 
                     // name
@@ -819,6 +834,11 @@ observer->dump(std::cout);
         os << "]}\n";
     }
 
+// Procedure: dump
+    inline void TFProfObserver::dump(std::ostream &os) const {
+        dump_tfprof(os, _timeline);
+    }
+
 // Function: dump
     inline std::string TFProfObserver::dump() const {
         std::ostringstream oss;
@@ -1070,6 +1090,510 @@ observer->dump(std::cout);
     }
 
 
+
+// ----------------------------------------------------------------------------
+// SamplingObserver definition
+// ----------------------------------------------------------------------------
+
+/**
+@class SamplingObserver
+
+@brief class to create an observer that keeps the last segments of each worker
+       in bounded memory
+
+Unlike collie::tf::TFProfObserver, which records every task until it is
+cleared, a collie::tf::SamplingObserver keeps a ring buffer of the last
+@c capacity segments per worker and records only one in every @c period tasks.
+Its memory is fixed at construction, so it can stay attached to the executor
+of a long-running service and be dumped on demand, while the executor runs,
+to the @TFProf or the @ChromeTracing format.
+
+@code{.cpp}
+collie::tf::Executor executor;
+
+// keep the last 4096 segments per worker, recording one task in 16
+auto observer = executor.make_observer<collie::tf::SamplingObserver>(4096, 16);
+
+// dump the segments to /tmp/executor.json whenever the process receives SIGUSR2
+observer->dump_on_signal(SIGUSR2, "/tmp/executor.json");
+
+// ... or at any time from any thread
+observer->dump(std::cout);
+@endcode
+
+Recording a sampled task takes an uncontended per-worker lock,
+and skipping a task costs a counter increment.
+*/
+    class SamplingObserver : public ObserverInterface {
+
+        friend class Executor;
+
+        // recorded task with the level at which it ran
+        struct Sample {
+            Segment segment;
+            size_t level{0};
+        };
+
+        struct alignas(TF_CACHELINE_SIZE) Ring {
+            // protects samples and head against concurrent dumps
+            mutable std::mutex mutex;
+            std::vector<Sample> samples;
+            size_t head{0};
+            // written only by the worker: entry stamps of the running tasks,
+            // with a default stamp for tasks that are not sampled
+            std::vector<observer_stamp_t> stack;
+            size_t seen{0};
+        };
+
+    public:
+
+        /**
+        @brief constructs an observer that keeps the last @c capacity segments
+               of each worker and records one in every @c period tasks
+
+        Both @c capacity and @c period must be greater than zero or an
+        exception will be thrown.
+        */
+        explicit SamplingObserver(size_t capacity = 1024, size_t period = 1);
+
+        /**
+        @brief destructs the observer and stops dumping it on signals
+        */
+        ~SamplingObserver();
+
+        /**
+        @brief queries the maximum number of segments kept per worker
+        */
+        size_t capacity() const noexcept;
+
+        /**
+        @brief queries the sampling period
+        */
+        size_t period() const noexcept;
+
+        /**
+        @brief dumps the kept segments into a @TFProf format through
+               an output stream
+
+        This member function is thread-safe and can be called while
+        the executor is running.
+        */
+        void dump(std::ostream &ostream) const;
+
+        /**
+        @brief dumps the kept segments into a @TFProf format
+        */
+        std::string dump() const;
+
+        /**
+        @brief dumps the kept segments into a @ChromeTracing format through
+               an output stream
+
+        This member function is thread-safe and can be called while
+        the executor is running.
+        */
+        void dump_chrome(std::ostream &ostream) const;
+
+        /**
+        @brief dumps the kept segments into a @ChromeTracing format
+        */
+        std::string dump_chrome() const;
+
+        /**
+        @brief writes the kept segments to the file at @c path every time
+               the process receives the signal @c signum
+
+        @param signum signal to dump on, for example @c SIGUSR2
+        @param path file to overwrite with each dump
+        @param type format of the dump, collie::tf::ObserverType::TFPROF or
+                    collie::tf::ObserverType::CHROME
+
+        The signal handler only wakes up a background thread that writes
+        the file, so the workers are never interrupted by a dump.
+        Several observers can be dumped on the same signal to different files.
+        A handler installed for the signal before the first call is kept and
+        still called after the dump is scheduled.
+        Signals that arrive while a dump is being written are coalesced.
+        This member function is only supported on POSIX systems and throws
+        an exception elsewhere.
+        */
+        void dump_on_signal(int signum, std::string path, ObserverType type = ObserverType::TFPROF);
+
+        /**
+        @brief clears the kept segments
+
+        This member function is thread-safe.
+        */
+        void clear();
+
+        /**
+        @brief queries the number of segments kept by all the workers
+        */
+        size_t num_tasks() const;
+
+    private:
+
+        const size_t _capacity;
+        const size_t _period;
+
+        size_t _uid{0};
+        observer_stamp_t _origin;
+        size_t _num_workers{0};
+        std::unique_ptr<Ring[]> _rings;
+
+        void set_up(size_t num_workers) override final;
+
+        void on_entry(WorkerView, TaskView) override final;
+
+        void on_exit(WorkerView, TaskView) override final;
+
+        Timeline _snapshot() const;
+    };
+
+/**
+@private
+
+Process-wide dispatcher of the signals registered through
+SamplingObserver::dump_on_signal. The signal handler writes the signal
+number to a pipe, the only thing it can safely do, and a background
+thread reads the pipe and dumps the observers registered for that signal.
+The write end is non-blocking, so a burst of signals during a long dump
+drops bytes instead of blocking the interrupted thread, which may be a worker.
+Handlers found in place are chained to.
+The dispatcher is never destroyed so that observers can outlive
+static destruction.
+*/
+    class SignalDumper {
+
+    public:
+
+        static SignalDumper &get() {
+            static SignalDumper *dumper = new SignalDumper();
+            return *dumper;
+        }
+
+        void add(int signum, const SamplingObserver *observer, std::string path, ObserverType type);
+
+        void remove(const SamplingObserver *observer);
+
+    private:
+
+        struct Entry {
+            int signum;
+            const SamplingObserver *observer;
+            std::string path;
+            ObserverType type;
+        };
+
+        std::mutex _mutex;
+        std::vector<Entry> _entries;
+        std::vector<int> _signals;
+
+        inline static std::atomic<int> _fd{-1};
+
+        SignalDumper() = default;
+
+#if TF_OS_UNIX
+        // the actions replaced by _handler, indexed by signal number
+        inline static struct sigaction _old_actions[NSIG]{};
+
+        static void _handler(int signum, siginfo_t *info, void *context);
+#endif
+
+        void _loop(int fd);
+    };
+
+// constructor
+    inline SamplingObserver::SamplingObserver(size_t capacity, size_t period) :
+            _capacity{capacity},
+            _period{period} {
+        if (capacity == 0 || period == 0) {
+            TF_THROW("sampling observer must have a non-zero capacity and period");
+        }
+    }
+
+// destructor
+    inline SamplingObserver::~SamplingObserver() {
+        SignalDumper::get().remove(this);
+    }
+
+// Function: capacity
+    inline size_t SamplingObserver::capacity() const noexcept {
+        return _capacity;
+    }
+
+// Function: period
+    inline size_t SamplingObserver::period() const noexcept {
+        return _period;
+    }
+
+// Procedure: set_up
+    inline void SamplingObserver::set_up(size_t num_workers) {
+        _uid = unique_id<size_t>();
+        _origin = observer_stamp_t::clock::now();
+        _num_workers = num_workers;
+        _rings = std::make_unique<Ring[]>(num_workers);
+        for (size_t w = 0; w < num_workers; ++w) {
+            _rings[w].samples.resize(_capacity);
+            _rings[w].stack.reserve(32);
+        }
+    }
+
+// Procedure: on_entry
+    inline void SamplingObserver::on_entry(WorkerView wv, TaskView) {
+        auto &ring = _rings[wv.id()];
+        // the stack is kept for every task so that levels stay correct
+        ring.stack.push_back(
+                ring.seen++ % _period == 0 ? observer_stamp_t::clock::now() : observer_stamp_t{}
+        );
+    }
+
+// Procedure: on_exit
+    inline void SamplingObserver::on_exit(WorkerView wv, TaskView tv) {
+
+        auto &ring = _rings[wv.id()];
+
+        assert(!ring.stack.empty());
+
+        auto beg = ring.stack.back();
+        ring.stack.pop_back();
+
+        if (beg == observer_stamp_t{}) {
+            return;
+        }
+
+        auto end = observer_stamp_t::clock::now();
+
+        std::lock_guard lock(ring.mutex);
+        // reuse the slot so that its name does not allocate once warmed up
+        auto &s = ring.samples[ring.head++ % _capacity];
+        s.segment.name = tv.name();
+        s.segment.type = tv.type();
+        s.segment.beg = beg;
+        s.segment.end = end;
+        s.level = ring.stack.size();
+    }
+
+// Function: _snapshot
+    inline Timeline SamplingObserver::_snapshot() const {
+
+        Timeline timeline;
+        timeline.uid = _uid;
+        timeline.origin = _origin;
+        timeline.segments.resize(_num_workers);
+
+        for (size_t w = 0; w < _num_workers; ++w) {
+            auto &ring = _rings[w];
+            std::lock_guard lock(ring.mutex);
+            // oldest first, as recorded by TFProfObserver
+            size_t n = std::min(ring.head, _capacity);
+            for (size_t i = ring.head - n; i < ring.head; ++i) {
+                const auto &s = ring.samples[i % _capacity];
+                if (s.level >= timeline.segments[w].size()) {
+                    timeline.segments[w].resize(s.level + 1);
+                }
+                timeline.segments[w][s.level].push_back(s.segment);
+            }
+        }
+
+        return timeline;
+    }
+
+// Procedure: dump
+    inline void SamplingObserver::dump(std::ostream &os) const {
+        dump_tfprof(os, _snapshot());
+    }
+
+// Function: dump
+    inline std::string SamplingObserver::dump() const {
+        std::ostringstream oss;
+        dump(oss);
+        return oss.str();
+    }
+
+// Procedure: dump_chrome
+    inline void SamplingObserver::dump_chrome(std::ostream &os) const {
+
+        using namespace std::chrono;
+
+        auto timeline = _snapshot();
+
+        os << '[';
+
+        bool comma = false;
+
+        for (size_t w = 0; w < timeline.segments.size(); w++) {
+            for (size_t l = 0; l < timeline.segments[w].size(); l++) {
+                for (size_t i = 0; i < timeline.segments[w][l].size(); ++i) {
+
+                    const auto &s = timeline.segments[w][l][i];
+
+                    if (comma) {
+                        os << ',';
+                    } else {
+                        comma = true;
+                    }
+
+                    os << '{' << "\"cat\":\"SamplingObserver\",";
+
+                    // name field
+                    os << "\"name\":\"";
+                    if (s.name.empty()) {
+                        os << w << '_' << i;
+                    } else {
+                        os << s.name;
+                    }
+                    os << "\",";
+
+                    // segment field
+                    os << "\"ph\":\"X\","
+                       << "\"pid\":1,"
+                       << "\"tid\":" << w << ','
+                       << "\"ts\":" << duration_cast<microseconds>(s.beg - timeline.origin).count() << ','
+                       << "\"dur\":" << duration_cast<microseconds>(s.end - s.beg).count()
+                       << '}';
+                }
+            }
+        }
+        os << "]\n";
+    }
+
+// Function: dump_chrome
+    inline std::string SamplingObserver::dump_chrome() const {
+        std::ostringstream oss;
+        dump_chrome(oss);
+        return oss.str();
+    }
+
+// Procedure: dump_on_signal
+    inline void SamplingObserver::dump_on_signal(int signum, std::string path, ObserverType type) {
+        if (type != ObserverType::TFPROF && type != ObserverType::CHROME) {
+            TF_THROW("sampling observer can only dump to tfprof or chrome format");
+        }
+        SignalDumper::get().add(signum, this, std::move(path), type);
+    }
+
+// Procedure: clear
+    inline void SamplingObserver::clear() {
+        for (size_t w = 0; w < _num_workers; ++w) {
+            std::lock_guard lock(_rings[w].mutex);
+            _rings[w].head = 0;
+        }
+    }
+
+// Function: num_tasks
+    inline size_t SamplingObserver::num_tasks() const {
+        size_t n = 0;
+        for (size_t w = 0; w < _num_workers; ++w) {
+            std::lock_guard lock(_rings[w].mutex);
+            n += std::min(_rings[w].head, _capacity);
+        }
+        return n;
+    }
+
+// Procedure: add
+    inline void SignalDumper::add(
+            int signum, const SamplingObserver *observer, std::string path, ObserverType type
+    ) {
+#if TF_OS_UNIX
+        std::lock_guard lock(_mutex);
+
+        // the first registration creates the pipe and the dumping thread
+        if (_fd.load(std::memory_order_relaxed) == -1) {
+            int fds[2];
+            if (::pipe(fds) != 0) {
+                TF_THROW("failed to create the pipe to dump observers on signals");
+            }
+            ::fcntl(fds[0], F_SETFD, FD_CLOEXEC);
+            ::fcntl(fds[1], F_SETFD, FD_CLOEXEC);
+            ::fcntl(fds[1], F_SETFL, ::fcntl(fds[1], F_GETFL) | O_NONBLOCK);
+            _fd.store(fds[1], std::memory_order_release);
+            std::thread(&SignalDumper::_loop, this, fds[0]).detach();
+        }
+
+        if (std::find(_signals.begin(), _signals.end(), signum) == _signals.end()) {
+            if (signum <= 0 || signum >= NSIG) {
+                TF_THROW("invalid signal ", signum);
+            }
+            struct sigaction sa {};
+            sa.sa_sigaction = &SignalDumper::_handler;
+            sigemptyset(&sa.sa_mask);
+            sa.sa_flags = SA_RESTART | SA_SIGINFO;
+            if (::sigaction(signum, &sa, &_old_actions[signum]) != 0) {
+                TF_THROW("failed to install the handler of signal ", signum);
+            }
+            _signals.push_back(signum);
+        }
+
+        _entries.push_back(Entry{signum, observer, std::move(path), type});
+#else
+        TF_THROW("dumping observers on signals is not supported on this platform");
+#endif
+    }
+
+// Procedure: remove
+    inline void SignalDumper::remove(const SamplingObserver *observer) {
+        // waits for a dump of the observer in progress
+        std::lock_guard lock(_mutex);
+        _entries.erase(
+                std::remove_if(_entries.begin(), _entries.end(), [&](const Entry &e) {
+                    return e.observer == observer;
+                }),
+                _entries.end()
+        );
+    }
+
+#if TF_OS_UNIX
+// Procedure: _handler
+    inline void SignalDumper::_handler(int signum, siginfo_t *info, void *context) {
+        int saved = errno;
+        unsigned char c = static_cast<unsigned char>(signum);
+        // a full pipe fails with EAGAIN: a dump is pending anyway
+        [[maybe_unused]] auto r = ::write(_fd.load(std::memory_order_acquire), &c, 1);
+        errno = saved;
+
+        // chain to the handler that was installed before, but not to the
+        // default action, which would usually terminate the process
+        const auto &old = _old_actions[signum];
+        if (old.sa_flags & SA_SIGINFO) {
+            if (old.sa_sigaction) {
+                old.sa_sigaction(signum, info, context);
+            }
+        } else if (old.sa_handler != SIG_DFL && old.sa_handler != SIG_IGN) {
+            old.sa_handler(signum);
+        }
+    }
+#endif
+
+// Procedure: _loop
+    inline void SignalDumper::_loop([[maybe_unused]] int fd) {
+#if TF_OS_UNIX
+        unsigned char c;
+        while (true) {
+            auto r = ::read(fd, &c, 1);
+            if (r < 0 && errno == EINTR) {
+                continue;
+            }
+            if (r <= 0) {
+                break;
+            }
+            std::lock_guard lock(_mutex);
+            for (const auto &e: _entries) {
+                if (e.signum != static_cast<int>(c)) {
+                    continue;
+                }
+                std::ofstream ofs(e.path);
+                if (e.type == ObserverType::CHROME) {
+                    e.observer->dump_chrome(ofs);
+                } else {
+                    e.observer->dump(ofs);
+                }
+            }
+        }
+#endif
+    }
+
+
 }  // end of namespace collie::tf -----------------------------------------------------
 
 
@@ -599,6 +599,8 @@ namespace collie::tf {
 
         friend class Runtime;
 
+        template<typename U> friend struct detail::FutureAwaiter;
+
     public:
 
         /**
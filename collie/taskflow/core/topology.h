@@ -39,10 +39,18 @@ namespace collie::tf {
         friend
         class Future;
 
+        template<typename T>
+        friend
+        struct detail::FutureAwaiter;
+
         constexpr static int CLEAN = 0;
         constexpr static int CANCELLED = 1;
         constexpr static int EXCEPTION = 2;
 
+        constexpr static int PENDING = 0;
+        constexpr static int READY = 1;
+        constexpr static int AWAITED = 2;
+
     public:
 
         template<typename P, typename C>
@@ -66,7 +74,16 @@ namespace collie::tf {
 
         std::exception_ptr _exception_ptr{nullptr};
 
+        // callback of a coroutine suspended on the future before the promise is set
+        std::atomic<int> _await_status{PENDING};
+        void (*_callback)(void *){nullptr};
+        void *_callback_arg{nullptr};
+
         void _carry_out_promise();
+
+        void _complete();
+
+        bool _set_callback(void (*)(void *), void *);
     };
 
 // Constructor
@@ -86,6 +103,25 @@ namespace collie::tf {
         } else {
             _promise.set_value();
         }
+        _complete();
+    }
+
+// Procedure: _complete
+// invokes the callback registered before the promise was set, if any
+    inline void Topology::_complete() {
+        if (_await_status.exchange(READY) == AWAITED) {
+            _callback(_callback_arg);
+        }
+    }
+
+// Function: _set_callback
+// registers the callback to invoke when the promise is set,
+// or returns false if the promise is already set
+    inline bool Topology::_set_callback(void (*callback)(void *), void *arg) {
+        _callback = callback;
+        _callback_arg = arg;
+        int expected = PENDING;
+        return _await_status.compare_exchange_strong(expected, AWAITED);
     }
 
 // Function: cancelled
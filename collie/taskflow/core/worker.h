@@ -21,6 +21,8 @@
 #include <collie/taskflow/core/declarations.h>
 #include <collie/taskflow/core/tsq.h>
 #include <collie/taskflow/core/notifier.h>
+#include <collie/taskflow/core/metrics.h>
+#include <collie/taskflow/utility/cpu_topology.h>
 
 /**
 @file worker.hpp
@@ -29,6 +31,309 @@
 
 namespace collie::tf {
 
+// ----------------------------------------------------------------------------
+// Class Definition: WorkerAffinity
+// ----------------------------------------------------------------------------
+
+/**
+@class WorkerAffinity
+
+@brief class to describe how the workers of an executor are pinned to cpus
+
+By default workers are not pinned and steal from random victims.
+When workers are pinned, each worker steals from the workers closest to it
+first: the workers on its hardware-thread siblings, then the workers sharing
+its last level cache, then the workers on its NUMA node, and only then the
+remote workers.
+
+@code{.cpp}
+// one worker per cpu, filling the cores of a NUMA node before the next one
+collie::tf::Executor executor(16, collie::tf::WorkerAffinity::compact());
+
+// keep all the workers on the first NUMA node
+collie::tf::Executor executor(8, collie::tf::WorkerAffinity::numa_nodes({0}));
+
+// pin worker i to cpu 2*i
+collie::tf::Executor executor(4, collie::tf::WorkerAffinity::cpus({0, 2, 4, 6}));
+@endcode
+
+Pinning is only supported on Linux and is silently ignored elsewhere.
+*/
+class WorkerAffinity {
+
+  public:
+
+    /**
+    @brief constructs an affinity that does not pin the workers
+    */
+    WorkerAffinity() = default;
+
+    /**
+    @brief does not pin the workers
+    */
+    static WorkerAffinity none() { return WorkerAffinity(); }
+
+    /**
+    @brief pins the workers to all the allowed cpus, one worker per core
+           of a NUMA node before using hardware-thread siblings or
+           the next NUMA node
+    */
+    static WorkerAffinity compact() {
+      WorkerAffinity a;
+      a._kind = COMPACT;
+      return a;
+    }
+
+    /**
+    @brief pins worker @c i to cpu <tt>cpus[i % cpus.size()]</tt>
+    */
+    static WorkerAffinity cpus(std::vector<size_t> cpus) {
+      WorkerAffinity a;
+      a._kind = cpus.empty() ? NONE : CPUS;
+      a._ids = std::move(cpus);
+      return a;
+    }
+
+    /**
+    @brief pins the workers to the cpus of the given NUMA nodes,
+           placed as with WorkerAffinity::compact
+    */
+    static WorkerAffinity numa_nodes(std::vector<size_t> nodes) {
+      WorkerAffinity a;
+      a._kind = nodes.empty() ? NONE : NODES;
+      a._ids = std::move(nodes);
+      return a;
+    }
+
+    /**
+    @brief queries if the workers are pinned
+    */
+    bool pinned() const { return _kind != NONE; }
+
+    /**
+    @brief assigns a cpu to each of the @c N workers
+
+    @return the cpu of each worker, or an empty vector if the workers are not pinned
+    */
+    std::vector<CpuInfo> assign(size_t N, const CpuTopology& topology) const;
+
+  private:
+
+    enum Kind { NONE, COMPACT, CPUS, NODES };
+
+    Kind _kind {NONE};
+    std::vector<size_t> _ids;
+};
+
+// Function: assign
+inline std::vector<CpuInfo> WorkerAffinity::assign(size_t N, const CpuTopology& topology) const {
+
+  std::vector<CpuInfo> order;
+
+  switch(_kind) {
+    case NONE:
+      return order;
+
+    case CPUS:
+      for(auto id : _ids) {
+        auto info = topology.find(id);
+        // an unknown cpu is considered remote to all the others
+        order.push_back(info ? *info : CpuInfo{id, id, id, id});
+      }
+    break;
+
+    case COMPACT:
+    case NODES: {
+      // rank of each cpu among its hardware-thread siblings
+      std::vector<std::pair<size_t, CpuInfo>> ranked;
+      for(const auto& c : topology.cpus()) {
+        if(_kind == NODES && std::find(_ids.begin(), _ids.end(), c.node) == _ids.end()) {
+          continue;
+        }
+        size_t rank = 0;
+        for(const auto& r : ranked) {
+          rank += (r.second.core == c.core);
+        }
+        ranked.emplace_back(rank, c);
+      }
+      std::stable_sort(ranked.begin(), ranked.end(), [](const auto& a, const auto& b){
+        if(a.second.node != b.second.node) return a.second.node < b.second.node;
+        if(a.first != b.first) return a.first < b.first;
+        return a.second.llc < b.second.llc;
+      });
+      for(const auto& r : ranked) {
+        order.push_back(r.second);
+      }
+    }
+    break;
+  }
+
+  if(order.empty()) {
+    return order;
+  }
+
+  std::vector<CpuInfo> cpus(N);
+  for(size_t i = 0; i < N; ++i) {
+    cpus[i] = order[i % order.size()];
+  }
+  return cpus;
+}
+
+// ----------------------------------------------------------------------------
+// Class Definition: IdlePolicy
+// ----------------------------------------------------------------------------
+
+/**
+@class IdlePolicy
+
+@brief class to describe what a worker does when it runs out of tasks
+
+A worker that runs out of tasks first tries to steal from each of the other
+workers a couple of times. If this fails, it keeps stealing while idling for
+a number of rounds, its @em budget, before it parks on the executor's notifier
+until new tasks are submitted. How a worker idles in each round depends
+on the policy:
+
+  + IdlePolicy::yield yields the thread to the operating system for up to
+    100 rounds (default, the executor's original behavior)
+  + IdlePolicy::spin busy-spins with a cpu pause instruction
+  + IdlePolicy::backoff spins for an exponentially growing number of pauses
+    and then yields
+  + IdlePolicy::park does not idle at all and parks immediately
+
+The budget is fixed at @c max_budget rounds unless the policy is made
+adaptive. An adaptive budget starts at @c max_budget and moves within
+<tt>[min_budget, max_budget]</tt> for each worker: it doubles when a steal
+succeeds while idling and halves when the worker parks without finding
+a task.
+Spinning trades cpu time for wake-up latency and suits dedicated machines
+running bursty workloads, while parking suits shared hosts.
+
+@code{.cpp}
+collie::tf::Executor executor(8, collie::tf::IdlePolicy::spin().max_budget(4096).adaptive(true));
+@endcode
+*/
+class IdlePolicy {
+
+  public:
+
+    /**
+    @brief enumeration of the ways a worker idles
+    */
+    enum Kind { YIELD, SPIN, BACKOFF, PARK };
+
+    /**
+    @brief constructs the default policy, IdlePolicy::yield
+    */
+    IdlePolicy() = default;
+
+    /**
+    @brief yields the thread in each idle round
+    */
+    static IdlePolicy yield() { return IdlePolicy(YIELD, 8, 100); }
+
+    /**
+    @brief busy-spins with a cpu pause instruction in each idle round
+    */
+    static IdlePolicy spin() { return IdlePolicy(SPIN, 64, 1024); }
+
+    /**
+    @brief spins for <tt>2^round</tt> pauses in each idle round and yields
+           the thread once the number of pauses reaches 64
+    */
+    static IdlePolicy backoff() { return IdlePolicy(BACKOFF, 8, 64); }
+
+    /**
+    @brief parks the worker as soon as stealing fails
+    */
+    static IdlePolicy park() { return IdlePolicy(PARK, 0, 0); }
+
+    /**
+    @brief queries the way a worker idles
+    */
+    Kind kind() const { return _kind; }
+
+    /**
+    @brief queries the minimum number of idle rounds before parking
+    */
+    size_t min_budget() const { return _min_budget; }
+
+    /**
+    @brief sets the minimum number of idle rounds before parking
+    */
+    IdlePolicy& min_budget(size_t n) {
+      _min_budget = n;
+      _max_budget = std::max(_max_budget, n);
+      return *this;
+    }
+
+    /**
+    @brief queries the maximum number of idle rounds before parking
+    */
+    size_t max_budget() const { return _max_budget; }
+
+    /**
+    @brief sets the maximum number of idle rounds before parking
+    */
+    IdlePolicy& max_budget(size_t n) {
+      _max_budget = n;
+      _min_budget = std::min(_min_budget, n);
+      return *this;
+    }
+
+    /**
+    @brief queries whether the budget of each worker adapts to the workload
+    */
+    bool adaptive() const { return _adaptive; }
+
+    /**
+    @brief enables or disables the adaptive budget, disabled by default
+    */
+    IdlePolicy& adaptive(bool on) {
+      _adaptive = on;
+      return *this;
+    }
+
+    /**
+    @brief idles for the given round
+    */
+    void idle(size_t round) const {
+      switch(_kind) {
+        case SPIN:
+          relax_cpu();
+        break;
+
+        case BACKOFF:
+          if(round < 6) {
+            for(size_t i = 0; i < (size_t{1} << round); ++i) {
+              relax_cpu();
+            }
+            break;
+          }
+          std::this_thread::yield();
+        break;
+
+        case YIELD:
+          std::this_thread::yield();
+        break;
+
+        case PARK:
+        break;
+      }
+    }
+
+  private:
+
+    IdlePolicy(Kind kind, size_t min_budget, size_t max_budget) :
+      _kind {kind}, _min_budget {min_budget}, _max_budget {max_budget} {
+    }
+
+    Kind _kind {YIELD};
+    size_t _min_budget {8};
+    size_t _max_budget {100};
+    bool _adaptive {false};
+};
+
 // ----------------------------------------------------------------------------
 // Class Definition: Worker
 // ----------------------------------------------------------------------------
@@ -75,16 +380,64 @@ class Worker {
     */
     inline size_t queue_capacity() const { return static_cast<size_t>(_wsq.capacity()); }
 
+    /**
+    @brief queries the cpu the worker is pinned to, or @c -1 if not pinned
+    */
+    inline int cpu() const { return _cpu; }
+
+    /**
+    @brief queries the number of tasks the worker has stolen
+    */
+    inline size_t num_steals() const { return _counters.num_steals.load(std::memory_order_relaxed); }
+
+    /**
+    @brief queries the number of steal attempts that found no task
+    */
+    inline size_t num_failed_steals() const { return _counters.num_failed_steals.load(std::memory_order_relaxed); }
+
+    /**
+    @brief queries the number of times the worker parked on the notifier
+    */
+    inline size_t num_parks() const { return _counters.num_parks.load(std::memory_order_relaxed); }
+
+    /**
+    @brief queries the number of times the worker was woken up from parking
+    */
+    inline size_t num_wakeups() const { return _counters.num_wakeups.load(std::memory_order_relaxed); }
+
+    /**
+    @brief queries the number of tasks the worker has run
+    */
+    inline size_t num_tasks() const { return _counters.num_tasks.load(std::memory_order_relaxed); }
+
+    /**
+    @brief queries the largest number of tasks seen in the queue of the worker
+    */
+    inline size_t queue_high_water() const { return _counters.queue_high_water.load(std::memory_order_relaxed); }
+
   private:
 
     size_t _id;
     size_t _vtm;
+    int _cpu {-1};
+    // steal victims ordered by distance (the worker itself comes first and
+    // stands for the shared queue) and the end of each distance tier
+    std::vector<size_t> _victims;
+    std::vector<size_t> _victim_tiers;
     Executor* _executor;
     std::thread* _thread;
     Notifier::Waiter* _waiter;
     std::default_random_engine _rdgen { std::random_device{}() };
     TaskQueue<Node*> _wsq;
     Node* _cache;
+    // number of idle rounds before parking, adapted by the executor
+    size_t _idle_budget {0};
+    // nesting depth of the tasks being run, deeper than one when a task
+    // coruns other tasks, so that busy time is only counted once
+    size_t _depth {0};
+    // counters are only written by the worker itself and can be read
+    // from any thread
+    WorkerCounters _counters;
 };
 
 // ----------------------------------------------------------------------------
@@ -156,6 +509,41 @@ class WorkerView {
     */
     size_t queue_capacity() const;
 
+    /**
+    @brief queries the cpu the worker is pinned to, or @c -1 if not pinned
+    */
+    int cpu() const;
+
+    /**
+    @brief queries the number of tasks the worker has stolen
+    */
+    size_t num_steals() const;
+
+    /**
+    @brief queries the number of steal attempts that found no task
+    */
+    size_t num_failed_steals() const;
+
+    /**
+    @brief queries the number of times the worker parked on the notifier
+    */
+    size_t num_parks() const;
+
+    /**
+    @brief queries the number of times the worker was woken up from parking
+    */
+    size_t num_wakeups() const;
+
+    /**
+    @brief queries the number of tasks the worker has run
+    */
+    size_t num_tasks() const;
+
+    /**
+    @brief queries the largest number of tasks seen in the queue of the worker
+    */
+    size_t queue_high_water() const;
+
   private:
 
     WorkerView(const Worker&);
@@ -184,6 +572,41 @@ inline size_t WorkerView::queue_capacity() const {
   return static_cast<size_t>(_worker._wsq.capacity());
 }
 
+// Function: cpu
+inline int WorkerView::cpu() const {
+  return _worker._cpu;
+}
+
+// Function: num_steals
+inline size_t WorkerView::num_steals() const {
+  return _worker.num_steals();
+}
+
+// Function: num_failed_steals
+inline size_t WorkerView::num_failed_steals() const {
+  return _worker.num_failed_steals();
+}
+
+// Function: num_parks
+inline size_t WorkerView::num_parks() const {
+  return _worker.num_parks();
+}
+
+// Function: num_wakeups
+inline size_t WorkerView::num_wakeups() const {
+  return _worker.num_wakeups();
+}
+
+// Function: num_tasks
+inline size_t WorkerView::num_tasks() const {
+  return _worker.num_tasks();
+}
+
+// Function: queue_high_water
+inline size_t WorkerView::queue_high_water() const {
+  return _worker.queue_high_water();
+}
+
 
 }  // end of namespact tf -----------------------------------------------------
 
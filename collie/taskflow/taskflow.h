@@ -19,6 +19,7 @@
 
 #include <collie/taskflow/core/executor.h>
 #include <collie/taskflow/core/async.h>
+#include <collie/taskflow/core/coroutine.h>
 #include <collie/taskflow/algorithm/critical.h>
 
 /**
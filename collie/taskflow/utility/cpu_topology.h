@@ -0,0 +1,309 @@
+//
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <collie/taskflow/utility/os.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if TF_OS_LINUX
+#include <dirent.h>
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+/**
+@file cpu_topology.h
+@brief cpu topology include file
+*/
+
+namespace collie::tf {
+
+/**
+@struct CpuInfo
+
+@brief location of a logical cpu in the machine topology
+
+Two cpus with the same @c core are hardware-thread siblings,
+two cpus with the same @c llc share the last level cache, and
+two cpus with the same @c node belong to the same NUMA node.
+*/
+struct CpuInfo {
+  size_t cpu  {0};
+  size_t core {0};
+  size_t llc  {0};
+  size_t node {0};
+};
+
+/**
+@class CpuTopology
+
+@brief class to query the logical cpus of the machine and their location
+
+On Linux the topology is read from @c /sys/devices/system/cpu and restricted
+to the cpus the process is allowed to run on.
+On other systems, or if the topology cannot be read, every cpu reported by
+std::thread::hardware_concurrency is its own core on a single node.
+
+@code{.cpp}
+auto topo = collie::tf::CpuTopology::detect();
+for(const auto& c : topo.cpus()) {
+  printf("cpu %zu: core %zu, llc %zu, node %zu\n", c.cpu, c.core, c.llc, c.node);
+}
+@endcode
+*/
+class CpuTopology {
+
+  public:
+
+    /**
+    @brief constructs an empty topology
+    */
+    CpuTopology() = default;
+
+    /**
+    @brief constructs a topology from the given cpus
+    */
+    explicit CpuTopology(std::vector<CpuInfo> cpus) : _cpus{std::move(cpus)} {
+      std::sort(_cpus.begin(), _cpus.end(), [](const CpuInfo& a, const CpuInfo& b){
+        return a.cpu < b.cpu;
+      });
+    }
+
+    /**
+    @brief detects the topology of the cpus this process is allowed to run on
+    */
+    static CpuTopology detect();
+
+    /**
+    @brief reads the topology of the online cpus from a sysfs cpu directory
+
+    Returns an empty topology if the directory cannot be read.
+    */
+    static CpuTopology read_sysfs(const std::string& root);
+
+    /**
+    @brief parses a cpu list such as @c "0-3,8,10-11"
+    */
+    static std::vector<size_t> parse_cpu_list(const std::string& str);
+
+    /**
+    @brief queries the logical cpus sorted by id
+    */
+    const std::vector<CpuInfo>& cpus() const { return _cpus; }
+
+    /**
+    @brief queries the number of logical cpus
+    */
+    size_t size() const { return _cpus.size(); }
+
+    /**
+    @brief queries if the topology has no cpu
+    */
+    bool empty() const { return _cpus.empty(); }
+
+    /**
+    @brief finds the information of the given cpu, or nullptr if unknown
+    */
+    const CpuInfo* find(size_t cpu) const {
+      auto itr = std::lower_bound(_cpus.begin(), _cpus.end(), cpu,
+        [](const CpuInfo& c, size_t id){ return c.cpu < id; }
+      );
+      return (itr != _cpus.end() && itr->cpu == cpu) ? &(*itr) : nullptr;
+    }
+
+    /**
+    @brief queries the distance between two cpus
+
+    The distance is @c 0 for hardware-thread siblings, @c 1 for cpus sharing
+    the last level cache, @c 2 for cpus of the same NUMA node and @c 3 otherwise.
+    */
+    static size_t distance(const CpuInfo& a, const CpuInfo& b) {
+      if(a.node != b.node) return 3;
+      if(a.llc  != b.llc ) return 2;
+      if(a.core != b.core) return 1;
+      return 0;
+    }
+
+  private:
+
+    std::vector<CpuInfo> _cpus;
+
+    static bool _read_line(const std::string& path, std::string& line);
+    static bool _read_number(const std::string& path, size_t& value);
+};
+
+// Function: parse_cpu_list
+inline std::vector<size_t> CpuTopology::parse_cpu_list(const std::string& str) {
+
+  std::vector<size_t> cpus;
+  size_t i = 0;
+
+  auto number = [&](size_t& v) {
+    size_t beg = i;
+    v = 0;
+    while(i < str.size() && str[i] >= '0' && str[i] <= '9') {
+      v = v*10 + static_cast<size_t>(str[i++] - '0');
+    }
+    return i > beg;
+  };
+
+  while(i < str.size()) {
+    size_t lo, hi;
+    if(!number(lo)) {
+      ++i;
+      continue;
+    }
+    hi = lo;
+    if(i < str.size() && str[i] == '-') {
+      ++i;
+      if(!number(hi)) {
+        hi = lo;
+      }
+    }
+    for(size_t c = lo; c <= hi; ++c) {
+      cpus.push_back(c);
+    }
+  }
+
+  return cpus;
+}
+
+// Function: _read_line
+inline bool CpuTopology::_read_line(const std::string& path, std::string& line) {
+  std::ifstream ifs(path);
+  return ifs && std::getline(ifs, line);
+}
+
+// Function: _read_number
+inline bool CpuTopology::_read_number(const std::string& path, size_t& value) {
+  std::string line;
+  if(!_read_line(path, line)) {
+    return false;
+  }
+  auto cpus = parse_cpu_list(line);
+  if(cpus.empty()) {
+    return false;
+  }
+  value = cpus.front();
+  return true;
+}
+
+// Function: read_sysfs
+inline CpuTopology CpuTopology::read_sysfs(const std::string& root) {
+
+  std::vector<CpuInfo> infos;
+
+#if TF_OS_LINUX
+  std::string online;
+  if(!_read_line(root + "/online", online)) {
+    return CpuTopology();
+  }
+
+  for(auto cpu : parse_cpu_list(online)) {
+
+    std::string dir = root + "/cpu" + std::to_string(cpu);
+    CpuInfo info;
+    info.cpu = cpu;
+
+    // core_id is only unique within a package, so a core is identified
+    // by the first cpu of its sibling list
+    if(!_read_number(dir + "/topology/thread_siblings_list", info.core) &&
+       !_read_number(dir + "/topology/core_cpus_list", info.core)) {
+      info.core = cpu;
+    }
+
+    size_t package = 0;
+    _read_number(dir + "/topology/physical_package_id", package);
+
+    // the last level cache is identified by the first cpu sharing
+    // the highest cache level
+    info.llc = package;
+    for(size_t index = 0, max_level = 0; ; ++index) {
+      std::string cache = dir + "/cache/index" + std::to_string(index);
+      size_t level, first;
+      if(!_read_number(cache + "/level", level)) {
+        break;
+      }
+      if(level >= 2 && level >= max_level &&
+         _read_number(cache + "/shared_cpu_list", first)) {
+        info.llc = first;
+        max_level = level;
+      }
+    }
+
+    // the numa node is exposed as a nodeN entry in the cpu directory
+    info.node = package;
+    if(DIR* d = ::opendir(dir.c_str()); d) {
+      while(auto e = ::readdir(d)) {
+        std::string name(e->d_name);
+        if(name.size() > 4 && name.compare(0, 4, "node") == 0 &&
+           name.find_first_not_of("0123456789", 4) == std::string::npos) {
+          info.node = std::stoul(name.substr(4));
+          break;
+        }
+      }
+      ::closedir(d);
+    }
+
+    infos.push_back(info);
+  }
+#else
+  (void)root;
+#endif
+
+  return CpuTopology(std::move(infos));
+}
+
+// Function: detect
+inline CpuTopology CpuTopology::detect() {
+
+  auto topo = read_sysfs("/sys/devices/system/cpu");
+
+#if TF_OS_LINUX
+  cpu_set_t allowed;
+  CPU_ZERO(&allowed);
+  if(sched_getaffinity(0, sizeof(allowed), &allowed) == 0) {
+    topo._cpus.erase(
+      std::remove_if(topo._cpus.begin(), topo._cpus.end(), [&](const CpuInfo& c){
+        return c.cpu >= CPU_SETSIZE || !CPU_ISSET(c.cpu, &allowed);
+      }),
+      topo._cpus.end()
+    );
+  }
+#endif
+
+  if(topo.empty()) {
+    size_t N = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<CpuInfo> infos;
+    for(size_t cpu = 0; cpu < N; ++cpu) {
+      infos.push_back(CpuInfo{cpu, cpu, 0, 0});
+    }
+    topo = CpuTopology(std::move(infos));
+  }
+
+  return topo;
+}
+
+}  // end of namespace collie::tf -----------------------------------------------
@@ -0,0 +1,306 @@
+//
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <collie/container/iterator.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+
+/**
+@file index_range.h
+@brief multi-dimensional index range include file
+*/
+
+namespace collie::tf {
+
+/**
+@class IndexRange
+
+@brief class to describe a @c D-dimensional iteration space split into tiles
+
+@tparam T integral index type
+@tparam D number of dimensions
+
+Each dimension @c d iterates the indices <tt>[begin(d), end(d))</tt> with
+the step size <tt>step(d)</tt>, following the same rules as
+collie::tf::FlowBuilder::for_each_index.
+Dimension @c D-1 is the innermost (contiguous) one.
+
+The space is split into rectangular tiles of <tt>tile_size(d)</tt> indices
+along each dimension, which collie::tf::FlowBuilder::for_each_index hands out
+to the workers as the unit of scheduling.
+When no tile size is given, the tiles cover up to @c default_tile_items
+indices and at most @c default_tile_width indices along the innermost dimension,
+so the data touched by a tile stays in the L1/L2 cache for the common element sizes.
+
+@code{.cpp}
+// iterate a 1024x768 image in tiles of 16x256 pixels
+collie::tf::IndexRange2D<int> range({0, 0}, {768, 1024});
+range.tile_size({16, 256});
+@endcode
+*/
+template <typename T, size_t D>
+class IndexRange {
+
+  static_assert(std::is_integral_v<T>, "index type must be integral");
+  static_assert(D >= 1, "index range must have at least one dimension");
+
+  public:
+
+    /**
+    @brief default number of indices covered by a tile
+    */
+    static constexpr size_t default_tile_items = 4096;
+
+    /**
+    @brief default maximum number of indices of a tile along the innermost dimension
+    */
+    static constexpr size_t default_tile_width = 256;
+
+    /**
+    @brief constructs an empty range
+    */
+    IndexRange() {
+      _begin.fill(0);
+      _end.fill(0);
+      _step.fill(1);
+      _tile.fill(0);
+    }
+
+    /**
+    @brief constructs a range of the indices <tt>[begin[d], end[d])</tt> with step size one
+    */
+    IndexRange(const std::array<T, D>& begin, const std::array<T, D>& end) :
+      _begin {begin}, _end {end} {
+      _step.fill(1);
+      _tile.fill(0);
+    }
+
+    /**
+    @brief constructs a range of the indices <tt>[begin[d], end[d])</tt> with step size @c step[d]
+    */
+    IndexRange(
+      const std::array<T, D>& begin, const std::array<T, D>& end, const std::array<T, D>& step
+    ) :
+      _begin {begin}, _end {end}, _step {step} {
+      _tile.fill(0);
+    }
+
+    /**
+    @brief queries the beginning index of dimension @c d
+    */
+    T begin(size_t d) const { return _begin[d]; }
+
+    /**
+    @brief queries the ending index of dimension @c d
+    */
+    T end(size_t d) const { return _end[d]; }
+
+    /**
+    @brief queries the step size of dimension @c d
+    */
+    T step(size_t d) const { return _step[d]; }
+
+    /**
+    @brief queries if any dimension is an invalid range
+    */
+    bool is_invalid() const {
+      for(size_t d=0; d<D; ++d) {
+        if(is_range_invalid(_begin[d], _end[d], _step[d])) {
+          return true;
+        }
+      }
+      return false;
+    }
+
+    /**
+    @brief queries the number of indices along dimension @c d
+    */
+    size_t size(size_t d) const {
+      return _begin[d] == _end[d] ? 0 : distance(_begin[d], _end[d], _step[d]);
+    }
+
+    /**
+    @brief queries the total number of indices in the range
+    */
+    size_t size() const {
+      size_t n = 1;
+      for(size_t d=0; d<D; ++d) {
+        n *= size(d);
+      }
+      return n;
+    }
+
+    /**
+    @brief queries if the range has no index
+    */
+    bool empty() const { return size() == 0; }
+
+    /**
+    @brief queries the tile sizes, where zero means the default tiling
+    */
+    const std::array<size_t, D>& tile_size() const { return _tile; }
+
+    /**
+    @brief sets the number of indices of a tile along each dimension
+
+    A zero size along any dimension selects the default tiling.
+    */
+    IndexRange& tile_size(const std::array<size_t, D>& tile) {
+      _tile = tile;
+      return *this;
+    }
+
+    /**
+    @brief queries the number of tiles along dimension @c d
+    */
+    size_t num_tiles(size_t d) const {
+      return (size(d) + _tile_at(d) - 1) / _tile_at(d);
+    }
+
+    /**
+    @brief queries the total number of tiles
+    */
+    size_t num_tiles() const {
+      size_t n = 1;
+      for(size_t d=0; d<D; ++d) {
+        n *= num_tiles(d);
+      }
+      return n;
+    }
+
+    /**
+    @brief returns the @c t-th tile in row-major order as an untiled range
+    */
+    IndexRange tile(size_t t) const {
+      IndexRange r;
+      for(size_t d=D; d-- > 0;) {
+        size_t nt = num_tiles(d);
+        size_t lo = (t % nt) * _tile_at(d);
+        size_t hi = std::min(lo + _tile_at(d), size(d));
+        t /= nt;
+        r._begin[d] = static_cast<T>(_begin[d] + static_cast<T>(lo) * _step[d]);
+        r._end[d]   = static_cast<T>(_begin[d] + static_cast<T>(hi) * _step[d]);
+        r._step[d]  = _step[d];
+        r._tile[d]  = hi - lo;
+      }
+      return r;
+    }
+
+    /**
+    @brief returns a copy of the range with the default tiling resolved
+           so that it has at least @c min_tiles tiles when possible
+
+    Tile sizes that were given explicitly are kept as they are.
+    */
+    IndexRange tiled(size_t min_tiles = 1) const {
+
+      IndexRange r(*this);
+
+      if(std::find(_tile.begin(), _tile.end(), 0) == _tile.end()) {
+        return r;
+      }
+
+      // fill the budget from the innermost dimension outwards
+      size_t budget = default_tile_items;
+      for(size_t d=D; d-- > 0;) {
+        size_t w = (d == D-1) ? std::min(budget, default_tile_width) : budget;
+        r._tile[d] = std::max(size_t{1}, std::min(size(d), w));
+        budget = std::max(size_t{1}, budget / r._tile[d]);
+      }
+
+      // split the outer dimensions first until every worker can get a tile
+      while(r.num_tiles() < min_tiles) {
+        size_t d = 0;
+        while(d < D && r._tile[d] == 1) {
+          ++d;
+        }
+        if(d == D) {
+          break;
+        }
+        r._tile[d] = (r._tile[d] + 1) / 2;
+      }
+
+      return r;
+    }
+
+    /**
+    @brief applies a callable to every index of the range in row-major order
+
+    The callable takes @c D arguments of the index type.
+    */
+    template <typename C>
+    void for_each(C&& c) const {
+      std::array<T, D> idx;
+      _for_each<0>(idx, c);
+    }
+
+  private:
+
+    std::array<T, D> _begin;
+    std::array<T, D> _end;
+    std::array<T, D> _step;
+    std::array<size_t, D> _tile;
+
+    size_t _tile_at(size_t d) const {
+      return _tile[d] == 0 ? std::max(size_t{1}, size(d)) : _tile[d];
+    }
+
+    template <size_t d, typename C>
+    void _for_each(std::array<T, D>& idx, C& c) const {
+      size_t n = size(d);
+      idx[d] = _begin[d];
+      for(size_t x=0; x<n; ++x, idx[d] += _step[d]) {
+        if constexpr(d + 1 == D) {
+          std::apply(c, idx);
+        }
+        else {
+          _for_each<d + 1>(idx, c);
+        }
+      }
+    }
+};
+
+/**
+@brief two-dimensional index range
+*/
+template <typename T>
+using IndexRange2D = IndexRange<T, 2>;
+
+/**
+@brief three-dimensional index range
+*/
+template <typename T>
+using IndexRange3D = IndexRange<T, 3>;
+
+// Trait: is_index_range
+template <typename R>
+struct is_index_range : std::false_type {};
+
+template <typename T, size_t D>
+struct is_index_range<IndexRange<T, D>> : std::true_type {};
+
+template <typename R>
+constexpr bool is_index_range_v = is_index_range<R>::value;
+
+}  // end of namespace collie::tf -----------------------------------------------------
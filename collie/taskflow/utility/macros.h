@@ -47,4 +47,11 @@
     }
 #endif
 
-// ----------------------------------------------------------------------------    
+// ----------------------------------------------------------------------------
+
+// coroutine tasks (collie::tf::co_task) need C++20 coroutine support
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+  #define TF_HAS_COROUTINE 1
+#else
+  #define TF_HAS_COROUTINE 0
+#endif
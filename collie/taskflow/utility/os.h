@@ -140,10 +140,10 @@
 //-----------------------------------------------------------------------------
 // pause
 //-----------------------------------------------------------------------------
-//#if __has_include (<immintrin.h>)
-//  #define TF_HAS_MM_PAUSE 1
-//  #include <immintrin.h>
-//#endif
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+  #define TF_HAS_MM_PAUSE 1
+  #include <immintrin.h>
+#endif
 
 namespace collie::tf {
 
@@ -193,11 +193,14 @@ inline bool has_env(const std::string& str) {
 }
 
 // Procedure: relax_cpu
-//inline void relax_cpu() {
-//#ifdef TF_HAS_MM_PAUSE
-//  _mm_pause();
-//#endif
-//}
+// hints the cpu that the caller is in a spin loop
+inline void relax_cpu() {
+#ifdef TF_HAS_MM_PAUSE
+  _mm_pause();
+#elif defined(__aarch64__)
+  asm volatile("yield" ::: "memory");
+#endif
+}
 
 
 
@@ -0,0 +1,204 @@
+//
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/**
+@file small_function.h
+@brief small function include file
+*/
+
+namespace collie::tf {
+
+    // ----------------------------------------------------------------------------
+    // SmallFunction
+    // ----------------------------------------------------------------------------
+
+    /**
+    @class SmallFunction
+
+    @brief class to hold the work of an asynchronous task
+
+    collie::tf::SmallFunction is a move-only replacement of std::function.
+    Callables of at most @c N bytes that can be moved without throwing are
+    stored in an inline buffer, so creating an asynchronous task with a small
+    closure does not allocate; larger callables fall back to the heap.
+    Calls are dispatched through a static table of function pointers per
+    callable type.
+    */
+    template<typename Sig, size_t N = 6 * sizeof(void *)>
+    class SmallFunction;
+
+    template<typename R, typename... Args, size_t N>
+    class SmallFunction<R(Args...), N> {
+
+        static_assert(N >= sizeof(void *), "inline buffer must be able to hold a pointer");
+
+        struct VTable {
+            R (*invoke)(void *, Args &&...);
+
+            void (*move)(void *, void *);
+
+            void (*destroy)(void *);
+        };
+
+        template<typename F>
+        constexpr static bool is_inline_v =
+                sizeof(F) <= N &&
+                alignof(F) <= alignof(std::max_align_t) &&
+                std::is_nothrow_move_constructible_v<F>;
+
+        template<typename F>
+        struct InlineOps {
+            static R invoke(void *p, Args &&... args) {
+                return std::invoke(*static_cast<F *>(p), std::forward<Args>(args)...);
+            }
+
+            static void move(void *dst, void *src) {
+                ::new(dst) F(std::move(*static_cast<F *>(src)));
+                static_cast<F *>(src)->~F();
+            }
+
+            static void destroy(void *p) {
+                static_cast<F *>(p)->~F();
+            }
+
+            constexpr static VTable vtable{invoke, move, destroy};
+        };
+
+        template<typename F>
+        struct HeapOps {
+            static R invoke(void *p, Args &&... args) {
+                return std::invoke(**static_cast<F **>(p), std::forward<Args>(args)...);
+            }
+
+            static void move(void *dst, void *src) {
+                ::new(dst) F *(*static_cast<F **>(src));
+            }
+
+            static void destroy(void *p) {
+                delete *static_cast<F **>(p);
+            }
+
+            constexpr static VTable vtable{invoke, move, destroy};
+        };
+
+    public:
+
+        /**
+        @brief the size in bytes of the largest callable stored inline
+        */
+        constexpr static size_t inline_capacity = N;
+
+        /**
+        @brief constructs an empty function
+        */
+        SmallFunction() = default;
+
+        /**
+        @brief constructs a function holding the callable @c c
+        */
+        template<typename C, typename F = std::decay_t<C>, std::enable_if_t<
+                !std::is_same_v<F, SmallFunction> && std::is_invocable_r_v<R, F &, Args...>, void
+        > * = nullptr>
+        SmallFunction(C &&c) {
+            if constexpr (is_inline_v<F>) {
+                ::new(static_cast<void *>(_buffer)) F(std::forward<C>(c));
+                _vtable = &InlineOps<F>::vtable;
+            } else {
+                ::new(static_cast<void *>(_buffer)) F *(new F(std::forward<C>(c)));
+                _vtable = &HeapOps<F>::vtable;
+            }
+        }
+
+        /**
+        @brief move constructor
+        */
+        SmallFunction(SmallFunction &&rhs) noexcept: _vtable{rhs._vtable} {
+            if (_vtable) {
+                _vtable->move(_buffer, rhs._buffer);
+                rhs._vtable = nullptr;
+            }
+        }
+
+        /**
+        @brief move assignment
+        */
+        SmallFunction &operator=(SmallFunction &&rhs) noexcept {
+            if (this != &rhs) {
+                _reset();
+                if ((_vtable = rhs._vtable)) {
+                    _vtable->move(_buffer, rhs._buffer);
+                    rhs._vtable = nullptr;
+                }
+            }
+            return *this;
+        }
+
+        /**
+        @brief disabled copy constructor
+        */
+        SmallFunction(const SmallFunction &) = delete;
+
+        /**
+        @brief disabled copy assignment
+        */
+        SmallFunction &operator=(const SmallFunction &) = delete;
+
+        /**
+        @brief destructs the function and the callable it holds
+        */
+        ~SmallFunction() {
+            _reset();
+        }
+
+        /**
+        @brief queries whether the function holds a callable
+        */
+        explicit operator bool() const {
+            return _vtable != nullptr;
+        }
+
+        /**
+        @brief invokes the callable
+        */
+        R operator()(Args... args) {
+            return _vtable->invoke(_buffer, std::forward<Args>(args)...);
+        }
+
+    private:
+
+        const VTable *_vtable{nullptr};
+
+        alignas(std::max_align_t) unsigned char _buffer[N];
+
+        void _reset() {
+            if (_vtable) {
+                _vtable->destroy(_buffer);
+                _vtable = nullptr;
+            }
+        }
+    };
+
+}  // end of namespace collie::tf -----------------------------------------------------
@@ -0,0 +1,437 @@
+//
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <collie/toml/impl/std_vector.h>
+#include <collie/toml/impl/source_region.h>
+#if TOML_COMPACT_DOM
+TOML_DISABLE_WARNINGS;
+#include <algorithm>
+TOML_ENABLE_WARNINGS;
+#include <collie/memory/size_class_pool.h>
+#endif
+#include <collie/toml/impl/header_start.h>
+
+/// \cond
+TOML_IMPL_NAMESPACE_START
+{
+#if TOML_COMPACT_DOM
+
+	// a source region owned through a pointer, so nodes and keys that don't have one only pay for the pointer.
+	// regions are only kept when TOML_COMPACT_DOM_SOURCE_REGIONS is enabled.
+	class source_region_storage
+	{
+	  private:
+		std::unique_ptr<source_region> region_;
+
+		template <typename Region>
+		static std::unique_ptr<source_region> make(Region&& region)
+		{
+#if TOML_COMPACT_DOM_SOURCE_REGIONS
+			if (region.begin)
+				return std::make_unique<source_region>(static_cast<Region&&>(region));
+#else
+			TOML_UNUSED(region);
+#endif
+			return {};
+		}
+
+	  public:
+		TOML_NODISCARD_CTOR
+		source_region_storage() noexcept = default;
+
+		TOML_NODISCARD_CTOR
+		source_region_storage(source_region&& region) //
+			: region_{ make(std::move(region)) }
+		{}
+
+		TOML_NODISCARD_CTOR
+		source_region_storage(const source_region& region) //
+			: region_{ make(region) }
+		{}
+
+		TOML_NODISCARD_CTOR
+		source_region_storage(const source_region_storage& other) //
+			: region_{ other.region_ ? make(*other.region_) : nullptr }
+		{}
+
+		TOML_NODISCARD_CTOR
+		source_region_storage(source_region_storage&&) noexcept = default;
+
+		source_region_storage& operator=(const source_region_storage& rhs)
+		{
+			if (&rhs != this)
+				region_ = rhs.region_ ? make(*rhs.region_) : nullptr;
+			return *this;
+		}
+
+		source_region_storage& operator=(source_region_storage&&) noexcept = default;
+
+		TOML_PURE_INLINE_GETTER
+		const source_region& get() const noexcept
+		{
+			static const source_region empty{};
+			return region_ ? *region_ : empty;
+		}
+
+		void set_begin(const source_position& pos) noexcept
+		{
+			if (region_)
+				region_->begin = pos;
+		}
+
+		void set_end(const source_position& pos) noexcept
+		{
+			if (region_)
+				region_->end = pos;
+		}
+	};
+
+	// a string with room for 15 characters inline; longer ones come from collie::size_class_pool.
+	// the last byte holds (15 - length) for inline strings, doubling as the null terminator when full,
+	// and heap_tag otherwise.
+	class key_string
+	{
+	  private:
+		static constexpr size_t inline_capacity = 15;
+		static constexpr unsigned char heap_tag = 0xFFu;
+		static constexpr size_t length_offset	= 8;
+		static_assert(sizeof(char*) <= length_offset);
+
+		alignas(char*) char bytes_[inline_capacity + 1];
+
+		TOML_PURE_INLINE_GETTER
+		bool on_heap() const noexcept
+		{
+			return static_cast<unsigned char>(bytes_[inline_capacity]) == heap_tag;
+		}
+
+		TOML_PURE_INLINE_GETTER
+		char* heap_data() const noexcept
+		{
+			char* ptr;
+			std::memcpy(&ptr, bytes_, sizeof(ptr));
+			return ptr;
+		}
+
+		TOML_PURE_INLINE_GETTER
+		size_t heap_length() const noexcept
+		{
+			uint32_t len;
+			std::memcpy(&len, bytes_ + length_offset, sizeof(len));
+			return len;
+		}
+
+		void set_empty() noexcept
+		{
+			bytes_[0]				= '\0';
+			bytes_[inline_capacity] = static_cast<char>(inline_capacity);
+		}
+
+		void assign(std::string_view str)
+		{
+			const auto len = str.length();
+			if (len <= inline_capacity)
+			{
+				if (len)
+					std::memcpy(bytes_, str.data(), len);
+				bytes_[len]				= '\0';
+				bytes_[inline_capacity] = static_cast<char>(inline_capacity - len);
+				return;
+			}
+
+			TOML_ASSERT(len < 0xFFFFFFFFu);
+			auto ptr = static_cast<char*>(collie::size_class_pool::allocate(len + 1u));
+			std::memcpy(ptr, str.data(), len);
+			ptr[len] = '\0';
+
+			const auto len32 = static_cast<uint32_t>(len);
+			std::memcpy(bytes_, &ptr, sizeof(ptr));
+			std::memcpy(bytes_ + length_offset, &len32, sizeof(len32));
+			bytes_[inline_capacity] = static_cast<char>(heap_tag);
+		}
+
+		void release() noexcept
+		{
+			if (on_heap())
+				collie::size_class_pool::deallocate(heap_data(), heap_length() + 1u);
+		}
+
+	  public:
+		TOML_NODISCARD_CTOR
+		key_string() noexcept
+		{
+			set_empty();
+		}
+
+		TOML_NODISCARD_CTOR
+		explicit key_string(std::string_view str)
+		{
+			assign(str);
+		}
+
+		TOML_NODISCARD_CTOR
+		key_string(const key_string& other)
+		{
+			assign(other.view());
+		}
+
+		TOML_NODISCARD_CTOR
+		key_string(key_string&& other) noexcept
+		{
+			std::memcpy(bytes_, other.bytes_, sizeof(bytes_));
+			other.set_empty();
+		}
+
+		key_string& operator=(const key_string& rhs)
+		{
+			if (&rhs != this)
+				*this = key_string{ rhs };
+			return *this;
+		}
+
+		key_string& operator=(key_string&& rhs) noexcept
+		{
+			if (&rhs != this)
+			{
+				release();
+				std::memcpy(bytes_, rhs.bytes_, sizeof(bytes_));
+				rhs.set_empty();
+			}
+			return *this;
+		}
+
+		~key_string() noexcept
+		{
+			release();
+		}
+
+		TOML_PURE_INLINE_GETTER
+		const char* data() const noexcept
+		{
+			return on_heap() ? heap_data() : bytes_;
+		}
+
+		TOML_PURE_INLINE_GETTER
+		size_t length() const noexcept
+		{
+			return on_heap() ? heap_length() : inline_capacity - static_cast<unsigned char>(bytes_[inline_capacity]);
+		}
+
+		TOML_PURE_INLINE_GETTER
+		bool empty() const noexcept
+		{
+			return length() == 0u;
+		}
+
+		TOML_PURE_INLINE_GETTER
+		std::string_view view() const noexcept
+		{
+			return { data(), length() };
+		}
+	};
+
+	// a std::map look-alike over a sorted vector, covering the parts of the std::map interface toml::table uses.
+	template <typename Key, typename T>
+	class flat_map
+	{
+	  public:
+		using value_type	 = std::pair<Key, T>;
+		using container_type = std::vector<value_type>;
+		using iterator		 = typename container_type::iterator;
+		using const_iterator = typename container_type::const_iterator;
+
+	  private:
+		container_type items_;
+
+		template <typename K>
+		TOML_PURE_INLINE_GETTER
+		static bool matches(const_iterator pos, const_iterator end, const K& key) noexcept
+		{
+			return pos != end && !(key < pos->first);
+		}
+
+	  public:
+		TOML_PURE_INLINE_GETTER
+		iterator begin() noexcept
+		{
+			return items_.begin();
+		}
+
+		TOML_PURE_INLINE_GETTER
+		const_iterator begin() const noexcept
+		{
+			return items_.begin();
+		}
+
+		TOML_PURE_INLINE_GETTER
+		const_iterator cbegin() const noexcept
+		{
+			return items_.cbegin();
+		}
+
+		TOML_PURE_INLINE_GETTER
+		iterator end() noexcept
+		{
+			return items_.end();
+		}
+
+		TOML_PURE_INLINE_GETTER
+		const_iterator end() const noexcept
+		{
+			return items_.end();
+		}
+
+		TOML_PURE_INLINE_GETTER
+		const_iterator cend() const noexcept
+		{
+			return items_.cend();
+		}
+
+		TOML_PURE_INLINE_GETTER
+		bool empty() const noexcept
+		{
+			return items_.empty();
+		}
+
+		TOML_PURE_INLINE_GETTER
+		size_t size() const noexcept
+		{
+			return items_.size();
+		}
+
+		void clear() noexcept
+		{
+			items_.clear();
+		}
+
+		template <typename K>
+		TOML_PURE_GETTER
+		iterator lower_bound(const K& key) noexcept
+		{
+			return std::lower_bound(items_.begin(),
+									items_.end(),
+									key,
+									[](const value_type& item, const K& k) noexcept { return item.first < k; });
+		}
+
+		template <typename K>
+		TOML_PURE_GETTER
+		const_iterator lower_bound(const K& key) const noexcept
+		{
+			return const_cast<flat_map&>(*this).lower_bound(key);
+		}
+
+		template <typename K>
+		TOML_PURE_GETTER
+		iterator find(const K& key) noexcept
+		{
+			const auto pos = lower_bound(key);
+			return matches(pos, items_.cend(), key) ? pos : items_.end();
+		}
+
+		template <typename K>
+		TOML_PURE_GETTER
+		const_iterator find(const K& key) const noexcept
+		{
+			return const_cast<flat_map&>(*this).find(key);
+		}
+
+		iterator erase(const_iterator pos) noexcept
+		{
+			return items_.erase(pos);
+		}
+
+		iterator erase(const_iterator first, const_iterator last) noexcept
+		{
+			return items_.erase(first, last);
+		}
+
+		// same semantics as std::map::emplace_hint(): a correct hint saves the search,
+		// and an existing key is returned untouched.
+		template <typename K, typename V>
+		iterator emplace_hint(const_iterator hint, K&& key, V&& value)
+		{
+			auto pos = items_.begin() + (hint - items_.cbegin());
+			if (matches(pos, items_.cend(), key) || (pos != items_.begin() && !(std::prev(pos)->first < key)))
+			{
+				pos = lower_bound(key);
+				if (matches(pos, items_.cend(), key))
+					return pos;
+			}
+			return items_.emplace(pos, static_cast<K&&>(key), static_cast<V&&>(value));
+		}
+
+		template <typename K, typename V>
+		std::pair<iterator, bool> insert_or_assign(K&& key, V&& value)
+		{
+			const auto pos = lower_bound(key);
+			if (matches(pos, items_.cend(), key))
+			{
+				pos->second = static_cast<V&&>(value);
+				return { pos, false };
+			}
+			return { items_.emplace(pos, static_cast<K&&>(key), static_cast<V&&>(value)), true };
+		}
+	};
+
+#else
+
+	class source_region_storage
+	{
+	  private:
+		source_region region_;
+
+	  public:
+		TOML_NODISCARD_CTOR
+		source_region_storage() noexcept = default;
+
+		TOML_NODISCARD_CTOR
+		source_region_storage(source_region&& region) noexcept //
+			: region_{ std::move(region) }
+		{}
+
+		TOML_NODISCARD_CTOR
+		source_region_storage(const source_region& region) noexcept //
+			: region_{ region }
+		{}
+
+		TOML_PURE_INLINE_GETTER
+		const source_region& get() const noexcept
+		{
+			return region_;
+		}
+
+		void set_begin(const source_position& pos) noexcept
+		{
+			region_.begin = pos;
+		}
+
+		void set_end(const source_position& pos) noexcept
+		{
+			region_.end = pos;
+		}
+	};
+
+#endif
+}
+TOML_IMPL_NAMESPACE_END;
+/// \endcond
+
+#include <collie/toml/impl/header_end.h>
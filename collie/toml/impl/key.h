@@ -19,6 +19,7 @@
 #pragma once
 
 #include <collie/toml/impl/source_region.h>
+#include <collie/toml/impl/compact_dom.h>
 #include <collie/toml/impl/std_utility.h>
 #include <collie/toml/impl/print_to_stream.h>
 #include <collie/toml/impl/header_start.h>
@@ -42,11 +43,18 @@ TOML_NAMESPACE_START
 	/// key 'b' defined at line 3, column 7
 	/// key 'c' defined at line 4, column 9
 	/// \eout
+	///
+	/// \remarks When #TOML_COMPACT_DOM is enabled, keys of up to 15 characters are stored
+	/// 		 without a heap allocation.
 	class key
 	{
 	  private:
+#if TOML_COMPACT_DOM
+		impl::key_string key_;
+#else
 		std::string key_;
-		source_region source_;
+#endif
+		impl::source_region_storage source_;
 
 	  public:
 		/// \brief	Default constructor.
@@ -69,14 +77,14 @@ TOML_NAMESPACE_START
 
 		/// \brief	Constructs a key from a string and source region.
 		TOML_NODISCARD_CTOR
-		explicit key(std::string&& k, source_region&& src = {}) noexcept //
+		explicit key(std::string&& k, source_region&& src = {}) noexcept(!TOML_COMPACT_DOM) //
 			: key_{ std::move(k) },
 			  source_{ std::move(src) }
 		{}
 
 		/// \brief	Constructs a key from a string and source region.
 		TOML_NODISCARD_CTOR
-		explicit key(std::string&& k, const source_region& src) noexcept //
+		explicit key(std::string&& k, const source_region& src) noexcept(!TOML_COMPACT_DOM) //
 			: key_{ std::move(k) },
 			  source_{ src }
 		{}
@@ -124,7 +132,7 @@ TOML_NAMESPACE_START
 		TOML_PURE_INLINE_GETTER
 		std::string_view str() const noexcept
 		{
-			return std::string_view{ key_ };
+			return std::string_view{ key_.data(), key_.length() };
 		}
 
 		/// \brief	Returns a view of the key's underlying string.
@@ -164,7 +172,7 @@ TOML_NAMESPACE_START
 		TOML_PURE_INLINE_GETTER
 		const source_region& source() const noexcept
 		{
-			return source_;
+			return source_.get();
 		}
 
 		/// @}
@@ -177,126 +185,126 @@ TOML_NAMESPACE_START
 		TOML_PURE_INLINE_GETTER
 		friend bool operator==(const key& lhs, const key& rhs) noexcept
 		{
-			return lhs.key_ == rhs.key_;
+			return lhs.str() == rhs.str();
 		}
 
 		/// \brief	Returns true if `lhs.str() != rhs.str()`.
 		TOML_PURE_INLINE_GETTER
 		friend bool operator!=(const key& lhs, const key& rhs) noexcept
 		{
-			return lhs.key_ != rhs.key_;
+			return lhs.str() != rhs.str();
 		}
 
 		/// \brief	Returns true if `lhs.str() < rhs.str()`.
 		TOML_PURE_INLINE_GETTER
 		friend bool operator<(const key& lhs, const key& rhs) noexcept
 		{
-			return lhs.key_ < rhs.key_;
+			return lhs.str() < rhs.str();
 		}
 
 		/// \brief	Returns true if `lhs.str() <= rhs.str()`.
 		TOML_PURE_INLINE_GETTER
 		friend bool operator<=(const key& lhs, const key& rhs) noexcept
 		{
-			return lhs.key_ <= rhs.key_;
+			return lhs.str() <= rhs.str();
 		}
 
 		/// \brief	Returns true if `lhs.str() > rhs.str()`.
 		TOML_PURE_INLINE_GETTER
 		friend bool operator>(const key& lhs, const key& rhs) noexcept
 		{
-			return lhs.key_ > rhs.key_;
+			return lhs.str() > rhs.str();
 		}
 
 		/// \brief	Returns true if `lhs.str() >= rhs.str()`.
 		TOML_PURE_INLINE_GETTER
 		friend bool operator>=(const key& lhs, const key& rhs) noexcept
 		{
-			return lhs.key_ >= rhs.key_;
+			return lhs.str() >= rhs.str();
 		}
 
 		/// \brief	Returns true if `lhs.str() == rhs`.
 		TOML_PURE_INLINE_GETTER
 		friend bool operator==(const key& lhs, std::string_view rhs) noexcept
 		{
-			return lhs.key_ == rhs;
+			return lhs.str() == rhs;
 		}
 
 		/// \brief	Returns true if `lhs.str() != rhs`.
 		TOML_PURE_INLINE_GETTER
 		friend bool operator!=(const key& lhs, std::string_view rhs) noexcept
 		{
-			return lhs.key_ != rhs;
+			return lhs.str() != rhs;
 		}
 
 		/// \brief	Returns true if `lhs.str() < rhs`.
 		TOML_PURE_INLINE_GETTER
 		friend bool operator<(const key& lhs, std::string_view rhs) noexcept
 		{
-			return lhs.key_ < rhs;
+			return lhs.str() < rhs;
 		}
 
 		/// \brief	Returns true if `lhs.str() <= rhs`.
 		TOML_PURE_INLINE_GETTER
 		friend bool operator<=(const key& lhs, std::string_view rhs) noexcept
 		{
-			return lhs.key_ <= rhs;
+			return lhs.str() <= rhs;
 		}
 
 		/// \brief	Returns true if `lhs.str() > rhs`.
 		TOML_PURE_INLINE_GETTER
 		friend bool operator>(const key& lhs, std::string_view rhs) noexcept
 		{
-			return lhs.key_ > rhs;
+			return lhs.str() > rhs;
 		}
 
 		/// \brief	Returns true if `lhs.str() >= rhs`.
 		TOML_PURE_INLINE_GETTER
 		friend bool operator>=(const key& lhs, std::string_view rhs) noexcept
 		{
-			return lhs.key_ >= rhs;
+			return lhs.str() >= rhs;
 		}
 
 		/// \brief	Returns true if `lhs == rhs.str()`.
 		TOML_PURE_INLINE_GETTER
 		friend bool operator==(std::string_view lhs, const key& rhs) noexcept
 		{
-			return lhs == rhs.key_;
+			return lhs == rhs.str();
 		}
 
 		/// \brief	Returns true if `lhs != rhs.str()`.
 		TOML_PURE_INLINE_GETTER
 		friend bool operator!=(std::string_view lhs, const key& rhs) noexcept
 		{
-			return lhs != rhs.key_;
+			return lhs != rhs.str();
 		}
 
 		/// \brief	Returns true if `lhs < rhs.str()`.
 		TOML_PURE_INLINE_GETTER
 		friend bool operator<(std::string_view lhs, const key& rhs) noexcept
 		{
-			return lhs < rhs.key_;
+			return lhs < rhs.str();
 		}
 
 		/// \brief	Returns true if `lhs <= rhs.str()`.
 		TOML_PURE_INLINE_GETTER
 		friend bool operator<=(std::string_view lhs, const key& rhs) noexcept
 		{
-			return lhs <= rhs.key_;
+			return lhs <= rhs.str();
 		}
 
 		/// \brief	Returns true if `lhs > rhs.str()`.
 		TOML_PURE_INLINE_GETTER
 		friend bool operator>(std::string_view lhs, const key& rhs) noexcept
 		{
-			return lhs > rhs.key_;
+			return lhs > rhs.str();
 		}
 
 		/// \brief	Returns true if `lhs >= rhs.str()`.
 		TOML_PURE_INLINE_GETTER
 		friend bool operator>=(std::string_view lhs, const key& rhs) noexcept
 		{
-			return lhs >= rhs.key_;
+			return lhs >= rhs.str();
 		}
 
 		/// @}
@@ -329,7 +337,7 @@ TOML_NAMESPACE_START
 		/// \brief	Prints the key's underlying string out to the stream.
 		friend std::ostream& operator<<(std::ostream& lhs, const key& rhs)
 		{
-			impl::print_to_stream(lhs, rhs.key_);
+			impl::print_to_stream(lhs, rhs.str());
 			return lhs;
 		}
 	};
@@ -21,6 +21,7 @@
 #include <collie/toml/impl/std_utility.h>
 #include <collie/toml/impl/forward_declarations.h>
 #include <collie/toml/impl/source_region.h>
+#include <collie/toml/impl/compact_dom.h>
 #include <collie/toml/impl/header_start.h>
 
 TOML_NAMESPACE_START
@@ -35,7 +36,7 @@ TOML_NAMESPACE_START
 		/// \cond
 
 		friend class TOML_PARSER_TYPENAME;
-		source_region source_{};
+		impl::source_region_storage source_{};
 
 		template <typename T>
 		TOML_NODISCARD
@@ -150,6 +151,27 @@ TOML_NAMESPACE_START
 		TOML_EXPORTED_MEMBER_FUNCTION
 		virtual ~node() noexcept;
 
+#if TOML_COMPACT_DOM
+
+		/// \brief	Allocates tables, arrays and values from collie::size_class_pool.
+		///
+		/// \availability This is only declared when #TOML_COMPACT_DOM is enabled.
+		TOML_NODISCARD
+		static void* operator new(size_t size)
+		{
+			return collie::size_class_pool::allocate(size);
+		}
+
+		/// \brief	Returns a table, array or value to collie::size_class_pool.
+		///
+		/// \availability This is only declared when #TOML_COMPACT_DOM is enabled.
+		static void operator delete(void* ptr, size_t size) noexcept
+		{
+			collie::size_class_pool::deallocate(ptr, size);
+		}
+
+#endif
+
 		/// \name Type checks
 		/// @{
 
@@ -737,7 +759,7 @@ TOML_NAMESPACE_START
 		TOML_PURE_INLINE_GETTER
 		const source_region& source() const noexcept
 		{
-			return source_;
+			return source_.get();
 		}
 
 		/// @}
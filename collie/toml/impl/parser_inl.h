@@ -3032,7 +3032,7 @@ TOML_IMPL_NAMESPACE_START
 				return_after_error({});
 			}
 
-			val->source_ = { begin_pos, current_position(1), reader.source_path() };
+			set_source(*val, begin_pos, current_position(1));
 			return val;
 		}
 
@@ -3111,10 +3111,25 @@ TOML_IMPL_NAMESPACE_START
 		{
 			TOML_ASSERT(key_buffer.size() > segment_index);
 
+#if TOML_RECORD_SOURCE_REGIONS
 			return key{
 				key_buffer[segment_index],
 				source_region{ key_buffer.starts[segment_index], key_buffer.ends[segment_index], root.source().path }
 			};
+#else
+			return key{ key_buffer[segment_index] };
+#endif
+		}
+
+		void set_source(node& nde, source_position begin, source_position end) const
+		{
+#if TOML_RECORD_SOURCE_REGIONS
+			nde.source_ = source_region{ begin, end, reader.source_path() };
+#else
+			TOML_UNUSED(nde);
+			TOML_UNUSED(begin);
+			TOML_UNUSED(end);
+#endif
 		}
 
 		TOML_NODISCARD
@@ -3239,7 +3254,7 @@ TOML_IMPL_NAMESPACE_START
 				{
 					pit		  = parent->emplace_hint<table>(pit, make_key(i));
 					table& p  = pit->second.ref_cast<table>();
-					p.source_ = { header_begin_pos, header_end_pos, reader.source_path() };
+					set_source(p, header_begin_pos, header_end_pos);
 
 					implicit_tables.push_back(&p);
 					parent = &p;
@@ -3260,7 +3275,7 @@ TOML_IMPL_NAMESPACE_START
 					is_arr && arr && impl::find(table_arrays.begin(), table_arrays.end(), arr))
 				{
 					table& tbl	= arr->emplace_back<table>();
-					tbl.source_ = { header_begin_pos, header_end_pos, reader.source_path() };
+					set_source(tbl, header_begin_pos, header_end_pos);
 					return &tbl;
 				}
 
@@ -3270,8 +3285,8 @@ TOML_IMPL_NAMESPACE_START
 						found && (tbl->empty() || tbl->is_homogeneous<table>()))
 					{
 						implicit_tables.erase(implicit_tables.cbegin() + (found - implicit_tables.data()));
-						tbl->source_.begin = header_begin_pos;
-						tbl->source_.end   = header_end_pos;
+						tbl->source_.set_begin(header_begin_pos);
+						tbl->source_.set_end(header_end_pos);
 						return tbl;
 					}
 				}
@@ -3310,10 +3325,10 @@ TOML_IMPL_NAMESPACE_START
 					it			   = parent->emplace_hint<array>(it, std::move(last_key));
 					array& tbl_arr = it->second.ref_cast<array>();
 					table_arrays.push_back(&tbl_arr);
-					tbl_arr.source_ = { header_begin_pos, header_end_pos, reader.source_path() };
+					set_source(tbl_arr, header_begin_pos, header_end_pos);
 
 					table& tbl	= tbl_arr.emplace_back<table>();
-					tbl.source_ = { header_begin_pos, header_end_pos, reader.source_path() };
+					set_source(tbl, header_begin_pos, header_end_pos);
 					return &tbl;
 				}
 
@@ -3322,7 +3337,7 @@ TOML_IMPL_NAMESPACE_START
 				{
 					it			= parent->emplace_hint<table>(it, std::move(last_key));
 					table& tbl	= it->second.ref_cast<table>();
-					tbl.source_ = { header_begin_pos, header_end_pos, reader.source_path() };
+					set_source(tbl, header_begin_pos, header_end_pos);
 					return &tbl;
 				}
 			}
@@ -3473,9 +3488,9 @@ TOML_IMPL_NAMESPACE_START
 			while (!is_eof());
 
 			auto eof_pos	 = current_position(1);
-			root.source_.end = eof_pos;
-			if (current_table && current_table != &root && current_table->source_.end <= current_table->source_.begin)
-				current_table->source_.end = eof_pos;
+			root.source_.set_end(eof_pos);
+			if (current_table && current_table != &root && current_table->source().end <= current_table->source().begin)
+				current_table->source_.set_end(eof_pos);
 		}
 
 		static void update_region_ends(node& nde) noexcept
@@ -3491,26 +3506,26 @@ TOML_IMPL_NAMESPACE_START
 									 // terminated
 					return;
 
-				auto end = nde.source_.end;
+				auto end = nde.source().end;
 				for (auto&& [k, v] : tbl)
 				{
 					TOML_UNUSED(k);
 					update_region_ends(v);
-					if (end < v.source_.end)
-						end = v.source_.end;
+					if (end < v.source().end)
+						end = v.source().end;
 				}
 			}
 			else // arrays
 			{
 				auto& arr = nde.ref_cast<array>();
-				auto end  = nde.source_.end;
+				auto end  = nde.source().end;
 				for (auto&& v : arr)
 				{
 					update_region_ends(v);
-					if (end < v.source_.end)
-						end = v.source_.end;
+					if (end < v.source().end)
+						end = v.source().end;
 				}
-				nde.source_.end = end;
+				nde.source_.set_end(end);
 			}
 		}
 
@@ -3518,7 +3533,7 @@ TOML_IMPL_NAMESPACE_START
 		parser(utf8_reader_interface&& reader_) //
 			: reader{ reader_ }
 		{
-			root.source_ = { prev_pos, prev_pos, reader.source_path() };
+			set_source(root, prev_pos, prev_pos);
 
 			if (!reader.peek_eof())
 			{
@@ -3536,7 +3551,9 @@ TOML_IMPL_NAMESPACE_START
 					parse_document();
 			}
 
+#if TOML_RECORD_SOURCE_REGIONS
 			update_region_ends(root);
+#endif
 		}
 
 		TOML_NODISCARD
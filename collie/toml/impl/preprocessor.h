@@ -832,6 +832,43 @@
 #define TOML_ENABLE_SIMD 1
 #endif
 
+// compact DOM
+#if defined(TOML_COMPACT_DOM) && TOML_COMPACT_DOM
+#undef TOML_COMPACT_DOM
+#define TOML_COMPACT_DOM 1
+#else
+#undef TOML_COMPACT_DOM
+#define TOML_COMPACT_DOM 0
+#endif
+/// \def		TOML_COMPACT_DOM
+/// \brief		Sets whether parsed documents use a smaller, flatter in-memory representation.
+/// \detail		Defaults to `0`.
+/// \remarks	When enabled:
+///				- toml::table keeps its key-value pairs in a sorted vector instead of a std::map
+///				- toml::key stores strings of up to 15 characters inline
+///				- nodes are allocated from collie::size_class_pool
+///				- source regions are kept out-of-line, and only if #TOML_COMPACT_DOM_SOURCE_REGIONS is enabled
+///
+///				Inserting into a table is then linear in its size, and inserting or erasing invalidates
+///				its iterators. This setting changes the layout of the DOM types, so it must be the same in
+///				every translation unit.
+
+#if TOML_COMPACT_DOM && defined(TOML_COMPACT_DOM_SOURCE_REGIONS) && TOML_COMPACT_DOM_SOURCE_REGIONS
+#undef TOML_COMPACT_DOM_SOURCE_REGIONS
+#define TOML_COMPACT_DOM_SOURCE_REGIONS 1
+#else
+#undef TOML_COMPACT_DOM_SOURCE_REGIONS
+#define TOML_COMPACT_DOM_SOURCE_REGIONS 0
+#endif
+/// \def		TOML_COMPACT_DOM_SOURCE_REGIONS
+/// \brief		Sets whether nodes and keys remember where they were parsed from when #TOML_COMPACT_DOM is enabled.
+/// \detail		Defaults to `0`, in which case `source()` always returns an empty region.
+///				Has no effect unless #TOML_COMPACT_DOM is enabled.
+
+/// \cond
+#define TOML_RECORD_SOURCE_REGIONS (!TOML_COMPACT_DOM || TOML_COMPACT_DOM_SOURCE_REGIONS)
+/// \endcond
+
 // windows compat
 #if !defined(TOML_ENABLE_WINDOWS_COMPAT) && defined(TOML_WINDOWS_COMPAT) // was TOML_WINDOWS_COMPAT pre-3.0
 #define TOML_ENABLE_WINDOWS_COMPAT TOML_WINDOWS_COMPAT
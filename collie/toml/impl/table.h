@@ -30,6 +30,12 @@
 /// \cond
 TOML_IMPL_NAMESPACE_START
 {
+#if TOML_COMPACT_DOM
+	using table_map = flat_map<toml::key, node_ptr>;
+#else
+	using table_map = std::map<toml::key, node_ptr, std::less<>>;
+#endif
+
 	template <bool IsConst>
 	struct table_proxy_pair
 	{
@@ -47,8 +53,8 @@ TOML_IMPL_NAMESPACE_START
 		friend class table_iterator;
 
 		using proxy_type		   = table_proxy_pair<IsConst>;
-		using mutable_map_iterator = std::map<toml::key, node_ptr, std::less<>>::iterator;
-		using const_map_iterator   = std::map<toml::key, node_ptr, std::less<>>::const_iterator;
+		using mutable_map_iterator = table_map::iterator;
+		using const_map_iterator   = table_map::const_iterator;
 		using map_iterator		   = std::conditional_t<IsConst, const_map_iterator, mutable_map_iterator>;
 
 		mutable map_iterator iter_;
@@ -105,7 +111,7 @@ TOML_IMPL_NAMESPACE_START
 		using reference			= value_type&;
 		using pointer			= value_type*;
 		using difference_type	= typename std::iterator_traits<map_iterator>::difference_type;
-		using iterator_category = typename std::iterator_traits<map_iterator>::iterator_category;
+		using iterator_category = std::bidirectional_iterator_tag;
 
 		table_iterator& operator++() noexcept // ++pre
 		{
@@ -203,7 +209,8 @@ TOML_NAMESPACE_START
 	///
 	/// \detail The interface of this type is modeled after std::map, with some
 	/// 		additional considerations made for the heterogeneous nature of a
-	/// 		TOML table.
+	/// 		TOML table. When #TOML_COMPACT_DOM is enabled the key-value pairs are
+	/// 		kept in a sorted vector, so inserting or erasing invalidates iterators.
 	///
 	/// \cpp
 	/// toml::table tbl = toml::parse(R"(
@@ -235,8 +242,8 @@ TOML_NAMESPACE_START
 	  private:
 		/// \cond
 
-		using map_type			 = std::map<toml::key, impl::node_ptr, std::less<>>;
-		using map_pair			 = std::pair<const toml::key, impl::node_ptr>;
+		using map_type			 = impl::table_map;
+		using map_pair			 = typename map_type::value_type;
 		using map_iterator		 = typename map_type::iterator;
 		using const_map_iterator = typename map_type::const_iterator;
 		map_type map_;
@@ -195,6 +195,7 @@ TOML_POP_WARNINGS;
 #undef TOML_PURE_GETTER
 #undef TOML_PURE_INLINE_GETTER
 #undef TOML_PUSH_WARNINGS
+#undef TOML_RECORD_SOURCE_REGIONS
 #undef TOML_REQUIRES
 #undef TOML_SA_LIST_BEG
 #undef TOML_SA_LIST_END
@@ -0,0 +1,336 @@
+//
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+#include <collie/container/flat_hash_map.h>
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+#include <collie/testing/doctest.h>
+
+#include <memory>
+#include <random>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+    // all keys land in the same group, to exercise probing and tombstones
+    struct BadHash {
+        size_t operator()(int v) const { return static_cast<size_t>(v & 3); }
+    };
+
+    struct Counted {
+        static inline int live = 0;
+        int v;
+
+        explicit Counted(int i) : v(i) { ++live; }
+
+        Counted(const Counted &o) : v(o.v) { ++live; }
+
+        Counted(Counted &&o) noexcept : v(o.v) { ++live; }
+
+        ~Counted() { --live; }
+    };
+
+    struct AllocState {
+        int live{0};
+        bool fail{false};
+    };
+
+    // a stateful allocator that stays with its container on move assignment
+    template<class T>
+    struct TrackingAlloc {
+        using value_type = T;
+        using propagate_on_container_move_assignment = std::false_type;
+        using is_always_equal = std::false_type;
+
+        AllocState *state;
+
+        explicit TrackingAlloc(AllocState *s) : state(s) {}
+
+        template<class U>
+        TrackingAlloc(const TrackingAlloc<U> &o) : state(o.state) {}
+
+        T *allocate(size_t n) {
+            if (state->fail) {
+                throw std::bad_alloc();
+            }
+            ++state->live;
+            return std::allocator<T>().allocate(n);
+        }
+
+        void deallocate(T *p, size_t n) {
+            --state->live;
+            std::allocator<T>().deallocate(p, n);
+        }
+
+        friend bool operator==(const TrackingAlloc &a, const TrackingAlloc &b) { return a.state == b.state; }
+
+        friend bool operator!=(const TrackingAlloc &a, const TrackingAlloc &b) { return a.state != b.state; }
+    };
+
+    using counted_alloc = TrackingAlloc<std::pair<const int, Counted>>;
+    using flat_counted_map = collie::flat_hash_map<int, Counted, std::hash<int>, std::equal_to<int>, counted_alloc>;
+    using node_counted_map = collie::node_hash_map<int, Counted, std::hash<int>, std::equal_to<int>, counted_alloc>;
+
+}  // namespace
+
+TEST_CASE_TEMPLATE("FlatHashMap.Basics", Map, collie::flat_hash_map<int, std::string>,
+                   collie::node_hash_map<int, std::string>) {
+    Map m;
+    CHECK(m.empty());
+    CHECK_EQ(m.find(1), m.end());
+    CHECK_EQ(m.begin(), m.end());
+
+    auto [it, inserted] = m.insert({1, "one"});
+    CHECK(inserted);
+    CHECK_EQ(it->first, 1);
+    CHECK_EQ(it->second, "one");
+    CHECK_FALSE(m.insert({1, "uno"}).second);
+    CHECK_EQ(m.at(1), "one");
+
+    CHECK(m.emplace(2, "two").second);
+    CHECK(m.try_emplace(3, 3, 'x').second);
+    CHECK_EQ(m[3], "xxx");
+    CHECK_FALSE(m.try_emplace(3, "no").second);
+    m[4] = "four";
+    CHECK_FALSE(m.insert_or_assign(4, "FOUR").second);
+    CHECK_EQ(m[4], "FOUR");
+    CHECK_EQ(m.size(), 4);
+    CHECK(m.contains(2));
+    CHECK_EQ(m.count(5), 0);
+    CHECK_THROWS_AS(m.at(5), std::out_of_range);
+
+    CHECK_EQ(m.erase(2), 1);
+    CHECK_EQ(m.erase(2), 0);
+    CHECK_FALSE(m.contains(2));
+    CHECK_EQ(m.size(), 3);
+
+    size_t n = 0;
+    for (auto &kv: m) {
+        kv.second += "!";
+        ++n;
+    }
+    CHECK_EQ(n, 3);
+    CHECK_EQ(m[1], "one!");
+
+    Map copy = m;
+    CHECK_EQ(copy, m);
+    copy[1] = "changed";
+    CHECK_NE(copy, m);
+    Map moved = std::move(copy);
+    CHECK_EQ(moved.size(), 3);
+    CHECK(copy.empty());
+
+    Map init = {{1, "a"}, {2, "b"}, {1, "c"}};
+    CHECK_EQ(init.size(), 2);
+    CHECK_EQ(init[1], "a");
+
+    m.clear();
+    CHECK(m.empty());
+    CHECK_EQ(m.begin(), m.end());
+    m[7] = "seven";
+    CHECK_EQ(m.size(), 1);
+}
+
+TEST_CASE_TEMPLATE("FlatHashMap.RandomAgainstUnorderedMap", Map, collie::flat_hash_map<uint64_t, uint64_t>,
+                   collie::node_hash_map<uint64_t, uint64_t>) {
+    std::mt19937_64 rng(12345);
+    Map m;
+    std::unordered_map<uint64_t, uint64_t> ref;
+    for (int i = 0; i < 200000; ++i) {
+        // a small key space, so that erasures and re-insertions are frequent
+        uint64_t key = rng() % 5000;
+        switch (rng() % 4) {
+            case 0:
+            case 1:
+                m[key] = i;
+                ref[key] = i;
+                break;
+            case 2:
+                REQUIRE_EQ(m.erase(key), ref.erase(key));
+                break;
+            default: {
+                auto it = m.find(key);
+                auto rit = ref.find(key);
+                REQUIRE_EQ(it == m.end(), rit == ref.end());
+                if (it != m.end()) {
+                    REQUIRE_EQ(it->second, rit->second);
+                }
+            }
+        }
+        REQUIRE_EQ(m.size(), ref.size());
+    }
+    size_t n = 0;
+    for (auto &kv: m) {
+        REQUIRE_EQ(ref.at(kv.first), kv.second);
+        ++n;
+    }
+    CHECK_EQ(n, ref.size());
+}
+
+TEST_CASE("FlatHashMap.Collisions") {
+    collie::flat_hash_map<int, int, BadHash> m;
+    for (int round = 0; round < 20; ++round) {
+        for (int i = 0; i < 100; ++i) {
+            m[i] = i * round;
+        }
+        for (int i = 0; i < 100; i += 2) {
+            CHECK_EQ(m.erase(i), 1);
+        }
+        CHECK_EQ(m.size(), 50);
+        for (int i = 1; i < 100; i += 2) {
+            REQUIRE_EQ(m.at(i), i * round);
+        }
+    }
+    // the tombstones are purged instead of growing the table forever
+    CHECK_LE(m.capacity(), 255);
+}
+
+TEST_CASE("FlatHashMap.HeterogeneousLookup") {
+    collie::flat_hash_map<std::string, int> m;
+    m["alpha"] = 1;
+    m[std::string("beta")] = 2;
+    std::string_view key = "alpha";
+    CHECK_EQ(m.find(key)->second, 1);
+    CHECK(m.contains("beta"));
+    CHECK_EQ(m.at(std::string_view("beta")), 2);
+    CHECK_FALSE(m.contains(std::string_view("gamma")));
+    CHECK(m.try_emplace(std::string_view("gamma"), 3).second);
+    CHECK_EQ(m.erase(std::string_view("alpha")), 1);
+    CHECK_EQ(m.size(), 2);
+}
+
+TEST_CASE("FlatHashMap.ReserveAndRehash") {
+    collie::flat_hash_map<int, int> m;
+    m.reserve(1000);
+    auto capacity = m.capacity();
+    CHECK_GE(capacity * 7 / 8, 1000);
+    for (int i = 0; i < 1000; ++i) {
+        m[i] = i;
+    }
+    CHECK_EQ(m.capacity(), capacity);
+    CHECK_LE(m.load_factor(), m.max_load_factor());
+
+    for (int i = 100; i < 1000; ++i) {
+        m.erase(i);
+    }
+    m.rehash(0);
+    CHECK_LT(m.capacity(), capacity);
+    for (int i = 0; i < 100; ++i) {
+        REQUIRE_EQ(m.at(i), i);
+    }
+    m.clear();
+    m.rehash(0);
+    CHECK_EQ(m.capacity(), 0);
+    CHECK_EQ(m.bucket_count(), 0);
+}
+
+TEST_CASE("FlatHashMap.MoveOnlyValues") {
+    collie::flat_hash_map<int, std::unique_ptr<int>> m;
+    for (int i = 0; i < 100; ++i) {
+        m.emplace(i, std::make_unique<int>(i));
+    }
+    for (int i = 0; i < 100; ++i) {
+        REQUIRE_EQ(*m.at(i), i);
+    }
+}
+
+TEST_CASE("NodeHashMap.StableReferences") {
+    collie::node_hash_map<int, int> m;
+    std::vector<int *> refs;
+    for (int i = 0; i < 1000; ++i) {
+        refs.push_back(&m[i]);
+        *refs.back() = i;
+    }
+    for (int i = 0; i < 1000; ++i) {
+        REQUIRE_EQ(refs[i], &m.at(i));
+        REQUIRE_EQ(*refs[i], i);
+    }
+}
+
+TEST_CASE("FlatHashMap.EraseWhileIterating") {
+    collie::flat_hash_map<int, int> m;
+    for (int i = 0; i < 1000; ++i) {
+        m[i] = i;
+    }
+    for (auto it = m.begin(); it != m.end();) {
+        if (it->first % 3 == 0) {
+            it = m.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    CHECK_EQ(m.size(), 666);
+    for (auto &kv: m) {
+        REQUIRE_NE(kv.first % 3, 0);
+    }
+}
+
+TEST_CASE_TEMPLATE("FlatHashMap.MoveAssignUnequalAllocators", Map, flat_counted_map, node_counted_map) {
+    AllocState sa, sb;
+    {
+        Map a(0, counted_alloc(&sa));
+        Map b(0, counted_alloc(&sb));
+        for (int i = 0; i < 100; ++i) {
+            a.emplace(i, Counted(i));
+        }
+        b.emplace(-1, Counted(-1));
+
+        b = std::move(a);
+        CHECK(b.get_allocator() == counted_alloc(&sb));
+        REQUIRE_EQ(b.size(), 100);
+        for (int i = 0; i < 100; ++i) {
+            REQUIRE_EQ(b.at(i).v, i);
+        }
+        CHECK_FALSE(b.contains(-1));
+
+        // equal allocators hand the storage over
+        Map c(0, counted_alloc(&sb));
+        c = std::move(b);
+        CHECK(b.empty());
+        CHECK_EQ(c.size(), 100);
+    }
+    // every block went back to the allocator it came from
+    CHECK_EQ(sa.live, 0);
+    CHECK_EQ(sb.live, 0);
+    CHECK_EQ(Counted::live, 0);
+}
+
+TEST_CASE_TEMPLATE("FlatHashMap.EmplaceRehashThrows", Map, flat_counted_map, node_counted_map) {
+    AllocState state;
+    {
+        Map m(0, counted_alloc(&state));
+        m.emplace(0, Counted(0));
+        state.fail = true;
+        bool thrown = false;
+        for (int i = 1; i < 1000 && !thrown; ++i) {
+            try {
+                m.emplace(i, Counted(i));
+            } catch (const std::bad_alloc &) {
+                thrown = true;
+            }
+        }
+        CHECK(thrown);
+        CHECK_EQ(Counted::live, static_cast<int>(m.size()));
+        state.fail = false;
+    }
+    CHECK_EQ(Counted::live, 0);
+    CHECK_EQ(state.live, 0);
+}
@@ -0,0 +1,86 @@
+//
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+#include <collie/container/flat_hash_set.h>
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+#include <collie/testing/doctest.h>
+
+#include <random>
+#include <set>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+TEST_CASE_TEMPLATE("FlatHashSet.Basics", Set, collie::flat_hash_set<std::string>,
+                   collie::node_hash_set<std::string>) {
+    static_assert(std::is_same_v<decltype(*std::declval<typename Set::iterator>()), const std::string &>);
+
+    Set s = {"a", "b", "c"};
+    CHECK_EQ(s.size(), 3);
+    CHECK(s.insert("d").second);
+    CHECK_FALSE(s.insert("a").second);
+    CHECK(s.emplace(3, 'e').second);
+    CHECK(s.contains("eee"));
+    CHECK(s.contains(std::string_view("b")));
+    CHECK_EQ(s.erase(std::string_view("b")), 1);
+    CHECK_EQ(s.size(), 4);
+
+    std::set<std::string> sorted(s.begin(), s.end());
+    CHECK_EQ(sorted, std::set<std::string>{"a", "c", "d", "eee"});
+
+    Set other(sorted.begin(), sorted.end());
+    CHECK_EQ(other, s);
+    other.erase(other.find("a"));
+    CHECK_NE(other, s);
+    swap(other, s);
+    CHECK_EQ(s.size(), 3);
+    CHECK_EQ(other.size(), 4);
+}
+
+TEST_CASE("FlatHashSet.RandomAgainstStdSet") {
+    std::mt19937 rng(99);
+    collie::flat_hash_set<int> s;
+    std::set<int> ref;
+    for (int i = 0; i < 100000; ++i) {
+        int v = static_cast<int>(rng() % 3000);
+        if (rng() % 3) {
+            REQUIRE_EQ(s.insert(v).second, ref.insert(v).second);
+        } else {
+            REQUIRE_EQ(s.erase(v), ref.erase(v));
+        }
+    }
+    CHECK_EQ(std::set<int>(s.begin(), s.end()), ref);
+}
+
+TEST_CASE("FlatHashSet.SmallTables") {
+    // tables smaller than a group probe through the cloned control bytes
+    for (int n = 0; n < 40; ++n) {
+        collie::flat_hash_set<int> s;
+        for (int i = 0; i < n; ++i) {
+            s.insert(i * 7919);
+        }
+        REQUIRE_EQ(s.size(), static_cast<size_t>(n));
+        for (int i = 0; i < n; ++i) {
+            REQUIRE(s.contains(i * 7919));
+        }
+        REQUIRE_FALSE(s.contains(-1));
+        REQUIRE_EQ(static_cast<size_t>(std::distance(s.begin(), s.end())), s.size());
+    }
+}
@@ -0,0 +1,214 @@
+//
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+#include <collie/container/ordered_hash_map.h>
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+#include <collie/testing/doctest.h>
+
+#include <memory>
+#include <random>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace {
+
+    // every key has the same home bucket, to exercise probing and the
+    // backward shift on erase
+    struct BadHash {
+        size_t operator()(int v) const { return static_cast<size_t>(v & 1); }
+    };
+
+    template<class Map>
+    std::vector<typename Map::key_type> keys_of(const Map &m) {
+        std::vector<typename Map::key_type> keys;
+        for (auto &kv: m) {
+            keys.push_back(kv.first);
+        }
+        return keys;
+    }
+
+}  // namespace
+
+TEST_CASE("OrderedHashMap.InsertionOrder") {
+    collie::ordered_hash_map<std::string, int> m;
+    CHECK(m.empty());
+    CHECK_EQ(m.begin(), m.end());
+    CHECK_EQ(m.find("x"), m.end());
+
+    m["zwei"] = 2;
+    m["eins"] = 1;
+    CHECK(m.emplace("drei", 3).second);
+    CHECK(m.insert({"vier", 4}).second);
+    CHECK_FALSE(m.insert({"eins", 10}).second);
+    CHECK(m.try_emplace("fuenf", 5).second);
+    CHECK_FALSE(m.insert_or_assign("drei", 30).second);
+
+    CHECK_EQ(m.size(), 5);
+    CHECK_EQ(keys_of(m), std::vector<std::string>{"zwei", "eins", "drei", "vier", "fuenf"});
+    CHECK_EQ(m.at("drei"), 30);
+    CHECK_EQ(m["eins"], 1);
+    CHECK_THROWS_AS(m.at("sechs"), std::out_of_range);
+
+    // heterogeneous lookup
+    std::string_view sv = "vier";
+    CHECK_EQ(m.find(sv)->second, 4);
+    CHECK(m.contains("fuenf"));
+    CHECK_EQ(m.count(std::string("zwei")), 1);
+
+    // fifo_map bounds follow the insertion order
+    CHECK_EQ(m.lower_bound("eins")->first, "eins");
+    CHECK_EQ(m.upper_bound("eins")->first, "drei");
+    CHECK_EQ(m.upper_bound("fuenf"), m.end());
+    CHECK_EQ(m.lower_bound("sechs"), m.end());
+
+    std::vector<std::string> reversed;
+    for (auto it = m.rbegin(); it != m.rend(); ++it) {
+        reversed.push_back(it->first);
+    }
+    CHECK_EQ(reversed, std::vector<std::string>{"fuenf", "vier", "drei", "eins", "zwei"});
+    CHECK_EQ((m.begin() + 2)->first, "drei");
+    CHECK_EQ((m.end() - 1)->first, "fuenf");
+}
+
+TEST_CASE("OrderedHashMap.Erase") {
+    collie::ordered_hash_map<std::string, int> m = {{"a", 1}, {"b", 2}, {"c", 3}, {"d", 4}, {"e", 5}};
+
+    CHECK_EQ(m.erase("c"), 1);
+    CHECK_EQ(m.erase("c"), 0);
+    CHECK_EQ(keys_of(m), std::vector<std::string>{"a", "b", "d", "e"});
+
+    // tombstones at the front are skipped, the ones at the back dropped
+    auto it = m.erase(m.begin());
+    CHECK_EQ(it->first, "b");
+    it = m.erase(std::prev(m.end()));
+    CHECK_EQ(it, m.end());
+    CHECK_EQ(keys_of(m), std::vector<std::string>{"b", "d"});
+
+    // an erased key goes to the back when inserted again
+    m["c"] = 30;
+    m["a"] = 10;
+    CHECK_EQ(keys_of(m), std::vector<std::string>{"b", "d", "c", "a"});
+
+    it = m.erase(std::next(m.begin()), std::prev(m.end()));
+    CHECK_EQ(it->first, "a");
+    CHECK_EQ(keys_of(m), std::vector<std::string>{"b", "a"});
+    it = m.erase(m.begin(), m.end());
+    CHECK_EQ(it, m.end());
+    CHECK(m.empty());
+    CHECK_EQ(m.begin(), m.end());
+
+    m["x"] = 1;
+    CHECK_EQ(keys_of(m), std::vector<std::string>{"x"});
+}
+
+TEST_CASE("OrderedHashMap.Compaction") {
+    collie::ordered_hash_map<int, int> m;
+    for (int i = 0; i < 1000; ++i) {
+        m[i] = i;
+    }
+    // erase the even keys while iterating, which compacts the array
+    for (auto it = m.begin(); it != m.end();) {
+        if (it->first % 2 == 0) {
+            it = m.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    CHECK_EQ(m.size(), 500);
+    int expected = 1;
+    for (auto &kv: m) {
+        CHECK_EQ(kv.first, expected);
+        expected += 2;
+    }
+    for (int i = 0; i < 1000; ++i) {
+        CHECK_EQ(m.contains(i), i % 2 == 1);
+    }
+
+    // popping the front is O(1) and keeps the order
+    while (m.size() > 10) {
+        m.erase(m.begin());
+    }
+    CHECK_EQ(m.begin()->first, 981);
+    m.shrink_to_fit();
+    CHECK_EQ(m.capacity(), 10);
+    CHECK_EQ(m.begin()->first, 981);
+    CHECK_EQ(m.at(999), 999);
+}
+
+TEST_CASE("OrderedHashMap.CollidingHash") {
+    collie::ordered_hash_map<int, int, BadHash> m;
+    std::vector<int> order;
+    std::mt19937 rng(42);
+    for (int round = 0; round < 2000; ++round) {
+        int k = static_cast<int>(rng() % 64);
+        if (rng() % 3 == 0) {
+            auto pos = std::find(order.begin(), order.end(), k);
+            CHECK_EQ(m.erase(k), pos != order.end() ? 1 : 0);
+            if (pos != order.end()) {
+                order.erase(pos);
+            }
+        } else if (m.try_emplace(k, k).second) {
+            order.push_back(k);
+        }
+        REQUIRE_EQ(m.size(), order.size());
+    }
+    CHECK_EQ(keys_of(m), order);
+    for (int k = 0; k < 64; ++k) {
+        CHECK_EQ(m.contains(k), std::find(order.begin(), order.end(), k) != order.end());
+    }
+}
+
+TEST_CASE("OrderedHashMap.ArgumentFromSameMap") {
+    collie::ordered_hash_map<int, std::string> m;
+    m[0] = std::string(100, 'x');
+    // the array is full, the new element must be built before it moves
+    for (int i = 1; i < 100; ++i) {
+        m.try_emplace(i, m.at(i - 1));
+    }
+    CHECK_EQ(m.at(99), std::string(100, 'x'));
+}
+
+TEST_CASE("OrderedHashMap.CopyMoveCompare") {
+    collie::ordered_hash_map<std::string, std::unique_ptr<int>> owners;
+    owners.try_emplace("p", std::make_unique<int>(7));
+    auto moved = std::move(owners);
+    CHECK(owners.empty());
+    CHECK_EQ(*moved.at("p"), 7);
+
+    collie::ordered_hash_map<std::string, int> m1 = {{"A", 1}, {"B", 2}};
+    collie::ordered_hash_map<std::string, int> m2 = {{"B", 2}, {"A", 1}};
+    collie::ordered_hash_map<std::string, int> m3 = {{"A", 3}, {"B", 4}};
+    auto copy = m1;
+    CHECK(copy == m1);
+    CHECK(m1 != m2);
+    CHECK(m1 < m3);
+    CHECK(m3 >= m1);
+
+    copy.erase("A");
+    copy["A"] = 1;
+    CHECK(copy == m2);
+    std::swap(copy, m1);
+    CHECK(m1 == m2);
+    m1.clear();
+    CHECK(m1.empty());
+    m1["C"] = 3;
+    CHECK_EQ(keys_of(m1), std::vector<std::string>{"C"});
+}
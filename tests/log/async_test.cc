@@ -168,7 +168,7 @@ TEST_CASE("to_file [async]")
     prepare_logdir();
     size_t messages = 1024;
     size_t tp_threads = 1;
-    collie::log::filename_t filename = TLOG_FILENAME_T(TEST_FILENAME);
+    collie::log::filename_t filename = CLOG_FILENAME_T(TEST_FILENAME);
     {
         auto file_sink = std::make_shared<collie::log::sinks::basic_file_sink_mt>(filename, true);
         auto tp = std::make_shared<collie::log::details::thread_pool>(messages, tp_threads);
@@ -183,7 +183,7 @@ TEST_CASE("to_file [async]")
     require_message_count(TEST_FILENAME, messages);
     auto contents = file_contents(TEST_FILENAME);
     using collie::log::details::os::default_eol;
-    REQUIRE(ends_with(contents, turbo::format("Hello message #1023{}", default_eol)));
+    REQUIRE(ends_with(contents, fmt::format("Hello message #1023{}", default_eol)));
 }
 
 TEST_CASE("to_file multi-workers [async]")
@@ -191,7 +191,7 @@ TEST_CASE("to_file multi-workers [async]")
     prepare_logdir();
     size_t messages = 1024 * 10;
     size_t tp_threads = 10;
-    collie::log::filename_t filename = TLOG_FILENAME_T(TEST_FILENAME);
+    collie::log::filename_t filename = CLOG_FILENAME_T(TEST_FILENAME);
     {
         auto file_sink = std::make_shared<collie::log::sinks::basic_file_sink_mt>(filename, true);
         auto tp = std::make_shared<collie::log::details::thread_pool>(messages, tp_threads);
@@ -205,3 +205,123 @@ TEST_CASE("to_file multi-workers [async]")
 
     require_message_count(TEST_FILENAME, messages);
 }
+
+TEST_CASE("per thread rings [async]")
+{
+    auto test_sink = std::make_shared<collie::log::sinks::test_sink_mt>();
+    size_t queue_size = 64;
+    size_t messages = 1024;
+    size_t n_threads = 10;
+    {
+        auto tp = std::make_shared<collie::log::details::thread_pool>(queue_size, 2, collie::log::async_queue_mode::per_thread);
+        auto logger = std::make_shared<collie::log::async_logger>("as", test_sink, tp, collie::log::async_overflow_policy::block);
+
+        std::vector<std::thread> threads;
+        for (size_t i = 0; i < n_threads; i++)
+        {
+            threads.emplace_back([logger, messages] {
+                for (size_t j = 0; j < messages; j++)
+                {
+                    logger->info("Hello message #{}", j);
+                }
+                logger->flush();
+            });
+        }
+
+        for (auto &t : threads)
+        {
+            t.join();
+        }
+        REQUIRE(tp->overrun_counter() == 0);
+    }
+
+    REQUIRE(test_sink->msg_counter() == messages * n_threads);
+    REQUIRE(test_sink->flush_counter() == n_threads);
+}
+
+TEST_CASE("per thread rings discard [async]")
+{
+    auto test_sink = std::make_shared<collie::log::sinks::test_sink_mt>();
+    test_sink->set_delay(std::chrono::milliseconds(1));
+    size_t queue_size = 4;
+    size_t messages = 1024;
+
+    auto tp = std::make_shared<collie::log::details::thread_pool>(queue_size, 1, collie::log::async_queue_mode::per_thread);
+    auto logger = std::make_shared<collie::log::async_logger>("as", test_sink, tp, collie::log::async_overflow_policy::discard_new);
+    for (size_t i = 0; i < messages; i++)
+    {
+        logger->info("Hello message");
+    }
+    REQUIRE(test_sink->msg_counter() < messages);
+    REQUIRE(tp->discard_counter() > 0);
+}
+
+TEST_CASE("deferred format [async]")
+{
+    auto test_sink = std::make_shared<collie::log::sinks::test_sink_mt>();
+    test_sink->set_pattern("%v");
+    {
+        auto tp = std::make_shared<collie::log::details::thread_pool>(128, 1);
+        auto logger = std::make_shared<collie::log::async_logger>("as", test_sink, tp);
+        logger->enable_deferred_format();
+        REQUIRE(logger->deferred_format_enabled());
+
+        std::string name = "eager";
+        logger->info("int {} double {:.2f} char {} bool {}", 42, 3.5, 'z', true);
+        logger->info("{} {}", name, 7);
+        logger->info("no args");
+        logger->flush();
+    }
+
+    auto lines = test_sink->lines();
+    REQUIRE(lines.size() == 3);
+    REQUIRE(lines[0] == "int 42 double 3.50 char z bool true");
+    REQUIRE(lines[1] == "eager 7");
+    REQUIRE(lines[2] == "no args");
+}
+
+TEST_CASE("batched file sink [async]")
+{
+    prepare_logdir();
+    size_t messages = 1024;
+    collie::log::filename_t filename = CLOG_FILENAME_T(TEST_FILENAME);
+    {
+        auto file_sink = std::make_shared<collie::log::sinks::basic_file_sink_mt>(filename, true);
+        file_sink->set_level(collie::log::level::info);
+        auto tp = std::make_shared<collie::log::details::thread_pool>(messages, 1);
+        auto logger = std::make_shared<collie::log::async_logger>("as", std::move(file_sink), std::move(tp));
+        logger->set_level(collie::log::level::trace);
+
+        for (size_t j = 0; j < messages; j++)
+        {
+            logger->info("Hello message #{}", j);
+            logger->debug("filtered by the sink #{}", j);
+        }
+    }
+
+    require_message_count(TEST_FILENAME, messages);
+    auto contents = file_contents(TEST_FILENAME);
+    using collie::log::details::os::default_eol;
+    REQUIRE(ends_with(contents, fmt::format("Hello message #1023{}", default_eol)));
+}
+
+TEST_CASE("batched rotating sink [async]")
+{
+    prepare_logdir();
+    size_t max_size = 1024;
+    collie::log::filename_t basename = CLOG_FILENAME_T(TEST_FILENAME);
+    {
+        auto rotating_sink = std::make_shared<collie::log::sinks::rotating_file_sink_mt>(basename, max_size, 2);
+        auto tp = std::make_shared<collie::log::details::thread_pool>(1024, 1);
+        auto logger = std::make_shared<collie::log::async_logger>("as", std::move(rotating_sink), std::move(tp));
+
+        for (int i = 0; i < 1000; i++)
+        {
+            logger->info("Hello message #{}", i);
+        }
+    }
+
+    REQUIRE(get_filesize(TEST_FILENAME) <= max_size);
+    auto filename1 = collie::log::sinks::rotating_file_sink_st::calc_filename(basename, 1);
+    REQUIRE(get_filesize(collie::log::details::os::filename_to_str(filename1)) <= max_size);
+}
@@ -17,23 +17,23 @@
 #include "collie/testing/test.h"
 #include "includes.h"
 
-#ifdef TLOG_USE_STD_FORMAT
+#ifdef CLOG_USE_STD_FORMAT
 using filename_memory_buf_t = std::basic_string<collie::log::filename_t::value_type>;
 #else
-using filename_memory_buf_t = turbo::basic_memory_buffer<collie::log::filename_t::value_type, 250>;
+using filename_memory_buf_t = fmt::basic_memory_buffer<collie::log::filename_t::value_type, 250>;
 #endif
 
-#ifdef TLOG_WCHAR_FILENAMES
+#ifdef CLOG_WCHAR_FILENAMES
 std::string filename_buf_to_utf8string(const filename_memory_buf_t &w)
 {
     collie::log::memory_buf_t buf;
     collie::log::details::os::wstr_to_utf8buf(collie::log::wstring_view_t(w.data(), w.size()), buf);
-    return TLOG_BUF_TO_STRING(buf);
+    return fmt::to_string(buf);
 }
 #else
 
 std::string filename_buf_to_utf8string(const filename_memory_buf_t &w) {
-    return TLOG_BUF_TO_STRING(w);
+    return fmt::to_string(w);
 }
 
 #endif
@@ -45,11 +45,11 @@ TEST_CASE("daily_logger with dateonly calculator [daily_logger]")
     prepare_logdir();
 
     // calculate filename (time based)
-    collie::log::filename_t basename = TLOG_FILENAME_T("test_logs/daily_dateonly");
-    std::tm tm = turbo::Time::time_now().to_local_tm();
+    collie::log::filename_t basename = CLOG_FILENAME_T("test_logs/daily_dateonly");
+    std::tm tm = collie::log::details::os::localtime();
     filename_memory_buf_t w;
-    turbo::format_to(
-            std::back_inserter(w), TLOG_FILENAME_T("{}_{:04d}-{:02d}-{:02d}"), basename, tm.tm_year + 1900,
+    fmt::format_to(
+            std::back_inserter(w), CLOG_FILENAME_T("{}_{:04d}-{:02d}-{:02d}"), basename, tm.tm_year + 1900,
             tm.tm_mon + 1, tm.tm_mday);
 
     auto logger = collie::log::create<sink_type>("logger", basename, 0, 0);
@@ -65,11 +65,11 @@ TEST_CASE("daily_logger with dateonly calculator [daily_logger]")
 struct custom_daily_file_name_calculator {
     static collie::log::filename_t calc_filename(const collie::log::filename_t &basename, const tm &now_tm) {
         filename_memory_buf_t w;
-        turbo::format_to(std::back_inserter(w), TLOG_FILENAME_T("{}{:04d}{:02d}{:02d}"), basename,
+        fmt::format_to(std::back_inserter(w), CLOG_FILENAME_T("{}{:04d}{:02d}{:02d}"), basename,
                                         now_tm.tm_year + 1900,
                                         now_tm.tm_mon + 1, now_tm.tm_mday);
 
-        return TLOG_BUF_TO_STRING(w);
+        return fmt::to_string(w);
     }
 };
 
@@ -80,11 +80,11 @@ TEST_CASE("daily_logger with custom calculator [daily_logger]")
     prepare_logdir();
 
     // calculate filename (time based)
-    collie::log::filename_t basename = TLOG_FILENAME_T("test_logs/daily_dateonly");
-    std::tm tm = turbo::Time::time_now().to_local_tm();
+    collie::log::filename_t basename = CLOG_FILENAME_T("test_logs/daily_dateonly");
+    std::tm tm = collie::log::details::os::localtime();
     filename_memory_buf_t w;
-    turbo::format_to(
-            std::back_inserter(w), TLOG_FILENAME_T("{}{:04d}{:02d}{:02d}"), basename, tm.tm_year + 1900, tm.tm_mon + 1,
+    fmt::format_to(
+            std::back_inserter(w), CLOG_FILENAME_T("{}{:04d}{:02d}{:02d}"), basename, tm.tm_year + 1900, tm.tm_mon + 1,
             tm.tm_mday);
 
     auto logger = collie::log::create<sink_type>("logger", basename, 0, 0);
@@ -103,20 +103,20 @@ TEST_CASE("daily_logger with custom calculator [daily_logger]")
 
 TEST_CASE("rotating_file_sink::calc_filename1 [rotating_file_sink]]")
 {
-    auto filename = collie::log::sinks::rotating_file_sink_st::calc_filename(TLOG_FILENAME_T("rotated.txt"), 3);
-    REQUIRE_EQ(filename , TLOG_FILENAME_T("rotated.3.txt"));
+    auto filename = collie::log::sinks::rotating_file_sink_st::calc_filename(CLOG_FILENAME_T("rotated.txt"), 3);
+    REQUIRE_EQ(filename , CLOG_FILENAME_T("rotated.3.txt"));
 }
 
 TEST_CASE("rotating_file_sink::calc_filename2 [rotating_file_sink]]")
 {
-    auto filename = collie::log::sinks::rotating_file_sink_st::calc_filename(TLOG_FILENAME_T("rotated"), 3);
-    REQUIRE_EQ(filename , TLOG_FILENAME_T("rotated.3"));
+    auto filename = collie::log::sinks::rotating_file_sink_st::calc_filename(CLOG_FILENAME_T("rotated"), 3);
+    REQUIRE_EQ(filename , CLOG_FILENAME_T("rotated.3"));
 }
 
 TEST_CASE("rotating_file_sink::calc_filename3 [rotating_file_sink]]")
 {
-    auto filename = collie::log::sinks::rotating_file_sink_st::calc_filename(TLOG_FILENAME_T("rotated.txt"), 0);
-    REQUIRE_EQ(filename , TLOG_FILENAME_T("rotated.txt"));
+    auto filename = collie::log::sinks::rotating_file_sink_st::calc_filename(CLOG_FILENAME_T("rotated.txt"), 0);
+    REQUIRE_EQ(filename , CLOG_FILENAME_T("rotated.txt"));
 }
 
 // regex supported only from gcc 4.9 and above
@@ -128,11 +128,11 @@ TEST_CASE("daily_file_sink::daily_filename_calculator [daily_file_sink]]")
 {
     // daily_YYYY-MM-DD_hh-mm.txt
     auto filename =
-            collie::log::sinks::daily_filename_calculator::calc_filename(TLOG_FILENAME_T("daily.txt"),
-                                                                         turbo::Time::time_now().to_local_tm());
+            collie::log::sinks::daily_filename_calculator::calc_filename(CLOG_FILENAME_T("daily.txt"),
+                                                                         collie::log::details::os::localtime());
     // date regex based on https://www.regular-expressions.info/dates.html
     std::basic_regex<collie::log::filename_t::value_type> re(
-            TLOG_FILENAME_T(R"(^daily_(19|20)\d\d-(0[1-9]|1[012])-(0[1-9]|[12][0-9]|3[01])\.txt$)"));
+            CLOG_FILENAME_T(R"(^daily_(19|20)\d\d-(0[1-9]|1[012])-(0[1-9]|[12][0-9]|3[01])\.txt$)"));
     std::match_results<collie::log::filename_t::const_iterator> match;
     REQUIRE(std::regex_match(filename, match, re));
 }
@@ -143,17 +143,17 @@ TEST_CASE("daily_file_sink::daily_filename_format_calculator [daily_file_sink]]"
 {
     std::tm tm = collie::log::details::os::localtime();
     // example-YYYY-MM-DD.log
-    auto filename = collie::log::sinks::daily_filename_format_calculator::calc_filename(TLOG_FILENAME_T("example-%Y-%m-%d.log"), tm);
+    auto filename = collie::log::sinks::daily_filename_format_calculator::calc_filename(CLOG_FILENAME_T("example-%Y-%m-%d.log"), tm);
 
     REQUIRE_EQ(filename,
-            turbo::format(TLOG_FILENAME_T("example-{:04d}-{:02d}-{:02d}.log"), tm.tm_year + 1900,
+            fmt::format(CLOG_FILENAME_T("example-{:04d}-{:02d}-{:02d}.log"), tm.tm_year + 1900,
                                          tm.tm_mon + 1, tm.tm_mday));
 }*/
 
 /* Test removal of old files */
-static collie::log::details::log_msg create_msg(turbo::Duration offset) {
+static collie::log::details::log_msg create_msg(collie::log::log_clock::duration offset) {
     collie::log::details::log_msg msg{"test", collie::log::level::info, "Hello Message"};
-    msg.time = turbo::Time::time_now() + offset;
+    msg.time = collie::log::details::os::now() + offset;
     return msg;
 }
 
@@ -163,13 +163,13 @@ static void test_rotate(int days_to_run, uint16_t max_days, uint16_t expected_n_
 
     prepare_logdir();
 
-    collie::log::filename_t basename = TLOG_FILENAME_T("test_logs/daily_rotate.txt");
+    collie::log::filename_t basename = CLOG_FILENAME_T("test_logs/daily_rotate.txt");
     daily_file_sink_st sink{basename, 2, 30, true, max_days};
 
     // simulate messages with 24 intervals
 
     for (int i = 0; i < days_to_run; i++) {
-        auto offset = turbo::Duration::seconds(24 * 3600 * i);
+        auto offset = std::chrono::seconds(24 * 3600 * i);
         sink.log(create_msg(offset));
     }
 
@@ -27,7 +27,7 @@
 #include <iomanip>
 #include <stdlib.h>
 
-#define TLOG_ACTIVE_LEVEL TLOG_LEVEL_DEBUG
+#define CLOG_ACTIVE_LEVEL CLOG_LEVEL_DEBUG
 
 #include "collie/log/logging.h"
 #include "collie/log/async.h"
@@ -37,5 +37,7 @@
 #include "collie/log/sinks/null_sink.h"
 #include "collie/log/sinks/ostream_sink.h"
 #include "collie/log/sinks/rotating_file_sink.h"
+#include "collie/log/sinks/mmap_rotating_file_sink.h"
 #include "collie/log/sinks/stdout_color_sinks.h"
 #include "collie/log/pattern_formatter.h"
+#include "collie/log/compiled_pattern.h"
@@ -17,8 +17,8 @@
 #include "log_sink.h"
 
 #include <cstdlib>
-#include <turbo/log/cfg/env.h>
-#include <turbo/log/cfg/argv.h>
+#include <collie/log/cfg/env.h>
+#include <collie/log/cfg/argv.h>
 
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 
@@ -33,9 +33,9 @@ TEST_CASE("env [cfg]")
     collie::log::drop("l1");
     auto l1 = collie::log::create<test_sink_st>("l1");
 #ifdef CATCH_PLATFORM_WINDOWS
-    _putenv_s("TLOG_LEVEL", "l1=warn");
+    _putenv_s("CLOG_LEVEL", "l1=warn");
 #else
-    ::setenv("TLOG_LEVEL", "l1=warn", 1);
+    ::setenv("CLOG_LEVEL", "l1=warn", 1);
 #endif
     load_env_levels();
     REQUIRE_EQ(l1->level(), collie::log::level::warn);
@@ -46,7 +46,7 @@ TEST_CASE("env [cfg]")
 TEST_CASE("argv1 [cfg]")
 {
     collie::log::drop("l1");
-    const char *argv[] = {"ignore", "TLOG_LEVEL=l1=warn"};
+    const char *argv[] = {"ignore", "CLOG_LEVEL=l1=warn"};
     load_argv_levels(2, argv);
     auto l1 = collie::log::create<collie::log::sinks::test_sink_st>("l1");
     REQUIRE_EQ(l1->level(), collie::log::level::warn);
@@ -56,7 +56,7 @@ TEST_CASE("argv1 [cfg]")
 TEST_CASE("argv2 [cfg]")
 {
     collie::log::drop("l1");
-    const char *argv[] = {"ignore", "TLOG_LEVEL=l1=warn,trace"};
+    const char *argv[] = {"ignore", "CLOG_LEVEL=l1=warn,trace"};
     load_argv_levels(2, argv);
     auto l1 = collie::log::create<test_sink_st>("l1");
     REQUIRE_EQ(l1->level(), collie::log::level::warn);
@@ -68,7 +68,7 @@ TEST_CASE("argv3 [cfg]")
     collie::log::set_level(collie::log::level::trace);
 
     collie::log::drop("l1");
-    const char *argv[] = {"ignore", "TLOG_LEVEL=junk_name=warn"};
+    const char *argv[] = {"ignore", "CLOG_LEVEL=junk_name=warn"};
     load_argv_levels(2, argv);
     auto l1 = collie::log::create<test_sink_st>("l1");
     REQUIRE_EQ(l1->level(), collie::log::level::trace);
@@ -79,7 +79,7 @@ TEST_CASE("argv4 [cfg]")
 {
     collie::log::set_level(collie::log::level::info);
     collie::log::drop("l1");
-    const char *argv[] = {"ignore", "TLOG_LEVEL=junk"};
+    const char *argv[] = {"ignore", "CLOG_LEVEL=junk"};
     load_argv_levels(2, argv);
     auto l1 = collie::log::create<test_sink_st>("l1");
     REQUIRE_EQ(l1->level(), collie::log::level::info);
@@ -89,7 +89,7 @@ TEST_CASE("argv5 [cfg]")
 {
     collie::log::set_level(collie::log::level::info);
     collie::log::drop("l1");
-    const char *argv[] = {"ignore", "ignore", "TLOG_LEVEL=l1=warn,trace"};
+    const char *argv[] = {"ignore", "ignore", "CLOG_LEVEL=l1=warn,trace"};
     load_argv_levels(3, argv);
     auto l1 = collie::log::create<test_sink_st>("l1");
     REQUIRE_EQ(l1->level(), collie::log::level::warn);
@@ -99,19 +99,19 @@ TEST_CASE("argv5 [cfg]")
 
 TEST_CASE("argv6 [cfg]")
 {
-    collie::log::set_level(collie::log::level::err);
+    collie::log::set_level(collie::log::level::error);
     const char *argv[] = {""};
     load_argv_levels(1, argv);
-    REQUIRE_EQ(collie::log::default_logger()->level(), collie::log::level::err);
+    REQUIRE_EQ(collie::log::default_logger()->level(), collie::log::level::error);
     collie::log::set_level(collie::log::level::info);
 }
 
 TEST_CASE("argv7 [cfg]")
 {
-    collie::log::set_level(collie::log::level::err);
+    collie::log::set_level(collie::log::level::error);
     const char *argv[] = {""};
     load_argv_levels(0, argv);
-    REQUIRE_EQ(collie::log::default_logger()->level(), collie::log::level::err);
+    REQUIRE_EQ(collie::log::default_logger()->level(), collie::log::level::error);
     collie::log::set_level(collie::log::level::info);
 }
 
@@ -130,7 +130,7 @@ TEST_CASE("level-not-set-test2 [cfg]")
 {
     collie::log::drop("l1");
     collie::log::drop("l2");
-    const char *argv[] = {"ignore", "TLOG_LEVEL=l1=trace"};
+    const char *argv[] = {"ignore", "CLOG_LEVEL=l1=trace"};
 
     auto l1 = collie::log::create<collie::log::sinks::test_sink_st>("l1");
     l1->set_level(collie::log::level::warn);
@@ -148,7 +148,7 @@ TEST_CASE("level-not-set-test3 [cfg]")
 {
     collie::log::drop("l1");
     collie::log::drop("l2");
-    const char *argv[] = {"ignore", "TLOG_LEVEL=l1=trace"};
+    const char *argv[] = {"ignore", "CLOG_LEVEL=l1=trace"};
 
     load_argv_levels(2, argv);
 
@@ -164,7 +164,7 @@ TEST_CASE("level-not-set-test4 [cfg]")
 {
     collie::log::drop("l1");
     collie::log::drop("l2");
-    const char *argv[] = {"ignore", "TLOG_LEVEL=l1=trace,warn"};
+    const char *argv[] = {"ignore", "CLOG_LEVEL=l1=trace,warn"};
 
     load_argv_levels(2, argv);
 
@@ -180,7 +180,7 @@ TEST_CASE("level-not-set-test5 [cfg]")
 {
     collie::log::drop("l1");
     collie::log::drop("l2");
-    const char *argv[] = {"ignore", "TLOG_LEVEL=l1=junk,warn"};
+    const char *argv[] = {"ignore", "CLOG_LEVEL=l1=junk,warn"};
 
     load_argv_levels(2, argv);
 
@@ -196,7 +196,7 @@ TEST_CASE("restore-to-default [cfg]")
 {
     collie::log::drop("l1");
     collie::log::drop("l2");
-    const char *argv[] = {"ignore", "TLOG_LEVEL=info"};
+    const char *argv[] = {"ignore", "CLOG_LEVEL=info"};
     load_argv_levels(2, argv);
     REQUIRE_EQ(collie::log::default_logger()->level(), collie::log::level::info);
 }
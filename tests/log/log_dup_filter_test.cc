@@ -14,7 +14,7 @@
 //
 
 #include "includes.h"
-#include "turbo/log/sinks/dup_filter_sink.h"
+#include "collie/log/sinks/dup_filter_sink.h"
 #include "log_sink.h"
 
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
@@ -25,7 +25,7 @@ TEST_CASE("dup_filter_test1 [dup_filter_sink]")
     using collie::log::sinks::dup_filter_sink_st;
     using collie::log::sinks::test_sink_mt;
 
-    dup_filter_sink_st dup_sink{turbo::Duration::seconds(5)};
+    dup_filter_sink_st dup_sink{std::chrono::seconds(5)};
     auto test_sink = std::make_shared<test_sink_mt>();
     dup_sink.add_sink(test_sink);
 
@@ -42,7 +42,7 @@ TEST_CASE("dup_filter_test2 [dup_filter_sink]")
     using collie::log::sinks::dup_filter_sink_st;
     using collie::log::sinks::test_sink_mt;
 
-    dup_filter_sink_st dup_sink{turbo::Duration::seconds(0)};
+    dup_filter_sink_st dup_sink{std::chrono::seconds(0)};
     auto test_sink = std::make_shared<test_sink_mt>();
     dup_sink.add_sink(test_sink);
 
@@ -60,7 +60,7 @@ TEST_CASE("dup_filter_test3 [dup_filter_sink]")
     using collie::log::sinks::dup_filter_sink_st;
     using collie::log::sinks::test_sink_mt;
 
-    dup_filter_sink_st dup_sink(turbo::Duration::seconds(1));
+    dup_filter_sink_st dup_sink(std::chrono::seconds(1));
     auto test_sink = std::make_shared<test_sink_mt>();
     dup_sink.add_sink(test_sink);
 
@@ -78,7 +78,7 @@ TEST_CASE("dup_filter_test4 [dup_filter_sink]")
     using collie::log::sinks::dup_filter_sink_mt;
     using collie::log::sinks::test_sink_mt;
 
-    dup_filter_sink_mt dup_sink{turbo::Duration::milliseconds(10)};
+    dup_filter_sink_mt dup_sink{std::chrono::milliseconds(10)};
     auto test_sink = std::make_shared<test_sink_mt>();
     dup_sink.add_sink(test_sink);
 
@@ -93,7 +93,7 @@ TEST_CASE("dup_filter_test5 [dup_filter_sink]")
     using collie::log::sinks::dup_filter_sink_mt;
     using collie::log::sinks::test_sink_mt;
 
-    dup_filter_sink_mt dup_sink{turbo::Duration::seconds(5)};
+    dup_filter_sink_mt dup_sink{std::chrono::seconds(5)};
     auto test_sink = std::make_shared<test_sink_mt>();
     test_sink->set_pattern("%v");
     dup_sink.add_sink(test_sink);
@@ -20,7 +20,7 @@
 #include "collie/testing/test.h"
 
 using collie::log::memory_buf_t;
-using collie::log::details::fmt_helper::to_string_view;
+using collie::log::details::to_string_view;
 
 void test_pad2(int n, const char *expected) {
     memory_buf_t buf;
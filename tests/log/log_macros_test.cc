@@ -17,8 +17,8 @@
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 #include "collie/testing/test.h"
 
-#if TLOG_ACTIVE_LEVEL != TLOG_LEVEL_DEBUG
-#    error "Invalid TLOG_ACTIVE_LEVEL in test. Should be TLOG_LEVEL_DEBUG"
+#if CLOG_ACTIVE_LEVEL != CLOG_LEVEL_DEBUG
+#    error "Invalid CLOG_ACTIVE_LEVEL in test. Should be CLOG_LEVEL_DEBUG"
 #endif
 
 #define TEST_FILENAME "test_logs/simple_log"
@@ -27,41 +27,41 @@ TEST_CASE("debug and trace w/o format string [macros]]")
 {
 
     prepare_logdir();
-    collie::log::filename_t filename = TLOG_FILENAME_T(TEST_FILENAME);
+    collie::log::filename_t filename = CLOG_FILENAME_T(TEST_FILENAME);
 
     auto logger = collie::log::create<collie::log::sinks::basic_file_sink_mt>("logger", filename);
     logger->set_pattern("%v");
     logger->set_level(collie::log::level::trace);
 
-    TLOG_LOGGER_TRACE(logger, "Test message 1");
-    TLOG_LOGGER_DEBUG(logger, "Test message 2");
+    CLOG_LOGGER_TRACE(logger, "Test message 1");
+    CLOG_LOGGER_DEBUG(logger, "Test message 2");
     logger->flush();
 
     using collie::log::details::os::default_eol;
-    REQUIRE(ends_with(file_contents(TEST_FILENAME), turbo::format("Test message 2{}", default_eol)));
+    REQUIRE(ends_with(file_contents(TEST_FILENAME), fmt::format("Test message 2{}", default_eol)));
     REQUIRE(count_lines(TEST_FILENAME) == 1);
 
     auto orig_default_logger = collie::log::default_logger();
     collie::log::set_default_logger(logger);
 
-    TLOG_TRACE("Test message 3");
-    TLOG_DEBUG("Test message {}", 4);
+    CLOG_TRACE("Test message 3");
+    CLOG_DEBUG("Test message {}", 4);
     logger->flush();
 
     require_message_count(TEST_FILENAME, 2);
-    REQUIRE(ends_with(file_contents(TEST_FILENAME), turbo::format("Test message 4{}", default_eol)));
+    REQUIRE(ends_with(file_contents(TEST_FILENAME), fmt::format("Test message 4{}", default_eol)));
     collie::log::set_default_logger(std::move(orig_default_logger));
 }
 
 TEST_CASE("disable param evaluation [macros]")
 {
-    TLOG_TRACE("Test message {}", throw std::runtime_error("Should not be evaluated"));
+    CLOG_TRACE("Test message {}", throw std::runtime_error("Should not be evaluated"));
 }
 
 TEST_CASE("pass logger pointer [macros]")
 {
     auto logger = collie::log::create<collie::log::sinks::null_sink_mt>("refmacro");
     auto &ref = *logger;
-    TLOG_LOGGER_TRACE(&ref, "Test message 1");
-    TLOG_LOGGER_DEBUG(&ref, "Test message 2");
+    CLOG_LOGGER_TRACE(&ref, "Test message 1");
+    CLOG_LOGGER_DEBUG(&ref, "Test message 2");
 }
@@ -15,7 +15,7 @@
 
 #include "includes.h"
 #include "log_sink.h"
-#include "turbo/log/fmt/bin_to_hex.h"
+#include "collie/log/bin_to_hex.h"
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 #include "collie/testing/test.h"
 
@@ -66,9 +66,9 @@ TEST_CASE("level_to_string_view [convert_to_string_view")
     REQUIRE(collie::log::level::to_string_view(collie::log::level::trace) == "trace");
     REQUIRE(collie::log::level::to_string_view(collie::log::level::debug) == "debug");
     REQUIRE(collie::log::level::to_string_view(collie::log::level::info) == "info");
-    REQUIRE(collie::log::level::to_string_view(collie::log::level::warn) == "warning");
-    REQUIRE(collie::log::level::to_string_view(collie::log::level::err) == "error");
-    REQUIRE(collie::log::level::to_string_view(collie::log::level::critical) == "critical");
+    REQUIRE(collie::log::level::to_string_view(collie::log::level::warn) == "warn");
+    REQUIRE(collie::log::level::to_string_view(collie::log::level::error) == "error");
+    REQUIRE(collie::log::level::to_string_view(collie::log::level::fatal) == "fatal");
     REQUIRE(collie::log::level::to_string_view(collie::log::level::off) == "off");
 }
 
@@ -78,8 +78,8 @@ TEST_CASE("to_short_c_str [convert_to_short_c_str]")
     REQUIRE(std::string(collie::log::level::to_short_c_str(collie::log::level::debug)) == "D");
     REQUIRE(std::string(collie::log::level::to_short_c_str(collie::log::level::info)) == "I");
     REQUIRE(std::string(collie::log::level::to_short_c_str(collie::log::level::warn)) == "W");
-    REQUIRE(std::string(collie::log::level::to_short_c_str(collie::log::level::err)) == "E");
-    REQUIRE(std::string(collie::log::level::to_short_c_str(collie::log::level::critical)) == "C");
+    REQUIRE(std::string(collie::log::level::to_short_c_str(collie::log::level::error)) == "E");
+    REQUIRE(std::string(collie::log::level::to_short_c_str(collie::log::level::fatal)) == "C");
     REQUIRE(std::string(collie::log::level::to_short_c_str(collie::log::level::off)) == "O");
 }
 
@@ -88,10 +88,10 @@ TEST_CASE("to_level_enum [convert_to_level_enum]")
     REQUIRE(collie::log::level::from_str("trace") == collie::log::level::trace);
     REQUIRE(collie::log::level::from_str("debug") == collie::log::level::debug);
     REQUIRE(collie::log::level::from_str("info") == collie::log::level::info);
-    REQUIRE(collie::log::level::from_str("warning") == collie::log::level::warn);
+    REQUIRE(collie::log::level::from_str("err") == collie::log::level::error);
     REQUIRE(collie::log::level::from_str("warn") == collie::log::level::warn);
-    REQUIRE(collie::log::level::from_str("error") == collie::log::level::err);
-    REQUIRE(collie::log::level::from_str("critical") == collie::log::level::critical);
+    REQUIRE(collie::log::level::from_str("error") == collie::log::level::error);
+    REQUIRE(collie::log::level::from_str("fatal") == collie::log::level::fatal);
     REQUIRE(collie::log::level::from_str("off") == collie::log::level::off);
     REQUIRE(collie::log::level::from_str("null") == collie::log::level::off);
 }
@@ -148,7 +148,7 @@ TEST_CASE("clone async [clone]")
     logger->info("Some message 1");
     cloned->info("Some message 2");
 
-    turbo::sleep_for(turbo::Duration::milliseconds(100));
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
 
     REQUIRE(test_sink->lines().size() == 2);
     REQUIRE(test_sink->lines()[0] == "Some message 1");
@@ -276,7 +276,7 @@ TEST_CASE("default logger API [default logger]")
     REQUIRE(oss.str() == "*** 123" + std::string(collie::log::details::os::default_eol));
 
     oss.str("");
-    collie::log::critical(std::string("some string"));
+    collie::log::fatal(std::string("some string"));
     REQUIRE(oss.str() == "*** some string" + std::string(collie::log::details::os::default_eol));
 
     oss.str("");
@@ -121,3 +121,209 @@ TEST_CASE("full_queue [mpmc_blocking_q]")
     q.dequeue_for(item, milliseconds(0));
     REQUIRE(item == 123456);
 }
+
+TEST_CASE("dequeue-empty-nowait [mpmc_lockfree_q]")
+{
+    size_t q_size = 100;
+    milliseconds tolerance_wait(20);
+    collie::log::details::mpmc_lockfree_queue<int> q(q_size);
+    int popped_item = 0;
+
+    auto start = test_clock::now();
+    auto rv = q.dequeue_for(popped_item, milliseconds::zero());
+    auto delta_ms = millis_from(start);
+
+    REQUIRE(rv == false);
+    INFO("Delta " << delta_ms.count() << " millis");
+    REQUIRE(delta_ms <= tolerance_wait);
+}
+
+TEST_CASE("dequeue-empty-wait [mpmc_lockfree_q]")
+{
+    size_t q_size = 100;
+    milliseconds wait_ms(250);
+    milliseconds tolerance_wait(250);
+
+    collie::log::details::mpmc_lockfree_queue<int> q(q_size);
+    int popped_item = 0;
+    auto start = test_clock::now();
+    auto rv = q.dequeue_for(popped_item, wait_ms);
+    auto delta_ms = millis_from(start);
+
+    REQUIRE(rv == false);
+
+    INFO("Delta " << delta_ms.count() << " millis");
+    REQUIRE(delta_ms >= wait_ms - tolerance_wait);
+    REQUIRE(delta_ms <= wait_ms + tolerance_wait);
+}
+
+TEST_CASE("capacity [mpmc_lockfree_q]")
+{
+    REQUIRE(collie::log::details::mpmc_lockfree_queue<int>(0).capacity() == 2);
+    REQUIRE(collie::log::details::mpmc_lockfree_queue<int>(100).capacity() == 128);
+    REQUIRE(collie::log::details::mpmc_lockfree_queue<int>(8192).capacity() == 8192);
+}
+
+TEST_CASE("full_queue [mpmc_lockfree_q]")
+{
+    size_t q_size = 128;
+    collie::log::details::mpmc_lockfree_queue<int> q(q_size);
+    for (int i = 0; i < static_cast<int>(q_size); i++)
+    {
+        q.enqueue(i + 0);
+    }
+    REQUIRE(q.size() == q_size);
+
+    q.enqueue_nowait(123456);
+    REQUIRE(q.overrun_counter() == 1);
+
+    q.enqueue_if_have_room(654321);
+    REQUIRE(q.discard_counter() == 1);
+
+    for (int i = 1; i < static_cast<int>(q_size); i++)
+    {
+        int item = -1;
+        q.dequeue_for(item, milliseconds(0));
+        REQUIRE(item == i);
+    }
+
+    // last item pushed has overridden the oldest.
+    int item = -1;
+    q.dequeue_for(item, milliseconds(0));
+    REQUIRE(item == 123456);
+    REQUIRE(q.size() == 0);
+
+    q.reset_overrun_counter();
+    q.reset_discard_counter();
+    REQUIRE(q.overrun_counter() == 0);
+    REQUIRE(q.discard_counter() == 0);
+}
+
+TEST_CASE("dequeue_bulk [mpmc_lockfree_q]")
+{
+    collie::log::details::mpmc_lockfree_queue<int> q(16);
+    for (int i = 0; i < 10; i++)
+    {
+        q.enqueue(i + 0);
+    }
+
+    int items[4] = {};
+    REQUIRE(q.dequeue_bulk(items, 4) == 4);
+    REQUIRE(items[0] == 0);
+    REQUIRE(items[3] == 3);
+
+    int rest[16] = {};
+    REQUIRE(q.dequeue_bulk(rest, 16) == 6);
+    REQUIRE(rest[0] == 4);
+    REQUIRE(rest[5] == 9);
+}
+
+TEST_CASE("blocked_producers [mpmc_lockfree_q]")
+{
+    size_t n_producers = 8;
+    size_t per_producer = 10000;
+    collie::log::details::mpmc_lockfree_queue<size_t> q(16);
+
+    std::vector<std::thread> producers;
+    for (size_t p = 0; p < n_producers; p++)
+    {
+        producers.emplace_back([&q, p, per_producer] {
+            for (size_t i = 0; i < per_producer; i++)
+            {
+                q.enqueue(p * per_producer + i + 1);
+            }
+        });
+    }
+
+    size_t received = 0;
+    size_t sum = 0;
+    size_t batch[32];
+    while (received < n_producers * per_producer)
+    {
+        size_t n = q.dequeue_bulk(batch, 32);
+        for (size_t i = 0; i < n; i++)
+        {
+            sum += batch[i];
+        }
+        received += n;
+    }
+    for (auto &t : producers)
+    {
+        t.join();
+    }
+
+    size_t total = n_producers * per_producer;
+    REQUIRE(received == total);
+    REQUIRE(sum == total * (total + 1) / 2);
+    REQUIRE(q.overrun_counter() == 0);
+}
+
+TEST_CASE("dequeue_bulk [mpmc_blocking_q]")
+{
+    collie::log::details::mpmc_blocking_queue<int> q(16);
+    for (int i = 0; i < 10; i++)
+    {
+        q.enqueue(i + 0);
+    }
+
+    int items[16] = {};
+    REQUIRE(q.dequeue_bulk(items, 4) == 4);
+    REQUIRE(items[3] == 3);
+    REQUIRE(q.dequeue_bulk(items, 16) == 6);
+    REQUIRE(items[5] == 9);
+}
+
+TEST_CASE("push_pop [spsc_ring]")
+{
+    collie::log::details::spsc_ring<int> ring(5);
+    REQUIRE(ring.capacity() == 8);
+    REQUIRE(ring.empty());
+
+    for (int i = 0; i < 8; i++)
+    {
+        int item = i;
+        REQUIRE(ring.try_push(item));
+    }
+    int overflow = 8;
+    REQUIRE_FALSE(ring.try_push(overflow));
+    REQUIRE(overflow == 8);
+    REQUIRE(ring.size() == 8);
+
+    int items[16] = {};
+    REQUIRE(ring.try_pop_bulk(items, 3) == 3);
+    REQUIRE(items[2] == 2);
+    REQUIRE(ring.try_push(overflow));
+    REQUIRE(ring.try_pop_bulk(items, 16) == 6);
+    REQUIRE(items[0] == 3);
+    REQUIRE(items[5] == 8);
+    REQUIRE(ring.try_pop_bulk(items, 16) == 0);
+}
+
+TEST_CASE("producer_consumer [spsc_ring]")
+{
+    size_t total = 100000;
+    collie::log::details::spsc_ring<size_t> ring(16);
+    std::thread producer([&ring, total] {
+        for (size_t i = 1; i <= total; i++)
+        {
+            size_t item = i;
+            while (!ring.try_push(item))
+            {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    size_t expected = 1;
+    size_t batch[8];
+    while (expected <= total)
+    {
+        size_t n = ring.try_pop_bulk(batch, 8);
+        for (size_t i = 0; i < n; i++)
+        {
+            REQUIRE(batch[i] == expected++);
+        }
+    }
+    producer.join();
+    REQUIRE(ring.empty());
+}
@@ -21,7 +21,7 @@
 #include "collie/testing/test.h"
 
 using collie::log::memory_buf_t;
-using collie::log::details::fmt_helper::to_string_view;
+using collie::log::details::to_string_view;
 
 // log to str and return it
 template<typename... Args>
@@ -73,7 +73,7 @@ TEST_CASE("name [pattern_formatter]")
 
 TEST_CASE("date MM/DD/YY  [pattern_formatter]")
 {
-    auto now_tm = turbo::Time::time_now().to_local_tm();
+    auto now_tm = collie::log::details::os::localtime();
     std::stringstream oss;
     oss << std::setfill('0') << std::setw(2) << now_tm.tm_mon + 1 << "/" << std::setw(2) << now_tm.tm_mday << "/"
         << std::setw(2)
@@ -81,13 +81,61 @@ TEST_CASE("date MM/DD/YY  [pattern_formatter]")
     REQUIRE(log_to_str("Some message", "%D %v", collie::log::pattern_time_type::local, "\n") == oss.str());
 }
 
+TEST_CASE("cached date prefix [pattern_formatter]")
+{
+    // the leading %Y..%S part is rendered once per second, the "%$" flag in front
+    // of the second formatter disables the cache.
+    std::string pattern = "[%Y-%m-%d %H:%M:%S.%e] [%l] %v";
+    collie::log::pattern_formatter cached(pattern, collie::log::pattern_time_type::utc, "\n");
+    collie::log::pattern_formatter uncached("%$" + pattern, collie::log::pattern_time_type::utc, "\n");
+
+    collie::log::details::log_msg msg("pattern_tester", collie::log::level::info, "Some message");
+    auto start = collie::log::log_clock::now();
+    for (int i = 0; i < 100; i++)
+    {
+        // crosses second boundaries forward and backward
+        msg.time = start + std::chrono::milliseconds(i * 170) - std::chrono::seconds(i % 3);
+        memory_buf_t cached_buf;
+        memory_buf_t uncached_buf;
+        cached.format(msg, cached_buf);
+        uncached.format(msg, uncached_buf);
+        REQUIRE_EQ(to_string_view(cached_buf), to_string_view(uncached_buf));
+    }
+}
+
+static constexpr char compiled_test_pattern[] = "[%Y-%m-%d %H:%M:%S.%e] [%-8l] [%n] %v %10!]";
+
+TEST_CASE("compiled pattern [pattern_formatter]")
+{
+    collie::log::compiled_pattern<compiled_test_pattern> compiled(collie::log::pattern_time_type::utc, "\n");
+    collie::log::pattern_formatter runtime(compiled_test_pattern, collie::log::pattern_time_type::utc, "\n");
+
+    collie::log::details::log_msg msg(collie::log::source_loc{"file.cc", 7, "func"}, "pattern_tester",
+                                      collie::log::level::warn, "Some message");
+    auto start = collie::log::log_clock::now();
+    for (int i = 0; i < 10; i++)
+    {
+        msg.time = start + std::chrono::milliseconds(i * 300);
+        memory_buf_t compiled_buf;
+        memory_buf_t runtime_buf;
+        compiled.format(msg, compiled_buf);
+        runtime.format(msg, runtime_buf);
+        REQUIRE_EQ(to_string_view(compiled_buf), to_string_view(runtime_buf));
+    }
+
+    auto cloned = compiled.clone();
+    memory_buf_t cloned_buf;
+    cloned->format(msg, cloned_buf);
+    REQUIRE(ends_with(std::string(cloned_buf.data(), cloned_buf.size()), "Some message       func]\n"));
+}
+
 TEST_CASE("color range test1 [pattern_formatter]")
 {
     auto formatter = std::make_shared<collie::log::pattern_formatter>("%^%v%$", collie::log::pattern_time_type::local,
                                                                       "\n");
 
     memory_buf_t buf;
-    turbo::format_to(std::back_inserter(buf), "Hello");
+    fmt::format_to(std::back_inserter(buf), "Hello");
     memory_buf_t formatted;
     std::string logger_name = "test";
     collie::log::details::log_msg msg(logger_name, collie::log::level::info,
@@ -376,12 +424,12 @@ public:
     explicit custom_test_flag(std::string txt)
             : some_txt{std::move(txt)} {}
 
-    void format(const collie::log::details::log_msg &, const turbo::CivilInfo &tm, collie::log::memory_buf_t &dest) override {
+    void format(const collie::log::details::log_msg &, const std::tm &tm, collie::log::memory_buf_t &dest) override {
         if (some_txt == "throw_me") {
-            throw collie::log::tlog_ex("custom_flag_exception_test");
+            throw collie::log::CLogEx("custom_flag_exception_test");
         } else if (some_txt == "time") {
-            auto formatted = turbo::format("{:d}:{:02d}{:s}", tm.hour() % 12, tm.minute(),
-                                                          tm.hour() / 12 ? "PM" : "AM");
+            auto formatted = fmt::format("{:d}:{:02d}{:s}", tm.tm_hour % 12, tm.tm_min,
+                                                          tm.tm_hour / 12 ? "PM" : "AM");
             dest.append(formatted.data(), formatted.data() + formatted.size());
             return;
         }
@@ -413,7 +461,7 @@ TEST_CASE("clone-custom_formatter [pattern_formatter]")
     formatter_1->format(msg, formatted_1);
     formatter_2->format(msg, formatted_2);
 
-    auto expected = turbo::format("[logger-name] [custom_output] some message{}",
+    auto expected = fmt::format("[logger-name] [custom_output] some message{}",
                                                  collie::log::details::os::default_eol);
 
     REQUIRE_EQ(to_string_view(formatted_1), expected);
@@ -489,7 +537,7 @@ TEST_CASE("custom flags [pattern_formatter]")
     collie::log::details::log_msg msg(collie::log::source_loc{}, "logger-name", collie::log::level::info,
                                       "some message");
     formatter->format(msg, formatted);
-    auto expected = turbo::format("[logger-name] [custom1] [custom2] some message{}",
+    auto expected = fmt::format("[logger-name] [custom1] [custom2] some message{}",
                                                  collie::log::details::os::default_eol);
 
     REQUIRE_EQ(to_string_view(formatted), expected);
@@ -506,7 +554,7 @@ TEST_CASE("custom flags-padding [pattern_formatter]")
     collie::log::details::log_msg msg(collie::log::source_loc{}, "logger-name", collie::log::level::info,
                                       "some message");
     formatter->format(msg, formatted);
-    auto expected = turbo::format("[logger-name] [custom1] [     custom2] some message{}",
+    auto expected = fmt::format("[logger-name] [custom1] [     custom2] some message{}",
                                                  collie::log::details::os::default_eol);
 
     REQUIRE_EQ(to_string_view(formatted), expected);
@@ -521,7 +569,7 @@ TEST_CASE("custom flags-exception [pattern_formatter]")
     memory_buf_t formatted;
     collie::log::details::log_msg msg(collie::log::source_loc{}, "logger-name", collie::log::level::info,
                                       "some message");
-    CHECK_THROWS_AS(formatter->format(msg, formatted), collie::log::tlog_ex);
+    CHECK_THROWS_AS(formatter->format(msg, formatted), collie::log::CLogEx);
 }
 
 TEST_CASE("override need_localtime [pattern_formatter]")
@@ -540,7 +588,7 @@ TEST_CASE("override need_localtime [pattern_formatter]")
     {
         formatter->need_localtime();
 
-        auto now_tm = turbo::time_now().to_local_tm();
+        auto now_tm = collie::log::details::os::localtime();
         std::stringstream oss;
         oss << (now_tm.tm_hour % 12) << ":" << std::setfill('0') << std::setw(2) << now_tm.tm_min
             << (now_tm.tm_hour / 12 ? "PM" : "AM")
@@ -19,14 +19,14 @@
 static const char *const tested_logger_name = "null_logger";
 static const char *const tested_logger_name2 = "null_logger2";
 
-#ifndef TLOG_NO_EXCEPTIONS
+#ifndef CLOG_NO_EXCEPTIONS
 TEST_CASE("register_drop [registry]")
 {
     collie::log::drop_all();
     collie::log::create<collie::log::sinks::null_sink_mt>(tested_logger_name);
     REQUIRE(collie::log::get(tested_logger_name) != nullptr);
     // Throw if registering existing name
-    REQUIRE_THROWS_AS(collie::log::create<collie::log::sinks::null_sink_mt>(tested_logger_name), collie::log::tlog_ex);
+    REQUIRE_THROWS_AS(collie::log::create<collie::log::sinks::null_sink_mt>(tested_logger_name), collie::log::CLogEx);
 }
 
 TEST_CASE("explicit register [registry]")
@@ -36,7 +36,7 @@ TEST_CASE("explicit register [registry]")
     collie::log::register_logger(logger);
     REQUIRE(collie::log::get(tested_logger_name) != nullptr);
     // Throw if registering existing name
-    REQUIRE_THROWS_AS(collie::log::create<collie::log::sinks::null_sink_mt>(tested_logger_name), collie::log::tlog_ex);
+    REQUIRE_THROWS_AS(collie::log::create<collie::log::sinks::null_sink_mt>(tested_logger_name), collie::log::CLogEx);
 }
 #endif
 
@@ -119,7 +119,7 @@ TEST_CASE("disable automatic registration [registry]")
     collie::log::set_level(log_level);
     // but disable automatic registration
     collie::log::set_automatic_registration(false);
-    auto logger1 = collie::log::create<collie::log::sinks::daily_file_sink_st>(tested_logger_name, TLOG_FILENAME_T("filename"), 11, 59);
+    auto logger1 = collie::log::create<collie::log::sinks::daily_file_sink_st>(tested_logger_name, CLOG_FILENAME_T("filename"), 11, 59);
     auto logger2 = collie::log::create_async<collie::log::sinks::stdout_color_sink_mt>(tested_logger_name2);
     // loggers should not be part of the registry
     REQUIRE_FALSE(collie::log::get(tested_logger_name));
@@ -130,3 +130,66 @@ TEST_CASE("disable automatic registration [registry]")
     collie::log::set_level(collie::log::level::info);
     collie::log::set_automatic_registration(true);
 }
+
+TEST_CASE("get after drop [registry]")
+{
+    collie::log::drop_all();
+    std::weak_ptr<collie::log::logger> weak_logger;
+    {
+        auto logger = collie::log::create<collie::log::sinks::null_sink_mt>(tested_logger_name);
+        weak_logger = logger;
+        REQUIRE(collie::log::get(tested_logger_name) == logger);
+    }
+    collie::log::drop(tested_logger_name);
+    // the lookup snapshot of this thread must not return nor keep the dropped logger
+    REQUIRE(collie::log::get(tested_logger_name) == nullptr);
+    REQUIRE(weak_logger.expired());
+
+    collie::log::create<collie::log::sinks::null_sink_mt>(tested_logger_name);
+    REQUIRE(collie::log::get(tested_logger_name) != nullptr);
+}
+
+TEST_CASE("concurrent get [registry]")
+{
+    collie::log::drop_all();
+    collie::log::create<collie::log::sinks::null_sink_mt>(tested_logger_name);
+    std::atomic<bool> stop{false};
+    std::atomic<size_t> misses{0};
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 4; i++)
+    {
+        readers.emplace_back([&] {
+            while (!stop.load())
+            {
+                if (collie::log::get(tested_logger_name) == nullptr)
+                {
+                    misses++;
+                }
+                collie::log::get(tested_logger_name2);
+            }
+        });
+    }
+    for (int i = 0; i < 100; i++)
+    {
+        collie::log::create<collie::log::sinks::null_sink_mt>(tested_logger_name2);
+        collie::log::drop(tested_logger_name2);
+    }
+    stop = true;
+    for (auto &t : readers)
+    {
+        t.join();
+    }
+    REQUIRE(misses.load() == 0);
+}
+
+TEST_CASE("set_vlog_level only updates registered loggers [registry]")
+{
+    collie::log::drop_all();
+    auto logger = collie::log::create<collie::log::sinks::null_sink_mt>(tested_logger_name);
+    collie::log::set_vlog_level(2);
+    REQUIRE(logger->vlog_level() == 2);
+    auto logger2 = collie::log::create<collie::log::sinks::null_sink_mt>(tested_logger_name2);
+    REQUIRE(logger2->vlog_level() == 0);
+    collie::log::set_vlog_level(0);
+    collie::log::drop_all();
+}
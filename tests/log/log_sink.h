@@ -15,13 +15,13 @@
 
 #pragma once
 
-#include "turbo/log/details/null_mutex.h"
-#include "turbo/log/sinks/base_sink.h"
+#include "collie/log/details/null_mutex.h"
+#include "collie/log/sinks/base_sink.h"
 #include <chrono>
 #include <mutex>
 #include <thread>
 
-namespace turbo::tlog {
+namespace collie::log {
     namespace sinks {
 
         template<class Mutex>
@@ -14,8 +14,8 @@
 //
 
 #include "includes.h"
-#include "turbo/log/sinks/stdout_sinks.h"
-#include "turbo/log/sinks/stdout_color_sinks.h"
+#include "collie/log/sinks/stdout_sinks.h"
+#include "collie/log/sinks/stdout_color_sinks.h"
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 #include "collie/testing/test.h"
 
@@ -52,7 +52,7 @@ TEST_CASE("stderr_mt [stderr]")
     l->info("Test stderr_mt");
     l->warn("Test stderr_mt");
     l->error("Test stderr_mt");
-    l->critical("Test stderr_mt");
+    l->fatal("Test stderr_mt");
     collie::log::drop_all();
 }
 
@@ -90,11 +90,11 @@ TEST_CASE("stderr_color_mt [stderr]")
     l->info("Test stderr_color_mt");
     l->warn("Test stderr_color_mt");
     l->error("Test stderr_color_mt");
-    l->critical("Test stderr_color_mt");
+    l->fatal("Test stderr_color_mt");
     collie::log::drop_all();
 }
 
-#ifdef TLOG_WCHAR_TO_UTF8_SUPPORT
+#ifdef CLOG_WCHAR_TO_UTF8_SUPPORT
 
 TEST_CASE("wchar_api [stdout]")
 {
@@ -106,7 +106,7 @@ TEST_CASE("wchar_api [stdout]")
     l->trace(L"Test wchar_api {}", 1);
     l->trace(L"Test wchar_api {}", std::wstring{L"wstring param"});
     l->trace(std::wstring{L"Test wchar_api wstring"});
-    TLOG_LOGGER_DEBUG(l, L"Test TLOG_LOGGER_DEBUG {}", L"param");
+    CLOG_LOGGER_DEBUG(l, L"Test CLOG_LOGGER_DEBUG {}", L"param");
     collie::log::drop_all();
 }
 
@@ -15,7 +15,7 @@
 
 #include "includes.h"
 #include "log_sink.h"
-#include "turbo/log/async.h"
+#include "collie/log/async.h"
 
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 #include "collie/testing/test.h"
@@ -26,7 +26,7 @@ TEST_CASE("time_point1 [time_point log_msg]")
     collie::log::logger logger("test-time_point", test_sink);
 
     collie::log::source_loc source{};
-    turbo::Time tp = turbo::Time::time_now();
+    auto tp = collie::log::details::os::now();
     test_sink->set_pattern("%T.%F"); // interested in the time_point
 
     // all the following should have the same time
@@ -58,7 +58,7 @@ std::size_t count_lines(const std::string &filename, bool dump)
     size_t counter = 0;
     while (std::getline(ifs, line)) {
         if(dump) {
-            turbo::println(line);
+            fmt::println("{}", line);
         }
         counter++;
     }
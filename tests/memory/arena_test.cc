@@ -0,0 +1,170 @@
+//
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+#include <collie/memory/arena.h>
+#include <collie/memory/memory_resource.h>
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+#include <collie/testing/doctest.h>
+
+#include <cstdint>
+#include <cstring>
+#include <list>
+#include <map>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+namespace {
+
+    bool is_aligned(const void *p, size_t align) {
+        return reinterpret_cast<uintptr_t>(p) % align == 0;
+    }
+
+    struct Counted {
+        explicit Counted(int *live) : live(live) { ++*live; }
+
+        ~Counted() { --*live; }
+
+        int *live;
+    };
+
+}  // namespace
+
+TEST_CASE("MonotonicArena.Allocate") {
+    collie::monotonic_arena arena(256);
+    CHECK_EQ(arena.reserved(), 0);
+
+    std::vector<char *> blocks;
+    for (size_t i = 1; i < 200; ++i) {
+        auto *p = static_cast<char *>(arena.allocate(i, 8));
+        CHECK(is_aligned(p, 8));
+        std::memset(p, static_cast<int>(i), i);
+        blocks.push_back(p);
+    }
+    // nothing was overwritten by a later allocation
+    for (size_t i = 1; i < 200; ++i) {
+        CHECK_EQ(blocks[i - 1][i - 1], static_cast<char>(i));
+    }
+
+    CHECK(is_aligned(arena.allocate(1, 64), 64));
+    CHECK(is_aligned(arena.allocate(3, 4096), 4096));
+    CHECK(is_aligned(arena.allocate_array<double>(3), alignof(double)));
+    CHECK_NE(arena.allocate(0), nullptr);
+    CHECK_THROWS_AS(arena.allocate_array<double>(SIZE_MAX / 4), std::bad_array_new_length);
+
+    // a large block gets a chunk of its own
+    auto *big = static_cast<char *>(arena.allocate(1 << 20));
+    std::memset(big, 1, 1 << 20);
+    CHECK_GE(arena.reserved(), size_t{1} << 20);
+
+    auto s = arena.copy("hello arena");
+    CHECK_EQ(s, "hello arena");
+}
+
+TEST_CASE("MonotonicArena.Reset") {
+    collie::monotonic_arena arena(256);
+    for (int i = 0; i < 1000; ++i) {
+        arena.allocate(64);
+    }
+    auto reserved = arena.reserved();
+    arena.reset();
+    // the chunks are merged into one
+    auto kept = arena.reserved();
+    CHECK_EQ(kept, reserved);
+    CHECK_GE(kept, 1000 * 64);
+    // which then serves the same workload without growing
+    for (int round = 0; round < 3; ++round) {
+        for (int i = 0; i < 1000; ++i) {
+            arena.allocate(64);
+        }
+        CHECK_EQ(arena.reserved(), kept);
+        arena.reset();
+    }
+    arena.release();
+    CHECK_EQ(arena.reserved(), 0);
+}
+
+TEST_CASE("MonotonicArena.Create") {
+    int live = 0;
+    {
+        collie::monotonic_arena arena;
+        for (int i = 0; i < 100; ++i) {
+            arena.create<Counted>(&live);
+        }
+        auto *str = arena.create<std::string>(100, 'x');
+        CHECK_EQ(str->size(), 100);
+        CHECK_EQ(live, 100);
+        arena.reset();
+        CHECK_EQ(live, 0);
+        arena.create<Counted>(&live);
+        CHECK_EQ(live, 1);
+    }
+    CHECK_EQ(live, 0);
+}
+
+TEST_CASE("MonotonicArena.InitialBuffer") {
+    alignas(16) char buffer[512];
+    collie::monotonic_arena arena(buffer, sizeof(buffer));
+    auto *p = static_cast<char *>(arena.allocate(100));
+    CHECK(p >= buffer);
+    CHECK(p < buffer + sizeof(buffer));
+    CHECK_EQ(arena.reserved(), 0);
+
+    arena.allocate(1000);
+    CHECK_GT(arena.reserved(), 0);
+    arena.release();
+    CHECK_EQ(arena.allocate(16), static_cast<void *>(buffer));
+}
+
+TEST_CASE("MonotonicArena.Allocators") {
+    collie::monotonic_arena arena;
+    {
+        std::vector<int, collie::arena_allocator<int>> v{collie::arena_allocator<int>(arena)};
+        for (int i = 0; i < 1000; ++i) {
+            v.push_back(i);
+        }
+        CHECK_EQ(v[999], 999);
+        std::list<int, collie::arena_allocator<int>> l(v.begin(), v.end(), v.get_allocator());
+        CHECK_EQ(l.size(), 1000);
+        CHECK(collie::arena_allocator<char>(arena) == v.get_allocator());
+    }
+
+    collie::arena_resource resource(arena);
+    {
+        std::pmr::map<std::pmr::string, int> m(&resource);
+        for (int i = 0; i < 100; ++i) {
+            m.emplace(std::to_string(i) + " a key too long for the small string buffer", i);
+        }
+        CHECK_EQ(m.size(), 100);
+        CHECK_EQ(m.begin()->second, 0);
+    }
+    CHECK(resource.is_equal(resource));
+    collie::arena_resource other(arena);
+    CHECK_FALSE(resource.is_equal(other));
+
+    {
+        collie::scoped_default_resource scope(&resource);
+        CHECK_EQ(std::pmr::get_default_resource(), &resource);
+        std::pmr::vector<int> v;
+        v.resize(10);
+        CHECK_EQ(v.get_allocator().resource(), &resource);
+    }
+    CHECK_NE(std::pmr::get_default_resource(), &resource);
+    arena.reset();
+}
@@ -0,0 +1,170 @@
+//
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+#include <collie/memory/memory_resource.h>
+#include <collie/memory/size_class_pool.h>
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+#include <collie/testing/doctest.h>
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <list>
+#include <map>
+#include <memory_resource>
+#include <set>
+#include <thread>
+#include <vector>
+
+TEST_CASE("SizeClassPool.SizeClasses") {
+    using collie::size_class_pool;
+    CHECK_EQ(size_class_pool::block_size(0), 16);
+    CHECK_EQ(size_class_pool::block_size(1), 16);
+    CHECK_EQ(size_class_pool::block_size(16), 16);
+    CHECK_EQ(size_class_pool::block_size(17), 32);
+    CHECK_EQ(size_class_pool::block_size(256), 256);
+    CHECK_EQ(size_class_pool::block_size(257), 320);
+    CHECK_EQ(size_class_pool::block_size(4096), 4096);
+    CHECK_EQ(size_class_pool::block_size(5000), 5000);
+    for (size_t n = 1; n <= size_class_pool::kMaxSize; ++n) {
+        CHECK_GE(size_class_pool::block_size(n), n);
+    }
+}
+
+TEST_CASE("SizeClassPool.AllocateFree") {
+    using collie::size_class_pool;
+    std::vector<std::pair<char *, size_t>> blocks;
+    std::set<char *> distinct;
+    for (size_t i = 0; i < 20000; ++i) {
+        size_t size = 1 + (i * 37) % 600;
+        if (i % 1000 == 0) {
+            size = 10000;
+        }
+        auto *p = static_cast<char *>(size_class_pool::allocate(size));
+        CHECK_EQ(reinterpret_cast<uintptr_t>(p) % size_class_pool::kAlignment, 0);
+        std::memset(p, static_cast<int>(i), size);
+        blocks.emplace_back(p, size);
+        distinct.insert(p);
+    }
+    CHECK_EQ(distinct.size(), blocks.size());
+    for (size_t i = 0; i < blocks.size(); ++i) {
+        CHECK_EQ(blocks[i].first[blocks[i].second - 1], static_cast<char>(i));
+    }
+    for (auto &[p, size]: blocks) {
+        size_class_pool::deallocate(p, size);
+    }
+    // freed blocks are handed out again
+    auto *p = size_class_pool::allocate(48);
+    size_class_pool::deallocate(p, 48);
+    CHECK_EQ(size_class_pool::allocate(48), p);
+    size_class_pool::deallocate(p, 48);
+    size_class_pool::flush_thread_cache();
+}
+
+TEST_CASE("SizeClassPool.CrossThread") {
+    using collie::size_class_pool;
+    constexpr int kThreads = 4;
+    constexpr int kBlocks = 20000;
+    std::vector<std::vector<void *>> produced(kThreads);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&, t] {
+            for (int i = 0; i < kBlocks; ++i) {
+                auto *p = static_cast<int *>(size_class_pool::allocate(64));
+                *p = t * kBlocks + i;
+                produced[t].push_back(p);
+            }
+        });
+    }
+    for (auto &th: threads) {
+        th.join();
+    }
+    threads.clear();
+    // every block is freed by another thread than its allocator
+    std::atomic<int> errors{0};
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&, t] {
+            auto &blocks = produced[(t + 1) % kThreads];
+            int owner = (t + 1) % kThreads;
+            for (int i = 0; i < kBlocks; ++i) {
+                if (*static_cast<int *>(blocks[i]) != owner * kBlocks + i) {
+                    ++errors;
+                }
+                size_class_pool::deallocate(blocks[i], 64);
+            }
+        });
+    }
+    for (auto &th: threads) {
+        th.join();
+    }
+    CHECK_EQ(errors.load(), 0);
+}
+
+namespace {
+
+    std::atomic<int> late_frees{0};
+
+    // a thread_local destroyed after the thread cache, which it outlives
+    // because it is constructed first
+    struct late_user {
+        void *block{nullptr};
+
+        ~late_user() {
+            collie::size_class_pool::deallocate(block, 48);
+            auto *p = static_cast<int *>(collie::size_class_pool::allocate(48));
+            *p = 1;
+            collie::size_class_pool::deallocate(p, 48);
+            ++late_frees;
+        }
+    };
+
+}  // namespace
+
+TEST_CASE("SizeClassPool.AfterThreadExit") {
+    std::thread([] {
+        thread_local late_user user;
+        user.block = collie::size_class_pool::allocate(48);
+    }).join();
+    CHECK_EQ(late_frees.load(), 1);
+}
+
+TEST_CASE("SizeClassPool.Allocators") {
+    {
+        std::map<int, int, std::less<>, collie::pool_allocator<std::pair<const int, int>>> m;
+        for (int i = 0; i < 10000; ++i) {
+            m[i] = i;
+        }
+        CHECK_EQ(m.size(), 10000);
+        std::list<int, collie::pool_allocator<int>> l(1000, 7);
+        CHECK_EQ(l.back(), 7);
+    }
+    CHECK_THROWS_AS(collie::pool_allocator<int>().allocate(SIZE_MAX / 2), std::bad_array_new_length);
+
+    collie::pool_resource resource;
+    collie::pool_resource other;
+    CHECK(resource.is_equal(other));
+    std::pmr::vector<std::pmr::string> v(&resource);
+    for (int i = 0; i < 1000; ++i) {
+        v.emplace_back(std::to_string(i) + " a key too long for the small string buffer");
+    }
+    CHECK_EQ(v[999].substr(0, 3), "999");
+    auto *aligned = resource.allocate(100, 128);
+    CHECK_EQ(reinterpret_cast<uintptr_t>(aligned) % 128, 0);
+    resource.deallocate(aligned, 100, 128);
+}
@@ -0,0 +1,135 @@
+//
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <collie/strings/cat.h>
+#include <collie/strings/inlined_string.h>
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+#include <collie/testing/doctest.h>
+
+#include <limits>
+
+namespace {
+
+    struct Point {
+        int x;
+        int y;
+    };
+}  // namespace
+
+template<>
+struct fmt::formatter<Point> : fmt::formatter<std::string_view> {
+    template<typename FormatContext>
+    auto format(const Point &p, FormatContext &ctx) const {
+        return fmt::format_to(ctx.out(), "({}, {})", p.x, p.y);
+    }
+};
+
+TEST_CASE("str_cat, Strings") {
+    std::string s = "std";
+    std::string_view sv = "view";
+    const char *cs = "cstr";
+    CHECK_EQ(collie::str_cat(), "");
+    CHECK_EQ(collie::str_cat(s), "std");
+    CHECK_EQ(collie::str_cat(s, sv, cs, "lit", 'c'), "stdviewcstrlitc");
+    CHECK_EQ(collie::str_cat("", std::string(), std::string_view()), "");
+}
+
+TEST_CASE("str_cat, Integers") {
+    CHECK_EQ(collie::str_cat(1, 2, 3, 4, 5), "12345");
+    CHECK_EQ(collie::str_cat(0), "0");
+    CHECK_EQ(collie::str_cat(-1), "-1");
+    CHECK_EQ(collie::str_cat(static_cast<short>(-32768)), "-32768");
+    CHECK_EQ(collie::str_cat(static_cast<unsigned char>(200)), "200");
+    CHECK_EQ(collie::str_cat(static_cast<signed char>(-100)), "-100");
+    CHECK_EQ(collie::str_cat(std::numeric_limits<int64_t>::min()), "-9223372036854775808");
+    CHECK_EQ(collie::str_cat(std::numeric_limits<int64_t>::max()), "9223372036854775807");
+    CHECK_EQ(collie::str_cat(std::numeric_limits<uint64_t>::max()), "18446744073709551615");
+
+    // every digit count and the boundaries between them
+    uint64_t p = 1;
+    for (int d = 1; d <= 19; ++d) {
+        CHECK_EQ(collie::str_cat(p), std::to_string(p));
+        CHECK_EQ(collie::str_cat(p - 1), std::to_string(p - 1));
+        CHECK_EQ(collie::str_cat(p * 9 + (p - 1)), std::to_string(p * 9 + (p - 1)));
+        p *= 10;
+    }
+}
+
+TEST_CASE("str_cat, Floats") {
+    CHECK_EQ(collie::str_cat(1.5), "1.5");
+    CHECK_EQ(collie::str_cat(0.1f), "0.1");
+    CHECK_EQ(collie::str_cat(-0.0), "-0");
+    CHECK_EQ(collie::str_cat(1e300), fmt::format("{}", 1e300));
+    CHECK_EQ(collie::str_cat(std::numeric_limits<double>::lowest()),
+             fmt::format("{}", std::numeric_limits<double>::lowest()));
+    CHECK_EQ(collie::str_cat(std::numeric_limits<double>::denorm_min()),
+             fmt::format("{}", std::numeric_limits<double>::denorm_min()));
+    CHECK_EQ(collie::str_cat(std::numeric_limits<double>::quiet_NaN()), "nan");
+    CHECK_EQ(collie::str_cat(2.5L), "2.5");
+}
+
+TEST_CASE("str_cat, Mixed") {
+    CHECK_EQ(collie::str_cat("user:", 42, ':', 3.5, ':', true), "user:42:3.5:true");
+    CHECK_EQ(collie::str_cat(Point{1, 2}, "/", false), "(1, 2)/false");
+    CHECK_EQ(collie::str_cat(std::vector<std::string>{"a", "b", "c"}), "abc");
+    CHECK_EQ(collie::str_cat(std::vector<std::string_view>{"a", "b"}, 1, std::vector<std::string>{}), "ab1");
+}
+
+TEST_CASE("str_cat_append, String") {
+    std::string result("number: ");
+    auto &r = collie::str_cat_append(result, 1);
+    CHECK_EQ(&r, &result);
+    collie::str_cat_append(result, 2, ',', "three");
+    CHECK_EQ(result, "number: 12,three");
+
+    collie::str_cat_append(result);
+    CHECK_EQ(result, "number: 12,three");
+
+    std::string v;
+    CHECK_EQ(&collie::str_cat_append(v, std::vector<std::string>{"x", "y"}, 'z'), &v);
+    CHECK_EQ(v, "xyz");
+}
+
+TEST_CASE("str_cat_append, Aliasing") {
+    // pieces that point into the destination, across a reallocation
+    std::string s = "abcdefghijklmnopqrst";
+    s.shrink_to_fit();
+    collie::str_cat_append(s, s, std::string_view(s).substr(0, 3));
+    CHECK_EQ(s, "abcdefghijklmnopqrstabcdefghijklmnopqrstabc");
+
+    std::string t(40, 'q');
+    collie::str_cat_append(t, 1, std::string_view(t).substr(38), std::vector<std::string_view>{std::string_view(t).substr(0, 2)});
+    CHECK_EQ(t, std::string(40, 'q') + "1qqqq");
+
+    collie::InlinedString<16> key;
+    collie::str_cat_append(key, "user:");
+    collie::str_cat_append(key, key.str(), key.str(), key.str(), key.str());
+    CHECK_EQ(key.str(), "user:user:user:user:user:");
+}
+
+TEST_CASE("str_cat_append, InlinedString") {
+    collie::InlinedString<16> key;
+    collie::str_cat_append(key, "user:", 42);
+    CHECK_EQ(key.str(), "user:42");
+
+    // grows out of the inline buffer
+    collie::str_cat_append(key, ':', std::string(32, 'x'), -7);
+    CHECK_EQ(key.str(), "user:42:" + std::string(32, 'x') + "-7");
+}
@@ -0,0 +1,163 @@
+//
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+#include <collie/strings/splitter.h>
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+#include <collie/testing/doctest.h>
+
+#include <cmath>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace {
+
+    std::vector<std::string_view> view_fields(std::string_view s, char sep, collie::EmptyFieldAction action) {
+        std::vector<std::string_view> out;
+        for (auto f: collie::split_view(s, sep, action)) {
+            out.push_back(f);
+        }
+        return out;
+    }
+
+    std::vector<std::string_view> splitter_fields(std::string_view s, char sep, collie::EmptyFieldAction action) {
+        std::vector<std::string_view> out;
+        for (collie::StringSplitter sp(s, sep, action); sp; ++sp) {
+            out.push_back(sp.field_sp());
+        }
+        return out;
+    }
+
+}  // namespace
+
+TEST_CASE("SplitView.SameFieldsAsStringSplitter") {
+    const char *inputs[] = {"", "\t", "a", "a\tb", "\ta\t\tb\t", "\t\t\t", "abc\t\tdef\tg",
+                            "one\ttwo\tthree\tfour\tfive\tsix\tseven\teight\tnine\tten"};
+    for (auto input: inputs) {
+        for (auto action: {collie::SKIP_EMPTY_FIELD, collie::ALLOW_EMPTY_FIELD}) {
+            CHECK_EQ(view_fields(input, '\t', action), splitter_fields(input, '\t', action));
+        }
+    }
+    CHECK_EQ(view_fields("a\t\tb", '\t', collie::ALLOW_EMPTY_FIELD),
+             std::vector<std::string_view>{"a", "", "b"});
+}
+
+TEST_CASE("SplitView.NoTerminator") {
+    // the fields point into the input, which needs no '\0' after it
+    std::string buf = "1\t2\t3XXXX";
+    std::string_view input(buf.data(), 5);
+    auto fields = view_fields(input, '\t', collie::SKIP_EMPTY_FIELD);
+    REQUIRE_EQ(fields.size(), 3);
+    CHECK_EQ(fields[2].data(), buf.data() + 4);
+    int v = 0;
+    CHECK_EQ(collie::parse_field(fields[2], &v), 0);
+    CHECK_EQ(v, 3);
+
+    auto view = collie::split_view(input, '\t');
+    auto it = view.begin();
+    auto first = it++;
+    CHECK_EQ(*first, "1");
+    CHECK_EQ(*it, "2");
+    CHECK_EQ(std::distance(view.begin(), view.end()), 3);
+}
+
+TEST_CASE("ParseField.Integers") {
+    int i = 7;
+    CHECK_EQ(collie::parse_field("-42", &i), 0);
+    CHECK_EQ(i, -42);
+    CHECK_EQ(collie::parse_field("+42", &i), 0);
+    CHECK_EQ(i, 42);
+    i = 7;
+    CHECK_EQ(collie::parse_field("", &i), -1);
+    CHECK_EQ(collie::parse_field("+", &i), -1);
+    CHECK_EQ(collie::parse_field("+-1", &i), -1);
+    CHECK_EQ(collie::parse_field("12a", &i), -1);
+    CHECK_EQ(collie::parse_field(" 12", &i), -1);
+    CHECK_EQ(collie::parse_field("2147483648", &i), -1);
+    CHECK_EQ(i, 7);
+
+    int8_t i8;
+    CHECK_EQ(collie::parse_field("-128", &i8), 0);
+    CHECK_EQ(i8, -128);
+    CHECK_EQ(collie::parse_field("128", &i8), -1);
+
+    unsigned u;
+    CHECK_EQ(collie::parse_field("4294967295", &u), 0);
+    CHECK_EQ(u, 4294967295u);
+    CHECK_EQ(collie::parse_field("-1", &u), -1);
+
+    uint64_t u64;
+    CHECK_EQ(collie::parse_field("18446744073709551615", &u64), 0);
+    CHECK_EQ(u64, std::numeric_limits<uint64_t>::max());
+}
+
+TEST_CASE("ParseField.FloatingPoint") {
+    double d = 0;
+    CHECK_EQ(collie::parse_field("3.25", &d), 0);
+    CHECK_EQ(d, 3.25);
+    CHECK_EQ(collie::parse_field("-1e-3", &d), 0);
+    CHECK_EQ(d, -1e-3);
+    CHECK_EQ(collie::parse_field("+.5", &d), 0);
+    CHECK_EQ(d, 0.5);
+    CHECK_EQ(collie::parse_field("0.1", &d), 0);
+    CHECK_EQ(d, 0.1);
+    CHECK_EQ(collie::parse_field("inf", &d), 0);
+    CHECK(std::isinf(d));
+    d = 1;
+    CHECK_EQ(collie::parse_field("1.5x", &d), -1);
+    CHECK_EQ(collie::parse_field("", &d), -1);
+    CHECK_EQ(collie::parse_field("1e999", &d), -1);
+    CHECK_EQ(d, 1);
+
+    float f = 0;
+    CHECK_EQ(collie::parse_field("2.5", &f), 0);
+    CHECK_EQ(f, 2.5f);
+}
+
+TEST_CASE("StringSplitter.TypedFields") {
+    // every field is parsed within its bounds, even when followed by digits
+    std::string_view line("12\t-3\t4.5\t7\t\tx");
+    collie::StringSplitter sp(line, '\t', collie::ALLOW_EMPTY_FIELD);
+    int i;
+    REQUIRE_EQ(sp.to_int(&i), 0);
+    CHECK_EQ(i, 12);
+    ++sp;
+    long l;
+    REQUIRE_EQ(sp.to_long(&l), 0);
+    CHECK_EQ(l, -3);
+    ++sp;
+    double d;
+    REQUIRE_EQ(sp.to_double(&d), 0);
+    CHECK_EQ(d, 4.5);
+    ++sp;
+    uint8_t u8;
+    REQUIRE_EQ(sp.to_uint8(&u8), 0);
+    CHECK_EQ(u8, 7);
+    ++sp;
+    CHECK_EQ(sp.to_int(&i), -1);
+    ++sp;
+    float f;
+    CHECK_EQ(sp.to_float(&f), -1);
+
+    collie::StringMultiSplitter msp("1,2;3", ",;");
+    ++msp;
+    unsigned long long ull;
+    REQUIRE_EQ(msp.to_ulonglong(&ull), 0);
+    CHECK_EQ(ull, 2);
+}
@@ -0,0 +1,169 @@
+//
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+#include <collie/strings/internal/str_simd_internal.h>
+#include <collie/strings/case_conv.h>
+#include <collie/strings/match.h>
+#include <collie/strings/splitter.h>
+#include <collie/strings/str_split.h>
+#include <collie/strings/trim.h>
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+#include <collie/testing/doctest.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace collie::strings_internal;
+
+namespace {
+
+    // a small alphabet, so that random needles and sets are found often
+    std::string random_text(std::mt19937 &rng, size_t n, int alphabet) {
+        std::uniform_int_distribution<int> d(0, alphabet - 1);
+        std::string s(n, '\0');
+        for (auto &c: s) {
+            c = static_cast<char>('a' + d(rng));
+        }
+        return s;
+    }
+
+}  // namespace
+
+TEST_CASE("StrSimd.WhiteSpaceChars") {
+    for (int c = 0; c < 256; ++c) {
+        auto in_set = kWhiteSpaceChars.find(static_cast<char>(c)) != std::string_view::npos;
+        REQUIRE_EQ(in_set, collie::ascii_is_space(static_cast<unsigned char>(c)));
+    }
+}
+
+TEST_CASE("StrSimd.FindByteAllBytes") {
+    // every byte value, at every position and offset around the vector width
+    std::string buf(160, '\0');
+    for (int c = 0; c < 256; ++c) {
+        auto ch = static_cast<char>(c);
+        auto other = static_cast<char>(c + 1);
+        std::fill(buf.begin(), buf.end(), other);
+        for (size_t off = 0; off < 4; ++off) {
+            for (size_t n = 0; n + off <= 70; ++n) {
+                const char *p = buf.data() + off;
+                REQUIRE_EQ(simd_find_byte(p, n, ch), n);
+                for (size_t i = 0; i < n; ++i) {
+                    buf[off + i] = ch;
+                    REQUIRE_EQ(simd_find_byte(p, n, ch), i);
+                    REQUIRE_EQ(simd_find_any(p, n, std::string_view(&ch, 1)), i);
+                    REQUIRE_EQ(simd_rfind_any(p, n, std::string_view(&ch, 1)), i);
+                    buf[off + i] = other;
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("StrSimd.FindAnyMatchesScalar") {
+    std::mt19937 rng(42);
+    for (int round = 0; round < 2000; ++round) {
+        auto n = static_cast<size_t>(rng() % 200);
+        auto text = random_text(rng, n, 20);
+        auto set = random_text(rng, 1 + rng() % 20, 26);
+        for (bool in_set: {true, false}) {
+            REQUIRE_EQ(simd_find_any(text.data(), n, set, in_set),
+                       scalar_find_any(text.data(), n, set, in_set));
+            REQUIRE_EQ(simd_rfind_any(text.data(), n, set, in_set),
+                       scalar_rfind_any(text.data(), n, set, in_set));
+        }
+    }
+}
+
+TEST_CASE("StrSimd.FindSubstrMatchesScalar") {
+    std::mt19937 rng(7);
+    for (int round = 0; round < 5000; ++round) {
+        auto n = static_cast<size_t>(rng() % 300);
+        auto text = random_text(rng, n, 3);
+        auto needle = random_text(rng, rng() % 8, 3);
+        REQUIRE_EQ(simd_find_substr(text.data(), n, needle),
+                   scalar_find_substr(text.data(), n, needle));
+        for (size_t pos = 0; pos < n; pos += 1 + rng() % 17) {
+            REQUIRE_EQ(find_substr(text, needle, pos), text.find(needle, pos));
+            REQUIRE_EQ(find_first_of(text, needle, pos), text.find_first_of(needle, pos));
+        }
+    }
+}
+
+TEST_CASE("StrSimd.CaseConvert") {
+    std::string all(256 * 3, '\0');
+    for (size_t i = 0; i < all.size(); ++i) {
+        all[i] = static_cast<char>(i);
+    }
+    for (size_t n = 0; n <= all.size(); n += 13) {
+        std::string_view s(all.data() + n % 7, n - n % 7);
+        auto lower = collie::str_to_lower(s);
+        auto upper = collie::str_to_upper(s);
+        REQUIRE_EQ(lower.size(), s.size());
+        for (size_t i = 0; i < s.size(); ++i) {
+            REQUIRE_EQ(lower[i], collie::ascii_to_lower(static_cast<unsigned char>(s[i])));
+            REQUIRE_EQ(upper[i], collie::ascii_to_upper(static_cast<unsigned char>(s[i])));
+        }
+        std::string inplace(s);
+        collie::str_to_upper(&inplace);
+        REQUIRE_EQ(inplace, upper);
+    }
+}
+
+TEST_CASE("StrSimd.Trim") {
+    std::string pad(40, ' ');
+    for (size_t i = 0; i < pad.size(); ++i) {
+        pad[i] = kWhiteSpaceChars[i % kWhiteSpaceChars.size()];
+    }
+    std::string s = pad + "a \t b" + pad;
+    CHECK_EQ(collie::trim_all(std::string_view(s)), "a \t b");
+    CHECK_EQ(collie::trim_left(std::string_view(pad)), "");
+    CHECK_EQ(collie::trim_right(std::string_view(pad)), "");
+    CHECK_EQ(collie::trim_all(std::string_view(s), collie::by_any_of(" \t")), s.substr(2));
+    CHECK_EQ(collie::trim_all(std::string_view(s), collie::by_any_of("")), s);
+    collie::trim_all(&s);
+    CHECK_EQ(s, "a \t b");
+}
+
+TEST_CASE("StrSimd.Split") {
+    std::string line;
+    for (int i = 0; i < 50; ++i) {
+        line += "field" + std::to_string(i) + (i % 3 == 0 ? ";" : ",");
+    }
+    line.pop_back();
+    std::vector<std::string> by_char = collie::str_split(line, ',');
+    std::vector<std::string> any_of = collie::str_split(line, collie::ByAnyChar(",;"));
+    std::vector<std::string> literal = collie::str_split(line, "d1");
+    CHECK_EQ(by_char.size(), 33);
+    CHECK_EQ(any_of.size(), 50);
+    CHECK_EQ(literal.size(), 12);
+    CHECK_EQ(any_of[49], "field49");
+
+    std::vector<std::string_view> fields;
+    for (collie::StringMultiSplitter sp(line.data(), line.data() + line.size(), ",;"); sp; ++sp) {
+        fields.push_back(sp.field_sp());
+    }
+    CHECK_EQ(fields.size(), 50);
+    CHECK_EQ(fields[10], "field10");
+    size_t count = 0;
+    for (collie::StringSplitter sp(std::string_view(line), ','); sp; ++sp) {
+        ++count;
+    }
+    CHECK_EQ(count, 33);
+}
@@ -401,3 +401,100 @@ TEST_CASE("RuntimeAsync.3threads") {
 TEST_CASE("RuntimeAsync.11threads") {
   runtime_async(11);
 }
+
+// --------------------------------------------------------
+// Testcase: AsyncFuture
+// --------------------------------------------------------
+
+void async_future(unsigned W) {
+
+  collie::tf::Executor executor(W);
+
+  // value, void, reference and move-only results
+  collie::tf::AsyncFuture<int> fu1 = executor.async([](){ return 1; });
+  REQUIRE(fu1.valid());
+  REQUIRE(fu1.get() == 1);
+  REQUIRE(!fu1.valid());
+  REQUIRE_THROWS_AS(fu1.get(), std::future_error);
+
+  std::atomic<int> counter {0};
+  auto fu2 = executor.async([&](){ counter++; });
+  fu2.wait();
+  REQUIRE(counter == 1);
+  REQUIRE(fu2.wait_for(std::chrono::seconds(0)) == std::future_status::ready);
+  fu2.get();
+
+  int value = 5;
+  auto fu3 = executor.async([&]() -> int& { return value; });
+  fu3.get() = 6;
+  REQUIRE(value == 6);
+
+  auto fu4 = executor.async([](){ return std::make_unique<int>(4); });
+  REQUIRE(*fu4.get() == 4);
+
+  // exceptions propagate to the future
+  auto fu5 = executor.async([]() -> int { throw std::runtime_error("x"); });
+  REQUIRE_THROWS_AS(fu5.get(), std::runtime_error);
+
+  // timeout while the task is blocked
+  std::atomic<bool> go {false};
+  auto fu6 = executor.async([&](){
+    while(!go) std::this_thread::yield();
+    return 6;
+  });
+  REQUIRE(fu6.wait_for(std::chrono::milliseconds(1)) == std::future_status::timeout);
+
+  // conversion to std::future before and after the result is ready
+  std::future<int> sfu6 = std::move(fu6);
+  REQUIRE(!fu6.valid());
+  go = true;
+  REQUIRE(sfu6.get() == 6);
+
+  auto fu7 = executor.async([](){ return 7; });
+  fu7.wait();
+  std::future<int> sfu7 = std::move(fu7);
+  REQUIRE(sfu7.get() == 7);
+
+  std::future<void> sfu8 = executor.async([]() { throw std::runtime_error("y"); });
+  REQUIRE_THROWS_AS(sfu8.get(), std::runtime_error);
+
+  // callables larger than the inline buffer and futures dropped early
+  std::array<int, 32> data;
+  data.fill(1);
+  std::vector<collie::tf::AsyncFuture<int>> fus;
+  for(int i=0; i<10000; i++) {
+    if(i % 2) {
+      executor.async([&counter](){ counter++; return 0; });
+    }
+    else {
+      fus.push_back(executor.async([&counter, data](){ counter++; return data[31]; }));
+    }
+  }
+  executor.wait_for_all();
+  REQUIRE(counter == 10001);
+  for(auto& fu : fus) {
+    REQUIRE(fu.get() == 1);
+  }
+
+  // runtime and dependent async
+  collie::tf::Taskflow taskflow;
+  taskflow.emplace([&](collie::tf::Runtime& rt){
+    auto fu = rt.async([](){ return 9; });
+    rt.corun_all();
+    REQUIRE(fu.get() == 9);
+  });
+  executor.run(taskflow).wait();
+
+  auto [A, fuA] = executor.dependent_async([](){ return 1; });
+  auto [B, fuB] = executor.dependent_async([](){ return 2; }, A);
+  REQUIRE(fuB.get() == 2);
+  REQUIRE(fuA.get() == 1);
+}
+
+TEST_CASE("AsyncFuture.1thread" * doctest::timeout(300)) {
+  async_future(1);
+}
+
+TEST_CASE("AsyncFuture.4threads" * doctest::timeout(300)) {
+  async_future(4);
+}
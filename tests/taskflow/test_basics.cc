@@ -5,6 +5,10 @@
 #include <collie/taskflow/algorithm/for_each.h>
 #include <collie/taskflow/algorithm/reduce.h>
 
+#include <csignal>
+#include <filesystem>
+#include <fstream>
+
 // --------------------------------------------------------
 // Testcase: Type
 // --------------------------------------------------------
@@ -1143,4 +1147,185 @@ TEST_CASE("Observer.4threads" * doctest::timeout(300)) {
   observer(4);
 }
 
+// --------------------------------------------------------
+// Testcase: SamplingObserver
+// --------------------------------------------------------
+
+void sampling_observer(size_t W, size_t C, size_t P) {
+
+  collie::tf::Executor executor(W);
+
+  auto observer = executor.make_observer<collie::tf::SamplingObserver>(C, P);
+
+  REQUIRE(observer->capacity() == C);
+  REQUIRE(observer->period() == P);
+  REQUIRE(observer->num_tasks() == 0);
+
+  collie::tf::Taskflow taskflow;
+  for(size_t i=0; i<100; i++) {
+    taskflow.emplace([](){}).name("task");
+  }
+  taskflow.emplace([](collie::tf::Subflow& sf){
+    sf.emplace([](){}).name("child");
+  }).name("parent");
+
+  // dumps are safe while the workers record
+  auto fu = executor.run_n(taskflow, 50);
+  while(fu.wait_for(std::chrono::milliseconds(0)) != std::future_status::ready) {
+    REQUIRE(observer->num_tasks() <= W*C);
+    observer->dump();
+    observer->dump_chrome();
+  }
+
+  // 102 tasks per run, each worker samples one in P of the tasks it runs
+  size_t kept = observer->num_tasks();
+  REQUIRE(kept <= W*C);
+  REQUIRE(kept <= 50*102/P + W);
+  REQUIRE(kept > 0);
+
+  auto tfp = observer->dump();
+  REQUIRE(tfp.find("\"executor\"") != std::string::npos);
+  REQUIRE(tfp.find("\"name\":\"task\"") != std::string::npos);
+
+  auto chrome = observer->dump_chrome();
+  REQUIRE(chrome.front() == '[');
+  REQUIRE(chrome.find("\"ph\":\"X\"") != std::string::npos);
+
+  observer->clear();
+  REQUIRE(observer->num_tasks() == 0);
+  REQUIRE(observer->dump() == "{}\n");
+  REQUIRE(observer->dump_chrome() == "[]\n");
+
+  executor.run(taskflow).wait();
+  REQUIRE(observer->num_tasks() <= W*C);
+}
+
+TEST_CASE("SamplingObserver.1thread" * doctest::timeout(300)) {
+  sampling_observer(1, 1024, 1);
+  sampling_observer(1, 16, 1);
+  sampling_observer(1, 16, 7);
+}
+
+TEST_CASE("SamplingObserver.2threads" * doctest::timeout(300)) {
+  sampling_observer(2, 1024, 1);
+  sampling_observer(2, 16, 1);
+  sampling_observer(2, 16, 7);
+}
+
+TEST_CASE("SamplingObserver.4threads" * doctest::timeout(300)) {
+  sampling_observer(4, 1024, 1);
+  sampling_observer(4, 16, 1);
+  sampling_observer(4, 16, 7);
+}
+
+TEST_CASE("SamplingObserver.Levels" * doctest::timeout(300)) {
+
+  collie::tf::Executor executor(1);
+  auto observer = executor.make_observer<collie::tf::SamplingObserver>(8);
+
+  collie::tf::Taskflow taskflow;
+  taskflow.emplace([](collie::tf::Subflow& sf){
+    sf.emplace([](){}).name("child");
+  }).name("parent");
+
+  executor.run(taskflow).wait();
+
+  // the child runs inside its parent, one level below
+  REQUIRE(observer->num_tasks() == 2);
+  auto tfp = observer->dump();
+  REQUIRE(tfp.find("\"level\":0") != std::string::npos);
+  REQUIRE(tfp.find("\"level\":1") != std::string::npos);
+}
+
+TEST_CASE("SamplingObserver.InvalidArguments" * doctest::timeout(300)) {
+  REQUIRE_THROWS_AS(collie::tf::SamplingObserver(0, 1), std::runtime_error);
+  REQUIRE_THROWS_AS(collie::tf::SamplingObserver(1, 0), std::runtime_error);
+}
+
+#if TF_OS_UNIX
+TEST_CASE("SamplingObserver.DumpOnSignal" * doctest::timeout(300)) {
+
+  collie::tf::Executor executor(2);
+  auto observer = executor.make_observer<collie::tf::SamplingObserver>(64);
+
+  auto tfp = std::filesystem::temp_directory_path() / "tf_sampling_observer.json";
+  auto chrome = std::filesystem::temp_directory_path() / "tf_sampling_observer_chrome.json";
+  std::filesystem::remove(tfp);
+  std::filesystem::remove(chrome);
+
+  observer->dump_on_signal(SIGUSR2, tfp.string());
+  observer->dump_on_signal(SIGUSR2, chrome.string(), collie::tf::ObserverType::CHROME);
+
+  collie::tf::Taskflow taskflow;
+  for(size_t i=0; i<10; i++) {
+    taskflow.emplace([](){}).name("task");
+  }
+  executor.run(taskflow).wait();
+
+  std::raise(SIGUSR2);
+
+  // the dump is written by a background thread
+  auto read = [](const std::filesystem::path& path) {
+    for(size_t i=0; i<1000; i++) {
+      std::ifstream ifs(path);
+      std::string s((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+      if(!s.empty() && s.back() == '\n') {
+        return s;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    return std::string();
+  };
+
+  REQUIRE(read(tfp).find("\"name\":\"task\"") != std::string::npos);
+  REQUIRE(read(chrome).find("\"ph\":\"X\"") != std::string::npos);
+
+  // a destroyed observer is no longer dumped
+  executor.remove_observer(observer);
+  observer.reset();
+  std::raise(SIGUSR2);
+
+  std::filesystem::remove(tfp);
+  std::filesystem::remove(chrome);
+}
+
+static volatile std::sig_atomic_t dump_on_signal_chained = 0;
+
+TEST_CASE("SamplingObserver.DumpOnSignalChainsHandler" * doctest::timeout(300)) {
+
+  // a handler installed before the observer is still called
+  struct sigaction sa {};
+  sa.sa_handler = [](int){ dump_on_signal_chained = 1; };
+  sigemptyset(&sa.sa_mask);
+  REQUIRE(::sigaction(SIGUSR1, &sa, nullptr) == 0);
+
+  collie::tf::Executor executor(2);
+  auto observer = executor.make_observer<collie::tf::SamplingObserver>(64);
+
+  auto tfp = std::filesystem::temp_directory_path() / "tf_sampling_observer_chained.json";
+  std::filesystem::remove(tfp);
+
+  observer->dump_on_signal(SIGUSR1, tfp.string());
+
+  collie::tf::Taskflow taskflow;
+  taskflow.emplace([](){}).name("task");
+  executor.run(taskflow).wait();
+
+  std::raise(SIGUSR1);
+  REQUIRE(dump_on_signal_chained == 1);
+
+  std::string s;
+  for(size_t i=0; i<1000 && (s.empty() || s.back() != '\n'); i++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    std::ifstream ifs(tfp);
+    s.assign(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+  }
+  REQUIRE(s.find("\"name\":\"task\"") != std::string::npos);
+
+  executor.remove_observer(observer);
+  observer.reset();
+  std::filesystem::remove(tfp);
+}
+#endif
+
 
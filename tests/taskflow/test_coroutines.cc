@@ -0,0 +1,197 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+#include <collie/testing/doctest.h>
+#include <collie/taskflow/taskflow.h>
+
+#if TF_HAS_COROUTINE
+
+// --------------------------------------------------------
+// Testcase: CoTask.Basics
+// --------------------------------------------------------
+
+collie::tf::co_task<int> square(int x) {
+  co_return x * x;
+}
+
+collie::tf::co_task<int> sum_of_squares(int n) {
+  int sum = 0;
+  for(int i=1; i<=n; i++) {
+    sum += co_await square(i);
+  }
+  co_return sum;
+}
+
+collie::tf::co_task<> increment(std::atomic<int>& counter) {
+  counter++;
+  co_return;
+}
+
+collie::tf::co_task<int> fail() {
+  throw std::runtime_error("x");
+  co_return 0;
+}
+
+collie::tf::co_task<int> catch_fail() {
+  try {
+    co_await fail();
+  }
+  catch(const std::runtime_error&) {
+    co_return 1;
+  }
+  co_return 0;
+}
+
+void co_task_basics(unsigned W) {
+
+  collie::tf::Executor executor(W);
+
+  REQUIRE(executor.co_run(square(7)).get() == 49);
+  REQUIRE(executor.co_run(sum_of_squares(10)).get() == 385);
+
+  std::atomic<int> counter {0};
+  executor.co_run(increment(counter)).get();
+  REQUIRE(counter == 1);
+
+  // exceptions propagate to the awaiter and to the future
+  REQUIRE(executor.co_run(catch_fail()).get() == 1);
+  REQUIRE_THROWS_AS(executor.co_run(fail()).get(), std::runtime_error);
+
+  // the future can be dropped; wait_for_all covers the coroutine
+  for(int i=0; i<1000; i++) {
+    executor.co_run(increment(counter));
+  }
+  executor.wait_for_all();
+  REQUIRE(counter == 1001);
+
+  // an unlaunched task is simply destroyed
+  auto task = square(2);
+  REQUIRE(task.valid());
+}
+
+TEST_CASE("CoTask.Basics.1thread" * doctest::timeout(300)) {
+  co_task_basics(1);
+}
+
+TEST_CASE("CoTask.Basics.4threads" * doctest::timeout(300)) {
+  co_task_basics(4);
+}
+
+// --------------------------------------------------------
+// Testcase: CoTask.AwaitFuture
+// --------------------------------------------------------
+
+collie::tf::co_task<int> await_async(collie::tf::Executor& executor, int n) {
+  int sum = 0;
+  for(int i=0; i<n; i++) {
+    sum += co_await executor.async([i](){ return i; });
+  }
+  auto fu = executor.async([](){ return 100; });
+  sum += co_await fu;
+  co_return sum;
+}
+
+collie::tf::co_task<int> await_blocked(
+  collie::tf::Executor& io, std::atomic<bool>& go, std::atomic<int>& resumed
+) {
+  int v = co_await io.async([&](){
+    while(!go) std::this_thread::yield();
+    return 5;
+  });
+  resumed++;
+  co_return v;
+}
+
+collie::tf::co_task<> await_taskflow(collie::tf::Executor& executor, collie::tf::Taskflow& taskflow) {
+  co_await executor.run(taskflow);
+}
+
+collie::tf::co_task<> await_taskflow_twice(collie::tf::Executor& executor, collie::tf::Taskflow& taskflow) {
+  // the first run completes while the second one is queued on the same taskflow
+  auto fu1 = executor.run(taskflow);
+  auto fu2 = executor.run_n(taskflow, 2);
+  co_await fu1;
+  co_await fu2;
+}
+
+void co_task_await_future(unsigned W) {
+
+  collie::tf::Executor executor(W);
+
+  REQUIRE(executor.co_run(await_async(executor, 100)).get() == 4950 + 100);
+
+  // a suspended coroutine does not hold a worker: while the coroutines wait
+  // on blocked tasks of another executor, this executor keeps running tasks
+  {
+    collie::tf::Executor io(1);
+    std::atomic<bool> go {false};
+    std::atomic<int> resumed {0};
+    std::vector<collie::tf::AsyncFuture<int>> fus;
+    for(int i=0; i<8; i++) {
+      fus.push_back(executor.co_run(await_blocked(io, go, resumed)));
+    }
+    for(int i=0; i<100; i++) {
+      REQUIRE(executor.async([i](){ return i; }).get() == i);
+    }
+    REQUIRE(resumed == 0);
+    go = true;
+    for(auto& fu : fus) {
+      REQUIRE(fu.get() == 5);
+    }
+    REQUIRE(resumed == 8);
+  }
+
+  // await a taskflow run
+  collie::tf::Taskflow taskflow;
+  std::atomic<int> counter {0};
+  for(int i=0; i<100; i++) {
+    taskflow.emplace([&](){ counter++; });
+  }
+  executor.co_run(await_taskflow(executor, taskflow)).get();
+  REQUIRE(counter == 100);
+
+  executor.co_run(await_taskflow_twice(executor, taskflow)).get();
+  REQUIRE(counter == 400);
+
+  // a coroutine waiting on a taskflow run does not keep the executor busy
+  {
+    collie::tf::Executor io(1);
+    std::atomic<bool> go {false};
+    collie::tf::Taskflow blocked;
+    blocked.emplace([&](){ while(!go) std::this_thread::yield(); });
+    auto fu = executor.co_run(await_taskflow(io, blocked));
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    auto n = executor.metrics().num_tasks();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    auto m = executor.metrics().num_tasks();
+    go = true;
+    fu.get();
+    REQUIRE(m == n);
+  }
+
+  // the exception of an awaited run propagates to the coroutine
+  collie::tf::Taskflow failing;
+  failing.emplace([](){ throw std::runtime_error("x"); });
+  REQUIRE_THROWS_AS(
+    executor.co_run(await_taskflow(executor, failing)).get(), std::runtime_error
+  );
+}
+
+TEST_CASE("CoTask.AwaitFuture.1thread" * doctest::timeout(300)) {
+  co_task_await_future(1);
+}
+
+TEST_CASE("CoTask.AwaitFuture.2threads" * doctest::timeout(300)) {
+  co_task_await_future(2);
+}
+
+TEST_CASE("CoTask.AwaitFuture.8threads" * doctest::timeout(300)) {
+  co_task_await_future(8);
+}
+
+#else
+
+TEST_CASE("CoTask.Unsupported") {
+  REQUIRE(TF_HAS_COROUTINE == 0);
+}
+
+#endif
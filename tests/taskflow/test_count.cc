@@ -0,0 +1,119 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+#include <collie/testing/doctest.h>
+#include <collie/taskflow/taskflow.h>
+#include <collie/taskflow/algorithm/count.h>
+
+// ----------------------------------------------------------------------------
+// count_if
+// ----------------------------------------------------------------------------
+
+template <typename P>
+void test_count_if(unsigned W) {
+
+  collie::tf::Executor executor(W);
+  collie::tf::Taskflow taskflow;
+  std::vector<int> input;
+
+  for(size_t n = 0; n <= 65536; n <= 256 ? n++ : n=2*n+1) {
+    for(size_t c : {0, 1, 3, 7, 99}) {
+
+      taskflow.clear();
+
+      input.resize(n);
+      for(auto& i : input) {
+        i = ::rand() % 100;
+      }
+
+      auto pred = [] (int i) { return i < 30; };
+      auto gold = std::count_if(input.begin(), input.end(), pred);
+
+      // the result is overwritten, not accumulated
+      size_t count = 12345;
+      std::vector<int>::iterator beg, end;
+
+      auto init = taskflow.emplace([&](){
+        beg = input.begin();
+        end = input.end();
+      });
+
+      auto task = taskflow.count_if(std::ref(beg), std::ref(end), count, pred, P(c));
+
+      init.precede(task);
+
+      executor.run(taskflow).wait();
+
+      REQUIRE(count == static_cast<size_t>(gold));
+    }
+  }
+}
+
+TEST_CASE("count_if.StaticPartitioner.1thread" * doctest::timeout(300)) {
+  test_count_if<collie::tf::StaticPartitioner<>>(1);
+}
+
+TEST_CASE("count_if.StaticPartitioner.4threads" * doctest::timeout(300)) {
+  test_count_if<collie::tf::StaticPartitioner<>>(4);
+}
+
+TEST_CASE("count_if.GuidedPartitioner.2threads" * doctest::timeout(300)) {
+  test_count_if<collie::tf::GuidedPartitioner<>>(2);
+}
+
+TEST_CASE("count_if.DynamicPartitioner.3threads" * doctest::timeout(300)) {
+  test_count_if<collie::tf::DynamicPartitioner<>>(3);
+}
+
+// ----------------------------------------------------------------------------
+// histogram
+// ----------------------------------------------------------------------------
+
+template <typename P>
+void test_histogram(unsigned W) {
+
+  collie::tf::Executor executor(W);
+  collie::tf::Taskflow taskflow;
+  std::vector<int> input;
+
+  for(size_t n = 0; n <= 65536; n <= 256 ? n++ : n=2*n+1) {
+    for(size_t num_bins : {1, 7, 64}) {
+
+      taskflow.clear();
+
+      input.resize(n);
+      for(auto& i : input) {
+        // include values that fall outside of the bins
+        i = ::rand() % 80 - 8;
+      }
+
+      auto bin = [] (int i) { return i; };
+
+      std::vector<size_t> gold(num_bins, 0);
+      for(auto i : input) {
+        if(i >= 0 && static_cast<size_t>(i) < num_bins) {
+          gold[i]++;
+        }
+      }
+
+      std::vector<size_t> bins(num_bins, 99);
+
+      taskflow.histogram(input.begin(), input.end(), bins.begin(), num_bins, bin, P());
+
+      executor.run(taskflow).wait();
+
+      REQUIRE(bins == gold);
+    }
+  }
+}
+
+TEST_CASE("histogram.StaticPartitioner.1thread" * doctest::timeout(300)) {
+  test_histogram<collie::tf::StaticPartitioner<>>(1);
+}
+
+TEST_CASE("histogram.StaticPartitioner.4threads" * doctest::timeout(300)) {
+  test_histogram<collie::tf::StaticPartitioner<>>(4);
+}
+
+TEST_CASE("histogram.DynamicPartitioner.3threads" * doctest::timeout(300)) {
+  test_histogram<collie::tf::DynamicPartitioner<>>(3);
+}
@@ -2869,3 +2869,71 @@ TEST_CASE("PipelineinPipeline.DataPipelines.5L.2W.4subL" * doctest::timeout(300)
   pipeline_in_pipeline(5, 2, 4);
 }
 
+
+// ----------------------------------------------------------------------------
+// Batched DataPipeline
+// ----------------------------------------------------------------------------
+
+void batched_data_pipeline(size_t L, unsigned w, size_t B) {
+
+  collie::tf::Executor executor(w);
+
+  for(size_t N = 0; N <= 50; N++) {
+
+    collie::tf::Taskflow taskflow;
+    std::vector<std::string> collection;
+
+    collie::tf::DataPipeline pl(L,
+      collie::tf::make_data_pipe<void, size_t>(collie::tf::PipeType::SERIAL, [N, B, L](collie::tf::Pipeflow& pf) -> size_t {
+        if(pf.token() == N) {
+          pf.stop();
+          return 0;
+        }
+        REQUIRE(pf.token() / B % L == pf.line());
+        return pf.token();
+      }),
+      collie::tf::make_data_pipe<size_t, std::string>(collie::tf::PipeType::PARALLEL, [](size_t& input, collie::tf::Pipeflow& pf) {
+        REQUIRE(input == pf.token());
+        return std::to_string(input);
+      }),
+      collie::tf::make_data_pipe<std::string, void>(collie::tf::PipeType::SERIAL, [&](std::string& input) {
+        collection.push_back(input);
+      })
+    );
+
+    pl.batch_size(B);
+    REQUIRE(pl.batch_size() == B);
+
+    taskflow.composed_of(pl);
+
+    for(size_t r = 0; r < 2; r++) {
+      collection.clear();
+      pl.reset();
+      executor.run(taskflow).wait();
+
+      REQUIRE(pl.num_tokens() == N);
+      REQUIRE(collection.size() == N);
+      for(size_t i = 0; i < N; i++) {
+        REQUIRE(collection[i] == std::to_string(i));
+      }
+    }
+  }
+}
+
+TEST_CASE("DataPipeline.Batched.1L.1W" * doctest::timeout(300)) {
+  for(size_t B = 1; B <= 8; B++) {
+    batched_data_pipeline(1, 1, B);
+  }
+}
+
+TEST_CASE("DataPipeline.Batched.2L.2W" * doctest::timeout(300)) {
+  for(size_t B = 1; B <= 8; B++) {
+    batched_data_pipeline(2, 2, B);
+  }
+}
+
+TEST_CASE("DataPipeline.Batched.4L.4W" * doctest::timeout(300)) {
+  for(size_t B = 1; B <= 8; B++) {
+    batched_data_pipeline(4, 4, B);
+  }
+}
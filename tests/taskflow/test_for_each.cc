@@ -720,6 +720,138 @@ TEST_CASE("ClosureWrapper.for_each.Dynamic" * doctest::timeout(300))
   }
 }
 
+// ----------------------------------------------------------------------------
+// for_each_index over multi-dimensional ranges
+// ----------------------------------------------------------------------------
+
+TEST_CASE("IndexRange.Tiles") {
+
+  collie::tf::IndexRange2D<int> range({0, 10}, {7, -10}, {1, -3});
+
+  REQUIRE(range.size(0) == 7);
+  REQUIRE(range.size(1) == 7);
+  REQUIRE(range.size() == 49);
+  REQUIRE(range.num_tiles() == 1);
+
+  range.tile_size({2, 3});
+  REQUIRE(range.num_tiles(0) == 4);
+  REQUIRE(range.num_tiles(1) == 3);
+
+  // the tiles cover every index exactly once
+  std::vector<int> seen(49, 0);
+  for(size_t t=0; t<range.num_tiles(); t++) {
+    range.tile(t).for_each([&](int i, int j){
+      seen[i * 7 + (10 - j) / 3]++;
+    });
+  }
+  REQUIRE(seen == std::vector<int>(49, 1));
+
+  // the last tile is clipped to the range
+  auto last = range.tile(range.num_tiles() - 1);
+  REQUIRE(last.begin(0) == 6);
+  REQUIRE(last.size(0) == 1);
+  REQUIRE(last.begin(1) == -8);
+  REQUIRE(last.size(1) == 1);
+
+  // the default tiling gives every worker a tile
+  collie::tf::IndexRange3D<int> cube({0, 0, 0}, {8, 8, 8});
+  REQUIRE(cube.tiled(4).num_tiles() >= 4);
+  REQUIRE(cube.tiled(1000).num_tiles() == 512);
+
+  REQUIRE(collie::tf::IndexRange2D<int>({0, 0}, {5, 5}, {1, -1}).is_invalid());
+  REQUIRE(collie::tf::IndexRange2D<int>({0, 0}, {0, 5}).empty());
+}
+
+template <typename P>
+void for_each_index_2d(unsigned W) {
+
+  collie::tf::Executor executor(W);
+  collie::tf::Taskflow taskflow;
+
+  for(int rows : {0, 1, 7, 100, 301}) {
+    for(int cols : {1, 13, 512}) {
+      for(size_t c : {0, 1, 3, 7, 99}) {
+        for(size_t tile : {0, 1, 16}) {
+
+          taskflow.clear();
+
+          std::vector<int> grid(rows * cols, 0);
+
+          collie::tf::IndexRange2D<int> range({0, 0}, {rows, cols});
+          range.tile_size({tile, tile});
+
+          taskflow.for_each_index(range, [&](int i, int j){
+            grid[i * cols + j]++;
+          }, P(c));
+
+          executor.run(taskflow).wait();
+
+          REQUIRE(grid == std::vector<int>(rows * cols, 1));
+        }
+      }
+    }
+  }
+}
+
+TEST_CASE("ParallelFor.Index2D.Static.1thread" * doctest::timeout(300)) {
+  for_each_index_2d<collie::tf::StaticPartitioner<>>(1);
+}
+
+TEST_CASE("ParallelFor.Index2D.Static.4threads" * doctest::timeout(300)) {
+  for_each_index_2d<collie::tf::StaticPartitioner<>>(4);
+}
+
+TEST_CASE("ParallelFor.Index2D.Guided.3threads" * doctest::timeout(300)) {
+  for_each_index_2d<collie::tf::GuidedPartitioner<>>(3);
+}
+
+TEST_CASE("ParallelFor.Index2D.Dynamic.4threads" * doctest::timeout(300)) {
+  for_each_index_2d<collie::tf::DynamicPartitioner<>>(4);
+}
+
+TEST_CASE("ParallelFor.Index3D.Tiles" * doctest::timeout(300)) {
+
+  collie::tf::Executor executor(4);
+  collie::tf::Taskflow taskflow;
+
+  const int N = 40;
+  std::vector<int> cube(N * N * N, 0);
+  std::atomic<size_t> num_tiles {0};
+
+  collie::tf::IndexRange3D<int> range;
+  int beg = 0, end = 0;
+
+  // stateful range set by a preceding task
+  auto init = taskflow.emplace([&](){
+    beg = 2;
+    end = N;
+    range = collie::tf::IndexRange3D<int>({beg, beg, beg}, {end, end, end}, {2, 1, 1});
+  });
+
+  // tile-wise callable
+  auto loop = taskflow.for_each_index(std::ref(range), [&](const collie::tf::IndexRange3D<int>& tile){
+    num_tiles++;
+    tile.for_each([&](int i, int j, int k){
+      cube[(i * N + j) * N + k]++;
+    });
+  }, collie::tf::GuidedPartitioner<>());
+
+  init.precede(loop);
+
+  executor.run(taskflow).wait();
+
+  REQUIRE(num_tiles >= 4);
+
+  for(int i=0; i<N; i++) {
+    for(int j=0; j<N; j++) {
+      for(int k=0; k<N; k++) {
+        int expected = (i >= 2 && i % 2 == 0 && j >= 2 && k >= 2) ? 1 : 0;
+        REQUIRE(cube[(i * N + j) * N + k] == expected);
+      }
+    }
+  }
+}
+
 //// ----------------------------------------------------------------------------
 //// Parallel For Exception
 //// ----------------------------------------------------------------------------
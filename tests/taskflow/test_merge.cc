@@ -0,0 +1,96 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+#include <collie/testing/doctest.h>
+#include <collie/taskflow/taskflow.h>
+#include <collie/taskflow/algorithm/merge.h>
+
+template <typename P>
+void test_merge(unsigned W) {
+
+  collie::tf::Executor executor(W);
+  collie::tf::Taskflow taskflow;
+
+  using T = std::pair<int, int>;
+  std::vector<T> a, b, output, gold;
+
+  // compare keys only so that stability is observable
+  auto cmp = [] (const T& x, const T& y) { return x.first < y.first; };
+
+  for(size_t n = 0; n <= 65536; n <= 256 ? n++ : n=2*n+1) {
+    for(size_t c : {0, 1, 3, 7, 99}) {
+
+      taskflow.clear();
+
+      size_t m = ::rand() % (n + 1);
+
+      a.resize(n);
+      b.resize(m);
+
+      for(auto& x : a) x = {::rand() % 16, 0};
+      for(auto& x : b) x = {::rand() % 16, 1};
+
+      std::sort(a.begin(), a.end(), cmp);
+      std::sort(b.begin(), b.end(), cmp);
+
+      gold.resize(n + m);
+      std::merge(a.begin(), a.end(), b.begin(), b.end(), gold.begin(), cmp);
+
+      output.assign(n + m, T{-1, -1});
+
+      taskflow.merge(
+        a.begin(), a.end(), b.begin(), b.end(), output.begin(), cmp, P(c)
+      );
+
+      executor.run(taskflow).wait();
+
+      REQUIRE(output == gold);
+    }
+  }
+}
+
+TEST_CASE("merge.StaticPartitioner.1thread" * doctest::timeout(300)) {
+  test_merge<collie::tf::StaticPartitioner<>>(1);
+}
+
+TEST_CASE("merge.StaticPartitioner.4threads" * doctest::timeout(300)) {
+  test_merge<collie::tf::StaticPartitioner<>>(4);
+}
+
+TEST_CASE("merge.GuidedPartitioner.2threads" * doctest::timeout(300)) {
+  test_merge<collie::tf::GuidedPartitioner<>>(2);
+}
+
+TEST_CASE("merge.DynamicPartitioner.3threads" * doctest::timeout(300)) {
+  test_merge<collie::tf::DynamicPartitioner<>>(3);
+}
+
+TEST_CASE("merge.DefaultComparator" * doctest::timeout(300)) {
+
+  collie::tf::Executor executor(4);
+  collie::tf::Taskflow taskflow;
+
+  std::vector<int> a(70000), b(30000), output(100000), gold(100000);
+  std::vector<int>::iterator beg1, end1;
+
+  for(auto& x : a) x = ::rand();
+  for(auto& x : b) x = ::rand();
+
+  std::sort(a.begin(), a.end());
+  std::sort(b.begin(), b.end());
+  std::merge(a.begin(), a.end(), b.begin(), b.end(), gold.begin());
+
+  auto init = taskflow.emplace([&](){
+    beg1 = a.begin();
+    end1 = a.end();
+  });
+
+  auto merge = taskflow.merge(
+    std::ref(beg1), std::ref(end1), b.begin(), b.end(), output.begin()
+  );
+
+  init.precede(merge);
+
+  executor.run(taskflow).wait();
+
+  REQUIRE(output == gold);
+}
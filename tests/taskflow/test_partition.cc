@@ -0,0 +1,205 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+#include <collie/testing/doctest.h>
+#include <collie/taskflow/taskflow.h>
+#include <collie/taskflow/algorithm/partition.h>
+
+// ----------------------------------------------------------------------------
+// copy_if
+// ----------------------------------------------------------------------------
+
+template <typename P>
+void test_copy_if(unsigned W) {
+
+  collie::tf::Executor executor(W);
+  collie::tf::Taskflow taskflow;
+  std::vector<int> input, output, gold;
+
+  for(size_t n = 0; n <= 65536; n <= 256 ? n++ : n=2*n+1) {
+    for(size_t c : {0, 1, 3, 7, 99}) {
+
+      taskflow.clear();
+
+      input.resize(n);
+      output.assign(n, -1);
+
+      for(auto& i : input) {
+        i = ::rand() % (2 * n + 1);
+      }
+
+      auto pred = [] (int i) { return i % 3 == 0; };
+
+      gold.clear();
+      std::copy_if(input.begin(), input.end(), std::back_inserter(gold), pred);
+
+      std::vector<int>::iterator result;
+      std::vector<int>::iterator beg, end, d_beg;
+
+      auto init = taskflow.emplace([&](){
+        beg = input.begin();
+        end = input.end();
+        d_beg = output.begin();
+      });
+
+      auto copy = taskflow.copy_if(
+        std::ref(beg), std::ref(end), std::ref(d_beg), result, pred, P(c)
+      );
+
+      init.precede(copy);
+
+      executor.run(taskflow).wait();
+
+      REQUIRE(result - output.begin() == gold.size());
+      REQUIRE(std::equal(gold.begin(), gold.end(), output.begin()));
+    }
+  }
+}
+
+TEST_CASE("copy_if.StaticPartitioner.1thread" * doctest::timeout(300)) {
+  test_copy_if<collie::tf::StaticPartitioner<>>(1);
+}
+
+TEST_CASE("copy_if.StaticPartitioner.4threads" * doctest::timeout(300)) {
+  test_copy_if<collie::tf::StaticPartitioner<>>(4);
+}
+
+TEST_CASE("copy_if.GuidedPartitioner.2threads" * doctest::timeout(300)) {
+  test_copy_if<collie::tf::GuidedPartitioner<>>(2);
+}
+
+TEST_CASE("copy_if.DynamicPartitioner.3threads" * doctest::timeout(300)) {
+  test_copy_if<collie::tf::DynamicPartitioner<>>(3);
+}
+
+TEST_CASE("copy_if.RandomPartitioner.4threads" * doctest::timeout(300)) {
+  test_copy_if<collie::tf::RandomPartitioner<>>(4);
+}
+
+// ----------------------------------------------------------------------------
+// partition
+// ----------------------------------------------------------------------------
+
+template <typename P>
+void test_partition(unsigned W) {
+
+  collie::tf::Executor executor(W);
+  collie::tf::Taskflow taskflow;
+  std::vector<std::pair<int, size_t>> input, gold;
+
+  for(size_t n = 0; n <= 65536; n <= 256 ? n++ : n=2*n+1) {
+    for(size_t c : {0, 1, 3, 7, 99}) {
+
+      taskflow.clear();
+
+      input.resize(n);
+
+      // tag each element with its position to check stability
+      for(size_t i = 0; i < n; i++) {
+        input[i] = {::rand() % 10, i};
+      }
+
+      auto pred = [] (const std::pair<int, size_t>& p) { return p.first < 4; };
+
+      gold = input;
+      auto gold_mid = std::stable_partition(gold.begin(), gold.end(), pred);
+
+      std::vector<std::pair<int, size_t>>::iterator result;
+
+      taskflow.partition(input.begin(), input.end(), result, pred, P(c));
+
+      executor.run(taskflow).wait();
+
+      REQUIRE(result - input.begin() == gold_mid - gold.begin());
+      REQUIRE(input == gold);
+    }
+  }
+}
+
+TEST_CASE("partition.StaticPartitioner.1thread" * doctest::timeout(300)) {
+  test_partition<collie::tf::StaticPartitioner<>>(1);
+}
+
+TEST_CASE("partition.StaticPartitioner.4threads" * doctest::timeout(300)) {
+  test_partition<collie::tf::StaticPartitioner<>>(4);
+}
+
+TEST_CASE("partition.GuidedPartitioner.2threads" * doctest::timeout(300)) {
+  test_partition<collie::tf::GuidedPartitioner<>>(2);
+}
+
+TEST_CASE("partition.DynamicPartitioner.3threads" * doctest::timeout(300)) {
+  test_partition<collie::tf::DynamicPartitioner<>>(3);
+}
+
+// ----------------------------------------------------------------------------
+// unique
+// ----------------------------------------------------------------------------
+
+template <typename P>
+void test_unique(unsigned W) {
+
+  collie::tf::Executor executor(W);
+  collie::tf::Taskflow taskflow;
+  std::vector<int> input, gold;
+
+  for(size_t n = 0; n <= 65536; n <= 256 ? n++ : n=2*n+1) {
+    for(size_t c : {0, 1, 3, 7, 99}) {
+
+      taskflow.clear();
+
+      // long runs of equal elements crossing the block boundaries
+      input.resize(n);
+      for(auto& i : input) {
+        i = ::rand() % 4;
+      }
+      std::sort(input.begin(), input.end());
+
+      gold = input;
+      gold.erase(std::unique(gold.begin(), gold.end()), gold.end());
+
+      std::vector<int>::iterator result;
+
+      taskflow.unique(
+        input.begin(), input.end(), result, std::equal_to<int>{}, P(c)
+      );
+
+      executor.run(taskflow).wait();
+
+      REQUIRE(result - input.begin() == gold.size());
+      REQUIRE(std::equal(gold.begin(), gold.end(), input.begin()));
+    }
+  }
+}
+
+TEST_CASE("unique.StaticPartitioner.1thread" * doctest::timeout(300)) {
+  test_unique<collie::tf::StaticPartitioner<>>(1);
+}
+
+TEST_CASE("unique.StaticPartitioner.4threads" * doctest::timeout(300)) {
+  test_unique<collie::tf::StaticPartitioner<>>(4);
+}
+
+TEST_CASE("unique.DynamicPartitioner.3threads" * doctest::timeout(300)) {
+  test_unique<collie::tf::DynamicPartitioner<>>(3);
+}
+
+TEST_CASE("unique.DefaultComparator" * doctest::timeout(300)) {
+
+  collie::tf::Executor executor(4);
+  collie::tf::Taskflow taskflow;
+
+  std::vector<int> input(100000);
+  for(auto& i : input) {
+    i = ::rand() % 3;
+  }
+
+  auto gold = input;
+  gold.erase(std::unique(gold.begin(), gold.end()), gold.end());
+
+  std::vector<int>::iterator result;
+  taskflow.unique(input.begin(), input.end(), result);
+  executor.run(taskflow).wait();
+
+  REQUIRE(result - input.begin() == gold.size());
+  REQUIRE(std::equal(gold.begin(), gold.end(), input.begin()));
+}
@@ -2926,3 +2926,104 @@ TEST_CASE("PipelineinPipeline.Pipelines.5L.2W.3subL" * doctest::timeout(300)) {
 TEST_CASE("PipelineinPipeline.Pipelines.5L.2W.4subL" * doctest::timeout(300)) {
   pipeline_in_pipeline(5, 2, 4);
 }
+
+// ----------------------------------------------------------------------------
+// Batched Pipeline
+// ----------------------------------------------------------------------------
+
+void batched_pipeline(size_t L, unsigned w, size_t B) {
+
+  collie::tf::Executor executor(w);
+
+  for(size_t N = 0; N <= 50; N++) {
+
+    collie::tf::Taskflow taskflow;
+
+    // per-token data of each line
+    std::vector<std::vector<size_t>> buffer(L, std::vector<size_t>(B));
+    std::vector<size_t> collection;
+    std::atomic<size_t> num_parallel {0};
+
+    collie::tf::Pipeline pl(L,
+      collie::tf::Pipe{collie::tf::PipeType::SERIAL, [&, N](collie::tf::Pipeflow& pf) {
+        if(pf.token() == N) {
+          pf.stop();
+          return;
+        }
+        REQUIRE(pf.batch_index() < B);
+        REQUIRE(pf.token() / B % L == pf.line());
+        buffer[pf.line()][pf.batch_index()] = pf.token();
+      }},
+      collie::tf::Pipe{collie::tf::PipeType::PARALLEL, [&](collie::tf::Pipeflow& pf) {
+        REQUIRE(buffer[pf.line()][pf.batch_index()] == pf.token());
+        buffer[pf.line()][pf.batch_index()] += 1;
+        num_parallel.fetch_add(1, std::memory_order_relaxed);
+      }},
+      collie::tf::Pipe{collie::tf::PipeType::SERIAL, [&](collie::tf::Pipeflow& pf) {
+        REQUIRE(buffer[pf.line()][pf.batch_index()] == pf.token() + 1);
+        collection.push_back(pf.token());
+      }}
+    );
+
+    pl.batch_size(B);
+    REQUIRE(pl.batch_size() == B);
+
+    taskflow.composed_of(pl);
+
+    for(size_t r = 0; r < 2; r++) {
+      collection.clear();
+      num_parallel = 0;
+      pl.reset();
+      executor.run(taskflow).wait();
+
+      REQUIRE(pl.num_tokens() == N);
+      REQUIRE(num_parallel == N);
+      REQUIRE(collection.size() == N);
+      for(size_t i = 0; i < N; i++) {
+        REQUIRE(collection[i] == i);
+      }
+    }
+  }
+}
+
+TEST_CASE("Pipeline.Batched.1L.1W" * doctest::timeout(300)) {
+  for(size_t B = 1; B <= 8; B++) {
+    batched_pipeline(1, 1, B);
+  }
+}
+
+TEST_CASE("Pipeline.Batched.2L.2W" * doctest::timeout(300)) {
+  for(size_t B = 1; B <= 8; B++) {
+    batched_pipeline(2, 2, B);
+  }
+}
+
+TEST_CASE("Pipeline.Batched.4L.4W" * doctest::timeout(300)) {
+  for(size_t B = 1; B <= 8; B++) {
+    batched_pipeline(4, 4, B);
+  }
+}
+
+TEST_CASE("Pipeline.Batched.Defer" * doctest::timeout(300)) {
+
+  collie::tf::Executor executor(2);
+  collie::tf::Taskflow taskflow;
+
+  collie::tf::Pipeline pl(2,
+    collie::tf::Pipe{collie::tf::PipeType::SERIAL, [](collie::tf::Pipeflow& pf) {
+      if(pf.token() == 10) {
+        pf.stop();
+        return;
+      }
+      if(pf.token() == 0) {
+        pf.defer(1);
+      }
+    }}
+  );
+
+  REQUIRE_THROWS_AS(pl.batch_size(0), std::runtime_error);
+
+  pl.batch_size(4);
+  taskflow.composed_of(pl);
+  REQUIRE_THROWS_AS(executor.run(taskflow).get(), std::runtime_error);
+}
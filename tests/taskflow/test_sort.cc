@@ -530,6 +530,192 @@ TEST_CASE("QuickSort" * doctest::timeout(300)) {
     }
 }
 
+// ----------------------------------------------------------------------------
+// radix sort
+// ----------------------------------------------------------------------------
+
+template<typename T, typename P>
+void radix_sort_pod(size_t W, P part) {
+
+    collie::tf::Executor executor(W);
+
+    for (size_t N : {0, 1, 100, 257, 1000, 10000, 100000}) {
+
+        std::vector<T> data(N);
+
+        for (auto &d: data) {
+            d = static_cast<T>(::rand() % 2000 - 1000);
+            if constexpr (std::is_floating_point_v<T>) {
+                d /= 7;
+            }
+        }
+
+        auto gold = data;
+        std::sort(gold.begin(), gold.end());
+
+        collie::tf::Taskflow taskflow;
+        taskflow.radix_sort(data.begin(), data.end(), [](T v) { return v; }, part);
+        executor.run(taskflow).wait();
+
+        REQUIRE(data == gold);
+    }
+}
+
+TEST_CASE("RadixSort.int" * doctest::timeout(300)) {
+    for (size_t W = 1; W <= 4; W++) {
+        radix_sort_pod<int>(W, collie::tf::GuidedPartitioner());
+        radix_sort_pod<int>(W, collie::tf::StaticPartitioner());
+    }
+}
+
+TEST_CASE("RadixSort.uint64" * doctest::timeout(300)) {
+    for (size_t W = 1; W <= 4; W++) {
+        radix_sort_pod<uint64_t>(W, collie::tf::DynamicPartitioner());
+    }
+}
+
+TEST_CASE("RadixSort.float" * doctest::timeout(300)) {
+    for (size_t W = 1; W <= 4; W++) {
+        radix_sort_pod<float>(W, collie::tf::GuidedPartitioner());
+    }
+}
+
+TEST_CASE("RadixSort.double" * doctest::timeout(300)) {
+    for (size_t W = 1; W <= 4; W++) {
+        radix_sort_pod<double>(W, collie::tf::RandomPartitioner());
+    }
+}
+
+TEST_CASE("RadixSort.Default" * doctest::timeout(300)) {
+
+    collie::tf::Executor executor(4);
+    collie::tf::Taskflow taskflow;
+
+    std::vector<int16_t> data(50000);
+    for (auto &d: data) {
+        d = static_cast<int16_t>(::rand());
+    }
+
+    taskflow.radix_sort(data.begin(), data.end());
+    executor.run(taskflow).wait();
+
+    REQUIRE(std::is_sorted(data.begin(), data.end()));
+}
+
+TEST_CASE("RadixSort.Records.Stable" * doctest::timeout(300)) {
+
+    for (size_t W = 1; W <= 4; W++) {
+
+        collie::tf::Executor executor(W);
+        collie::tf::Taskflow taskflow;
+
+        // (key, original position)
+        std::vector<std::pair<uint32_t, size_t>> data(100000);
+        for (size_t i = 0; i < data.size(); i++) {
+            data[i] = {static_cast<uint32_t>(::rand() % 100), i};
+        }
+
+        taskflow.radix_sort(data.begin(), data.end(), [](const auto &r) {
+            return r.first;
+        });
+        executor.run(taskflow).wait();
+
+        REQUIRE(std::is_sorted(data.begin(), data.end()));
+    }
+}
+
+TEST_CASE("RadixSort.UniformDigitPass" * doctest::timeout(300)) {
+
+    collie::tf::Executor executor(4);
+    collie::tf::Taskflow taskflow;
+
+    // the low byte of every key is 0x2a, the next one varies
+    const size_t N = 40000;
+    std::vector<uint32_t> src(N), dst(N, 0);
+    for (size_t i = 0; i < N; i++) {
+        src[i] = static_cast<uint32_t>((::rand() % 256) << 8 | 0x2a);
+    }
+    const auto orig = src;
+
+    bool moved[2] = {true, false};
+    bool dst_untouched = false;
+    taskflow.emplace([&](collie::tf::Runtime &rt) {
+        collie::tf::StaticPartitioner part;
+        auto key = [](uint32_t v) { return v; };
+        size_t num_blocks = 4;
+        std::vector<size_t> counts(num_blocks << 8);
+        moved[0] = collie::tf::detail::parallel_radix_pass(
+                rt, part, src.data(), dst.data(), N, num_blocks, key, 0, counts);
+        dst_untouched = std::all_of(dst.begin(), dst.end(), [](uint32_t v) { return v == 0; });
+        moved[1] = collie::tf::detail::parallel_radix_pass(
+                rt, part, src.data(), dst.data(), N, num_blocks, key, 8, counts);
+    });
+    executor.run(taskflow).wait();
+
+    // the uniform pass is skipped without touching dst, the other one scatters
+    REQUIRE(moved[0] == false);
+    REQUIRE(dst_untouched);
+    REQUIRE(moved[1] == true);
+    REQUIRE(src == orig);
+    REQUIRE(std::is_sorted(dst.begin(), dst.end()));
+}
+
+// ----------------------------------------------------------------------------
+// stable sort
+// ----------------------------------------------------------------------------
+
+template<typename P>
+void stable_sort_records(size_t W, P part) {
+
+    collie::tf::Executor executor(W);
+
+    for (size_t N : {0, 1, 100, 1000, 4097, 10000, 100000}) {
+
+        // (key, original position)
+        std::vector<std::pair<int, std::string>> data(N);
+        for (size_t i = 0; i < N; i++) {
+            data[i] = {::rand() % 50, std::to_string(i)};
+        }
+
+        auto gold = data;
+        auto by_key = [](const auto &l, const auto &r) { return l.first < r.first; };
+        std::stable_sort(gold.begin(), gold.end(), by_key);
+
+        collie::tf::Taskflow taskflow;
+        taskflow.stable_sort(data.begin(), data.end(), by_key, part);
+        executor.run(taskflow).wait();
+
+        REQUIRE(data == gold);
+    }
+}
+
+TEST_CASE("StableSort.Records" * doctest::timeout(300)) {
+    for (size_t W = 1; W <= 5; W++) {
+        stable_sort_records(W, collie::tf::GuidedPartitioner());
+        stable_sort_records(W, collie::tf::StaticPartitioner());
+        stable_sort_records(W, collie::tf::DynamicPartitioner());
+    }
+}
+
+TEST_CASE("StableSort.int" * doctest::timeout(300)) {
+
+    for (size_t W = 1; W <= 4; W++) {
+
+        collie::tf::Executor executor(W);
+        collie::tf::Taskflow taskflow;
+
+        std::vector<int> data(1000000);
+        for (auto &d: data) {
+            d = ::rand();
+        }
+
+        taskflow.stable_sort(data.begin(), data.end());
+        executor.run(taskflow).wait();
+
+        REQUIRE(std::is_sorted(data.begin(), data.end()));
+    }
+}
+
 //// ----------------------------------------------------------------------------
 //// Exception
 //// ----------------------------------------------------------------------------
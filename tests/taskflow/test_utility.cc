@@ -5,6 +5,7 @@
 #include <collie/taskflow/utility/traits.h>
 #include <collie/taskflow/utility/object_pool.h>
 #include <collie/taskflow/utility/math.h>
+#include <collie/taskflow/utility/small_function.h>
 
 
 
@@ -336,7 +337,51 @@ TEST_CASE("NextPow2") {
   REQUIRE(collie::tf::is_pow2(64u) == true);
 }
 
-
-
-
-
+// --------------------------------------------------------
+// Testcase: SmallFunction
+// --------------------------------------------------------
+TEST_CASE("SmallFunction" * doctest::timeout(300)) {
+
+  using Function = collie::tf::SmallFunction<int(int)>;
+
+  // small callables are stored inline
+  int base = 10;
+  Function f1 = [&](int x){ return base + x; };
+  REQUIRE(f1);
+  REQUIRE(f1(5) == 15);
+
+  // large callables fall back to the heap
+  std::array<int, 64> data;
+  data.fill(1);
+  Function f2 = [data](int x) { return data[0] + data[63] + x; };
+  REQUIRE(f2(1) == 3);
+
+  // move-only callables are supported
+  auto ptr = std::make_unique<int>(7);
+  Function f3 = [p = std::move(ptr)](int x) mutable { return (*p += x); };
+  REQUIRE(f3(1) == 8);
+  REQUIRE(f3(1) == 9);
+
+  // moves transfer the callable and leave the source empty
+  Function f4 = std::move(f2);
+  REQUIRE(!f2);
+  REQUIRE(f4(2) == 4);
+
+  f4 = std::move(f3);
+  REQUIRE(!f3);
+  REQUIRE(f4(1) == 10);
+
+  Function f5;
+  REQUIRE(!f5);
+
+  // captured objects are destroyed exactly once
+  auto shared = std::make_shared<int>(0);
+  {
+    Function f6 = [shared](int x){ return x + *shared; };
+    Function f7 = std::move(f6);
+    Function f8;
+    f8 = std::move(f7);
+    REQUIRE(shared.use_count() == 2);
+  }
+  REQUIRE(shared.use_count() == 1);
+}
@@ -3,6 +3,9 @@
 #include <collie/testing/doctest.h>
 #include <collie/taskflow/taskflow.h>
 
+#include <filesystem>
+#include <fstream>
+
 // ============================================================================
 // Test without Priority
 // ============================================================================
@@ -1243,3 +1246,335 @@ TEST_CASE("WorkStealing.Continuation.8threads" * doctest::timeout(300)) {
 
 
 
+
+// ----------------------------------------------------------------------------
+// Worker Affinity
+// ----------------------------------------------------------------------------
+
+TEST_CASE("WorkStealing.CpuList") {
+  using V = std::vector<size_t>;
+  REQUIRE(collie::tf::CpuTopology::parse_cpu_list("") == V{});
+  REQUIRE(collie::tf::CpuTopology::parse_cpu_list("3") == V{3});
+  REQUIRE(collie::tf::CpuTopology::parse_cpu_list("0-3,8,10-11\n") == V{0, 1, 2, 3, 8, 10, 11});
+}
+
+// builds a sysfs tree of 2 nodes x 2 cores x 2 hardware threads,
+// cpu c and c+4 being siblings
+TEST_CASE("WorkStealing.CpuTopology") {
+
+  namespace fs = std::filesystem;
+
+  auto root = fs::temp_directory_path() / "tf_cpu_topology_test";
+  fs::remove_all(root);
+  fs::create_directories(root);
+
+  auto write = [](const fs::path& path, const std::string& str) {
+    fs::create_directories(path.parent_path());
+    std::ofstream(path) << str << '\n';
+  };
+
+  write(root / "online", "0-7");
+  for(size_t c=0; c<8; ++c) {
+    auto dir = root / ("cpu" + std::to_string(c));
+    size_t core = c % 4;
+    size_t node = core / 2;
+    write(dir / "topology" / "thread_siblings_list", std::to_string(core) + "," + std::to_string(core + 4));
+    write(dir / "topology" / "physical_package_id", std::to_string(node));
+    write(dir / "cache" / "index0" / "level", "1");
+    write(dir / "cache" / "index0" / "shared_cpu_list", std::to_string(core) + "," + std::to_string(core + 4));
+    write(dir / "cache" / "index1" / "level", "3");
+    write(dir / "cache" / "index1" / "shared_cpu_list", std::to_string(node*2) + "-" + std::to_string(node*2+1) + "," + std::to_string(node*2+4) + "-" + std::to_string(node*2+5));
+    fs::create_directories(dir / ("node" + std::to_string(node)));
+  }
+
+  auto topo = collie::tf::CpuTopology::read_sysfs(root.string());
+  fs::remove_all(root);
+
+  REQUIRE(topo.size() == 8);
+  for(const auto& c : topo.cpus()) {
+    REQUIRE(c.core == c.cpu % 4);
+    REQUIRE(c.node == (c.cpu % 4) / 2);
+    REQUIRE(c.llc == c.node * 2);
+  }
+  REQUIRE(collie::tf::CpuTopology::distance(*topo.find(0), *topo.find(4)) == 0);
+  REQUIRE(collie::tf::CpuTopology::distance(*topo.find(0), *topo.find(1)) == 1);
+  REQUIRE(collie::tf::CpuTopology::distance(*topo.find(0), *topo.find(2)) == 3);
+  REQUIRE(topo.find(8) == nullptr);
+
+  // compact: one worker per core of node 0, then the siblings, then node 1
+  auto cpus = collie::tf::WorkerAffinity::compact().assign(8, topo);
+  std::vector<size_t> ids;
+  for(const auto& c : cpus) {
+    ids.push_back(c.cpu);
+  }
+  REQUIRE(ids == std::vector<size_t>{0, 1, 4, 5, 2, 3, 6, 7});
+
+  cpus = collie::tf::WorkerAffinity::numa_nodes({1}).assign(3, topo);
+  REQUIRE(cpus.size() == 3);
+  REQUIRE(cpus[0].cpu == 2);
+  REQUIRE(cpus[1].cpu == 3);
+  REQUIRE(cpus[2].cpu == 6);
+
+  cpus = collie::tf::WorkerAffinity::cpus({5, 1}).assign(3, topo);
+  REQUIRE(cpus[0].cpu == 5);
+  REQUIRE(cpus[1].cpu == 1);
+  REQUIRE(cpus[2].cpu == 5);
+
+  REQUIRE(collie::tf::WorkerAffinity().assign(4, topo).empty());
+}
+
+void affinity_test(size_t W, const collie::tf::WorkerAffinity& affinity) {
+
+  collie::tf::Executor executor(W, affinity);
+  collie::tf::Taskflow taskflow;
+
+  std::atomic<size_t> counter {0};
+  for(size_t i=0; i<10000; ++i) {
+    taskflow.emplace([&](){ counter.fetch_add(1, std::memory_order_relaxed); });
+  }
+
+  executor.run_n(taskflow, 10).wait();
+  REQUIRE(counter == 100000);
+}
+
+TEST_CASE("WorkStealing.Affinity.Compact" * doctest::timeout(300)) {
+  for(size_t W=1; W<=8; ++W) {
+    affinity_test(W, collie::tf::WorkerAffinity::compact());
+  }
+}
+
+TEST_CASE("WorkStealing.Affinity.SameCpu" * doctest::timeout(300)) {
+  for(size_t W=1; W<=8; ++W) {
+    affinity_test(W, collie::tf::WorkerAffinity::cpus({0}));
+  }
+}
+
+// ----------------------------------------------------------------------------
+// Idle Policy
+// ----------------------------------------------------------------------------
+
+TEST_CASE("WorkStealing.IdlePolicy.Budget") {
+
+  // the default keeps the executor's fixed yield loop
+  auto policy = collie::tf::IdlePolicy();
+  REQUIRE(policy.kind() == collie::tf::IdlePolicy::YIELD);
+  REQUIRE(policy.max_budget() == 100);
+  REQUIRE(policy.min_budget() <= policy.max_budget());
+  REQUIRE(!policy.adaptive());
+  REQUIRE(!collie::tf::IdlePolicy::spin().adaptive());
+  REQUIRE(collie::tf::IdlePolicy::spin().adaptive(true).adaptive());
+
+  policy = collie::tf::IdlePolicy::park();
+  REQUIRE(policy.kind() == collie::tf::IdlePolicy::PARK);
+  REQUIRE(policy.max_budget() == 0);
+
+  policy = collie::tf::IdlePolicy::spin().min_budget(10).max_budget(5);
+  REQUIRE(policy.kind() == collie::tf::IdlePolicy::SPIN);
+  REQUIRE(policy.min_budget() == 5);
+  REQUIRE(policy.max_budget() == 5);
+
+  policy = collie::tf::IdlePolicy::backoff().min_budget(200);
+  REQUIRE(policy.min_budget() == 200);
+  REQUIRE(policy.max_budget() == 200);
+}
+
+// observer recording the steal counter of each worker on task exit
+struct IdleCounterObserver : public collie::tf::ObserverInterface {
+
+  std::vector<std::atomic<size_t>> steals;
+
+  void set_up(size_t W) override final {
+    steals = std::vector<std::atomic<size_t>>(W);
+  }
+
+  void on_entry(collie::tf::WorkerView, collie::tf::TaskView) override final {
+  }
+
+  void on_exit(collie::tf::WorkerView wv, collie::tf::TaskView) override final {
+    steals[wv.id()] = wv.num_steals();
+  }
+};
+
+void idle_policy_test(size_t W, const collie::tf::IdlePolicy& policy) {
+
+  collie::tf::Executor executor(W, policy);
+  collie::tf::Taskflow taskflow;
+
+  REQUIRE(executor.idle_policy().kind() == policy.kind());
+
+  auto observer = executor.make_observer<IdleCounterObserver>();
+
+  std::atomic<size_t> counter {0};
+  for(size_t i=0; i<1000; ++i) {
+    taskflow.emplace([&](){ counter.fetch_add(1, std::memory_order_relaxed); });
+  }
+
+  // leave time between the runs for the workers to park
+  for(size_t r=0; r<10; ++r) {
+    executor.run(taskflow).wait();
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+  REQUIRE(counter == 10000);
+
+  // tasks submitted from outside are stolen from the shared queue
+  size_t steals = 0;
+  for(size_t w=0; w<W; ++w) {
+    steals += observer->steals[w];
+  }
+  REQUIRE(steals > 0);
+
+  executor.remove_observer(observer);
+}
+
+TEST_CASE("WorkStealing.IdlePolicy.Yield" * doctest::timeout(300)) {
+  for(size_t W=1; W<=4; ++W) {
+    idle_policy_test(W, collie::tf::IdlePolicy::yield());
+  }
+}
+
+TEST_CASE("WorkStealing.IdlePolicy.Spin" * doctest::timeout(300)) {
+  for(size_t W=1; W<=4; ++W) {
+    idle_policy_test(W, collie::tf::IdlePolicy::spin());
+  }
+}
+
+TEST_CASE("WorkStealing.IdlePolicy.Backoff" * doctest::timeout(300)) {
+  for(size_t W=1; W<=4; ++W) {
+    idle_policy_test(W, collie::tf::IdlePolicy::backoff());
+  }
+}
+
+TEST_CASE("WorkStealing.IdlePolicy.Adaptive" * doctest::timeout(300)) {
+  for(size_t W=1; W<=4; ++W) {
+    idle_policy_test(W, collie::tf::IdlePolicy::yield().adaptive(true));
+    idle_policy_test(W, collie::tf::IdlePolicy::spin().adaptive(true));
+  }
+}
+
+TEST_CASE("WorkStealing.IdlePolicy.Park" * doctest::timeout(300)) {
+  for(size_t W=1; W<=4; ++W) {
+    idle_policy_test(W, collie::tf::IdlePolicy::park());
+  }
+}
+
+// ----------------------------------------------------------------------------
+// Metrics
+// ----------------------------------------------------------------------------
+
+TEST_CASE("WorkStealing.Metrics.LatencyHistogram" * doctest::timeout(300)) {
+
+  using H = collie::tf::LatencyHistogram;
+
+  REQUIRE(H::bucket(0) == 0);
+  REQUIRE(H::bucket(1) == 0);
+  REQUIRE(H::bucket(2) == 1);
+  REQUIRE(H::bucket(3) == 1);
+  REQUIRE(H::bucket(1023) == 9);
+  REQUIRE(H::bucket(1024) == 10);
+  REQUIRE(H::bucket(~uint64_t{0}) == H::NUM_BUCKETS - 1);
+
+  for(size_t b=1; b<H::NUM_BUCKETS; ++b) {
+    REQUIRE(H::bucket(H::lower_bound(b)) == b);
+    REQUIRE(H::bucket(H::upper_bound(b) - 1) == b);
+  }
+
+  H h;
+  REQUIRE(h.count() == 0);
+  REQUIRE(h.percentile(50) == 0);
+}
+
+void metrics_test(size_t W) {
+
+  collie::tf::Executor executor(W);
+  collie::tf::Taskflow taskflow;
+
+  REQUIRE(executor.task_timing_enabled() == false);
+
+  for(size_t i=0; i<100; ++i) {
+    taskflow.emplace([](){});
+  }
+
+  executor.run_n(taskflow, 10).wait();
+
+  // without timing, tasks are counted but not timed
+  auto m = executor.metrics();
+  REQUIRE(m.workers.size() == W);
+  REQUIRE(m.num_tasks() == 1000);
+  REQUIRE(m.latency().count() == 0);
+  REQUIRE(m.busy().count() == 0);
+
+  executor.enable_task_timing();
+  REQUIRE(executor.task_timing_enabled() == true);
+
+  taskflow.clear();
+  taskflow.emplace([](collie::tf::Subflow& sf){
+    for(size_t i=0; i<100; ++i) {
+      sf.emplace([](){ std::this_thread::sleep_for(std::chrono::microseconds(10)); });
+    }
+  });
+
+  executor.run_n(taskflow, 10).wait();
+
+  m = executor.metrics();
+  REQUIRE(m.num_tasks() == 1000 + 10*101);
+  REQUIRE(m.latency().count() == 10*101);
+  REQUIRE(m.latency().percentile(50) >= 10000);
+  REQUIRE(m.latency().percentile(0) <= m.latency().percentile(100));
+  REQUIRE(m.busy().count() > 0);
+  REQUIRE(m.utilization() <= 1.0);
+
+  size_t num_tasks = 0;
+  size_t high_water = 0;
+  for(size_t w=0; w<W; ++w) {
+    REQUIRE(m.workers[w].id == w);
+    REQUIRE(m.workers[w].latency.count() <= m.workers[w].num_tasks);
+    // tasks run inside the subflows are not counted twice
+    REQUIRE(m.workers[w].busy <= m.uptime);
+    num_tasks += m.workers[w].num_tasks;
+    high_water = std::max(high_water, m.workers[w].queue_high_water);
+  }
+  REQUIRE(num_tasks == m.num_tasks());
+  // each subflow pushes its 100 tasks to the queue of its worker at once
+  REQUIRE(high_water >= 100);
+
+  executor.enable_task_timing(false);
+  executor.run(taskflow).wait();
+  REQUIRE(executor.metrics().latency().count() == m.latency().count());
+}
+
+TEST_CASE("WorkStealing.Metrics.1thread" * doctest::timeout(300)) {
+  metrics_test(1);
+}
+
+TEST_CASE("WorkStealing.Metrics.2threads" * doctest::timeout(300)) {
+  metrics_test(2);
+}
+
+TEST_CASE("WorkStealing.Metrics.4threads" * doctest::timeout(300)) {
+  metrics_test(4);
+}
+
+TEST_CASE("WorkStealing.Metrics.Parks" * doctest::timeout(300)) {
+
+  collie::tf::Executor executor(2, collie::tf::IdlePolicy::park());
+
+  for(size_t r=0; r<5; ++r) {
+    executor.silent_async([](){});
+    executor.wait_for_all();
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+
+  // metrics can be taken while the workers are running
+  std::atomic<bool> stop {false};
+  executor.silent_async([&](){
+    while(!stop.load(std::memory_order_relaxed));
+  });
+  auto m = executor.metrics();
+  stop = true;
+  executor.wait_for_all();
+
+  REQUIRE(m.num_tasks() >= 5);
+  REQUIRE(m.num_parks() > 0);
+  REQUIRE(m.num_wakeups() > 0);
+  REQUIRE(m.idle().count() > 0);
+}
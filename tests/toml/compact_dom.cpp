@@ -0,0 +1,103 @@
+// This file is a part of toml++ and is subject to the the terms of the MIT license.
+// Copyright (c) Mark Gillard <mark.gillard@outlook.com.au>
+// See https://github.com/marzer/tomlplusplus/blob/master/LICENSE for the full license text.
+// SPDX-License-Identifier: MIT
+
+#include "tests.h"
+
+// these run with and without TOML_COMPACT_DOM; only the recorded source regions differ.
+
+#if TOML_COMPACT_DOM
+static_assert(sizeof(toml::key) <= 24);
+#endif
+
+TEST_CASE("compact dom - keys")
+{
+	const auto short_str = "fifteen__chars_"sv;
+	const auto long_str	 = "a key that is too long to be stored inline"sv;
+
+	key k1{ short_str };
+	key k2{ long_str };
+	CHECK(k1.str() == short_str);
+	CHECK(k1.length() == 15u);
+	CHECK(k1.data()[15] == '\0');
+	CHECK(k2.str() == long_str);
+	CHECK(k2.data()[long_str.length()] == '\0');
+	CHECK(key{}.empty());
+	CHECK(key{ ""sv }.str() == ""sv);
+	CHECK(k1 > k2);
+	CHECK(k2 < short_str);
+
+	key k3{ k2 };
+	CHECK(k3 == k2);
+	CHECK(k3.data() != k2.data());
+
+	key k4{ std::move(k3) };
+	CHECK(k4 == long_str);
+	CHECK(k3.empty());
+
+	k4 = k1;
+	CHECK(k4 == short_str);
+	k1 = std::move(k2);
+	CHECK(k1 == long_str);
+	CHECK(std::string_view{ k1.begin(), static_cast<size_t>(k1.end() - k1.begin()) } == long_str);
+}
+
+TEST_CASE("compact dom - tables")
+{
+	table tbl;
+	for (auto k : { "m"sv, "c"sv, "x"sv, "a"sv, "q"sv, "a long key in the middle"sv })
+		tbl.insert(k, static_cast<int64_t>(k.length()));
+	CHECK(tbl.size() == 6u);
+
+	std::string order;
+	for (auto&& [k, v] : tbl)
+	{
+		CHECK(v.as_integer());
+		order += k.str().substr(0, 1);
+	}
+	CHECK(order == "aacmqx");
+
+	// wrong hints still land in the right place
+	tbl.emplace_hint<int64_t>(tbl.begin(), "z"sv, 1);
+	tbl.emplace_hint<int64_t>(tbl.end(), "b"sv, 2);
+	CHECK(tbl.begin()->first == "a"sv);
+	CHECK(std::prev(tbl.end())->first == "z"sv);
+	CHECK(tbl.lower_bound("b"sv)->first == "b"sv);
+	CHECK(tbl.lower_bound("n"sv)->first == "q"sv);
+
+	// existing keys are left alone by insert and replaced by insert_or_assign
+	CHECK(!tbl.insert("m"sv, 42).second);
+	CHECK(tbl["m"] == 1);
+	CHECK(!tbl.insert_or_assign("m"sv, 42).second);
+	CHECK(tbl["m"] == 42);
+
+	CHECK(tbl.erase("c"sv) == 1u);
+	CHECK(tbl.find("c"sv) == tbl.end());
+	CHECK(tbl.size() == 7u);
+
+	table copy{ tbl };
+	CHECK(copy == tbl);
+	copy.erase(copy.begin(), std::next(copy.begin(), 2));
+	CHECK(copy.size() == 5u);
+	CHECK(copy.begin()->first == "b"sv);
+}
+
+TEST_CASE("compact dom - source regions")
+{
+	parsing_should_succeed(FILE_LINE_ARGS,
+						   "a = 1\n[t]\nb = 2\n"sv,
+						   [](table&& tbl)
+						   {
+							   REQUIRE(tbl["t"]["b"].as_integer());
+#if TOML_COMPACT_DOM && !TOML_COMPACT_DOM_SOURCE_REGIONS
+							   CHECK(!tbl["a"].node()->source().begin);
+							   CHECK(!tbl["t"].node()->source().begin);
+							   CHECK(!tbl.begin()->first.source().begin);
+#else
+							   CHECK(tbl["a"].node()->source().begin == source_position{ 1, 5 });
+							   CHECK(tbl["t"].node()->source().begin == source_position{ 2, 1 });
+							   CHECK(tbl.begin()->first.source().begin == source_position{ 1, 1 });
+#endif
+						   });
+}
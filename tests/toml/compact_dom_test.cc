@@ -0,0 +1,196 @@
+//
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+#include <collie/testing/test.h>
+#include <collie/toml/toml.h>
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std::string_view_literals;
+
+// built once with TOML_COMPACT_DOM and once with TOML_COMPACT_DOM_SOURCE_REGIONS on top of it.
+static_assert(TOML_COMPACT_DOM);
+
+static bool stored_inline(const toml::key &k) {
+    const auto *self = reinterpret_cast<const char *>(&k);
+    return k.data() >= self && k.data() < self + sizeof(k);
+}
+
+static std::vector<std::string_view> keys_of(const toml::table &tbl) {
+    std::vector<std::string_view> keys;
+    for (auto &&[k, v]: tbl) {
+        keys.push_back(k.str());
+    }
+    return keys;
+}
+
+TEST_CASE("compact_dom key inline boundary") {
+    const std::string fifteen(15, 'a');
+    const std::string sixteen(16, 'b');
+
+    toml::key k15{fifteen};
+    toml::key k16{sixteen};
+    CHECK(stored_inline(k15));
+    CHECK_FALSE(stored_inline(k16));
+    CHECK_EQ(k15.str(), fifteen);
+    CHECK_EQ(k16.str(), sixteen);
+    CHECK_EQ(k15.length(), 15u);
+    CHECK_EQ(k16.length(), 16u);
+    CHECK_EQ(k15.data()[15], '\0');
+    CHECK_EQ(k16.data()[16], '\0');
+
+    // copies own their storage, moves hand it over
+    toml::key copy15{k15};
+    toml::key copy16{k16};
+    CHECK(stored_inline(copy15));
+    CHECK_NE(copy16.data(), k16.data());
+    CHECK_EQ(copy16, k16);
+
+    const auto *heap = copy16.data();
+    toml::key moved16{std::move(copy16)};
+    CHECK_EQ(moved16.data(), heap);
+    CHECK(copy16.empty());
+
+    // assignment across the boundary in both directions
+    toml::key k{fifteen};
+    k = k16;
+    CHECK_FALSE(stored_inline(k));
+    CHECK_EQ(k.str(), sixteen);
+    k = k15;
+    CHECK(stored_inline(k));
+    CHECK_EQ(k.str(), fifteen);
+    k = std::move(moved16);
+    CHECK_EQ(k.str(), sixteen);
+    k = toml::key{""sv};
+    CHECK(k.empty());
+    CHECK(stored_inline(k));
+}
+
+TEST_CASE("compact_dom out of order inserts") {
+    std::vector<std::string> names;
+    for (int i = 0; i < 300; ++i) {
+        // mix inline and heap keys
+        names.push_back((i % 3 == 0 ? "a_rather_long_key_" : "k") + std::to_string(i));
+    }
+    auto shuffled = names;
+    std::shuffle(shuffled.begin(), shuffled.end(), std::mt19937{42});
+
+    toml::table tbl;
+    for (const auto &name: shuffled) {
+        CHECK(tbl.insert(name, static_cast<int64_t>(name.size())).second);
+    }
+    REQUIRE_EQ(tbl.size(), names.size());
+
+    auto keys = keys_of(tbl);
+    CHECK(std::is_sorted(keys.begin(), keys.end()));
+    for (const auto &name: names) {
+        auto it = tbl.find(name);
+        REQUIRE(it != tbl.end());
+        CHECK_EQ(it->first.str(), name);
+        CHECK_EQ(it->second.value<int64_t>(), static_cast<int64_t>(name.size()));
+    }
+    // duplicates are rejected wherever they land
+    for (const auto &name: shuffled) {
+        CHECK_FALSE(tbl.insert(name, 0).second);
+    }
+    CHECK_EQ(tbl.size(), names.size());
+}
+
+TEST_CASE("compact_dom emplace_hint with wrong hints") {
+    toml::table tbl;
+    for (auto k: {"d"sv, "h"sv, "m"sv, "r"sv}) {
+        tbl.insert(k, 0);
+    }
+
+    // hints on the wrong side of the key, and hints at existing keys
+    tbl.emplace_hint<int64_t>(tbl.begin(), "z"sv, 1);
+    tbl.emplace_hint<int64_t>(tbl.end(), "a"sv, 2);
+    tbl.emplace_hint<int64_t>(tbl.find("r"sv), "e"sv, 3);
+    tbl.emplace_hint<int64_t>(tbl.find("d"sv), "q"sv, 4);
+    auto it = tbl.emplace_hint<int64_t>(tbl.begin(), "h"sv, 5);
+    CHECK_EQ(it->first, "h"sv);
+    CHECK_EQ(it->second.value<int64_t>(), 0);
+
+    CHECK_EQ(keys_of(tbl), std::vector<std::string_view>{"a", "d", "e", "h", "m", "q", "r", "z"});
+    CHECK_EQ(tbl["a"].value<int64_t>(), 2);
+    CHECK_EQ(tbl["e"].value<int64_t>(), 3);
+    CHECK_EQ(tbl["q"].value<int64_t>(), 4);
+    CHECK_EQ(tbl["z"].value<int64_t>(), 1);
+}
+
+TEST_CASE("compact_dom parse, copy and erase") {
+    toml::table doc = toml::parse(R"(
+        title = "compact"
+        a_key_longer_than_sixteen = 1
+
+        [server]
+        host = "localhost"
+        port = 8080
+        tags = ["x", "y"]
+
+        [server.limits]
+        connections_per_client = 16
+        timeout = 30
+    )"sv);
+
+    toml::table copy{doc};
+    CHECK_EQ(copy, doc);
+
+    CHECK_EQ(copy.erase("title"sv), 1u);
+    auto *server = copy["server"].as_table();
+    REQUIRE(server);
+    server->erase(server->find("port"sv));
+    (*server)["limits"].as_table()->erase("connections_per_client"sv);
+
+    // the copy is independent of the parsed document
+    CHECK_NE(copy, doc);
+    CHECK_EQ(doc["title"].value<std::string_view>(), "compact"sv);
+    CHECK_EQ(doc["server"]["port"].value<int64_t>(), 8080);
+    CHECK_EQ(doc["server"]["limits"]["connections_per_client"].value<int64_t>(), 16);
+
+    CHECK_EQ(keys_of(copy), std::vector<std::string_view>{"a_key_longer_than_sixteen", "server"});
+    CHECK_EQ(keys_of(*server), std::vector<std::string_view>{"host", "limits", "tags"});
+    CHECK_EQ(copy["server"]["limits"]["timeout"].value<int64_t>(), 30);
+    CHECK_EQ(copy["server"]["tags"][1].value<std::string_view>(), "y"sv);
+
+    // erasing a range, then everything
+    server->erase(server->begin(), std::next(server->begin(), 2));
+    CHECK_EQ(keys_of(*server), std::vector<std::string_view>{"tags"});
+    copy.clear();
+    CHECK(copy.empty());
+    CHECK_EQ(doc.size(), 3u);
+}
+
+TEST_CASE("compact_dom source regions") {
+    toml::table doc = toml::parse("a = 1\n[t]\nb = 2\n"sv);
+    REQUIRE(doc["t"]["b"].is_integer());
+#if TOML_COMPACT_DOM_SOURCE_REGIONS
+    CHECK_EQ(doc["a"].node()->source().begin, toml::source_position{1, 5});
+    CHECK_EQ(doc["t"].node()->source().begin, toml::source_position{2, 1});
+    CHECK_EQ(doc.begin()->first.source().begin, toml::source_position{1, 1});
+#else
+    CHECK_FALSE(doc["a"].node()->source().begin);
+    CHECK_FALSE(doc["t"].node()->source().begin);
+    CHECK_FALSE(doc.begin()->first.source().begin);
+#endif
+}
@@ -378,11 +378,13 @@ TEST_CASE("tables - insertion and erasure")
 		CHECK(*tbl.get_as<std::string>("kek") == "kek");
 
 		REQUIRE(vals.size() == 3u);
+#if !TOML_COMPACT_DOM // compact keys copy the characters out of the string instead of taking its buffer
 		CHECK(vals[0].first == "");
-		CHECK(vals[0].second == "");
 		CHECK(vals[1].first == "");
-		CHECK(vals[1].second == "");
 		CHECK(vals[2].first == "");
+#endif
+		CHECK(vals[0].second == "");
+		CHECK(vals[1].second == "");
 		CHECK(vals[2].second == "");
 
 		tbl.clear();
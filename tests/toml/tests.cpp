@@ -16,6 +16,7 @@ bool parsing_should_succeed(std::string_view test_file,
 
 	constexpr auto validate_table = [](table&& tabl, std::string_view path) -> table&&
 	{
+#if !TOML_COMPACT_DOM || TOML_COMPACT_DOM_SOURCE_REGIONS
 		INFO("Validating table source information"sv)
 		CHECK(tabl.source().begin != source_position{});
 		CHECK(tabl.source().end != source_position{});
@@ -26,6 +27,9 @@ bool parsing_should_succeed(std::string_view test_file,
 			REQUIRE(tabl.source().path != nullptr);
 			CHECK(*tabl.source().path == path);
 		}
+#else
+		TOML_UNUSED(path);
+#endif
 		return std::move(tabl);
 	};
 